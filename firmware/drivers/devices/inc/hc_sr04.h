@@ -9,6 +9,16 @@
  ** @{ */
 
 /** \brief Driver for reading distance with HC-SR04 module.
+ *
+ * Distance can be read in two ways:
+ * - Blocking: HcSr04ReadDistanceInCentimeters() and HcSr04ReadDistanceInInches() trigger a 
+ * measurement and wait for the echo (up to ~24 ms), keeping the calling task busy.
+ * - Scan: after HcSr04ScanInit() and HcSr04ScanStart() up to HC_SR04_MAX_SENSORS sensors are 
+ * triggered in turns by a timer, one per slot, so the echo of a sensor is never taken by 
+ * another one (cross-talk). Echo edges are timestamped in the GPIO interrupt with the 
+ * free-running timer (see TimerGetTimestamp()), so the CPU is only used for a few us per 
+ * measurement. Readings are median filtered per sensor and stored in a ring buffer, read by 
+ * the application with HcSr04ScanRead().
  *
  * @note Maximun distance: 300cm (118 inches).
  * 
@@ -29,6 +39,8 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 17/10/2026 | Interrupt driven scan of several sensors, median filter				|
+ * | 17/10/2026 | Blocking reads measure the echo with 1 us resolution					|
  * 
  **/
 
@@ -36,9 +48,38 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "gpio_mcu.h"
+#include "timer_mcu.h"
 /*==================[macros]=================================================*/
+#define HC_SR04_MAX_SENSORS		4		/*!< Max. number of sensors scanned */
+#define HC_SR04_MEDIAN_MAX		5		/*!< Max. median filter window */
+#define HC_SR04_BUFFER_SIZE		16		/*!< Readings stored by the scan (power of two) */
+#define HC_SR04_MIN_SLOT_MS		25		/*!< Min. time between triggers (max. echo plus margin) */
+#define HC_SR04_MAX_MM			3000	/*!< Distance reported when the echo is out of range */
 
 /*==================[typedef]================================================*/
+/**
+ * @brief Scan configuration
+ */
+typedef struct {
+	uint8_t n_sensors;							/*!< Number of sensors (up to HC_SR04_MAX_SENSORS) */
+	gpio_t echo[HC_SR04_MAX_SENSORS];			/*!< GPIO where echo pin of each sensor is connected */
+	gpio_t trigger[HC_SR04_MAX_SENSORS];		/*!< GPIO where trigger pin of each sensor is connected */
+	timer_mcu_t timer;							/*!< Timer used for the slots (not available for the application) */
+	uint16_t slot_ms;							/*!< Time between triggers (ms, >= HC_SR04_MIN_SLOT_MS, 60 recommended) */
+	uint8_t median;								/*!< Median filter window (1: no filter, up to HC_SR04_MEDIAN_MAX) */
+	void *consumer;								/*!< Task notified on each reading (TaskHandle_t, NULL: none) */
+} hc_sr04_scan_config_t;
+
+/**
+ * @brief Scan reading
+ */
+typedef struct {
+	uint64_t time;			/*!< Trigger time (us since boot, see TimerGetTimestamp()) */
+	uint16_t echo_us;		/*!< Echo pulse width (us, 0: no echo) */
+	uint16_t distance;		/*!< Median filtered distance (mm, up to HC_SR04_MAX_MM) */
+	uint8_t sensor;			/*!< Sensor number (position in the configuration) */
+	bool valid;				/*!< false when there was no echo (sensor disconnected) */
+} hc_sr04_reading_t;
 
 /*==================[external data declaration]==============================*/
 
@@ -66,6 +107,53 @@ uint16_t HcSr04ReadDistanceInCentimeters(void);
  */
 uint16_t HcSr04ReadDistanceInInches(void);
 
+/**
+ * @brief Initialize the scan of several sensors (scan is stopped after init).
+ * 
+ * @note Each sensor is measured once every n_sensors * slot_ms. Sensors facing the same 
+ * space with slots shorter than 60 ms may receive late echoes of the previous one.
+ * 
+ * @param config Scan configuration
+ * @return true when success, false if the configuration is not valid
+ */
+bool HcSr04ScanInit(const hc_sr04_scan_config_t *config);
+
+/**
+ * @brief Start (or resume) the scan.
+ * 
+ */
+void HcSr04ScanStart(void);
+
+/**
+ * @brief Stop the scan (the measurement in progress is discarded).
+ * 
+ */
+void HcSr04ScanStop(void);
+
+/**
+ * @brief Read the oldest scan readings (without waiting).
+ * 
+ * @param readings Buffer for the readings
+ * @param n Max. number of readings to read
+ * @return uint32_t Number of readings read
+ */
+uint32_t HcSr04ScanRead(hc_sr04_reading_t *readings, uint32_t n);
+
+/**
+ * @brief Wait for scan readings (called from the consumer task).
+ * 
+ * @param timeout_ms Max. time to wait
+ * @return true if there are readings to read
+ */
+bool HcSr04ScanWait(uint32_t timeout_ms);
+
+/**
+ * @brief Number of readings lost because the application didn't read them on time.
+ * 
+ * @return uint32_t Readings lost since HcSr04ScanInit()
+ */
+uint32_t HcSr04ScanDropped(void);
+
 /**
  * @brief HC_SR04 de-initialization.
  * 
@@ -10,6 +10,15 @@
 /** \brief The HX711 amplifier is a breakout board that allows you to easily read load cells to measure weight. It communicates with the EDU-ESP
  * board via I2C.
  * 
+ * Readings can be taken in two ways:
+ * - Blocking: HX711_read() and the functions based on it wait for the conversion (up to 100 ms
+ * at 10 SPS) and keep the calling task busy.
+ * - Stream: after HX711_startStream() each conversion is read in the DOUT data-ready interrupt 
+ * (~40 us) and stored, timestamped, in a ring buffer. The application reads the samples with 
+ * HX711_readSamples() when it wants, and can filter them with a hx711_filter_t (median, moving 
+ * average, tare and scale), so weighing runs concurrently with other tasks.
+ * 
+ * @note Blocking functions must not be used while the stream is running.
  * @author Juan Ignacio Cerrudo
  *
  * @section changelog
@@ -17,14 +26,45 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 30/01/2024 | Document creation		                         						|
+ * | 17/10/2026 | Interrupt driven stream of samples, median/average/tare filter		|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <gpio_mcu.h>
 /*==================[macros]=================================================*/
+#define HX711_BUFFER_SIZE		32		/*!< Samples stored by the stream (power of two) */
+#define HX711_MEDIAN_MAX		7		/*!< Max. median filter window */
+#define HX711_AVERAGE_MAX		32		/*!< Max. moving average window */
 
 /*==================[typedef]================================================*/
+/**
+ * @brief Stream sample
+ */
+typedef struct {
+	int32_t value;		/*!< Conversion result (24 bits two's complement, sign extended) */
+	uint64_t time;		/*!< Data ready time (us since boot, see TimerGetTimestamp()) */
+} hx711_sample_t;
+
+/**
+ * @brief Streaming filter: median -> moving average -> tare -> scale
+ */
+typedef struct {
+	uint8_t median;							/*!< Median window (1: no median filter) */
+	uint8_t average;						/*!< Moving average window (1: no average) */
+	int32_t med_buf[HX711_MEDIAN_MAX];		/*!< Last samples (median window) */
+	uint8_t med_idx;						/*!< Oldest sample in med_buf */
+	uint8_t med_count;						/*!< Samples in med_buf */
+	int32_t avg_buf[HX711_AVERAGE_MAX];		/*!< Last medians (average window) */
+	uint8_t avg_idx;						/*!< Oldest median in avg_buf */
+	uint8_t avg_count;						/*!< Medians in avg_buf */
+	int64_t avg_sum;						/*!< Sum of avg_buf */
+	int32_t offset;							/*!< Tare value */
+	float scale;							/*!< Counts per unit */
+	int64_t tare_sum;						/*!< Sum of filtered values while taring */
+	uint16_t tare_n;						/*!< Values to average for the tare */
+	uint16_t tare_count;					/*!< Values summed for the tare */
+} hx711_filter_t;
 
 /*==================[external data declaration]==============================*/
 
@@ -65,20 +105,20 @@ uint32_t HX711_read(void);
  */
 uint32_t HX711_readAverage(uint8_t times);
 
-/** @fn HX711_get_value(uint8_t times)
+/** @fn HX711_getValue(uint8_t times)
  * @brief Returns (read_average() - OFFSET), that is the current value without the tare weight
  * @param[in] times How many times to read
  * @return Read value
  */
-double HX711_get_value(uint8_t times);
+double HX711_getValue(uint8_t times);
 
 
-/** @fn HX711_get_units(uint8_t times)
+/** @fn HX711_getUnits(uint8_t times)
  * @brief Returns get_value() divided by SCALE, that is the raw value divided by a value obtained via calibration
  * @param[in] times How many readings to do
  * @return Read value
  */
-float HX711_get_units(uint8_t times);
+float HX711_getUnits(uint8_t times);
 
 /** @fn HX711_tare(uint8_t times)
  * @brief Set the OFFSET value for tare weight
@@ -120,6 +160,74 @@ void HX711_powerDown(void);
  */
 void HX711_powerUp(void);
 
+/** @fn bool HX711_startStream(void *consumer)
+ * @brief Start reading each conversion in the data-ready interrupt (samples are stored in a ring buffer)
+ * @note The chip is reset (power down and up) to get the first data-ready edge: the first sample
+ * comes after the settling time (400 ms at 10 SPS, 50 ms at 80 SPS).
+ * @note The clock pulses of each reading are generated in the interrupt, higher priority 
+ * interrupts longer than 50 us could power down the chip.
+ * @param[in] consumer Task notified on each sample (TaskHandle_t, NULL: none), see HX711_waitSamples()
+ * @return true when success
+ */
+bool HX711_startStream(void *consumer);
+
+/** @fn void HX711_stopStream(void)
+ * @brief Stop the stream (stored samples can still be read)
+ */
+void HX711_stopStream(void);
+
+/** @fn uint32_t HX711_readSamples(hx711_sample_t *samples, uint32_t n)
+ * @brief Read the oldest samples stored by the stream (without waiting)
+ * @param[out] samples Array where samples are stored
+ * @param[in] n Max. number of samples to read
+ * @return Number of samples read
+ */
+uint32_t HX711_readSamples(hx711_sample_t *samples, uint32_t n);
+
+/** @fn bool HX711_waitSamples(uint32_t timeout_ms)
+ * @brief Block the consumer task (given to HX711_startStream()) until there are samples stored
+ * @param[in] timeout_ms Max. time to wait (ms)
+ * @return true if there are samples stored, false on timeout
+ */
+bool HX711_waitSamples(uint32_t timeout_ms);
+
+/** @fn uint32_t HX711_droppedSamples(void)
+ * @brief Samples lost because the ring buffer was full (since HX711_startStream())
+ * @return Samples lost
+ */
+uint32_t HX711_droppedSamples(void);
+
+/** @fn void HX711_filterInit(hx711_filter_t *filter, uint8_t median, uint8_t average)
+ * @brief Initialize a streaming filter (no tare, scale 1)
+ * @param[in] filter Filter
+ * @param[in] median Median window (1 to HX711_MEDIAN_MAX, odd)
+ * @param[in] average Moving average window (1 to HX711_AVERAGE_MAX)
+ */
+void HX711_filterInit(hx711_filter_t *filter, uint8_t median, uint8_t average);
+
+/** @fn bool HX711_filterPush(hx711_filter_t *filter, int32_t value, float *units)
+ * @brief Add a sample to the filter
+ * @param[in] filter Filter
+ * @param[in] value Sample value
+ * @param[out] units Filtered value, without tare and divided by the scale
+ * @return true if units is valid (windows are full and the filter isn't taring)
+ */
+bool HX711_filterPush(hx711_filter_t *filter, int32_t value, float *units);
+
+/** @fn void HX711_filterTare(hx711_filter_t *filter, uint16_t times)
+ * @brief Take the tare from the next filtered values (filter output isn't valid meanwhile)
+ * @param[in] filter Filter
+ * @param[in] times How many filtered values to average for the tare
+ */
+void HX711_filterTare(hx711_filter_t *filter, uint16_t times);
+
+/** @fn void HX711_filterSetScale(hx711_filter_t *filter, float scale)
+ * @brief Set the counts per measure unit (obtained via calibration)
+ * @param[in] filter Filter
+ * @param[in] scale Scale value
+ */
+void HX711_filterSetScale(hx711_filter_t *filter, float scale);
+
 /*==================[internal functions declaration]=========================*/
 // Sends/receives data. 
 uint8_t shiftIn(void);
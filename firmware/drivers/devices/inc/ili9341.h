@@ -33,6 +33,12 @@
  * |   Date	    | Description                                    |
  * |:----------:|:-----------------------------------------------|
  * | 18/01/2024 | Document creation		                         |
+ * | 17/10/2026 | Off-screen framebuffer with dirty regions      |
+ * | 17/10/2026 | Queued DMA pixel pipeline                      |
+ * | 17/10/2026 | Glyph cache and single window strings          |
+ * | 17/10/2026 | RLE and palette compressed images              |
+ * | 17/10/2026 | Span based geometry, thick lines and rounded rectangles |
+ * | 17/10/2026 | Vertical scrolling                             |
  *
  */
 
@@ -46,6 +52,9 @@
 #define ILI9341_WIDTH       240			/*!< LCD width in pixels */
 #define ILI9341_HEIGHT      320			/*!< LCD height in pixels */
 #define ILI9341_PIXEL_MAX	76800
+#define ILI9341_MAX_DIRTY_RECTS	8		/*!< Max. number of regions tracked by the framebuffer between flushes */
+#define ILI9341_MAX_BURST	4092		/*!< Max. bytes of a pixel burst (SPI max_transfer_sz) */
+#define ILI9341_GLYPH_CACHE_ENTRIES	32	/*!< Max. number of characters kept by the glyph cache */
 /* 16bits colors (RGB565) */			/*	 R,   G,   B */
 #define ILI9341_BLACK          	0x0000  /*   0,   0,   0 */
 #define ILI9341_NAVY           	0x000F 	/*   0,   0, 128 */
@@ -80,6 +89,26 @@ typedef enum ili9341_orientation {
 	ILI9341_Landscape_1, 	/*!< Landscape orientation mode 1 */
 	ILI9341_Landscape_2  	/*!< Landscape orientation mode 2 */
 } ili9341_orientation_t;
+
+/**
+ * @brief  Pixel encoding of compressed images
+ */
+typedef enum ili9341_image_format {
+	ILI9341_IMAGE_RLE16,	/*!< Runs of RGB565 colors (lossless) */
+	ILI9341_IMAGE_RLE8,		/*!< Runs of 8 bits palette indexes (up to 256 colors) */
+	ILI9341_IMAGE_RLE4		/*!< Runs of 4 bits palette indexes (up to 16 colors) */
+} ili9341_image_format_t;
+
+/**
+ * @brief  Compressed image (see ILI9341DrawImage())
+ */
+typedef struct {
+	uint16_t width;						/*!< Image width in pixels */
+	uint16_t height;					/*!< Image height in pixels */
+	ili9341_image_format_t format;		/*!< Pixel encoding */
+	const uint16_t *palette;			/*!< RGB565 colors (NULL for ILI9341_IMAGE_RLE16) */
+	const uint8_t *data;				/*!< Encoded pixels */
+} ili9341_image_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -154,6 +183,8 @@ void ILI9341DrawInt(uint16_t x, uint16_t y, uint32_t num, uint8_t dig, Font_t* f
 
 /**
  * @brief  		Draw a string on the LCD
+ * @note		Each line that fits in the LCD width is sent in a single window, with the 1 pixel
+ * 				gap between characters filled with background color.
  * @param[in] 	x: X position of top left corner of first character in string
  * @param[in]  	y: Y position of top left corner of first character in string
  * @param[in]  	str: Pointer to first character
@@ -185,6 +216,19 @@ void ILI9341GetStringSize(char* str, Font_t* font, uint16_t* width, uint16_t* he
  */
 void ILI9341DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
 
+/**
+ * @brief  		Draws line of a given thickness on the LCD
+ * @note		Ends are cut along the closest axis (i.e. vertical for lines closer to horizontal)
+ * @param[in]  	x0: X coordinate of starting point
+ * @param[in]  	y0: Y coordinate of starting point
+ * @param[in]  	x1: X coordinate of ending point
+ * @param[in]  	y1: Y coordinate of ending point
+ * @param[in]  	thickness: Line thickness in pixels
+ * @param[in]  	color: Line color (RGB565)
+ * @retval 		None
+ */
+void ILI9341DrawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t thickness, uint16_t color);
+
 /**
  * @brief  		Draws rectangle on the LCD
  * @param[in]  	x0: X coordinate of top left point
@@ -207,6 +251,30 @@ void ILI9341DrawRectangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, ui
  */
 void ILI9341DrawFilledRectangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
 
+/**
+ * @brief  		Draws rectangle with rounded corners on the LCD
+ * @param[in]  	x0: X coordinate of top left point
+ * @param[in]  	y0: Y coordinate of top left point
+ * @param[in]  	x1: X coordinate of bottom right point
+ * @param[in]  	y1: Y coordinate of bottom right point
+ * @param[in]  	r: Corners radius (limited to half of the shortest side)
+ * @param[in]  	color: Rectangle color (RGB565)
+ * @retval 		None
+ */
+void ILI9341DrawRoundRectangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t r, uint16_t color);
+
+/**
+ * @brief  		Draws filled rectangle with rounded corners on the LCD
+ * @param[in]  	x0: X coordinate of top left point
+ * @param[in]  	y0: Y coordinate of top left point
+ * @param[in]  	x1: X coordinate of bottom right point
+ * @param[in]  	y1: Y coordinate of bottom right point
+ * @param[in]  	r: Corners radius (limited to half of the shortest side)
+ * @param[in]  	color: Rectangle color (RGB565)
+ * @retval 		None
+ */
+void ILI9341DrawFilledRoundRectangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t r, uint16_t color);
+
 /**
  * @brief  		Draws circle on the LCD
  * @param[in]  	x0: X coordinate of center circle point
@@ -267,6 +335,143 @@ void ILI9341DrawFilledTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, i
  */
 void ILI9341DrawPicture(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* pic);
 
+/**
+ * @brief  		Draw a compressed image on the LCD
+ * @note		Images are converted to C arrays with devices/tools/img2ili9341.py (PNG, BMP or 
+ * 				RGB565 arrays of ILI9341DrawPicture). Pixels are decoded straight into the burst 
+ * 				buffers, rows from top to bottom, as packets of up to 128 pixels:
+ * 				- Header byte: bit 7 = 1 for a run (same value repeated), 0 for a literal; 
+ * 				  bits 6-0 = pixels - 1.
+ * 				- Run: one value. Literal: one value per pixel.
+ * 				- Values: RGB565 high byte first (RLE16), palette index (RLE8) or 4 bits palette 
+ * 				  index, high nibble first (RLE4; runs use the low nibble of one byte).
+ * @param[in] 	x: X position of top left corner of image
+ * @param[in]  	y: Y position of top left corner of image
+ * @param[in]  	image: Pointer to image
+ * @retval 		None
+ */
+void ILI9341DrawImage(uint16_t x, uint16_t y, const ili9341_image_t *image);
+
+/**
+ * @brief  		Redirect all ILI9341Draw* functions (and ILI9341Fill) to an off-screen framebuffer
+ * @note		The framebuffer can cover the whole LCD (ILI9341_PIXEL_MAX pixels, 150 KB) or 
+ * 				only a region/band of it. Drawings outside the region are discarded. Modified 
+ * 				regions are sent to the LCD by ILI9341FramebufferFlush().
+ * @note		To render a full screen with a smaller buffer, draw the screen once for each 
+ * 				band, calling ILI9341FramebufferMove() before and ILI9341FramebufferFlush() after.
+ * @param[in]  	buffer: Array of width * height pixels (must be DMA capable, i.e. internal RAM)
+ * @param[in]  	x: LCD column of the left side of the region
+ * @param[in]  	y: LCD row of the top side of the region
+ * @param[in]  	width: Region width in pixels
+ * @param[in]  	height: Region height in pixels
+ * @retval 		None
+ */
+void ILI9341FramebufferEnable(uint16_t *buffer, uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+
+/**
+ * @brief  		Move the region covered by the framebuffer
+ * @note		Pending changes are discarded and buffer contents are kept: the region must be 
+ * 				redrawn before flushing.
+ * @param[in]  	x: LCD column of the left side of the region
+ * @param[in]  	y: LCD row of the top side of the region
+ * @retval 		None
+ */
+void ILI9341FramebufferMove(uint16_t x, uint16_t y);
+
+/**
+ * @brief  		Send the regions modified since last flush to the LCD in burst writes
+ * @retval 		None
+ */
+void ILI9341FramebufferFlush(void);
+
+/**
+ * @brief  		Flush pending changes and go back to drawing directly on the LCD
+ * @retval 		None
+ */
+void ILI9341FramebufferDisable(void);
+
+/**
+ * @brief  		Send pixels in background through a queue of DMA buffers
+ * @note		Pixels of Fill, DrawChar, DrawIcon, DrawPicture and FramebufferFlush are generated
+ * 				in one buffer while the previous ones are on the wire, and drawing functions return 
+ * 				as soon as their last buffer is queued. Commands (i.e. the next drawing window) wait
+ * 				for the queue to be empty.
+ * @note		Without pipeline pixels are sent in blocking bursts of ILI9341_MAX_BURST bytes.
+ * @param[in]  	buffers: Array of n_buffers * buffer_size bytes (DMA capable, 4 bytes aligned)
+ * @param[in]  	buffer_size: Bytes of each buffer (rounded down to a multiple of 4, up to ILI9341_MAX_BURST)
+ * @param[in]  	n_buffers: Number of buffers (at least 2)
+ * @param[in]  	func_p: Function called (from ISR) each time the queue gets empty, NULL if not used
+ * @param[in]  	param_p: Parameter of func_p
+ * @retval 		None
+ */
+void ILI9341PipelineEnable(uint8_t *buffers, uint16_t buffer_size, uint8_t n_buffers, void *func_p, void *param_p);
+
+/**
+ * @brief  		Wait until all queued pixels are sent (fence)
+ * @note		Needed before sharing the SPI bus or changing the LCD hardware state 
+ * 				(i.e. turning it off); drawing functions synchronize by themselves.
+ * @retval 		None
+ */
+void ILI9341PipelineWait(void);
+
+/**
+ * @brief  		Wait for queued pixels and go back to blocking writes
+ * @retval 		None
+ */
+void ILI9341PipelineDisable(void);
+
+/**
+ * @brief  		Keep characters already expanded to RGB565, so redrawing them (i.e. numeric 
+ * 				readouts) is a copy instead of a bit by bit expansion
+ * @note		Characters are kept by (font, character, foreground, background). When the pool 
+ * 				or the ILI9341_GLYPH_CACHE_ENTRIES entries are full, the least recently used 
+ * 				ones are evicted. A character uses width * height * 2 bytes (i.e. ~840 bytes 
+ * 				for a font_30 digit, ~3.3 KB for a font_59 digit).
+ * @param[in]  	pool: Array to store expanded characters
+ * @param[in]  	size: Pool size in bytes
+ * @retval 		None
+ */
+void ILI9341GlyphCacheEnable(uint8_t *pool, uint32_t size);
+
+/**
+ * @brief  		Discard cached characters and go back to expanding them on each drawing
+ * @retval 		None
+ */
+void ILI9341GlyphCacheDisable(void);
+
+/**
+ * @brief  		Current LCD orientation
+ * @retval 		Orientation set with ILI9341Rotate()
+ */
+ili9341_orientation_t ILI9341GetOrientation(void);
+
+/**
+ * @brief  		Defines the scrolling area of the display
+ * @note		Scrolling works along the ILI9341_HEIGHT side of the panel, on frame memory lines:
+ * 				rows in portrait modes, columns in landscape modes (counted from the left edge in 
+ * 				ILI9341_Landscape_1 and from the right edge in ILI9341_Landscape_2). Lines outside 
+ * 				the area are fixed.
+ * @param[in]  	top_fixed: Number of fixed lines before the scrolling area
+ * @param[in]  	lines: Number of lines of the scrolling area
+ * @retval 		1 when success, 0 when fails (top_fixed + lines must not exceed ILI9341_HEIGHT, the
+ * 				area is not changed otherwise)
+ */
+uint8_t ILI9341ScrollArea(uint16_t top_fixed, uint16_t lines);
+
+/**
+ * @brief  		Sets the frame memory line shown at the first line of the scrolling area
+ * @note		Only the displayed image moves, drawing functions keep using frame memory coordinates
+ * @param[in]  	line: Frame memory line (top_fixed <= line < top_fixed + lines)
+ * @retval 		None
+ */
+void ILI9341ScrollStart(uint16_t line);
+
+/**
+ * @brief  		Stops scrolling (frame memory is displayed as it is)
+ * @retval 		None
+ */
+void ILI9341ScrollDisable(void);
+
 /**
  * @brief  	De-initializes ILI9341 LCD
  * @param	None
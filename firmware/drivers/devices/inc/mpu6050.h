@@ -10,6 +10,13 @@
 /** \brief MPU6050 sensor module is a 6-axis Motion Tracking Device. It combines 3-axis Accelerometer and 3-axis Gyroscope. It communicates with the EDU-ESP
  * board via I2C.
  * 
+ * Besides register reads (MPU6050_getMotion6() and others, one I2C read per sample), samples
+ * can be streamed through the sensor FIFO: after MPU6050_startStream() accelerometer and
+ * gyroscope frames are stored in the FIFO at the sample rate, the data ready interrupt (INT 
+ * pin) notifies a consumer task every burst samples, and MPU6050_readStream() drains the FIFO 
+ * with a single burst read, parsing the frames into a struct of arrays. The FIFO holds 85
+ * frames, so the consumer can be delayed up to that many samples without losing any.
+ * 
  * @author Juan Ignacio Cerrudo
  *
  * @section changelog
@@ -17,6 +24,7 @@
  * |   Date	| Description                                    			|
  * |:----------:|:----------------------------------------------------------------------|
  * | 30/01/2024 | Document creation		                         		|
+ * | 17/10/2026 | FIFO burst streaming (MPU6050_startStream)				|
  * 
  **/
 
@@ -409,7 +417,37 @@
 #define MPU6050_DMP_MEMORY_CHUNK_SIZE   16
 // note: DMP code memory blocks defined at end of header file
 
+#define MPU6050_FIFO_SIZE           1024    /*!< FIFO size (bytes) */
+#define MPU6050_FIFO_FRAME_SIZE     12      /*!< Stream frame: accel X, Y, Z and gyro X, Y, Z (big endian) */
+#define MPU6050_STREAM_FRAMES       (MPU6050_FIFO_SIZE / MPU6050_FIFO_FRAME_SIZE)  /*!< Frames the FIFO can hold (85) */
+
 /*==================[typedef]================================================*/
+/**
+ * @brief FIFO stream configuration
+ */
+typedef struct {
+	uint16_t rate;			/*!< Samples per second (gyro output rate / integer divider: 4 to 1000) */
+	uint8_t dlpf;			/*!< Digital low pass filter (MPU6050_DLPF_BW_*) */
+	gpio_t int_pin;			/*!< GPIO where INT pin is connected */
+	uint8_t burst;			/*!< Samples between consumer notifications (1 to MPU6050_STREAM_FRAMES / 2) */
+	void *consumer;			/*!< Task notified every burst samples (TaskHandle_t, required) */
+} mpu6050_stream_config_t;
+
+/**
+ * @brief Stream frames, as a struct of arrays (each axis is contiguous)
+ */
+typedef struct {
+	int16_t ax[MPU6050_STREAM_FRAMES];		/*!< Accelerometer X-axis */
+	int16_t ay[MPU6050_STREAM_FRAMES];		/*!< Accelerometer Y-axis */
+	int16_t az[MPU6050_STREAM_FRAMES];		/*!< Accelerometer Z-axis */
+	int16_t gx[MPU6050_STREAM_FRAMES];		/*!< Gyroscope X-axis */
+	int16_t gy[MPU6050_STREAM_FRAMES];		/*!< Gyroscope Y-axis */
+	int16_t gz[MPU6050_STREAM_FRAMES];		/*!< Gyroscope Z-axis */
+	uint16_t count;							/*!< Frames stored, oldest first */
+	bool overflow;							/*!< FIFO overflowed: it was reset and its frames were lost */
+	uint32_t lost;							/*!< Frames lost by FIFO overflows since the stream started */
+	uint64_t time;							/*!< Time of the last data ready interrupt before the read (us since boot) */
+} mpu6050_frames_t;
 
 /*==================[external data declaration]==============================*/
 
@@ -2669,6 +2707,44 @@ uint8_t MPU6050_getDeviceID();
  */
 void MPU6050_setDeviceID(uint8_t id);
 
+// FIFO stream
+/** Start streaming accelerometer and gyroscope frames through the FIFO.
+ * Sample rate, DLPF, FIFO and data ready interrupt are configured, and the FIFO
+ * is reset. The actual rate is the gyro output rate (1 kHz, or 8 kHz with
+ * MPU6050_DLPF_BW_256) divided by an integer.
+ * @param config Stream configuration
+ * @return True when success, false if the configuration is not valid (i.e. no consumer
+ * task) or the stream is already running
+ */
+bool MPU6050_startStream(const mpu6050_stream_config_t *config);
+
+/** Stop the stream (FIFO and data ready interrupt are disabled).
+ */
+void MPU6050_stopStream();
+
+/** Wait for a burst of samples (called from the consumer task).
+ * @param timeout_ms Max. time to wait
+ * @return True if burst samples (or more) were taken since the last call
+ */
+bool MPU6050_waitStream(uint32_t timeout_ms);
+
+/** Read all the complete frames in the FIFO (one burst read).
+ * If the FIFO has overflowed, its frames are not aligned anymore: it is reset,
+ * no frames are returned and frames->overflow is set.
+ * @param frames Frames read (previous content is replaced)
+ * @return Number of frames read
+ */
+uint16_t MPU6050_readStream(mpu6050_frames_t *frames);
+
+/** Parse FIFO bytes into frames.
+ * @param data FIFO bytes, starting at a frame boundary (an incomplete last
+ * frame is ignored)
+ * @param length Number of bytes
+ * @param frames Frames are added after frames->count (up to MPU6050_STREAM_FRAMES)
+ * @return Number of frames added
+ */
+uint16_t MPU6050_parseFIFO(const uint8_t *data, uint16_t length, mpu6050_frames_t *frames);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -0,0 +1,159 @@
+#ifndef NEOPIXEL_ANIM_H
+#define NEOPIXEL_ANIM_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Devices Drivers devices
+ ** @{ */
+/** \addtogroup NeoPixel_Anim NeoPixel animations
+ ** @{ */
+
+/** \brief Non-blocking animations for a NeoPixel stripe.
+ *
+ * Frames are rendered and sent by a task of the driver, at a fixed rate given by a timer,
+ * so effects run continuously alongside the application tasks.
+ *
+ * Up to NEOPIXEL_ANIM_MAX_EFFECTS effects are composed on each frame, in the order they were
+ * added, starting from all NeoPixels off: rainbow and fade overwrite the colors of their range,
+ * chase draws over them and breathe scales the brightness of the previous effects. Each effect
+ * covers a range of the stripe, and its cycle time doesn't depend on the frame rate.
+ *
+ * The CPU time used by each frame (render and send) is measured against the frame period,
+ * see NeoPixelAnimGetStats().
+ *
+ * @note While the animations are running, no other NeoPixel function must be called.
+ *
+ * @note Frames take 30 us per NeoPixel to be sent: if the frame period is shorter, the task
+ * waits for the previous frames (and the time is counted as used).
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "neopixel_stripe.h"
+#include "timer_mcu.h"
+/*==================[macros]=================================================*/
+#define NEOPIXEL_ANIM_MAX_EFFECTS	4		/*!< Max. number of effects composed on each frame */
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Animation effects
+ */
+typedef enum {
+	NEOPIXEL_EFFECT_RAINBOW,	/*!< Moving gradient of hues (overwrites its range) */
+	NEOPIXEL_EFFECT_CHASE,		/*!< Group of NeoPixels running along its range (drawn over previous effects) */
+	NEOPIXEL_EFFECT_FADE,		/*!< Color going from color to color2 and back (overwrites its range) */
+	NEOPIXEL_EFFECT_BREATHE,	/*!< Brightness of the previous effects rising and falling */
+} neopixel_effect_type_t;
+
+/**
+ * @brief Animation effect
+ */
+typedef struct {
+	neopixel_effect_type_t type;	/*!< Effect */
+	uint16_t first;					/*!< First NeoPixel of the range */
+	uint16_t length;				/*!< NeoPixels in the range (0: up to the end of the stripe) */
+	uint16_t period;				/*!< Duration of a cycle (ms, 0: still) */
+	neopixel_color_t color;			/*!< Chase color, fade first color */
+	neopixel_color_t color2;		/*!< Fade second color (the same as color: solid color) */
+	uint8_t size;					/*!< Chase: NeoPixels lit, rainbow: repetitions of the hues in the range */
+	uint8_t sat;					/*!< Rainbow saturation (HSV color model) */
+	uint8_t val;					/*!< Rainbow value (HSV color model), breathe: min. brightness (0 to 255) */
+	bool reverse;					/*!< Rainbow and chase move towards the first NeoPixel */
+} neopixel_effect_t;
+
+/**
+ * @brief Animation engine configuration
+ */
+typedef struct {
+	gpio_t pin;						/*!< GPIO where NeoPixel data pin (DIN) is connected */
+	uint16_t len;					/*!< Number of NeoPixels in the stripe (up to WS2812B_MAX_LEDS) */
+	neopixel_color_t *color_array;	/*!< Array of len length, where frames are rendered */
+	timer_mcu_t timer;				/*!< Timer used for the frame rate (not available for the application) */
+	uint16_t fps;					/*!< Frames per second (1 to 1000) */
+	uint8_t priority;				/*!< Priority of the animation task */
+	void *func_p;					/*!< Function called after each frame, from the animation task (NULL: none) */
+	void *param_p;					/*!< Parameter of func_p */
+} neopixel_anim_config_t;
+
+/**
+ * @brief CPU budget of the frames
+ */
+typedef struct {
+	uint32_t frames;				/*!< Frames sent */
+	uint32_t missed;				/*!< Frames skipped (previous frame not finished on time) */
+	uint32_t budget;				/*!< Frame period (us) */
+	uint32_t last;					/*!< Time used by the last frame (us) */
+	uint32_t max;					/*!< Max. time used by a frame (us) */
+	uint32_t average;				/*!< Average time used by the frames (us) */
+	uint32_t latency;				/*!< Max. delay from the timer tick to the start of a frame (us) */
+	uint8_t load;					/*!< Time used by the last frame (% of the frame period, up to 200) */
+} neopixel_anim_stats_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize the stripe and the animation engine (animations are stopped after init).
+ *
+ * @note It can only be initialized once.
+ * @param config Engine configuration
+ * @return true when success
+ */
+bool NeoPixelAnimInit(const neopixel_anim_config_t *config);
+
+/**
+ * @brief Add an effect on top of the previous ones.
+ *
+ * @param effect Effect (copied)
+ * @return int8_t Effect number, -1 if there are already NEOPIXEL_ANIM_MAX_EFFECTS effects or
+ * the range is out of the stripe
+ */
+int8_t NeoPixelAnimAdd(const neopixel_effect_t *effect);
+
+/**
+ * @brief Remove an effect.
+ *
+ * @param effect Effect number returned by NeoPixelAnimAdd()
+ */
+void NeoPixelAnimRemove(int8_t effect);
+
+/**
+ * @brief Remove all the effects (NeoPixels are turned off on next frame).
+ *
+ */
+void NeoPixelAnimClear(void);
+
+/**
+ * @brief Start (or resume) the animations.
+ *
+ */
+void NeoPixelAnimStart(void);
+
+/**
+ * @brief Stop the animations (NeoPixels keep the colors of the last frame).
+ *
+ */
+void NeoPixelAnimStop(void);
+
+/**
+ * @brief Read the CPU budget of the frames.
+ *
+ * @param stats Frames statistics
+ * @param reset Restart max. and average values
+ */
+void NeoPixelAnimGetStats(neopixel_anim_stats_t *stats, bool reset);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif
+
+/*==================[end of file]============================================*/
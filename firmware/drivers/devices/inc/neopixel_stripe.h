@@ -14,6 +14,14 @@
  * 
  * @note ESP-EDU have one individual NeoPixel connected to GPIO_8, that can be used with this driver.
  * 
+ * @note Colors are sent in background (RMT peripheral): functions that update the stripe return 
+ * without waiting, use NeoPixelWait() or NeoPixelSetCallback() to know when the colors are shown.
+ * Up to WS2812B_MAX_LEDS NeoPixels.
+ * 
+ * @note Colors are kept encoded as sent to the stripe (brightness and gamma correction applied 
+ * with a single table, rebuilt only when brightness changes). Only the NeoPixels whose color 
+ * changed are encoded again, and nothing is sent if no color changed.
+ * 
  * @author Albano Peñalva
  *
  * @section changelog
@@ -21,6 +29,9 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 17/10/2026 | Colors sent in background, frame end callback							|
+ * | 17/10/2026 | Brightness and gamma table, only changed colors are encoded and sent	|
+ * | 17/10/2026 | Shift rotates the array start, HSV gradients (see neopixel_anim.h)	|
  * 
  **/
 
@@ -77,7 +88,7 @@ typedef uint32_t neopixel_color_t;
  * @brief NeoPixel array initialization.
  * 
  * @param pin           GPIO number where NeoPixel data pin (DIN) will be connected
- * @param len           Number of NeoPixels in the stripe
+ * @param len           Number of NeoPixels in the stripe (up to WS2812B_MAX_LEDS)
  * @param color_array   Array of len length, to store each NeoPixel color
  */
 void NeoPixelInit(gpio_t pin, uint16_t len, neopixel_color_t *color_array);
@@ -106,14 +117,31 @@ void NeoPixelSetPixel(uint16_t pixel, neopixel_color_t color);
 /**
  * @brief Set all NeoPixels in the array with the color stored in an array.
  * 
+ * @note After NeoPixelShift() the array is shown rotated: the first NeoPixel shows the color 
+ * shifted into it. NeoPixelAllColor() and NeoPixelRainbow() restore the array order.
  * @param color_array Array of 24 bits color
  */
 void NeoPixelSetArray(neopixel_color_t *color_array);
 
+/**
+ * @brief Set a function to be called each time the colors have been sent to the stripe.
+ * 
+ * @param func_p    Function called from ISR (NULL: none)
+ * @param param_p   Parameter of func_p
+ */
+void NeoPixelSetCallback(void *func_p, void *param_p);
+
+/**
+ * @brief Wait until colors have been sent to the stripe.
+ * 
+ */
+void NeoPixelWait(void);
+
 /**
  * @brief Shift the all NeoPixel colors in the array 1 position (up or down)
  * 
- * @note The last color'll be moved to the first position.
+ * @note The last color'll be moved to the first position. Colors aren't moved in the color 
+ * array (the NeoPixel where the array starts is rotated), but all NeoPixels are sent again.
  * @param upwards Shift direction: true: upwars, false: downwards.
  */
 void NeoPixelShift(bool upwards);
@@ -147,6 +175,19 @@ neopixel_color_t NeoPixelRgb2Color(uint8_t red, uint8_t green, uint8_t blue);
  */
 neopixel_color_t NeoPixelHSV2Color(uint16_t hue, uint8_t sat, uint8_t val);
 
+/**
+ * @brief Fill an array with a gradient of colors (HSV color model), with integer operations only.
+ * 
+ * @param colors Array of 24 bits color
+ * @param len Number of colors
+ * @param first_hue Hue of the first color
+ * @param hue_step Hue increment between consecutive colors, in 1/65536 hue units (16.16 fixed point, 
+ * the hue wraps around)
+ * @param sat Color saturation of all the colors (HSV color model)
+ * @param val Color value or brightness of all the colors (HSV color model)
+ */
+void NeoPixelHSVGradient(neopixel_color_t *colors, uint16_t len, uint16_t first_hue, uint32_t hue_step, uint8_t sat, uint8_t val);
+
 /**
  * @brief Set all NeoPixels with a gradient of colors. 
  * 
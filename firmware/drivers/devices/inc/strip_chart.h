@@ -0,0 +1,131 @@
+#ifndef STRIP_CHART_H_
+#define STRIP_CHART_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Devices Drivers devices
+ ** @{ */
+/** \addtogroup Strip_Chart Strip chart
+ ** @{ */
+
+/** \brief Real-time signal plot (ECG, IMU, etc.) on the ILI9341 LCD.
+ *
+ * Each new column of the chart is drawn with a single window write of one column, the rest
+ * of the plot is never redrawn:
+ *
+ * - Scroll mode: in landscape orientations, a chart covering the full LCD height uses the
+ * LCD hardware scrolling. New samples appear at the right edge and the plot moves left.
+ * Only one chart at a time can use this mode.
+ * - Sweep mode: otherwise, columns are written from left to right over the old ones (like
+ * an ECG monitor), with a blank column ahead of the newest one.
+ *
+ * When the sample frequency is higher than the column frequency, each column shows the
+ * min-max envelope of its samples (peaks are never lost). Autoscale at least doubles the
+ * range as soon as a column is out of it and shrinks it once per chart width when the signals
+ * use less than a quarter of it (the whole plot is redrawn from the stored envelopes).
+ *
+ * @note With blocking LCD writes a column keeps the CPU busy ~0.2 ms (240 rows at 20 MHz SPI,
+ * twice that in sweep mode): keep column_frec around 250 or lower, or enable the ILI9341
+ * pipeline (see ILI9341PipelineEnable()) so columns are sent by DMA.
+ *
+ * @note Nothing else must be drawn inside a chart in scroll mode: the displayed image of the
+ * chart columns doesn't match their coordinates.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "ili9341.h"
+/*==================[macros]=================================================*/
+#define STRIP_CHART_MAX_TRACES	4		/*!< Max. number of signals of a chart */
+/*==================[typedef]================================================*/
+/**
+ * @brief Strip chart configuration
+ */
+typedef struct {
+	uint16_t x;									/*!< Left column */
+	uint16_t y;									/*!< Top row */
+	uint16_t width;								/*!< Width in pixels (number of columns, >= 2) */
+	uint16_t height;							/*!< Height in pixels */
+	uint16_t sample_frec;						/*!< Samples per second of each signal */
+	uint16_t column_frec;						/*!< Columns per second (decimation is sample_frec / column_frec) */
+	uint8_t n_traces;							/*!< Number of signals (up to STRIP_CHART_MAX_TRACES) */
+	uint16_t color[STRIP_CHART_MAX_TRACES];		/*!< Color of each signal (RGB565), later signals are drawn over previous ones */
+	uint16_t background;						/*!< Background color (RGB565) */
+	uint16_t grid_color;						/*!< Grid color (RGB565) */
+	uint16_t grid_x;							/*!< Columns between vertical grid lines (0: none) */
+	uint16_t grid_y;							/*!< Rows between horizontal grid lines (0: none) */
+	bool autoscale;								/*!< Adjust the range to the signals */
+	int16_t min;								/*!< Value at the bottom row (initial value if autoscale is set) */
+	int16_t max;								/*!< Value at the top row (initial value if autoscale is set) */
+} strip_chart_config_t;
+
+/**
+ * @brief Strip chart instance
+ */
+typedef struct {
+	strip_chart_config_t config;							/*!< Configuration */
+	int16_t low[STRIP_CHART_MAX_TRACES][ILI9341_HEIGHT];	/*!< Min. value of each column (low > high: empty column) */
+	int16_t high[STRIP_CHART_MAX_TRACES][ILI9341_HEIGHT];	/*!< Max. value of each column */
+	int16_t col_low[STRIP_CHART_MAX_TRACES];				/*!< Min. value of the column being accumulated */
+	int16_t col_high[STRIP_CHART_MAX_TRACES];				/*!< Max. value of the column being accumulated */
+	int16_t last[STRIP_CHART_MAX_TRACES];					/*!< Last sample of each signal */
+	int16_t min;											/*!< Current value at the bottom row */
+	int16_t max;											/*!< Current value at the top row */
+	uint32_t columns;										/*!< Columns completed since last clear */
+	uint16_t head;											/*!< Chart column of the next column */
+	uint16_t decimation;									/*!< Samples per column */
+	uint16_t count;											/*!< Samples of the column being accumulated */
+	bool scroll;											/*!< Hardware scrolling is used */
+	uint8_t pixels[2 * 2 * ILI9341_HEIGHT];					/*!< Pixels of the columns being written (LCD byte order) */
+} strip_chart_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief  		Initializes a strip chart and draws it empty
+ * @note		LCD must be initialized and rotated before. Chart instances are ~6.5 KB, declare
+ * 				them static.
+ * @param[in]  	chart: Strip chart instance
+ * @param[in]  	config: Chart configuration (copied)
+ * @retval 		true when success, false if the configuration is not valid
+ */
+bool StripChartInit(strip_chart_t *chart, const strip_chart_config_t *config);
+
+/**
+ * @brief  		Adds one sample of each signal
+ * @note		Drawing cost is paid once every decimation samples, when a column is completed.
+ * @param[in]  	chart: Strip chart instance
+ * @param[in]  	values: One value per signal (n_traces values)
+ * @retval 		None
+ */
+void StripChartAddSample(strip_chart_t *chart, const int16_t *values);
+
+/**
+ * @brief  		Discards all samples and draws the chart empty
+ * @param[in]  	chart: Strip chart instance
+ * @retval 		None
+ */
+void StripChartClear(strip_chart_t *chart);
+
+/**
+ * @brief  		Stops using a chart (LCD scrolling is disabled if the chart was using it)
+ * @param[in]  	chart: Strip chart instance
+ * @retval 		None
+ */
+void StripChartDeinit(strip_chart_t *chart);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* STRIP_CHART_H_ */
+
+/*==================[end of file]============================================*/
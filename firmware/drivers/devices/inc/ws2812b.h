@@ -12,6 +12,10 @@
  *
  * @note For handling NeoPixels arrays use "neopixel_stripe.h".
  * 
+ * @note Bits are generated by the RMT peripheral: colors are collected in a frame with 
+ * ws2812bSend() and the frame is sent in background by ws2812bSendRet(). Two frames are used 
+ * alternately, so a new frame can be built while the previous one is being sent.
+ * 
  * @author Albano Peñalva
  *
  * @section changelog
@@ -19,6 +23,8 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 17/10/2026 | RMT frames sent in background (replaces timed bit-bang)				|
+ * | 17/10/2026 | Pre-encoded frames (ws2812bSendFrame), max. leds raised to 300		|
  * 
  **/
 
@@ -28,6 +34,7 @@
 #include "esp_err.h"
 #include "gpio_mcu.h"
 /*==================[macros]=================================================*/
+#define WS2812B_MAX_LEDS	300		/*!< Max. number of leds of a frame */
 
 /*==================[typedef]================================================*/
 /**
@@ -51,18 +58,52 @@ typedef struct rgb_led{
 void ws2812bInit(gpio_t pin);
 
 /**
- * @brief Send color information to NeoPixel.
+ * @brief Set a function to be called at the end of each frame.
+ * 
+ * @param func_p Function called (from ISR) when a frame has been sent (NULL: none)
+ * @param param_p Parameter of func_p
+ */
+void ws2812bSetCallback(void *func_p, void *param_p);
+
+/**
+ * @brief Add color information of the next NeoPixel to the frame.
  * 
+ * @note Leds after WS2812B_MAX_LEDS are ignored.
  * @param data NeoPixel color
  */
 void ws2812bSend(rgb_led_t led_color);
 
 /**
- * @brief Send a ret command to NeoPixel.
+ * @brief Send the frame (followed by a ret command) in background, and return without waiting.
  * 
  */
 void ws2812bSendRet(void);
 
+/**
+ * @brief Send a frame of already encoded colors (GRB bytes, gamma corrected) in background, 
+ * and return without waiting.
+ * 
+ * @note The colors are copied, the buffer can be modified on return. A frame being built with 
+ * ws2812bSend() is sent first. Leds after WS2812B_MAX_LEDS are ignored.
+ * @param data 3 bytes (green, red, blue) per led, as sent to the leds
+ * @param leds Number of leds
+ */
+void ws2812bSendFrame(const uint8_t *data, uint16_t leds);
+
+/**
+ * @brief Gamma correction of a color level.
+ * 
+ * @param component Color level (0 to 255)
+ * @return uint8_t Level sent to the leds
+ */
+uint8_t ws2812bGammaCorrection(uint8_t component);
+
+/**
+ * @brief Wait until all frames have been sent.
+ * 
+ */
+void ws2812bWait(void);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -12,6 +12,8 @@
 /*==================[inclusions]=============================================*/
 #include "hc_sr04.h"
 #include "delay_mcu.h"
+#include "ring_buffer_mcu.h"
+#include "freertos/FreeRTOS.h"
 /*==================[macros and definitions]=================================*/
 #define MAX_US		17700	/* maximun distance time in us (300cm or 118inch) */
 #define MAX_CM		300		/* maximun distance time in cm */
@@ -19,8 +21,41 @@
 #define US2CM		59		/* scale factor to conver pulse width to cm */
 #define US2INCH		150		/* scale factor to conver pulse width to inch */
 #define WAIT_MAX	5900	/* maximun time to wait for echo signal */
+#define TRIGGER_US	10		/* trigger pulse width */
+#define US_PER_MS	1000
 /*==================[internal data declaration]==============================*/
+/**
+ * @brief Scan measurement state of a sensor
+ */
+typedef enum {
+	ECHO_IDLE,			/*!< Not triggered */
+	ECHO_WAIT_RISE,		/*!< Triggered, echo not started */
+	ECHO_WAIT_FALL,		/*!< Echo started */
+} echo_state_t;
+
+/**
+ * @brief Scanned sensor
+ */
+typedef struct {
+	gpio_t echo;								/*!< Echo GPIO */
+	gpio_t trigger;								/*!< Trigger GPIO */
+	volatile echo_state_t state;				/*!< Measurement state */
+	uint64_t trigger_time;						/*!< Trigger timestamp */
+	uint64_t rise_time;							/*!< Echo rising edge timestamp */
+	uint16_t med_buf[HC_SR04_MEDIAN_MAX];		/*!< Last echo widths (median window) */
+	uint8_t med_idx;							/*!< Oldest width in med_buf */
+	uint8_t med_count;							/*!< Widths in med_buf */
+} hc_sr04_sensor_t;
+
 static gpio_t echo_st, trigger_st; /**<  Stores the pin inicilization*/
+static hc_sr04_sensor_t scan_sensors[HC_SR04_MAX_SENSORS];		/*!< Scanned sensors */
+static uint8_t scan_n;											/*!< Number of sensors scanned */
+static uint8_t scan_current;									/*!< Sensor of the current slot */
+static uint8_t scan_median;										/*!< Median filter window */
+static timer_mcu_t scan_timer;									/*!< Slot timer */
+static bool scan_init = false;									/*!< Scan initialized */
+static ring_buffer_t scan_rb;									/*!< Readings */
+static hc_sr04_reading_t scan_readings[HC_SR04_BUFFER_SIZE];	/*!< scan_rb storage */
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
@@ -28,6 +63,139 @@ static gpio_t echo_st, trigger_st; /**<  Stores the pin inicilization*/
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Trigger a measurement and wait for the echo (blocking reads)
+ * 
+ * @return uint32_t Echo width in us (0: no echo, > MAX_US: out of range)
+ */
+static uint32_t HcSr04EchoWidth(void){
+	uint64_t start;
+	GPIOOn(trigger_st);
+	DelayUs(TRIGGER_US);
+	GPIOOff(trigger_st);
+	start = TimerGetTimestamp();
+	while(!GPIORead(echo_st)){
+		if(TimerGetTimestamp() - start > WAIT_MAX){
+			return 0;
+		}
+	}
+	start = TimerGetTimestamp();
+	while(GPIORead(echo_st)){
+		if(TimerGetTimestamp() - start > MAX_US){
+			return MAX_US + 1;
+		}
+	}
+	return TimerGetTimestamp() - start;
+}
+
+/**
+ * @brief Add an echo width to the median window of a sensor
+ * 
+ * @return uint16_t Median of the window
+ */
+static uint16_t HcSr04Median(hc_sr04_sensor_t *sensor, uint16_t width){
+	uint16_t sorted[HC_SR04_MEDIAN_MAX], value;
+	uint8_t i, j;
+
+	sensor->med_buf[sensor->med_idx] = width;
+	sensor->med_idx = (sensor->med_idx + 1) % scan_median;
+	if(sensor->med_count < scan_median){
+		sensor->med_count++;
+	}
+	/* Insertion sort: at most HC_SR04_MEDIAN_MAX values */
+	for(i = 0; i < sensor->med_count; i++){
+		value = sensor->med_buf[i];
+		for(j = i; (j > 0) && (sorted[j - 1] > value); j--){
+			sorted[j] = sorted[j - 1];
+		}
+		sorted[j] = value;
+	}
+	return sorted[sensor->med_count / 2];
+}
+
+/**
+ * @brief End the measurement of a sensor and store the reading (called from ISR)
+ * 
+ * @param n Sensor number
+ * @param width Echo width in us (0: no echo, > MAX_US: out of range)
+ * @param task_woken Set to true if the consumer task was woken
+ */
+static void HcSr04ScanReading(uint8_t n, uint32_t width, bool *task_woken){
+	hc_sr04_sensor_t *sensor = &scan_sensors[n];
+	hc_sr04_reading_t reading = {
+		.time = sensor->trigger_time,
+		.sensor = n,
+		.valid = (width != 0),
+	};
+
+	sensor->state = ECHO_IDLE;
+	if(width == 0){
+		/* Disconnected: old widths are not valid anymore */
+		sensor->med_count = 0;
+		sensor->med_idx = 0;
+	} else{
+		if(width > MAX_US){
+			width = MAX_US;
+		}
+		reading.echo_us = width;
+		/* Rounded to the nearest mm, with the same scale as the blocking reads */
+		reading.distance = (HcSr04Median(sensor, width) * 10 + US2CM / 2) / US2CM;
+		if(reading.distance > HC_SR04_MAX_MM){
+			reading.distance = HC_SR04_MAX_MM;
+		}
+	}
+	RingBufferPushFromISR(&scan_rb, &reading, 1, task_woken);
+}
+
+/**
+ * @brief Slot timer callback: ends the measurement of the previous slot and triggers the 
+ * next sensor
+ */
+static void HcSr04ScanSlot(void *param){
+	hc_sr04_sensor_t *sensor = &scan_sensors[scan_current];
+	bool task_woken = false;
+
+	/* Echo still high: object out of range. Echo not started: no sensor */
+	if(sensor->state == ECHO_WAIT_FALL){
+		HcSr04ScanReading(scan_current, MAX_US + 1, &task_woken);
+	} else if(sensor->state == ECHO_WAIT_RISE){
+		HcSr04ScanReading(scan_current, 0, &task_woken);
+	}
+	scan_current = (scan_current + 1 == scan_n) ? 0 : scan_current + 1;
+	sensor = &scan_sensors[scan_current];
+	sensor->state = ECHO_WAIT_RISE;
+	GPIOOn(sensor->trigger);
+	DelayUs(TRIGGER_US);
+	GPIOOff(sensor->trigger);
+	sensor->trigger_time = TimerGetTimestamp();
+	/* Timer interrupts always yield on exit */
+}
+
+/**
+ * @brief Echo edge interrupt: timestamps the edges of the echo pulse
+ * 
+ * @note Both edges go through the same interrupt path, so most of the latency cancels out 
+ * in the width. Echo pulses (>= 150 us) are much longer than the latency, so the level 
+ * tells the edge.
+ */
+static void HcSr04ScanEcho(void *param){
+	uint64_t now = TimerGetTimestamp();
+	uint8_t n = (uintptr_t)param;
+	hc_sr04_sensor_t *sensor = &scan_sensors[n];
+	bool task_woken = false;
+
+	if(GPIORead(sensor->echo)){
+		if(sensor->state == ECHO_WAIT_RISE){
+			sensor->rise_time = now;
+			sensor->state = ECHO_WAIT_FALL;
+		}
+	} else if(sensor->state == ECHO_WAIT_FALL){
+		HcSr04ScanReading(n, now - sensor->rise_time, &task_woken);
+		if(task_woken){
+			portYIELD_FROM_ISR();
+		}
+	}
+}
 
 /*==================[external functions definition]==========================*/
 
@@ -43,50 +211,91 @@ bool HcSr04Init(gpio_t echo, gpio_t trigger){
 }
 
 uint16_t HcSr04ReadDistanceInCentimeters(void){
-	uint16_t distance = 0, waiting = 0;
-	GPIOOn(trigger_st);
-	DelayUs(10);
-	GPIOOff(trigger_st);
-	while(!GPIORead(echo_st)){
-		DelayUs(10);
-		waiting += 10;
-		if(waiting > WAIT_MAX){
-			return 0;
-		}
-	}
-	do{
-		DelayUs(10);
-		distance += 10;
-		if(distance > MAX_US)
-			return MAX_CM;
+	uint32_t width = HcSr04EchoWidth();
+	if(width > MAX_US){
+		return MAX_CM;
 	}
-	while(GPIORead(echo_st));
-	return (distance/US2CM);
+	return (width/US2CM);
 }
 
 uint16_t HcSr04ReadDistanceInInches(void){
-	uint16_t distance = 0, waiting = 0;
-	GPIOOn(trigger_st);
-	DelayUs(10);
-	GPIOOff(trigger_st);
-	while(!GPIORead(echo_st)){
-		DelayUs(10);
-		waiting += 10;
-		if(waiting > WAIT_MAX){
-			return 0;
-		}
+	uint32_t width = HcSr04EchoWidth();
+	if(width > MAX_US){
+		return MAX_INCH;
 	}
-	do{
-		DelayUs(10);
-		distance += 10;
-		if(distance > MAX_US)
-			return MAX_INCH;
+	return (width/US2INCH);
+}
+
+bool HcSr04ScanInit(const hc_sr04_scan_config_t *config){
+	timer_config_t timer = {
+		.timer = config->timer,
+		.period = (uint32_t)config->slot_ms * US_PER_MS,
+		.func_p = HcSr04ScanSlot,
+		.param_p = NULL
+	};
+
+	if(scan_init || (config->n_sensors == 0) || (config->n_sensors > HC_SR04_MAX_SENSORS) ||
+		(config->slot_ms < HC_SR04_MIN_SLOT_MS) || (config->median == 0) || 
+		(config->median > HC_SR04_MEDIAN_MAX)){
+		return false;
+	}
+	scan_n = config->n_sensors;
+	scan_median = config->median;
+	scan_timer = config->timer;
+	/* First slot ends the (empty) measurement of the last sensor and triggers the first one */
+	scan_current = scan_n - 1;
+	RingBufferInit(&scan_rb, scan_readings, HC_SR04_BUFFER_SIZE, sizeof(hc_sr04_reading_t));
+	RingBufferSetConsumer(&scan_rb, config->consumer);
+	for(uint8_t i = 0; i < scan_n; i++){
+		scan_sensors[i] = (hc_sr04_sensor_t){
+			.echo = config->echo[i],
+			.trigger = config->trigger[i],
+			.state = ECHO_IDLE,
+		};
+		GPIOInit(config->trigger[i], GPIO_OUTPUT);
+		GPIOInit(config->echo[i], GPIO_INPUT);
+		GPIOActivIntBothEdges(config->echo[i], HcSr04ScanEcho, (void *)(uintptr_t)i);
+	}
+	TimerInit(&timer);
+	scan_init = true;
+	return true;
+}
+
+void HcSr04ScanStart(void){
+	if(scan_init){
+		TimerStart(scan_timer);
+	}
+}
+
+void HcSr04ScanStop(void){
+	if(scan_init){
+		TimerStop(scan_timer);
+		for(uint8_t i = 0; i < scan_n; i++){
+			scan_sensors[i].state = ECHO_IDLE;
+		}
 	}
-	while(GPIORead(echo_st));
-	return (distance/US2INCH);
+}
+
+uint32_t HcSr04ScanRead(hc_sr04_reading_t *readings, uint32_t n){
+	return RingBufferPop(&scan_rb, readings, n);
+}
+
+bool HcSr04ScanWait(uint32_t timeout_ms){
+	return RingBufferWait(&scan_rb, timeout_ms);
+}
+
+uint32_t HcSr04ScanDropped(void){
+	return scan_rb.dropped;
 }
 
 bool HcSr04Deinit(void){
+	if(scan_init){
+		HcSr04ScanStop();
+		for(uint8_t i = 0; i < scan_n; i++){
+			GPIODeactivInt(scan_sensors[i].echo);
+		}
+		scan_init = false;
+	}
 	GPIODeinit();
 	return true;
 }
@@ -12,8 +12,13 @@
 #include "hx711.h"
 
 #include <delay_mcu.h>
+#include <timer_mcu.h>
+#include <ring_buffer_mcu.h>
+#include "freertos/FreeRTOS.h"
 
 /*==================[macros and definitions]=================================*/
+#define HX711_BITS		24			/*!< Bits of a conversion */
+#define HX711_SIGN		0x800000	/*!< Sign bit of a conversion */
 
 /*==================[internal data declaration]==============================*/
 uint8_t GAIN;		             /*!<  Amplification factor */
@@ -24,6 +29,11 @@ float SCALE;	                 /*!<  Used to return weight in grams, kg, ounces,
 gpio_t internal_pd_sck;
 gpio_t internal_dout;
 
+static hx711_sample_t stream_samples[HX711_BUFFER_SIZE];	/*!< Stream storage */
+static ring_buffer_t stream_rb;								/*!< Stream ring buffer */
+static volatile bool stream_on = false;						/*!< Stream running */
+static volatile bool stream_skip;							/*!< Discard next sample (gain not set yet) */
+
 /*==================[internal functions declaration]=========================*/
 
 uint8_t shiftIn(void)
@@ -42,6 +52,78 @@ uint8_t shiftIn(void)
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Clock out a conversion (DOUT must be low) and set the gain of the next one
+ * @return Conversion result, sign extended
+ */
+static int32_t HX711_clockOut(void)
+{
+	uint32_t count = 0;
+
+	for (uint8_t i = 0; i < HX711_BITS; i++)
+	{
+		GPIOOn(internal_pd_sck);
+		DelayUs(1);
+		GPIOOff(internal_pd_sck);
+		count = (count << 1) | GPIORead(internal_dout);
+	}
+	// 1 to 3 more pulses select channel and gain of the next conversion
+	for (uint8_t i = 0; i < GAIN; i++)
+	{
+		GPIOOn(internal_pd_sck);
+		DelayUs(1);
+		GPIOOff(internal_pd_sck);
+	}
+	return (int32_t)(count ^ HX711_SIGN) - HX711_SIGN;
+}
+
+/**
+ * @brief DOUT falling edge: conversion ready
+ */
+static void HX711_dataReady(void *param)
+{
+	hx711_sample_t sample;
+	bool task_woken = false;
+
+	// Edges of the data bits while clocking out are also latched: DOUT is already high then
+	if (!stream_on || GPIORead(internal_dout))
+	{
+		return;
+	}
+	sample.time = TimerGetTimestamp();
+	sample.value = HX711_clockOut();
+	if (stream_skip)
+	{
+		stream_skip = false;
+		return;
+	}
+	RingBufferPushFromISR(&stream_rb, &sample, 1, &task_woken);
+	if (task_woken)
+	{
+		portYIELD_FROM_ISR();
+	}
+}
+
+/**
+ * @brief Median of the filter window
+ */
+static int32_t HX711_median(hx711_filter_t *filter)
+{
+	int32_t sorted[HX711_MEDIAN_MAX], value;
+	int8_t j;
+
+	// Insertion sort: at most HX711_MEDIAN_MAX values
+	for (uint8_t i = 0; i < filter->median; i++)
+	{
+		value = filter->med_buf[i];
+		for (j = i - 1; (j >= 0) && (sorted[j] > value); j--)
+		{
+			sorted[j + 1] = sorted[j];
+		}
+		sorted[j + 1] = value;
+	}
+	return sorted[filter->median / 2];
+}
 
 /*==================[external functions definition]==========================*/
 void HX711_Init(uint8_t gain, gpio_t pd_sck, gpio_t dout)
@@ -132,7 +214,7 @@ double HX711_getValue(uint8_t times)
 
 float HX711_getUnits(uint8_t times)
 {
-	return HX711_get_value(times) / SCALE;
+	return HX711_getValue(times) / SCALE;
 }
 
 void HX711_tare(uint8_t times)
@@ -173,4 +255,137 @@ void HX711_powerUp(void)
 	GPIOOff(internal_pd_sck);//PD_SCK_SET_LOW;
 }
 
+bool HX711_startStream(void *consumer)
+{
+	if (stream_on)
+	{
+		return false;
+	}
+	RingBufferInit(&stream_rb, stream_samples, HX711_BUFFER_SIZE, sizeof(hx711_sample_t));
+	RingBufferSetConsumer(&stream_rb, consumer);
+	// DOUT may be low already (no falling edge until it is read): reset to start a new conversion
+	HX711_powerDown();
+	GPIOActivInt(internal_dout, HX711_dataReady, false, NULL);
+	// After reset the gain is 128: the first conversion sets the configured one
+	stream_skip = (GAIN != 1);
+	stream_on = true;
+	HX711_powerUp();
+	return true;
+}
+
+void HX711_stopStream(void)
+{
+	if (!stream_on)
+	{
+		return;
+	}
+	GPIODeactivInt(internal_dout);
+	stream_on = false;
+}
+
+uint32_t HX711_readSamples(hx711_sample_t *samples, uint32_t n)
+{
+	return RingBufferPop(&stream_rb, samples, n);
+}
+
+bool HX711_waitSamples(uint32_t timeout_ms)
+{
+	return RingBufferWait(&stream_rb, timeout_ms);
+}
+
+uint32_t HX711_droppedSamples(void)
+{
+	return stream_rb.dropped;
+}
+
+void HX711_filterInit(hx711_filter_t *filter, uint8_t median, uint8_t average)
+{
+	if (median > HX711_MEDIAN_MAX)
+	{
+		median = HX711_MEDIAN_MAX;
+	}
+	if (average > HX711_AVERAGE_MAX)
+	{
+		average = HX711_AVERAGE_MAX;
+	}
+	filter->median = median | 1;
+	filter->average = (average == 0) ? 1 : average;
+	filter->med_idx = 0;
+	filter->med_count = 0;
+	filter->avg_idx = 0;
+	filter->avg_count = 0;
+	filter->avg_sum = 0;
+	filter->offset = 0;
+	filter->scale = 1;
+	filter->tare_n = 0;
+	filter->tare_count = 0;
+	filter->tare_sum = 0;
+}
+
+bool HX711_filterPush(hx711_filter_t *filter, int32_t value, float *units)
+{
+	int32_t filtered;
+
+	// Median of the last samples
+	filter->med_buf[filter->med_idx] = value;
+	if (++filter->med_idx == filter->median)
+	{
+		filter->med_idx = 0;
+	}
+	if (filter->med_count < filter->median)
+	{
+		if (++filter->med_count < filter->median)
+		{
+			return false;
+		}
+	}
+	value = (filter->median == 1) ? value : HX711_median(filter);
+
+	// Moving average of the medians (running sum)
+	if (filter->avg_count == filter->average)
+	{
+		filter->avg_sum -= filter->avg_buf[filter->avg_idx];
+	}
+	else
+	{
+		filter->avg_count++;
+	}
+	filter->avg_buf[filter->avg_idx] = value;
+	filter->avg_sum += value;
+	if (++filter->avg_idx == filter->average)
+	{
+		filter->avg_idx = 0;
+	}
+	if (filter->avg_count < filter->average)
+	{
+		return false;
+	}
+	filtered = filter->avg_sum / filter->average;
+
+	// Tare
+	if (filter->tare_count < filter->tare_n)
+	{
+		filter->tare_sum += filtered;
+		if (++filter->tare_count == filter->tare_n)
+		{
+			filter->offset = filter->tare_sum / filter->tare_n;
+		}
+		return false;
+	}
+	*units = (filtered - filter->offset) / filter->scale;
+	return true;
+}
+
+void HX711_filterTare(hx711_filter_t *filter, uint16_t times)
+{
+	filter->tare_sum = 0;
+	filter->tare_count = 0;
+	filter->tare_n = times;
+}
+
+void HX711_filterSetScale(hx711_filter_t *filter, float scale)
+{
+	filter->scale = scale;
+}
+
 
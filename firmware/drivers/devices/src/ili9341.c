@@ -15,6 +15,7 @@
 #include "spi_mcu.h"
 #include "gpio_mcu.h"
 #include "delay_mcu.h"
+#include "esp_attr.h"
 /*==================[macros and definitions]=================================*/
 #define NULL 0
 
@@ -22,7 +23,6 @@
 #define MAX_PIXEL 320*240*2			/*!< Maximum number of bytes to write on LCD */
 #define MSK_BIT16 0x8000			/*!< 16th bit mask */
 #define MSK_BIT8 0x80				/*!< 8th bit mask */
-#define MAX_VALUE_SIZE 256			/*!< Maximum length of a data array to prevent excessive use of memory */
 #define LEFT -1						/*!< Horizontal grow direction */
 #define RIGHT 1						/*!< Horizontal grow direction */
 #define DOWN 1						/*!< Vertical grow direction */
@@ -32,6 +32,7 @@
 #define RESET				0x01 	/*!< Resets the commands and parameters to their S/W Reset default values */
 #define SLEEP_IN			0x10 	/*!< Enter to the minimum power consumption mode */
 #define SLEEP_OUT			0x11 	/*!< Turns off sleep mode */
+#define NORMAL_MODE_ON		0x13 	/*!< Returns the display to normal mode (partial and scrolling off) */
 #define DISPLAY_INV_OFF		0x20 	/*!< Recover from display inversion mode */
 #define DISPLAY_INV_ON		0x21 	/*!< Invert every bit from the frame memory to the display */
 #define GAMMA_SET			0x26 	/*!< Select the desired Gamma curve for the current display */
@@ -40,7 +41,9 @@
 #define COLUMN_ADDR_SET		0x2A 	/*!< Define columns of frame memory where MCU can access */
 #define PAGE_ADDR_SET		0x2B 	/*!< Define rows of frame memory where MCU can access */
 #define MEM_WRITE			0x2C 	/*!< Transfer data from MCU to frame memory */
+#define VERT_SCROLL_DEF		0x33 	/*!< Defines the vertical scrolling area of the display */
 #define MEM_ACC_CTRL		0x36 	/*!< Defines read/write scanning direction of frame memory */
+#define VERT_SCROLL_START	0x37 	/*!< Frame memory line displayed at the top of the scrolling area */
 #define PIXEL_FORMAT_SET	0x3A 	/*!< Sets the pixel format for the RGB image data used by the interface */
 #define WRITE_DISP_BRIGHT	0x51 	/*!< Adjust the brightness value of the display */
 #define WRITE_CTRL_DISP		0x53 	/*!< Control display brightness */
@@ -64,6 +67,10 @@
 
 #define HighByte(x) x >> 8			/*!< High byte of a 16 bits data */
 #define LowByte(x) x & 0xFF			/*!< Low byte of a 16 bits data */
+#define MAX_LINE_CHARS (ILI9341_HEIGHT / 3)	/*!< Max. characters of a text line (narrowest character + gap: 3 pixels) */
+#define RLE_RUN 0x80				/*!< Run packet flag of compressed images */
+#define RLE_COUNT 0x7F				/*!< Pixels - 1 of a compressed image packet */
+#define PanelOrder(x) ((uint16_t)(((x) >> 8) | ((x) << 8)))	/*!< RGB565 color with bytes in the order sent to the LCD */
 /*==================[typedef]================================================*/
 /**
  * @brief  Structure with LCD orientation properties
@@ -82,6 +89,79 @@ typedef struct {
     uint32_t databytes; 	/*!< Number of bytes of data to transmit */
     uint8_t *data;			/*!< Pointer to data or parameters array */
 } lcd_cmd_t;
+/**
+ * @brief Rectangle (inclusive coordinates)
+ */
+typedef struct {
+	int16_t x0;				/*!< Left column */
+	int16_t y0;				/*!< Top row */
+	int16_t x1;				/*!< Right column */
+	int16_t y1;				/*!< Bottom row */
+} rect_t;
+
+/**
+ * @brief Off-screen framebuffer state
+ */
+typedef struct {
+	uint16_t *buffer;		/*!< Pixels in LCD byte order (NULL if framebuffer is disabled) */
+	int16_t x;				/*!< LCD column of the first buffer column */
+	int16_t y;				/*!< LCD row of the first buffer row */
+	uint16_t width;			/*!< Buffer width in pixels */
+	uint16_t height;		/*!< Buffer height in pixels */
+	rect_t dirty[ILI9341_MAX_DIRTY_RECTS];	/*!< Regions modified since last flush (LCD coordinates) */
+	uint8_t n_dirty;		/*!< Number of dirty regions */
+} framebuffer_t;
+
+/**
+ * @brief Pixel stream state: queued DMA buffers (pipeline) or a single blocking buffer
+ */
+typedef struct {
+	uint8_t *buffers;			/*!< Pipeline buffers (NULL if pipeline is disabled) */
+	uint8_t *data;				/*!< Buffer being filled */
+	uint16_t size;				/*!< Bytes of each buffer */
+	uint16_t used;				/*!< Bytes used of the buffer being filled */
+	uint8_t n_buffers;			/*!< Number of pipeline buffers */
+	uint8_t current;			/*!< Index of the buffer being filled */
+	void (*func_p)(void*);		/*!< Function called when the queue gets empty */
+	void *param_p;				/*!< Parameter of func_p */
+	volatile uint32_t queued;	/*!< Buffers queued */
+	volatile uint32_t done;		/*!< Buffers sent */
+} pixel_stream_t;
+
+/**
+ * @brief Pre-expanded character (RGB565 in LCD byte order)
+ */
+typedef struct {
+	Font_t *font;			/*!< Font */
+	uint32_t offset;		/*!< Position of pixels in cache pool */
+	uint32_t last_used;		/*!< Cache tick of last use */
+	uint32_t size;			/*!< Bytes of pixels (0 if entry is free) */
+	uint16_t foreground;	/*!< Foreground color */
+	uint16_t background;	/*!< Background color */
+	char data;				/*!< Character */
+} glyph_t;
+
+/**
+ * @brief Glyph cache state
+ */
+typedef struct {
+	uint8_t *pool;			/*!< Pixels of cached glyphs (NULL if cache is disabled) */
+	uint32_t size;			/*!< Pool size in bytes */
+	uint32_t used;			/*!< Bytes used (glyphs are packed at the beginning of the pool) */
+	uint32_t tick;			/*!< Incremented on each drawing; glyphs of current drawing are not evicted */
+	glyph_t glyph[ILI9341_GLYPH_CACHE_ENTRIES];	/*!< Cached glyphs */
+} glyph_cache_t;
+
+/**
+ * @brief Position of next pixel when decoding an image into the framebuffer
+ */
+typedef struct {
+	int16_t x;				/*!< LCD column of image left side */
+	int16_t y;				/*!< LCD row of image top side */
+	uint16_t width;			/*!< Image width in pixels */
+	uint16_t column;		/*!< Image column of next pixel */
+	uint16_t row;			/*!< Image row of next pixel */
+} image_cursor_t;
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
@@ -114,6 +194,8 @@ void SetCursorPosition(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
  */
 void Fill(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
 
+static void FramebufferFill(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+
 /*==================[internal data definition]===============================*/
 /**
  * @brief Initial LCD configuration parameters
@@ -185,6 +267,22 @@ spi_mcu_config_t spi_conf = {
 static spi_dev_t ili9341_spi;				/*!< uC SPI port */
 static gpio_t ili9341_dc, ili9341_rst;		/*!< uC GPIO ports to use as CS, DC and RST */
 
+static framebuffer_t fb = {.buffer = NULL};	/*!< Off-screen framebuffer */
+
+static uint8_t burst[ILI9341_MAX_BURST];	/*!< Pixel buffer of blocking writes */
+static pixel_stream_t stream = {
+	.buffers = NULL,
+	.data = burst,
+	.size = ILI9341_MAX_BURST,
+	.func_p = NULL
+};	/*!< Pixel stream */
+
+static glyph_cache_t glyphs = {.pool = NULL};	/*!< Glyph cache */
+
+static rect_t window = {-1, -1, -1, -1};	/*!< Last address window sent to the LCD (-1: unknown) */
+static rect_t span = {0, 0, -1, -1};		/*!< Pending span (empty if x1 < x0) */
+static uint16_t span_color;					/*!< Color of pending span */
+
 static orientation_properties_t lcd_orientation = {
 		ILI9341_WIDTH,
 		ILI9341_HEIGHT,
@@ -194,7 +292,8 @@ static orientation_properties_t lcd_orientation = {
 /*==================[internal functions definition]==========================*/
 
 void WriteLCD(lcd_cmd_t * data){
-	SpiInit(&spi_conf);
+	/* Queued bursts must be sent before changing DC or using blocking writes */
+	SpiWaitQueued(ili9341_spi, 0);
 	/* If command is NULL don't send command */
 	if (data->cmd != NULL){
 		/* Send command */
@@ -223,20 +322,663 @@ void SetCursorPosition(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1){
 		y0 = y1;
 		y1 = aux;
 	}
-	uint8_t columns[] = {HighByte(x0), LowByte(x0), HighByte(x1), LowByte(x1)};
-	lcd_cmd_t lcd_columns = {COLUMN_ADDR_SET, 4, columns};
-	uint8_t rows[] = {HighByte(y0), LowByte(y0), HighByte(y1), LowByte(y1)};
-	lcd_cmd_t lcd_rows = {PAGE_ADDR_SET, 4, rows};
-	WriteLCD(&lcd_columns);
-	WriteLCD(&lcd_rows);
+	/* Only changed addresses are sent (consecutive spans usually share columns or rows) */
+	if ((x0 != window.x0) || (x1 != window.x1)){
+		uint8_t columns[] = {HighByte(x0), LowByte(x0), HighByte(x1), LowByte(x1)};
+		lcd_cmd_t lcd_columns = {COLUMN_ADDR_SET, 4, columns};
+		WriteLCD(&lcd_columns);
+		window.x0 = x0;
+		window.x1 = x1;
+	}
+	if ((y0 != window.y0) || (y1 != window.y1)){
+		uint8_t rows[] = {HighByte(y0), LowByte(y0), HighByte(y1), LowByte(y1)};
+		lcd_cmd_t lcd_rows = {PAGE_ADDR_SET, 4, rows};
+		WriteLCD(&lcd_rows);
+		window.y0 = y0;
+		window.y1 = y1;
+	}
+}
+
+/**
+ * @brief  		Called (from ISR) at the end of each queued burst
+ * @param[in]  	param: Not used
+ * @retval 		None
+ */
+static void IRAM_ATTR StreamDone(void *param){
+	stream.done++;
+	if ((stream.done == stream.queued) && (stream.func_p != NULL)){
+		stream.func_p(stream.param_p);
+	}
+}
+
+/**
+ * @brief  		Start writing LCD memory (window must be already set)
+ * @retval 		None
+ */
+static void StreamBegin(void){
+	lcd_cmd_t lcd_write = {MEM_WRITE, NULL, NULL};
+	WriteLCD(&lcd_write);
+	/* Everything sent until next command is pixel data */
+	GPIOOn(ili9341_dc);
+	stream.used = 0;
+}
+
+/**
+ * @brief  		Send the pixels of the current buffer
+ * @note		With pipeline the burst is queued and the next buffer is taken, waiting 
+ * 				only if it is still on the wire.
+ * @retval 		None
+ */
+static void StreamSend(void){
+	if (stream.used == 0){
+		return;
+	}
+	if (stream.buffers != NULL){
+		stream.queued++;
+		SpiWriteQueued(ili9341_spi, stream.data, stream.used);
+		stream.current = (stream.current + 1) % stream.n_buffers;
+		stream.data = &stream.buffers[stream.current * stream.size];
+		/* Buffers are used in order: the next one is free when at most n_buffers - 1 bursts are pending */
+		SpiWaitQueued(ili9341_spi, stream.n_buffers - 1);
+	}
+	else{
+		lcd_cmd_t lcd_pixels = {NULL, stream.used, stream.data};
+		WriteLCD(&lcd_pixels);
+	}
+	stream.used = 0;
+}
+
+/**
+ * @brief  		Add a pixel to the stream
+ * @param[in]  	color: color (RGB565)
+ * @retval 		None
+ */
+static inline void StreamPixel(uint16_t color){
+	stream.data[stream.used++] = HighByte(color);
+	stream.data[stream.used++] = LowByte(color);
+	if (stream.used == stream.size){
+		StreamSend();
+	}
+}
+
+/**
+ * @brief  		Add a number of pixels of the same color to the stream
+ * @param[in]  	color: color (RGB565)
+ * @param[in]  	count: Number of pixels
+ * @retval 		None
+ */
+static void StreamRepeat(uint16_t color, uint32_t count){
+	uint32_t n;
+	uint8_t *dst;
+	while (count > 0){
+		n = (stream.size - stream.used) / 2;
+		if (n > count){
+			n = count;
+		}
+		dst = &stream.data[stream.used];
+		for (uint32_t k = 0; k < n; k++){
+			*dst++ = HighByte(color);
+			*dst++ = LowByte(color);
+		}
+		stream.used += n * 2;
+		count -= n;
+		if (stream.used == stream.size){
+			StreamSend();
+		}
+	}
+}
+
+/**
+ * @brief  		Add bytes already in LCD order to the stream
+ * @param[in]  	src: Pixel bytes
+ * @param[in]  	bytes_count: Number of bytes
+ * @retval 		None
+ */
+static void StreamCopy(const uint8_t *src, uint32_t bytes_count){
+	uint32_t n;
+	while (bytes_count > 0){
+		n = stream.size - stream.used;
+		if (n > bytes_count){
+			n = bytes_count;
+		}
+		for (uint32_t k = 0; k < n; k++){
+			stream.data[stream.used + k] = src[k];
+		}
+		stream.used += n;
+		src += n;
+		bytes_count -= n;
+		if (stream.used == stream.size){
+			StreamSend();
+		}
+	}
+}
+
+/**
+ * @brief  		Pack cached glyphs at the beginning of the pool (after evictions)
+ * @retval 		None
+ */
+static void GlyphCacheCompact(void){
+	uint32_t cursor = 0;
+	glyph_t *next;
+	while (1){
+		/* Glyph with lowest position not yet moved */
+		next = NULL;
+		for (uint8_t i = 0; i < ILI9341_GLYPH_CACHE_ENTRIES; i++){
+			if ((glyphs.glyph[i].size > 0) && (glyphs.glyph[i].offset >= cursor) &&
+				((next == NULL) || (glyphs.glyph[i].offset < next->offset))){
+				next = &glyphs.glyph[i];
+			}
+		}
+		if (next == NULL){
+			break;
+		}
+		for (uint32_t k = 0; k < next->size; k++){
+			glyphs.pool[cursor + k] = glyphs.pool[next->offset + k];
+		}
+		next->offset = cursor;
+		cursor += next->size;
+	}
+	glyphs.used = cursor;
+}
+
+/**
+ * @brief  		Get a character from the glyph cache, expanding it if not cached
+ * @note		Least recently used glyphs are evicted to make room, except those used on the
+ * 				current drawing (glyphs.tick).
+ * @param[in]  	data: Character
+ * @param[in]  	font: Pointer to used font
+ * @param[in]  	foreground: Color for character (RGB565)
+ * @param[in]  	background: Color for character background (RGB565)
+ * @retval 		Cached glyph, NULL if cache is disabled or there is no room for it
+ */
+static glyph_t *GlyphCacheGet(char data, Font_t *font, uint16_t foreground, uint16_t background){
+	glyph_t *glyph = NULL, *lru;
+	uint8_t *dst;
+	const uint8_t *char_row;
+	uint16_t width = font->info[data - ' '].width;
+	uint32_t size = (uint32_t)width * font->font_height * 2;
+	bool evicted = false;
+
+	if (glyphs.pool == NULL){
+		return NULL;
+	}
+	for (uint8_t i = 0; i < ILI9341_GLYPH_CACHE_ENTRIES; i++){
+		if ((glyphs.glyph[i].size > 0) && (glyphs.glyph[i].data == data) && (glyphs.glyph[i].font == font) &&
+			(glyphs.glyph[i].foreground == foreground) && (glyphs.glyph[i].background == background)){
+			glyphs.glyph[i].last_used = glyphs.tick;
+			return &glyphs.glyph[i];
+		}
+		if ((glyph == NULL) && (glyphs.glyph[i].size == 0)){
+			glyph = &glyphs.glyph[i];
+		}
+	}
+	if (size > glyphs.size){
+		return NULL;
+	}
+	/* Evict until there is a free entry and room in the pool */
+	while ((glyph == NULL) || (glyphs.size - glyphs.used < size)){
+		lru = NULL;
+		for (uint8_t i = 0; i < ILI9341_GLYPH_CACHE_ENTRIES; i++){
+			if ((glyphs.glyph[i].size > 0) && (glyphs.glyph[i].last_used != glyphs.tick) &&
+				((lru == NULL) || (glyphs.glyph[i].last_used < lru->last_used))){
+				lru = &glyphs.glyph[i];
+			}
+		}
+		if (lru == NULL){
+			break;
+		}
+		glyphs.used -= lru->size;
+		lru->size = 0;
+		if (glyph == NULL){
+			glyph = lru;
+		}
+		evicted = true;
+	}
+	if (evicted){
+		GlyphCacheCompact();
+	}
+	/* Not enough room without evicting glyphs of current drawing */
+	if ((glyph == NULL) || (glyphs.size - glyphs.used < size)){
+		return NULL;
+	}
+	/* Expand character bits */
+	dst = &glyphs.pool[glyphs.used];
+	for (uint16_t i = 0; i < font->font_height; i++){
+		char_row = &font->data[font->info[data - ' '].offset + i * ((width + 7) / 8)];
+		for (uint16_t j = 0; j < width; j++){
+			if (char_row[j / 8] & (MSK_BIT8 >> (j % 8))){
+				*dst++ = HighByte(foreground);
+				*dst++ = LowByte(foreground);
+			}
+			else{
+				*dst++ = HighByte(background);
+				*dst++ = LowByte(background);
+			}
+		}
+	}
+	glyph->font = font;
+	glyph->data = data;
+	glyph->foreground = foreground;
+	glyph->background = background;
+	glyph->offset = glyphs.used;
+	glyph->size = size;
+	glyph->last_used = glyphs.tick;
+	glyphs.used += size;
+	return glyph;
+}
+
+/**
+ * @brief  		Add a row of a character to the pixel stream
+ * @param[in]  	data: Character
+ * @param[in]  	row: Row number
+ * @param[in]  	font: Pointer to used font
+ * @param[in]  	foreground: Color for character (RGB565)
+ * @param[in]  	background: Color for character background (RGB565)
+ * @param[in]  	glyph: Cached character, NULL to expand the character bits
+ * @retval 		None
+ */
+static void StreamCharRow(char data, uint16_t row, Font_t *font, uint16_t foreground, uint16_t background, glyph_t *glyph){
+	uint16_t width = font->info[data - ' '].width;
+	const uint8_t *char_row;
+	if (glyph != NULL){
+		StreamCopy(&glyphs.pool[glyph->offset + (uint32_t)row * width * 2], width * 2);
+		return;
+	}
+	char_row = &font->data[font->info[data - ' '].offset + row * ((width + 7) / 8)];
+	for (uint16_t j = 0; j < width; j++){
+		/* if bit = 1, draw foreground color */
+		StreamPixel((char_row[j / 8] & (MSK_BIT8 >> (j % 8))) ? foreground : background);
+	}
+}
+
+/**
+ * @brief  		Draw a line of text (without control characters)
+ * @note		If the line fits in the LCD width it is sent as a single window, with the 
+ * 				1 pixel gap between characters filled with background color. If not, characters 
+ * 				are drawn one by one (wrapping like ILI9341DrawChar).
+ * @param[in] 	x: X position of top left corner of first character
+ * @param[in]  	y: Y position of top left corner of first character
+ * @param[in]  	str: Pointer to first character
+ * @param[in]  	n: Number of characters
+ * @param[in]  	font: Pointer to used font
+ * @param[in]  	foreground: Color for string (RGB565)
+ * @param[in]  	background: Color for string background (RGB565)
+ * @retval 		Line width in pixels (including the gap after the last character)
+ */
+static uint16_t StringLine(uint16_t x, uint16_t y, const char *str, uint16_t n, Font_t *font,
+						   uint16_t foreground, uint16_t background){
+	static glyph_t *line_glyph[MAX_LINE_CHARS];
+	uint32_t width = 0;
+	uint16_t k, i;
+
+	for (k = 0; k < n; k++){
+		width += font->info[str[k] - ' '].width + 1;
+	}
+	if ((n > MAX_LINE_CHARS) || (x + width - 1 > lcd_orientation.width)){
+		for (k = 0; k < n; k++){
+			ILI9341DrawChar(x, y, str[k], font, foreground, background);
+			x += font->info[str[k] - ' '].width + 1;
+		}
+		return width;
+	}
+	if (fb.buffer != NULL){
+		for (k = 0; k < n; k++){
+			ILI9341DrawChar(x, y, str[k], font, foreground, background);
+			x += font->info[str[k] - ' '].width;
+			if (k < n - 1){
+				FramebufferFill(x, y, x, y + font->font_height - 1, background);
+			}
+			x++;
+		}
+		return width;
+	}
+	/* All glyphs are taken before drawing, so none of them is evicted while drawing */
+	glyphs.tick++;
+	for (k = 0; k < n; k++){
+		line_glyph[k] = GlyphCacheGet(str[k], font, foreground, background);
+	}
+	SetCursorPosition(x, y, x + width - 2, y + font->font_height - 1);
+	StreamBegin();
+	for (i = 0; i < font->font_height; i++){
+		for (k = 0; k < n; k++){
+			StreamCharRow(str[k], i, font, foreground, background, line_glyph[k]);
+			if (k < n - 1){
+				StreamPixel(background);
+			}
+		}
+	}
+	StreamSend();
+	return width;
+}
+
+/**
+ * @brief  		Add pixels of a compressed image to the pixel stream or to the framebuffer
+ * @param[in]  	color: color (RGB565)
+ * @param[in]  	count: Number of pixels
+ * @param[in]  	cursor: Position of next pixel in the framebuffer, NULL to add pixels to the stream
+ * @retval 		None
+ */
+static void ImageRun(uint16_t color, uint16_t count, image_cursor_t *cursor){
+	int16_t x, y;
+	if (cursor == NULL){
+		StreamRepeat(color, count);
+		return;
+	}
+	while (count > 0){
+		x = cursor->x + cursor->column;
+		y = cursor->y + cursor->row;
+		if ((x >= fb.x) && (x < fb.x + fb.width) && (y >= fb.y) && (y < fb.y + fb.height)){
+			fb.buffer[(y - fb.y) * fb.width + (x - fb.x)] = PanelOrder(color);
+		}
+		if (++cursor->column == cursor->width){
+			cursor->column = 0;
+			cursor->row++;
+		}
+		count--;
+	}
+}
+
+/**
+ * @brief  		Decode a compressed image (see ILI9341DrawImage())
+ * @param[in]  	image: Pointer to image
+ * @param[in]  	cursor: Position of first pixel in the framebuffer, NULL to decode to the pixel stream
+ * @retval 		None
+ */
+static void ImageDecode(const ili9341_image_t *image, image_cursor_t *cursor){
+	const uint8_t *data = image->data;
+	int32_t pixels = (int32_t)image->width * image->height;
+	uint16_t count, k;
+	uint8_t header;
+
+	while (pixels > 0){
+		header = *data++;
+		count = (header & RLE_COUNT) + 1;
+		if (count > pixels){
+			count = pixels;
+		}
+		pixels -= count;
+		if (header & RLE_RUN){
+			switch (image->format){
+			case ILI9341_IMAGE_RLE16:
+				ImageRun((data[0] << 8) | data[1], count, cursor);
+				data += 2;
+				break;
+			case ILI9341_IMAGE_RLE8:
+				ImageRun(image->palette[data[0]], count, cursor);
+				data++;
+				break;
+			case ILI9341_IMAGE_RLE4:
+				ImageRun(image->palette[data[0] & 0x0F], count, cursor);
+				data++;
+				break;
+			}
+			continue;
+		}
+		switch (image->format){
+		case ILI9341_IMAGE_RLE16:
+			/* Already in LCD order */
+			if (cursor == NULL){
+				StreamCopy(data, count * 2);
+			}
+			else{
+				for (k = 0; k < count; k++){
+					ImageRun((data[2 * k] << 8) | data[2 * k + 1], 1, cursor);
+				}
+			}
+			data += count * 2;
+			break;
+		case ILI9341_IMAGE_RLE8:
+			for (k = 0; k < count; k++){
+				ImageRun(image->palette[data[k]], 1, cursor);
+			}
+			data += count;
+			break;
+		case ILI9341_IMAGE_RLE4:
+			for (k = 0; k < count; k++){
+				ImageRun(image->palette[(data[k / 2] >> ((k % 2) ? 0 : 4)) & 0x0F], 1, cursor);
+			}
+			data += (count + 1) / 2;
+			break;
+		}
+	}
+}
+
+/**
+ * @brief  		Draw the pending span (clipped to the LCD)
+ * @retval 		None
+ */
+static void SpanFlush(void){
+	rect_t r = span;
+	span.x1 = span.x0 - 1;
+	if (r.x0 < 0){
+		r.x0 = 0;
+	}
+	if (r.y0 < 0){
+		r.y0 = 0;
+	}
+	if (r.x1 >= lcd_orientation.width){
+		r.x1 = lcd_orientation.width - 1;
+	}
+	if (r.y1 >= lcd_orientation.height){
+		r.y1 = lcd_orientation.height - 1;
+	}
+	if ((r.x0 <= r.x1) && (r.y0 <= r.y1)){
+		Fill(r.x0, r.y0, r.x1, r.y1, span_color);
+	}
+}
+
+/**
+ * @brief  		Add a horizontal or vertical span (or any rectangle) to the pending one.
+ * 				Spans that extend the pending rectangle are merged, so they are written
+ * 				with a single address window.
+ * @param[in]  	x0: Left column (x0 <= x1)
+ * @param[in]  	y0: Top row (y0 <= y1)
+ * @param[in]  	x1: Right column
+ * @param[in]  	y1: Bottom row
+ * @param[in]	color: color
+ * @retval 		None
+ */
+static void SpanAdd(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color){
+	if ((span.x0 <= span.x1) && (color == span_color)){
+		/* Already drawn */
+		if ((x0 >= span.x0) && (x1 <= span.x1) && (y0 >= span.y0) && (y1 <= span.y1)){
+			return;
+		}
+		/* Same rows, overlapping or adjacent columns */
+		if ((y0 == span.y0) && (y1 == span.y1) && (x0 <= span.x1 + 1) && (x1 >= span.x0 - 1)){
+			span.x0 = (x0 < span.x0) ? x0 : span.x0;
+			span.x1 = (x1 > span.x1) ? x1 : span.x1;
+			return;
+		}
+		/* Same columns, overlapping or adjacent rows */
+		if ((x0 == span.x0) && (x1 == span.x1) && (y0 <= span.y1 + 1) && (y1 >= span.y0 - 1)){
+			span.y0 = (y0 < span.y0) ? y0 : span.y0;
+			span.y1 = (y1 > span.y1) ? y1 : span.y1;
+			return;
+		}
+	}
+	SpanFlush();
+	span.x0 = x0;
+	span.y0 = y0;
+	span.x1 = x1;
+	span.y1 = y1;
+	span_color = color;
+}
+
+/**
+ * @brief  		Integer square root
+ * @param[in]  	n: Radicand
+ * @retval 		floor(sqrt(n))
+ */
+static uint32_t ISqrt(uint32_t n){
+	uint32_t root = 0, bit = 1UL << 30;
+	while (bit > n){
+		bit >>= 2;
+	}
+	while (bit != 0){
+		if (n >= root + bit){
+			n -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else{
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+	return root;
+}
+
+/**
+ * @brief  		Bresenham line made of spans of constant length. Brush is vertical for
+ * 				shallow lines and horizontal for steep ones, so consecutive spans merge
+ * 				into rectangles along straight stretches.
+ * @param[in]  	x0: Start column
+ * @param[in]  	y0: Start row
+ * @param[in]  	x1: End column
+ * @param[in]  	y1: End row
+ * @param[in]  	width: Span length in pixels (1: thin line)
+ * @param[in]	color: color
+ * @retval 		None
+ */
+static void SpanLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t width, uint16_t color){
+	int16_t x_dist, y_dist, x_grow, y_grow, error, error_2;
+	int16_t before = (width - 1) / 2, after = width / 2;
+	bool vertical;
+
+	x_dist = (x1 > x0) ? (x1 - x0) : (x0 - x1);
+	y_dist = (y1 > y0) ? (y1 - y0) : (y0 - y1);
+	x_grow = (x0 > x1) ? LEFT : RIGHT;
+	y_grow = (y0 > y1) ? UP : DOWN;
+	vertical = (x_dist >= y_dist);
+	error = x_dist - y_dist;
+	while (1){
+		if (vertical){
+			SpanAdd(x0, y0 - before, x0, y0 + after, color);
+		}
+		else{
+			SpanAdd(x0 - before, y0, x0 + after, y0, color);
+		}
+		if (x0 == x1 && y0 == y1){
+			break;
+		}
+		error_2 = 2 * error;
+		if (error_2 > -y_dist){
+			error -= y_dist;
+			x0 += x_grow;
+		}
+		if (error_2 < x_dist){
+			error += x_dist;
+			y0 += y_grow;
+		}
+	}
+}
+
+/**
+ * @brief  		Spans of one run of the midpoint circle algorithm (points from (xs, y) to
+ * 				(xe, y) of the first octant) mirrored to the eight octants of a circle
+ * 				stretched to a rectangle (a rounded rectangle)
+ * @param[in]  	r: Rectangle with the centers of the corner arcs
+ * @param[in]  	xs: First x of the run
+ * @param[in]  	xe: Last x of the run
+ * @param[in]  	y: y of the run
+ * @param[in]	color: color
+ * @retval 		None
+ */
+static void ArcRun(rect_t *r, int16_t xs, int16_t xe, int16_t y, uint16_t color){
+	if (xs == 0){
+		/* Runs touching the axes join the straight sides */
+		SpanAdd(r->x0 - xe, r->y0 - y, r->x1 + xe, r->y0 - y, color);
+		SpanAdd(r->x1 + y, r->y0 - xe, r->x1 + y, r->y1 + xe, color);
+		SpanAdd(r->x0 - xe, r->y1 + y, r->x1 + xe, r->y1 + y, color);
+		SpanAdd(r->x0 - y, r->y0 - xe, r->x0 - y, r->y1 + xe, color);
+	}
+	else{
+		SpanAdd(r->x0 - xe, r->y0 - y, r->x0 - xs, r->y0 - y, color);
+		SpanAdd(r->x1 + xs, r->y0 - y, r->x1 + xe, r->y0 - y, color);
+		SpanAdd(r->x1 + y, r->y0 - xe, r->x1 + y, r->y0 - xs, color);
+		SpanAdd(r->x1 + y, r->y1 + xs, r->x1 + y, r->y1 + xe, color);
+		SpanAdd(r->x1 + xs, r->y1 + y, r->x1 + xe, r->y1 + y, color);
+		SpanAdd(r->x0 - xe, r->y1 + y, r->x0 - xs, r->y1 + y, color);
+		SpanAdd(r->x0 - y, r->y1 + xs, r->x0 - y, r->y1 + xe, color);
+		SpanAdd(r->x0 - y, r->y0 - xe, r->x0 - y, r->y0 - xs, color);
+	}
+}
+
+/**
+ * @brief  		Outline of a rounded rectangle (a circle if the rectangle is a point)
+ * @param[in]  	r: Rectangle with the centers of the corner arcs
+ * @param[in]  	radius: Radius of the corners
+ * @param[in]	color: color
+ * @retval 		None
+ */
+static void SpanArcs(rect_t *r, int16_t radius, uint16_t color){
+	int16_t f = 1 - radius, ddF_x = 1, ddF_y = -2 * radius, x = 0, y = radius, xs = 0;
+
+	/* Midpoint circle, points of equal y are emitted as a single run */
+	while (x < y){
+		if (f >= 0){
+			ArcRun(r, xs, x, y, color);
+			xs = x + 1;
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+	}
+	ArcRun(r, xs, x, y, color);
+}
+
+/**
+ * @brief  		Filled rounded rectangle (a filled circle if the rectangle is a point)
+ * @param[in]  	r: Rectangle with the centers of the corner arcs
+ * @param[in]  	radius: Radius of the corners (up to ILI9341_HEIGHT - 1)
+ * @param[in]	color: color
+ * @retval 		None
+ */
+static void SpanDisc(rect_t *r, int16_t radius, uint16_t color){
+	static int16_t half[ILI9341_HEIGHT];	/*!< Half width of the row at each distance from the center */
+	int16_t f = 1 - radius, ddF_x = 1, ddF_y = -2 * radius, x = 0, y = radius, dy;
+
+	for (dy = 0; dy <= radius; dy++){
+		half[dy] = 0;
+	}
+	half[0] = radius;
+	while (x < y){
+		if (f >= 0){
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+		if (half[y] < x){
+			half[y] = x;
+		}
+		if (half[x] < y){
+			half[x] = y;
+		}
+	}
+	/* Rows top to bottom: equal rows merge into a single window */
+	for (dy = radius; dy > 0; dy--){
+		SpanAdd(r->x0 - half[dy], r->y0 - dy, r->x1 + half[dy], r->y0 - dy, color);
+	}
+	SpanAdd(r->x0 - radius, r->y0, r->x1 + radius, r->y1, color);
+	for (dy = 1; dy <= radius; dy++){
+		SpanAdd(r->x0 - half[dy], r->y1 + dy, r->x1 + half[dy], r->y1 + dy, color);
+	}
 }
 
 void Fill(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color){
-	static uint16_t i;
-	static int32_t bytes_count;
+	static int32_t pixels_count;
 	static int16_t x_dist, y_dist;
-	static uint8_t pixel[MAX_VALUE_SIZE];
 
+	if (fb.buffer != NULL){
+		FramebufferFill(x0, y0, x1, y1, color);
+		return;
+	}
 	x_dist = x1 - x0;
 	y_dist = y1 - y0;
 	if (x0 > x1){
@@ -245,26 +987,187 @@ void Fill(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color){
 	if (y0 > y1){
 		y_dist = - y_dist;
 	}
-	/* Number of bytes to write. We have to write 2 bytes/pixel (16bits color) */
-	bytes_count = (x_dist + 1) * (y_dist + 1) * 2;
+	/* Number of pixels to write */
+	pixels_count = (x_dist + 1) * (y_dist + 1);
 	/* Define area to fill */
 	SetCursorPosition(x0, y0, x1, y1);
 
-	for (i = 0; i < MAX_VALUE_SIZE; i += 2){
-		pixel[i] = HighByte(color);
-		pixel[i + 1] = LowByte(color);
+	StreamBegin();
+	StreamRepeat(color, pixels_count);
+	StreamSend();
+}
+
+
+/**
+ * @brief  		Area of a rectangle
+ * @param[in]  	r: Rectangle
+ * @retval 		Area in pixels
+ */
+static int32_t RectArea(rect_t *r){
+	return (int32_t)(r->x1 - r->x0 + 1) * (r->y1 - r->y0 + 1);
+}
+
+/**
+ * @brief  		Smallest rectangle containing two rectangles
+ * @param[in]  	a: First rectangle
+ * @param[in]  	b: Second rectangle
+ * @retval 		Union rectangle
+ */
+static rect_t RectUnion(rect_t *a, rect_t *b){
+	rect_t u;
+	u.x0 = (a->x0 < b->x0) ? a->x0 : b->x0;
+	u.y0 = (a->y0 < b->y0) ? a->y0 : b->y0;
+	u.x1 = (a->x1 > b->x1) ? a->x1 : b->x1;
+	u.y1 = (a->y1 > b->y1) ? a->y1 : b->y1;
+	return u;
+}
+
+/**
+ * @brief  		Clip a rectangle to the framebuffer area
+ * @param[in]  	r: Rectangle (LCD coordinates, any corner order), returns clipped rectangle
+ * @retval 		true if some part of the rectangle is inside the framebuffer
+ */
+static bool FramebufferClip(rect_t *r){
+	int16_t aux;
+	if (r->x0 > r->x1){
+		aux = r->x0;
+		r->x0 = r->x1;
+		r->x1 = aux;
 	}
-	/* Start writing LCD memory */
-	lcd_cmd_t lcd_write = {MEM_WRITE, NULL, NULL};
-	WriteLCD(&lcd_write);
+	if (r->y0 > r->y1){
+		aux = r->y0;
+		r->y0 = r->y1;
+		r->y1 = aux;
+	}
+	if (r->x0 < fb.x){
+		r->x0 = fb.x;
+	}
+	if (r->y0 < fb.y){
+		r->y0 = fb.y;
+	}
+	if (r->x1 > fb.x + fb.width - 1){
+		r->x1 = fb.x + fb.width - 1;
+	}
+	if (r->y1 > fb.y + fb.height - 1){
+		r->y1 = fb.y + fb.height - 1;
+	}
+	return (r->x0 <= r->x1) && (r->y0 <= r->y1);
+}
 
-	while(bytes_count - MAX_VALUE_SIZE > 0){
-		lcd_cmd_t lcd_pixel = {NULL, MAX_VALUE_SIZE, pixel};
-		WriteLCD(&lcd_pixel);
-		bytes_count -= MAX_VALUE_SIZE;
+/**
+ * @brief  		Add a region to the dirty list
+ * @note		Overlapping or adjacent regions are merged. When the list is full the region
+ * 				is merged with the one that grows less.
+ * @param[in]  	r: Region (LCD coordinates, already clipped)
+ * @retval 		None
+ */
+static void FramebufferDirty(rect_t r){
+	uint8_t i, best = 0;
+	int32_t growth, best_growth = INT32_MAX;
+	rect_t u;
+	for (i = 0; i < fb.n_dirty; i++){
+		if ((r.x0 <= fb.dirty[i].x1 + 1) && (r.x1 + 1 >= fb.dirty[i].x0) &&
+			(r.y0 <= fb.dirty[i].y1 + 1) && (r.y1 + 1 >= fb.dirty[i].y0)){
+			fb.dirty[i] = RectUnion(&fb.dirty[i], &r);
+			return;
+		}
+	}
+	if (fb.n_dirty < ILI9341_MAX_DIRTY_RECTS){
+		fb.dirty[fb.n_dirty++] = r;
+		return;
+	}
+	for (i = 0; i < fb.n_dirty; i++){
+		u = RectUnion(&fb.dirty[i], &r);
+		growth = RectArea(&u) - RectArea(&fb.dirty[i]);
+		if (growth < best_growth){
+			best_growth = growth;
+			best = i;
+		}
 	}
-	lcd_cmd_t lcd_pixel = {NULL, bytes_count, pixel};
-	WriteLCD(&lcd_pixel);
+	fb.dirty[best] = RectUnion(&fb.dirty[best], &r);
+}
+
+/**
+ * @brief  		Fill an area of the framebuffer with a determined color
+ * @param[in]  	x0: Start column
+ * @param[in]  	y0: Start row
+ * @param[in]  	x1: End column
+ * @param[in]  	y1: End row
+ * @param[in]	color: color
+ * @retval 		None
+ */
+static void FramebufferFill(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color){
+	rect_t r = {x0, y0, x1, y1};
+	uint16_t *row;
+	uint16_t value = PanelOrder(color);
+	if (!FramebufferClip(&r)){
+		return;
+	}
+	for (int16_t y = r.y0; y <= r.y1; y++){
+		row = &fb.buffer[(y - fb.y) * fb.width - fb.x];
+		for (int16_t x = r.x0; x <= r.x1; x++){
+			row[x] = value;
+		}
+	}
+	FramebufferDirty(r);
+}
+
+/**
+ * @brief  		Draw a 1 bit per pixel bitmap (font character or icon) on the framebuffer
+ * @param[in]  	x: X position of top left corner
+ * @param[in]  	y: Y position of top left corner
+ * @param[in]  	width: Bitmap width in pixels
+ * @param[in]  	height: Bitmap height in pixels
+ * @param[in]  	bits: Bitmap data (rows of (width + 7) / 8 bytes, MSB first)
+ * @param[in]  	foreground: Color for bits = 1 (RGB565)
+ * @param[in]  	background: Color for bits = 0 (RGB565)
+ * @retval 		None
+ */
+static void FramebufferBitmap(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t *bits,
+							  uint16_t foreground, uint16_t background){
+	rect_t r = {x, y, x + width - 1, y + height - 1};
+	uint16_t fg = PanelOrder(foreground);
+	uint16_t bg = PanelOrder(background);
+	uint16_t stride = (width + 7) / 8;
+	uint16_t *row;
+	const uint8_t *bits_row;
+	if (!FramebufferClip(&r)){
+		return;
+	}
+	for (int16_t j = r.y0; j <= r.y1; j++){
+		row = &fb.buffer[(j - fb.y) * fb.width - fb.x];
+		bits_row = &bits[(j - y) * stride];
+		for (int16_t i = r.x0; i <= r.x1; i++){
+			row[i] = (bits_row[(i - x) / 8] & (MSK_BIT8 >> ((i - x) % 8))) ? fg : bg;
+		}
+	}
+	FramebufferDirty(r);
+}
+
+/**
+ * @brief  		Copy a picture (RGB565, 2 bytes/pixel in LCD order) to the framebuffer
+ * @param[in]  	x: X position of top left corner
+ * @param[in]  	y: Y position of top left corner
+ * @param[in]  	width: Picture width in pixels
+ * @param[in]  	height: Picture height in pixels
+ * @param[in]  	pic: Pointer to first byte of picture
+ * @retval 		None
+ */
+static void FramebufferPicture(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t* pic){
+	rect_t r = {x, y, x + width - 1, y + height - 1};
+	uint8_t *dst;
+	const uint8_t *src;
+	if (!FramebufferClip(&r)){
+		return;
+	}
+	for (int16_t j = r.y0; j <= r.y1; j++){
+		dst = (uint8_t *)&fb.buffer[(j - fb.y) * fb.width + (r.x0 - fb.x)];
+		src = &pic[((j - y) * width + (r.x0 - x)) * 2];
+		for (int32_t i = 0; i < (r.x1 - r.x0 + 1) * 2; i++){
+			dst[i] = src[i];
+		}
+	}
+	FramebufferDirty(r);
 }
 
 /*==================[external functions definition]==========================*/
@@ -272,7 +1175,9 @@ void Fill(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color){
 uint8_t ILI9341Init(spi_dev_t spi_dev, uint8_t gpio_dc, uint8_t gpio_rst){
 	/* SPI configuration */
 	spi_conf.device = spi_dev;
+	spi_conf.func_p = StreamDone;
 	ili9341_spi = spi_dev;
+	SpiInit(&spi_conf);
 	/* GPIOs configuration and initialization */
 	ili9341_dc = gpio_dc;
 	ili9341_rst = gpio_rst;
@@ -291,6 +1196,8 @@ uint8_t ILI9341Init(spi_dev_t spi_dev, uint8_t gpio_dc, uint8_t gpio_rst){
 	for (uint8_t i = 0; i < sizeof(lcd_init)/sizeof(lcd_cmd_t); i++){
 		WriteLCD(&lcd_init[i]);
 	}
+	window.x0 = -1;
+	window.y0 = -1;
 	/* It will be necessary to wait 5msec before sending next command after sleep out */
 	WriteLCD(&lcd_sleep_out);
 	DelayMs(10);
@@ -303,6 +1210,10 @@ uint8_t ILI9341Init(spi_dev_t spi_dev, uint8_t gpio_dc, uint8_t gpio_rst){
 }
 
 void ILI9341DrawPixel(uint16_t x, uint16_t y, uint16_t color){
+	if (fb.buffer != NULL){
+		FramebufferFill(x, y, x, y, color);
+		return;
+	}
 	/* Define area (pixel) to fill */
 	SetCursorPosition(x, y, x, y);
 	uint8_t pixels[] = {HighByte(color), LowByte(color)};
@@ -311,7 +1222,7 @@ void ILI9341DrawPixel(uint16_t x, uint16_t y, uint16_t color){
 }
 
 void ILI9341Fill(uint16_t color){
-	Fill(0, 0, lcd_orientation.width, lcd_orientation.height, color);
+	Fill(0, 0, lcd_orientation.width - 1, lcd_orientation.height - 1, color);
 }
 
 void ILI9341Rotate(ili9341_orientation_t orientation){
@@ -347,14 +1258,15 @@ void ILI9341Rotate(ili9341_orientation_t orientation){
 	}
 	lcd_cmd_t lcd_mem_acc = {MEM_ACC_CTRL, 1, mem_acc};
 	WriteLCD(&lcd_mem_acc);
+	/* Address window is reinterpreted with the new orientation */
+	window.x0 = -1;
+	window.y0 = -1;
 }
 
 void ILI9341DrawChar(uint16_t x, uint16_t y, char data, Font_t* font, uint16_t foreground, uint16_t background){
-	static uint32_t i, j, k;
-	static uint32_t char_row;
+	static uint32_t i;
 	static uint16_t lcd_x, lcd_y;
-	static int32_t bytes_count, bytes_row;
-	static uint8_t pixel[MAX_VALUE_SIZE];
+	static glyph_t *glyph;
 
 	/* Set coordinates */
 	lcd_x = x;
@@ -366,57 +1278,33 @@ void ILI9341DrawChar(uint16_t x, uint16_t y, char data, Font_t* font, uint16_t f
 		lcd_x = 0;
 	}
 
-	SetCursorPosition(lcd_x, lcd_y, lcd_x + font->info[data - ' '].width - 1, lcd_y + font->font_height - 1);
+	if (fb.buffer != NULL){
+		FramebufferBitmap(lcd_x, lcd_y, font->info[data - ' '].width, font->font_height,
+						  &font->data[font->info[data - ' '].offset], foreground, background);
+		return;
+	}
 
-	/* Number of bytes to write. We have to write 2 bytes/pixel */
-	bytes_count = font->font_height * font->info[data - ' '].width * 2;
+	glyphs.tick++;
+	glyph = GlyphCacheGet(data, font, foreground, background);
+
+	SetCursorPosition(lcd_x, lcd_y, lcd_x + font->info[data - ' '].width - 1, lcd_y + font->font_height - 1);
 
 	/* Start writing LCD memory */
-	lcd_cmd_t lcd_write = {MEM_WRITE, NULL, NULL};
-	WriteLCD(&lcd_write);
+	StreamBegin();
 
 	/* Draw font data */
 	/* go through character rows */
-	k = 0;
 	for (i = 0; i < font->font_height; i++)	{
-		/* */
-		char_row = font->info[data - ' '].offset + i * ((font->info[data - ' '].width + 7) / 8);
-		/* go through character columns */
-		bytes_row = -1;
-		for (j = 0; j < font->info[data - ' '].width; j++){
-			if(j % 8 == 0){
-				bytes_row++;
-			}
-			/* If exceed buffer size, send buffer */
-			if ((2 * j + i * font->info[data - ' '].width * 2 - k * MAX_VALUE_SIZE + 1) > MAX_VALUE_SIZE){
-				lcd_cmd_t lcd_pixels = {NULL, MAX_VALUE_SIZE, pixel};
-				WriteLCD(&lcd_pixels);
-				bytes_count -= MAX_VALUE_SIZE;
-				k++;
-			}
-			/* The n=FontWidth first bits of the 16bits row data draws the corresponding part of a character */
-			if (font->data[char_row + bytes_row] & (MSK_BIT8 >> (j % 8))){
-				/* if bit = 1, draw put foreground color */
-				pixel[2 * j + i * font->info[data - ' '].width * 2 - k * MAX_VALUE_SIZE] = HighByte(foreground);
-				pixel[2 * j + i * font->info[data - ' '].width * 2 - k * MAX_VALUE_SIZE + 1] = LowByte(foreground);
-			}
-			else{
-				pixel[2 * j + i * font->info[data - ' '].width * 2 - k * MAX_VALUE_SIZE] = HighByte(background);
-				pixel[2 * j + i * font->info[data - ' '].width * 2 - k * MAX_VALUE_SIZE + 1] = LowByte(background);
-			}
-		}
+		StreamCharRow(data, i, font, foreground, background, glyph);
 	}
 	/* Send the rest of the buffer */
-	lcd_cmd_t lcd_pixels = {NULL, bytes_count, pixel};
-	WriteLCD(&lcd_pixels);
+	StreamSend();
 }
 
 void ILI9341DrawIcon(uint16_t x, uint16_t y, icon_t icon, icon_font_t* icon_font, uint16_t foreground, uint16_t background){
-	static uint32_t i, j, k;
-	static uint32_t char_row;
+	static uint32_t i, j;
+	static const uint8_t *char_row;
 	static uint16_t lcd_x, lcd_y;
-	static int32_t bytes_count, bytes_row;
-	static uint8_t pixel[MAX_VALUE_SIZE];
 
 	/* Set coordinates */
 	lcd_x = x;
@@ -428,49 +1316,29 @@ void ILI9341DrawIcon(uint16_t x, uint16_t y, icon_t icon, icon_font_t* icon_font
 		lcd_x = 0;
 	}
 
-	SetCursorPosition(lcd_x, lcd_y, lcd_x + icon_font->width - 1, lcd_y + icon_font->height - 1);
+	if (fb.buffer != NULL){
+		FramebufferBitmap(lcd_x, lcd_y, icon_font->width, icon_font->height,
+						  &icon_font->data[icon * icon_font->offset], foreground, background);
+		return;
+	}
 
-	/* Number of bytes to write. We have to write 2 bytes/pixel */
-	bytes_count = icon_font->height * icon_font->width * 2;
+	SetCursorPosition(lcd_x, lcd_y, lcd_x + icon_font->width - 1, lcd_y + icon_font->height - 1);
 
 	/* Start writing LCD memory */
-	lcd_cmd_t lcd_write = {MEM_WRITE, NULL, NULL};
-	WriteLCD(&lcd_write);
+	StreamBegin();
 
-	/* Draw font data */
-	/* go through character rows */
-	k = 0;
+	/* Draw icon data */
+	/* go through icon rows */
 	for (i = 0; i < icon_font->height; i++)	{
-		/*  */
-		char_row = icon * icon_font->offset + i * ((icon_font->width + 7) / 8);
-		/* go through character columns */
-		bytes_row = -1;
+		char_row = &icon_font->data[icon * icon_font->offset + i * ((icon_font->width + 7) / 8)];
+		/* go through icon columns */
 		for (j = 0; j < icon_font->width; j++){
-			if(j % 8 == 0){
-				bytes_row++;
-			}
-			/* If exceed buffer size, send buffer */
-			if ((2 * j + i * icon_font->width * 2 - k * MAX_VALUE_SIZE + 1) > MAX_VALUE_SIZE){
-				lcd_cmd_t lcd_pixels = {NULL, MAX_VALUE_SIZE, pixel};
-				WriteLCD(&lcd_pixels);
-				bytes_count -= MAX_VALUE_SIZE;
-				k++;
-			}
-			/* The n=FontWidth first bits of the 16bits row data draws the corresponding part of a character */
-			if (icon_font->data[char_row + bytes_row] & (MSK_BIT8 >> (j % 8))){
-				/* if bit = 1, draw put foreground color */
-				pixel[2 * j + i * icon_font->width * 2 - k * MAX_VALUE_SIZE] = HighByte(foreground);
-				pixel[2 * j + i * icon_font->width * 2 - k * MAX_VALUE_SIZE + 1] = LowByte(foreground);
-			}
-			else{
-				pixel[2 * j + i * icon_font->width * 2 - k * MAX_VALUE_SIZE] = HighByte(background);
-				pixel[2 * j + i * icon_font->width * 2 - k * MAX_VALUE_SIZE + 1] = LowByte(background);
-			}
+			/* if bit = 1, draw foreground color */
+			StreamPixel((char_row[j / 8] & (MSK_BIT8 >> (j % 8))) ? foreground : background);
 		}
 	}
 	/* Send the rest of the buffer */
-	lcd_cmd_t lcd_pixels = {NULL, bytes_count, pixel};
-	WriteLCD(&lcd_pixels);
+	StreamSend();
 }
 
 void ILI9341DrawInt(uint16_t x, uint16_t y, uint32_t num, uint8_t dig, Font_t* font, uint16_t foreground, uint16_t background){
@@ -490,6 +1358,7 @@ void ILI9341DrawInt(uint16_t x, uint16_t y, uint32_t num, uint8_t dig, Font_t* f
 
 void ILI9341DrawString(uint16_t x, uint16_t y, char* str, Font_t *font, uint16_t foreground, uint16_t background){
 	static uint16_t lcd_x, lcd_y;
+	static uint16_t n;
 
 	/* Set coordinates */
 	lcd_x = x;
@@ -510,14 +1379,17 @@ void ILI9341DrawString(uint16_t x, uint16_t y, char* str, Font_t *font, uint16_t
 			str++;
 		}
 		else if (*str == '\r'){
-				str++;
+			str++;
+		}
+		else{
+			/* Put characters until end of line to LCD */
+			n = 0;
+			while ((str[n] != '\0') && (str[n] != '\n') && (str[n] != '\r')){
+				n++;
 			}
-
-		/* Put character to LCD */
-		ILI9341DrawChar(lcd_x, lcd_y, *str, font, foreground, background);
-		lcd_x += font->info[*str - ' '].width + 1;
-		/* Next character */
-		str++;
+			lcd_x += StringLine(lcd_x, lcd_y, str, n, font, foreground, background);
+			str += n;
+		}
 	}
 }
 
@@ -535,8 +1407,6 @@ void ILI9341GetStringSize(char* str, Font_t* font, uint16_t* width, uint16_t* he
 }
 
 void ILI9341DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color){
-	static int16_t x_dist, y_dist, x_grow, y_grow, error, error_2;
-
 	/* Check for overflow */
 	if (x0 >= lcd_orientation.width){
 		x0 = lcd_orientation.width - 1;
@@ -550,53 +1420,35 @@ void ILI9341DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_
 	if (y1 >= lcd_orientation.height){
 		y1 = lcd_orientation.height - 1;
 	}
+	/* Straight lines end up as a single span, diagonal ones as one span per step */
+	SpanLine(x0, y0, x1, y1, 1, color);
+	SpanFlush();
+}
 
-	/* Calculate x y distances and determine grow direction */
-	x_dist = x1 - x0;
-	y_dist = y1 - y0;
-	if (x0 > x1){
-		x_dist = -x_dist;
-		x_grow = LEFT;
+void ILI9341DrawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t thickness, uint16_t color){
+	uint32_t x_dist, y_dist, length;
+	uint16_t width;
+
+	if (thickness == 0){
+		return;
 	}
-	else{
-		x_grow = RIGHT;
+	x_dist = (x1 > x0) ? (x1 - x0) : (x0 - x1);
+	y_dist = (y1 > y0) ? (y1 - y0) : (y0 - y1);
+	if (x_dist < y_dist){
+		length = x_dist;
+		x_dist = y_dist;
+		y_dist = length;
 	}
-	if (y0 > y1){
-		y_dist = -y_dist;
-		y_grow = UP;
+	/* Brush length measured along the minor axis gives the requested perpendicular thickness */
+	if (x_dist == 0){
+		width = thickness;
 	}
 	else{
-		y_grow = DOWN;
-	}
-
-	/* Vertical or horizontal line */
-	if (x_dist == 0 || y_dist == 0){
-		Fill(x0, y0, x1, y1, color);
-	}
-	/* Diagonal line */
-	else{
-		error = x_dist - y_dist;
-
-		while (1){
-			/* Draw start point */
-			ILI9341DrawPixel(x0, y0, color);
-			/* Loop ends when start point reaches end point */
-			if (x0 == x1 && y0 == y1){
-				break;
-			}
-			error_2 = 2 * error;
-			/* Determine if line must grow in x direction */
-			if (error_2 > -y_dist){
-				error -= y_dist;
-				x0 += x_grow;	/* Move start point */
-			}
-			/* Determine if line must grow in y direction */
-			if (error_2 < x_dist){
-				error += x_dist;
-				y0 += y_grow;	/* Move start point */
-			}
-		}
+		length = ISqrt(x_dist * x_dist + y_dist * y_dist);
+		width = (thickness * length + x_dist / 2) / x_dist;
 	}
+	SpanLine(x0, y0, x1, y1, width, color);
+	SpanFlush();
 }
 
 void ILI9341DrawRectangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color){
@@ -610,73 +1462,82 @@ void ILI9341DrawFilledRectangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t
 	Fill(x0, y0, x1, y1, color);
 }
 
+void ILI9341DrawRoundRectangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t r, uint16_t color){
+	rect_t centers;
+
+	if (x0 > x1){
+		centers.x0 = x1;
+		x1 = x0;
+		x0 = centers.x0;
+	}
+	if (y0 > y1){
+		centers.y0 = y1;
+		y1 = y0;
+		y0 = centers.y0;
+	}
+	/* Radius can't exceed half of the shortest side */
+	if (2 * r > x1 - x0){
+		r = (x1 - x0) / 2;
+	}
+	if (2 * r > y1 - y0){
+		r = (y1 - y0) / 2;
+	}
+	centers.x0 = x0 + r;
+	centers.y0 = y0 + r;
+	centers.x1 = x1 - r;
+	centers.y1 = y1 - r;
+	SpanArcs(&centers, r, color);
+	SpanFlush();
+}
+
+void ILI9341DrawFilledRoundRectangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t r, uint16_t color){
+	rect_t centers;
+
+	if (x0 > x1){
+		centers.x0 = x1;
+		x1 = x0;
+		x0 = centers.x0;
+	}
+	if (y0 > y1){
+		centers.y0 = y1;
+		y1 = y0;
+		y0 = centers.y0;
+	}
+	if (2 * r > x1 - x0){
+		r = (x1 - x0) / 2;
+	}
+	if (2 * r > y1 - y0){
+		r = (y1 - y0) / 2;
+	}
+	centers.x0 = x0 + r;
+	centers.y0 = y0 + r;
+	centers.x1 = x1 - r;
+	centers.y1 = y1 - r;
+	SpanDisc(&centers, r, color);
+	SpanFlush();
+}
+
 void ILI9341DrawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color){
-	static int16_t f, ddF_x, ddF_y, x, y;
-
-	f = 1 - r;
-	ddF_x = 1;
-	ddF_y = -2 * r;
-	x = 0;
-	y = r;
-
-	ILI9341DrawPixel(x0, y0 + r, color);
-	ILI9341DrawPixel(x0, y0 - r, color);
-	ILI9341DrawPixel(x0 + r, y0, color);
-	ILI9341DrawPixel(x0 - r, y0, color);
-
-    while (x < y){
-        if (f >= 0){
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
-
-        ILI9341DrawPixel(x0 + x, y0 + y, color);
-        ILI9341DrawPixel(x0 - x, y0 + y, color);
-        ILI9341DrawPixel(x0 + x, y0 - y, color);
-        ILI9341DrawPixel(x0 - x, y0 - y, color);
-
-        ILI9341DrawPixel(x0 + y, y0 + x, color);
-        ILI9341DrawPixel(x0 - y, y0 + x, color);
-        ILI9341DrawPixel(x0 + y, y0 - x, color);
-        ILI9341DrawPixel(x0 - y, y0 - x, color);
-    }
+	rect_t center = {x0, y0, x0, y0};
+
+	if (r < 0){
+		return;
+	}
+	SpanArcs(&center, r, color);
+	SpanFlush();
 }
 
 void ILI9341DrawFilledCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color){
-	static int16_t f, ddF_x, ddF_y, x, y;
-
-	f = 1 - r;
-	ddF_x = 1;
-	ddF_y = -2 * r;
-	x = 0;
-	y = r;
-
-    ILI9341DrawPixel(x0, y0 + r, color);
-    ILI9341DrawPixel(x0, y0 - r, color);
-    ILI9341DrawPixel(x0 + r, y0, color);
-    ILI9341DrawPixel(x0 - r, y0, color);
-    ILI9341DrawLine(x0 - r, y0, x0 + r, y0, color);
-
-    while (x < y){
-        if (f >= 0){
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
-
-        ILI9341DrawLine(x0 - x, y0 + y, x0 + x, y0 + y, color);
-        ILI9341DrawLine(x0 + x, y0 - y, x0 - x, y0 - y, color);
-
-        ILI9341DrawLine(x0 + y, y0 + x, x0 - y, y0 + x, color);
-        ILI9341DrawLine(x0 + y, y0 - x, x0 - y, y0 - x, color);
-    }
+	rect_t center = {x0, y0, x0, y0};
+
+	if (r < 0){
+		return;
+	}
+	if (r >= ILI9341_HEIGHT){
+		r = ILI9341_HEIGHT - 1;
+	}
+	SpanDisc(&center, r, color);
+	SpanFlush();
 }
 
 void ILI9341DrawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color){
@@ -686,148 +1547,227 @@ void ILI9341DrawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t
 }
 
 void ILI9341DrawFilledTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color){
-	static int16_t x_0 = 0;
-	static int16_t y_0 = 0;
-	static int16_t x_1 = 0;
-	static int16_t y_1 = 0;
-	static int16_t x_2 = 0;
-	static int16_t y_2 = 0;
-	static int16_t x_aux = 0;
-	static int16_t y_aux = 0;
-	static int16_t scanline_y = 0;
-	float invslope1, invslope2, curx1, curx2;
-	if((y0 <= y1) && (y0 <= y2)){
-		x_0 = x0;
-		y_0 = y0;
-		if(y1 <= y2){
-			x_1 = x1;
-			y_1 = y1;
-			x_2 = x2;
-			y_2 = y2;
-		} else{
-			x_1 = x2;
-			y_1 = y2;
-			x_2 = x1;
-			y_2 = y1;
-		}
-	}else if((y1 <= y2) && (y1 <= y0)){
-		x_0 = x1;
-		y_0 = y1;
-		if(y0 <= y2){
-			x_1 = x0;
-			y_1 = y0;
-			x_2 = x2;
-			y_2 = y2;
-		} else{
-			x_1 = x2;
-			y_1 = y2;
-			x_2 = x0;
-			y_2 = y0;
-		}
-	}else if((y2 <= y1) && (y2 <= y0)){
-		x_0 = x2;
-		y_0 = y2;
-		if(y0 <= y1){
-			x_1 = x0;
-			y_1 = y0;
-			x_2 = x1;
-			y_2 = y1;
-		} else{
-			x_1 = x1;
-			y_1 = y1;
-			x_2 = x0;
-			y_2 = y0;
-		}
-	}
-	if(y_1 == y_2){
-		// Bottom flat triangle
-		invslope1 = (float)(x_1 - x_0) / (float)(y_1 - y_0);
-		invslope2 = (float)(x_2 - x_0) / (float)(y_2 - y_0);
-		curx1 = x_0;
-		curx2 = x_0;
-		scanline_y = y_0;
-		while(scanline_y < y_1){
-			ILI9341DrawLine((int)curx1, scanline_y, (int)curx2, scanline_y, color);
-			curx1 += invslope1;
-			curx2 += invslope2;
-			scanline_y++;
-		}
-  	}
-  	else if (y_0 == y_1){
-		// Top flat triangle
-		invslope1 = (float)(x_2 - x_0) / (float)(y_2 - y_0);
-		invslope2 = (float)(x_2 - x_1) / (float)(y_2 - y_1);
-		curx1 = x_2;
-		curx2 = x_2;
-		scanline_y = y_2;
-		while(scanline_y > y_0){
-			ILI9341DrawLine((int)curx1, scanline_y, (int)curx2, scanline_y, color);
-			curx1 -= invslope1;
-			curx2 -= invslope2;
-			scanline_y--;
-		}
-  	}
-  	else{
-		// Split in a flat top triangle and a bottom flat triangle
-		x_aux = (int)(x_0 + (float)(y_1 - y_0) / (float)(y_2 - y_0) * (x_2 - x_0));
-		y_aux = y_1;
-		// Bottom flat triangle
-		invslope1 = (float)(x_1 - x_0) / (float)(y_1 - y_0);
-		invslope2 = (float)(x_aux - x_0) / (float)(y_aux - y_0);
-		curx1 = x_0;
-		curx2 = x_0;
-		scanline_y = y_0;
-		while(scanline_y < y_1){
-			ILI9341DrawLine((int)curx1, scanline_y, (int)curx2, scanline_y, color);
-			curx1 += invslope1;
-			curx2 += invslope2;
-			scanline_y++;
-		}
-		// Top flat triangle
-		invslope1 = (float)(x_2 - x_1) / (float)(y_2 - y_1);
-		invslope2 = (float)(x_2 - x_aux) / (float)(y_2 - y_aux);
-		curx1 = x_2;
-		curx2 = x_2;
-		scanline_y = y_2;
-		while(scanline_y > y_1){
-			ILI9341DrawLine((int)curx1, scanline_y, (int)curx2, scanline_y, color);
-			curx1 -= invslope1;
-			curx2 -= invslope2;
-			scanline_y--;
-		}
-		ILI9341DrawLine(x_1, y_1, x_aux, y_aux, color);
-  	}
+	int16_t aux, y, last, a, b;
+	int32_t dx01, dy01, dx02, dy02, dx12, dy12, sa = 0, sb = 0;
+
+	/* Sort vertices by row (y0 <= y1 <= y2) */
+	if (y0 > y1){
+		aux = y0; y0 = y1; y1 = aux;
+		aux = x0; x0 = x1; x1 = aux;
+	}
+	if (y1 > y2){
+		aux = y2; y2 = y1; y1 = aux;
+		aux = x2; x2 = x1; x1 = aux;
+	}
+	if (y0 > y1){
+		aux = y0; y0 = y1; y1 = aux;
+		aux = x0; x0 = x1; x1 = aux;
+	}
+	/* All vertices on the same row */
+	if (y0 == y2){
+		a = b = x0;
+		a = (x1 < a) ? x1 : a;
+		b = (x1 > b) ? x1 : b;
+		a = (x2 < a) ? x2 : a;
+		b = (x2 > b) ? x2 : b;
+		SpanAdd(a, y0, b, y0, color);
+		SpanFlush();
+		return;
+	}
+	dx01 = x1 - x0;
+	dy01 = y1 - y0;
+	dx02 = x2 - x0;
+	dy02 = y2 - y0;
+	dx12 = x2 - x1;
+	dy12 = y2 - y1;
+	/* Upper part: edges 0-1 and 0-2 (row y1 included only if lower part is flat) */
+	last = (y1 == y2) ? y1 : y1 - 1;
+	for (y = y0; y <= last; y++){
+		a = x0 + sa / dy01;
+		b = x0 + sb / dy02;
+		sa += dx01;
+		sb += dx02;
+		SpanAdd((a < b) ? a : b, y, (a < b) ? b : a, y, color);
+	}
+	/* Lower part: edges 1-2 and 0-2 */
+	sa = dx12 * (y - y1);
+	sb = dx02 * (y - y0);
+	for (; y <= y2; y++){
+		a = x1 + sa / dy12;
+		b = x0 + sb / dy02;
+		sa += dx12;
+		sb += dx02;
+		SpanAdd((a < b) ? a : b, y, (a < b) ? b : a, y, color);
+	}
+	SpanFlush();
 }
 
 void ILI9341DrawPicture(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* pic){
-	static uint16_t i, j;
-	static int32_t bytes_count;
-	static uint8_t pixel[MAX_VALUE_SIZE];
+	if (fb.buffer != NULL){
+		FramebufferPicture(x, y, width, height, pic);
+		return;
+	}
 
 	SetCursorPosition(x, y, x + width - 1, y + height - 1);
 
-	/* Number of bytes to write. We have to write 2 bytes/pixel */
-	bytes_count = width * height * 2;
+	/* Start writing LCD memory. We have to write 2 bytes/pixel */
+	StreamBegin();
+	StreamCopy(pic, (uint32_t)width * height * 2);
+	StreamSend();
+}
+
+void ILI9341DrawImage(uint16_t x, uint16_t y, const ili9341_image_t *image){
+	image_cursor_t cursor = {x, y, image->width, 0, 0};
+	rect_t r = {x, y, x + image->width - 1, y + image->height - 1};
+
+	if (fb.buffer != NULL){
+		if (FramebufferClip(&r)){
+			ImageDecode(image, &cursor);
+			FramebufferDirty(r);
+		}
+		return;
+	}
+
+	SetCursorPosition(x, y, x + image->width - 1, y + image->height - 1);
 
 	/* Start writing LCD memory */
-	lcd_cmd_t lcd_write = {MEM_WRITE, NULL, NULL};
-	WriteLCD(&lcd_write);
+	StreamBegin();
+	ImageDecode(image, NULL);
+	StreamSend();
+}
 
-	j = 0;
-	while(bytes_count - MAX_VALUE_SIZE > 0){
-		for (i = 0; i < MAX_VALUE_SIZE; i++){
-			pixel[i] = pic[j * MAX_VALUE_SIZE + i];
+void ILI9341FramebufferEnable(uint16_t *buffer, uint16_t x, uint16_t y, uint16_t width, uint16_t height){
+	fb.buffer = buffer;
+	fb.width = width;
+	fb.height = height;
+	ILI9341FramebufferMove(x, y);
+}
+
+void ILI9341FramebufferMove(uint16_t x, uint16_t y){
+	fb.x = x;
+	fb.y = y;
+	fb.n_dirty = 0;
+}
+
+void ILI9341FramebufferFlush(void){
+	uint16_t *buffer = fb.buffer;
+	rect_t *r;
+	int32_t bytes_count, row_bytes;
+	uint8_t *src;
+	if (buffer == NULL){
+		return;
+	}
+	/* Disable the framebuffer while sending, so Fill and SetCursorPosition go to the LCD */
+	fb.buffer = NULL;
+	for (uint8_t i = 0; i < fb.n_dirty; i++){
+		r = &fb.dirty[i];
+		SetCursorPosition(r->x0, r->y0, r->x1, r->y1);
+		StreamBegin();
+		row_bytes = (r->x1 - r->x0 + 1) * 2;
+		if ((row_bytes == fb.width * 2) && (stream.buffers == NULL)){
+			/* Full width region: rows are contiguous in the framebuffer, send them directly */
+			src = (uint8_t *)&buffer[(r->y0 - fb.y) * fb.width];
+			bytes_count = row_bytes * (r->y1 - r->y0 + 1);
+			while (bytes_count > 0){
+				lcd_cmd_t lcd_pixels = {NULL, (bytes_count > ILI9341_MAX_BURST) ? ILI9341_MAX_BURST : bytes_count, src};
+				WriteLCD(&lcd_pixels);
+				src += lcd_pixels.databytes;
+				bytes_count -= lcd_pixels.databytes;
+			}
 		}
-		lcd_cmd_t lcd_pixel = {NULL, MAX_VALUE_SIZE, pixel};
-		WriteLCD(&lcd_pixel);
-		bytes_count -= MAX_VALUE_SIZE;
-		j++;
+		else{
+			/* Rows are packed in bursts. With pipeline they are also copied when full width, so
+			 * the framebuffer can be modified as soon as this function returns */
+			for (int16_t y = r->y0; y <= r->y1; y++){
+				src = (uint8_t *)&buffer[(y - fb.y) * fb.width + (r->x0 - fb.x)];
+				StreamCopy(src, row_bytes);
+			}
+			StreamSend();
+		}
+	}
+	fb.n_dirty = 0;
+	fb.buffer = buffer;
+}
+
+void ILI9341FramebufferDisable(void){
+	ILI9341FramebufferFlush();
+	fb.buffer = NULL;
+}
+
+void ILI9341PipelineEnable(uint8_t *buffers, uint16_t buffer_size, uint8_t n_buffers, void *func_p, void *param_p){
+	ILI9341PipelineDisable();
+	if (buffer_size > ILI9341_MAX_BURST){
+		buffer_size = ILI9341_MAX_BURST;
 	}
-	for (i = 0; i < bytes_count; i++){
-		pixel[i] = pic[j * MAX_VALUE_SIZE + i];
+	/* Whole pixels and word aligned buffers (unaligned DMA buffers are copied by the SPI driver) */
+	buffer_size &= ~0x03;
+	if ((buffers == NULL) || (buffer_size == 0) || (n_buffers < 2)){
+		return;
 	}
-	lcd_cmd_t lcd_pixel = {NULL, bytes_count, pixel};
-	WriteLCD(&lcd_pixel);
+	stream.func_p = func_p;
+	stream.param_p = param_p;
+	stream.size = buffer_size;
+	stream.n_buffers = n_buffers;
+	stream.current = 0;
+	stream.data = buffers;
+	stream.buffers = buffers;
+}
+
+void ILI9341PipelineWait(void){
+	SpiWaitQueued(ili9341_spi, 0);
+}
+
+void ILI9341PipelineDisable(void){
+	ILI9341PipelineWait();
+	stream.buffers = NULL;
+	stream.data = burst;
+	stream.size = ILI9341_MAX_BURST;
+	stream.func_p = NULL;
+}
+
+void ILI9341GlyphCacheEnable(uint8_t *pool, uint32_t size){
+	ILI9341GlyphCacheDisable();
+	glyphs.size = size;
+	glyphs.used = 0;
+	glyphs.pool = pool;
+}
+
+void ILI9341GlyphCacheDisable(void){
+	glyphs.pool = NULL;
+	for (uint8_t i = 0; i < ILI9341_GLYPH_CACHE_ENTRIES; i++){
+		glyphs.glyph[i].size = 0;
+	}
+}
+
+ili9341_orientation_t ILI9341GetOrientation(void){
+	return lcd_orientation.orientation;
+}
+
+uint8_t ILI9341ScrollArea(uint16_t top_fixed, uint16_t lines){
+	uint16_t bottom_fixed;
+	/* VSCRDEF areas must add up to the frame memory lines */
+	if ((uint32_t)top_fixed + lines > ILI9341_HEIGHT){
+		return 0;
+	}
+	bottom_fixed = ILI9341_HEIGHT - top_fixed - lines;
+	uint8_t scroll_def[] = {HighByte(top_fixed), LowByte(top_fixed), HighByte(lines), LowByte(lines),
+		HighByte(bottom_fixed), LowByte(bottom_fixed)};
+	lcd_cmd_t lcd_scroll_def = {VERT_SCROLL_DEF, sizeof(scroll_def), scroll_def};
+	WriteLCD(&lcd_scroll_def);
+	return 1;
+}
+
+void ILI9341ScrollStart(uint16_t line){
+	uint8_t scroll_start[] = {HighByte(line), LowByte(line)};
+	lcd_cmd_t lcd_scroll_start = {VERT_SCROLL_START, sizeof(scroll_start), scroll_start};
+	WriteLCD(&lcd_scroll_start);
+}
+
+void ILI9341ScrollDisable(void){
+	lcd_cmd_t lcd_normal = {NORMAL_MODE_ON, NULL, NULL};
+	ILI9341ScrollArea(0, ILI9341_HEIGHT);
+	ILI9341ScrollStart(0);
+	WriteLCD(&lcd_normal);
 }
 
 uint8_t ILI9341DeInit(void){
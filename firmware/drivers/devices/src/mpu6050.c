@@ -13,12 +13,27 @@
 #include "mpu6050.h"
 #include "math.h"
 #include <string.h>
+#include "timer_mcu.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 /*==================[macros and definitions]=================================*/
 #define I2C_NUM I2C_NUM_0
+#define GYRO_RATE_DLPF      1000    /* gyro output rate with DLPF enabled */
+#define GYRO_RATE           8000    /* gyro output rate with DLPF disabled */
 
 /*==================[internal data definition]===============================*/
 uint8_t devAddr;
 uint8_t buffer[14];
+static uint8_t stream_bytes[MPU6050_STREAM_FRAMES * MPU6050_FIFO_FRAME_SIZE];  /* FIFO burst */
+static bool stream_on = false;              /* stream running */
+static gpio_t stream_pin;                   /* INT pin */
+static TaskHandle_t stream_consumer;        /* task notified every stream_burst samples */
+static uint8_t stream_burst;                /* samples per notification */
+static uint8_t stream_pending;              /* samples since last notification */
+static volatile uint32_t stream_samples;    /* samples taken (data ready interrupts) */
+static volatile uint64_t stream_time;       /* last data ready interrupt */
+static uint32_t stream_delivered;           /* samples read or lost */
+static uint32_t stream_lost;                /* samples lost by overflows */
 /*==================[internal functions declaration]=========================*/
 
 /*==================[external functions definition]==========================*/
@@ -2766,4 +2781,123 @@ void MPU6050_setDeviceID(uint8_t id) {
     I2C_writeBits(devAddr, MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH, id);
 }
 
+// FIFO stream
+
+/** Data ready interrupt: a frame was stored in the FIFO.
+ */
+static void MPU6050_dataReady(void *param) {
+    BaseType_t task_woken = pdFALSE;
+
+    stream_time = TimerGetTimestamp();
+    stream_samples++;
+    if(++stream_pending >= stream_burst){
+        stream_pending = 0;
+        vTaskNotifyGiveFromISR(stream_consumer, &task_woken);
+        if(task_woken){
+            portYIELD_FROM_ISR();
+        }
+    }
+}
+
+bool MPU6050_startStream(const mpu6050_stream_config_t *config) {
+    uint16_t gyro_rate = ((config->dlpf == MPU6050_DLPF_BW_256) || (config->dlpf > MPU6050_DLPF_BW_5)) ?
+        GYRO_RATE : GYRO_RATE_DLPF;
+
+    if(stream_on || (config->rate == 0) || (config->rate > GYRO_RATE_DLPF) || (gyro_rate / config->rate > 256) ||
+        (config->burst == 0) || (config->burst > MPU6050_STREAM_FRAMES / 2) || (config->consumer == NULL)){
+        return false;
+    }
+    MPU6050_setIntEnabled(0);
+    MPU6050_setFIFOEnabled(false);
+    MPU6050_setDLPFMode(config->dlpf);
+    MPU6050_setRate(gyro_rate / config->rate - 1);
+    // Frames in register order: ACCEL_XOUT_H to ACCEL_ZOUT_L, GYRO_XOUT_H to GYRO_ZOUT_L
+    I2C_writeByte(devAddr, MPU6050_RA_FIFO_EN, (1 << MPU6050_XG_FIFO_EN_BIT) | (1 << MPU6050_YG_FIFO_EN_BIT) |
+        (1 << MPU6050_ZG_FIFO_EN_BIT) | (1 << MPU6050_ACCEL_FIFO_EN_BIT));
+    // INT active high, 50 us pulse on each sample
+    MPU6050_setInterruptMode(false);
+    MPU6050_setInterruptLatch(false);
+    MPU6050_resetFIFO();
+
+    stream_consumer = config->consumer;
+    stream_burst = config->burst;
+    stream_pending = 0;
+    stream_samples = 0;
+    stream_delivered = 0;
+    stream_lost = 0;
+    stream_pin = config->int_pin;
+    GPIOInit(stream_pin, GPIO_INPUT);
+    GPIOActivInt(stream_pin, MPU6050_dataReady, true, NULL);
+    stream_on = true;
+    MPU6050_setFIFOEnabled(true);
+    MPU6050_setIntEnabled(1 << MPU6050_INTERRUPT_DATA_RDY_BIT);
+    return true;
+}
+
+void MPU6050_stopStream() {
+    if(!stream_on){
+        return;
+    }
+    MPU6050_setIntEnabled(0);
+    MPU6050_setFIFOEnabled(false);
+    GPIODeactivInt(stream_pin);
+    stream_on = false;
+}
+
+bool MPU6050_waitStream(uint32_t timeout_ms) {
+    return ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms)) > 0;
+}
+
+uint16_t MPU6050_readStream(mpu6050_frames_t *frames) {
+    uint16_t count;
+    uint32_t samples;
+
+    frames->count = 0;
+    frames->overflow = false;
+    // 64 bits are not written atomically by the interrupt
+    do{
+        frames->time = stream_time;
+    } while(frames->time != stream_time);
+    if(I2C_readBurst(devAddr, MPU6050_RA_FIFO_COUNTH, 2, stream_bytes, I2C_MASTER_TIMEOUT_MS) != 2){
+        return 0;
+    }
+    count = (((uint16_t)stream_bytes[0]) << 8) | stream_bytes[1];
+    if(count > MPU6050_STREAM_FRAMES * MPU6050_FIFO_FRAME_SIZE){
+        // Oldest bytes were overwritten (1024 is not a multiple of the frame size): frames are misaligned
+        MPU6050_setFIFOEnabled(false);
+        MPU6050_resetFIFO();
+        MPU6050_setFIFOEnabled(true);
+        samples = stream_samples;
+        stream_lost += samples - stream_delivered;
+        stream_delivered = samples;
+        frames->overflow = true;
+    } else{
+        count -= count % MPU6050_FIFO_FRAME_SIZE;
+        if(I2C_readBurst(devAddr, MPU6050_RA_FIFO_R_W, count, stream_bytes, I2C_MASTER_TIMEOUT_MS) == count){
+            stream_delivered += MPU6050_parseFIFO(stream_bytes, count, frames);
+        }
+    }
+    frames->lost = stream_lost;
+    return frames->count;
+}
+
+uint16_t MPU6050_parseFIFO(const uint8_t *data, uint16_t length, mpu6050_frames_t *frames) {
+    uint16_t i = frames->count;
+    uint16_t n = length / MPU6050_FIFO_FRAME_SIZE;
+
+    if(n > MPU6050_STREAM_FRAMES - i){
+        n = MPU6050_STREAM_FRAMES - i;
+    }
+    for(uint16_t end = i + n; i < end; i++, data += MPU6050_FIFO_FRAME_SIZE){
+        frames->ax[i] = (int16_t)((data[0] << 8) | data[1]);
+        frames->ay[i] = (int16_t)((data[2] << 8) | data[3]);
+        frames->az[i] = (int16_t)((data[4] << 8) | data[5]);
+        frames->gx[i] = (int16_t)((data[6] << 8) | data[7]);
+        frames->gy[i] = (int16_t)((data[8] << 8) | data[9]);
+        frames->gz[i] = (int16_t)((data[10] << 8) | data[11]);
+    }
+    frames->count = i;
+    return n;
+}
+
 /*==================[end of file]============================================*/
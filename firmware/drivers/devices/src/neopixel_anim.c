@@ -0,0 +1,325 @@
+/**
+ * @file neopixel_anim.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "neopixel_anim.h"
+#include "ws2812b.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+/*==================[macros and definitions]=================================*/
+#define ANIM_STACK_SIZE		2048		/*!< Animation task stack (bytes) */
+#define RB_MSK				0x00FF00FF	/*!< Red and blue levels of a color (processed together) */
+#define G_MSK				0x0000FF00	/*!< Green level of a color */
+#define FULL_LEVEL			256			/*!< Level that keeps a color unchanged */
+#define US_PER_SEC			1000000
+#define MS_PER_SEC			1000
+/*==================[internal data declaration]==============================*/
+/**
+ * @brief Effect being animated
+ */
+typedef struct {
+	neopixel_effect_t effect;	/*!< Effect configuration */
+	uint32_t phase;				/*!< Position in the cycle (fraction of 2^32) */
+	uint32_t step;				/*!< Phase increment per frame */
+	uint32_t hue_step;			/*!< Rainbow hue increment per NeoPixel (16.16 fixed point) */
+	bool used;					/*!< Slot in use */
+} anim_slot_t;
+
+static anim_slot_t anim_slots[NEOPIXEL_ANIM_MAX_EFFECTS];	/*!< Effects, in composition order */
+static neopixel_color_t *anim_colors;						/*!< Frame being rendered */
+static uint16_t anim_length;								/*!< NeoPixels in the stripe */
+static uint16_t anim_fps;									/*!< Frames per second */
+static timer_mcu_t anim_timer;								/*!< Frame rate timer */
+static void (*anim_frame_p)(void*);							/*!< Called after each frame */
+static void *anim_frame_param;								/*!< Parameter of anim_frame_p */
+static neopixel_anim_stats_t anim_stats;					/*!< Frames statistics */
+static uint64_t anim_total_us;								/*!< Time used by the frames since last reset */
+static uint32_t anim_total_frames;							/*!< Frames since last reset */
+static TaskHandle_t anim_task = NULL;						/*!< Animation task */
+static StaticTask_t anim_task_buffer;						/*!< anim_task storage */
+static StackType_t anim_stack[ANIM_STACK_SIZE];				/*!< anim_task stack */
+static SemaphoreHandle_t anim_mutex = NULL;					/*!< Protects effects and statistics */
+static StaticSemaphore_t anim_mutex_buffer;					/*!< anim_mutex storage */
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Scale the levels of a color (red and blue are scaled with a single product)
+ *
+ * @param color 24 bits color
+ * @param level 0 (off) to FULL_LEVEL (unchanged)
+ * @return neopixel_color_t Scaled color
+ */
+static inline neopixel_color_t ColorScale(neopixel_color_t color, uint32_t level){
+	return ((((color & RB_MSK) * level) >> 8) & RB_MSK) | ((((color & G_MSK) * level) >> 8) & G_MSK);
+}
+
+/**
+ * @brief Mix of two colors
+ *
+ * @param color First color
+ * @param color2 Second color
+ * @param mix 0 (first color) to FULL_LEVEL (second color)
+ * @return neopixel_color_t Mixed color
+ */
+static inline neopixel_color_t ColorMix(neopixel_color_t color, neopixel_color_t color2, uint32_t mix){
+	uint32_t rb = ((color & RB_MSK) * (FULL_LEVEL - mix) + (color2 & RB_MSK) * mix) >> 8;
+	uint32_t g = ((color & G_MSK) * (FULL_LEVEL - mix) + (color2 & G_MSK) * mix) >> 8;
+	return (rb & RB_MSK) | (g & G_MSK);
+}
+
+/**
+ * @brief Triangle wave of the phase: 0 at the start of the cycle, FULL_LEVEL at the middle
+ *
+ * @param phase Position in the cycle (fraction of 2^32)
+ * @return uint32_t 0 to FULL_LEVEL
+ */
+static inline uint32_t Triangle(uint32_t phase){
+	uint32_t half = phase >> 23;		/* 0 to 511 */
+	return (half < FULL_LEVEL) ? half : 2 * FULL_LEVEL - half;
+}
+
+/**
+ * @brief Render an effect over the frame
+ *
+ * @param slot Effect
+ */
+static void EffectRender(anim_slot_t *slot){
+	neopixel_effect_t *effect = &slot->effect;
+	neopixel_color_t *colors = &anim_colors[effect->first];
+	uint16_t length = effect->length;
+	uint32_t level;
+	uint16_t pos, i;
+	neopixel_color_t color;
+
+	switch (effect->type){
+	case NEOPIXEL_EFFECT_RAINBOW:
+		/* Gradient start moves instead of the colors */
+		NeoPixelHSVGradient(colors, length, effect->reverse ? (slot->phase >> 16) : -(slot->phase >> 16),
+			slot->hue_step, effect->sat, effect->val);
+		break;
+	case NEOPIXEL_EFFECT_CHASE:
+		/* Head position, tail behind it (wraps around the range) */
+		pos = ((uint64_t)slot->phase * length) >> 32;
+		if (effect->reverse){
+			pos = length - 1 - pos;
+		}
+		for (i = 0; (i < effect->size) && (i < length); i++){
+			colors[pos] = effect->color;
+			if (effect->reverse){
+				pos = (pos == length - 1) ? 0 : pos + 1;
+			}
+			else{
+				pos = (pos == 0) ? length - 1 : pos - 1;
+			}
+		}
+		break;
+	case NEOPIXEL_EFFECT_FADE:
+		color = ColorMix(effect->color, effect->color2, Triangle(slot->phase));
+		for (i = 0; i < length; i++){
+			colors[i] = color;
+		}
+		break;
+	case NEOPIXEL_EFFECT_BREATHE:
+		/* Quadratic rise and fall looks smoother than a linear one */
+		level = Triangle(slot->phase);
+		level = (level * level) >> 8;
+		level = effect->val + (((FULL_LEVEL - effect->val) * level) >> 8);
+		for (i = 0; i < length; i++){
+			colors[i] = ColorScale(colors[i], level);
+		}
+		break;
+	}
+}
+
+/**
+ * @brief Render a frame
+ *
+ * @param frames Frames elapsed since the previous one
+ */
+static void FrameRender(uint32_t frames){
+	for (uint16_t i = 0; i < anim_length; i++){
+		anim_colors[i] = 0;
+	}
+	for (uint8_t i = 0; i < NEOPIXEL_ANIM_MAX_EFFECTS; i++){
+		if (anim_slots[i].used){
+			anim_slots[i].phase += anim_slots[i].step * frames;
+			EffectRender(&anim_slots[i]);
+		}
+	}
+}
+
+/**
+ * @brief Frame rate timer callback
+ */
+static void FrameTick(void *param){
+	/* Timer driver yields on return */
+	vTaskNotifyGiveFromISR(anim_task, NULL);
+}
+
+/**
+ * @brief Animation task: renders and sends a frame on each timer tick
+ */
+static void AnimTask(void *param){
+	uint32_t ticks, start, end, used;
+
+	while (true){
+		ticks = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		start = TimerRead(anim_timer);
+		xSemaphoreTake(anim_mutex, portMAX_DELAY);
+		FrameRender(ticks);
+		xSemaphoreGive(anim_mutex);
+		NeoPixelSetArray(anim_colors);
+		end = TimerRead(anim_timer);
+		/* Timer count restarts on each tick */
+		used = (end >= start) ? end - start : end + anim_stats.budget - start;
+
+		xSemaphoreTake(anim_mutex, portMAX_DELAY);
+		anim_stats.frames++;
+		anim_stats.missed += ticks - 1;
+		anim_stats.last = used;
+		anim_stats.load = (used >= 2 * anim_stats.budget) ? 200 : (used * 100) / anim_stats.budget;
+		if (used > anim_stats.max){
+			anim_stats.max = used;
+		}
+		if (start > anim_stats.latency){
+			anim_stats.latency = start;
+		}
+		anim_total_us += used;
+		anim_total_frames++;
+		anim_stats.average = anim_total_us / anim_total_frames;
+		xSemaphoreGive(anim_mutex);
+
+		if (anim_frame_p != NULL){
+			anim_frame_p(anim_frame_param);
+		}
+	}
+}
+
+/*==================[external functions definition]==========================*/
+bool NeoPixelAnimInit(const neopixel_anim_config_t *config){
+	timer_config_t timer = {
+		.timer = config->timer,
+		.func_p = FrameTick,
+		.param_p = NULL
+	};
+
+	if ((anim_task != NULL) || (config->fps == 0) || (config->fps > MS_PER_SEC) ||
+		(config->len == 0) || (config->color_array == NULL)){
+		return false;
+	}
+	NeoPixelInit(config->pin, config->len, config->color_array);
+	anim_colors = config->color_array;
+	anim_length = (config->len > WS2812B_MAX_LEDS) ? WS2812B_MAX_LEDS : config->len;
+	anim_fps = config->fps;
+	anim_timer = config->timer;
+	anim_frame_p = config->func_p;
+	anim_frame_param = config->param_p;
+	for (uint8_t i = 0; i < NEOPIXEL_ANIM_MAX_EFFECTS; i++){
+		anim_slots[i].used = false;
+	}
+	anim_stats = (neopixel_anim_stats_t){0};
+	anim_stats.budget = US_PER_SEC / anim_fps;
+	anim_total_us = 0;
+	anim_total_frames = 0;
+
+	anim_mutex = xSemaphoreCreateMutexStatic(&anim_mutex_buffer);
+	anim_task = xTaskCreateStatic(AnimTask, "neopixel_anim", ANIM_STACK_SIZE, NULL, config->priority,
+		anim_stack, &anim_task_buffer);
+	timer.period = anim_stats.budget;
+	TimerInit(&timer);
+	return true;
+}
+
+int8_t NeoPixelAnimAdd(const neopixel_effect_t *effect){
+	anim_slot_t *slot;
+	uint16_t length = effect->length;
+	int8_t id = -1;
+
+	if ((anim_task == NULL) || (effect->first >= anim_length)){
+		return -1;
+	}
+	if ((length == 0) || (length > anim_length - effect->first)){
+		length = anim_length - effect->first;
+	}
+	xSemaphoreTake(anim_mutex, portMAX_DELAY);
+	for (uint8_t i = 0; i < NEOPIXEL_ANIM_MAX_EFFECTS; i++){
+		if (!anim_slots[i].used){
+			id = i;
+			break;
+		}
+	}
+	if (id >= 0){
+		slot = &anim_slots[id];
+		slot->effect = *effect;
+		slot->effect.length = length;
+		slot->phase = 0;
+		/* Cycles of period ms: 2^32 phase increments in period * fps / 1000 frames */
+		slot->step = 0;
+		if (effect->period != 0){
+			slot->step = (((uint64_t)1 << 32) * MS_PER_SEC) / ((uint32_t)effect->period * anim_fps);
+		}
+		slot->hue_step = ((((uint64_t)effect->size) << 32) + length / 2) / length;
+		slot->used = true;
+	}
+	xSemaphoreGive(anim_mutex);
+	return id;
+}
+
+void NeoPixelAnimRemove(int8_t effect){
+	if ((anim_task == NULL) || (effect < 0) || (effect >= NEOPIXEL_ANIM_MAX_EFFECTS)){
+		return;
+	}
+	xSemaphoreTake(anim_mutex, portMAX_DELAY);
+	anim_slots[effect].used = false;
+	xSemaphoreGive(anim_mutex);
+}
+
+void NeoPixelAnimClear(void){
+	for (int8_t i = 0; i < NEOPIXEL_ANIM_MAX_EFFECTS; i++){
+		NeoPixelAnimRemove(i);
+	}
+}
+
+void NeoPixelAnimStart(void){
+	if (anim_task != NULL){
+		TimerStart(anim_timer);
+	}
+}
+
+void NeoPixelAnimStop(void){
+	if (anim_task != NULL){
+		TimerStop(anim_timer);
+	}
+}
+
+void NeoPixelAnimGetStats(neopixel_anim_stats_t *stats, bool reset){
+	if (anim_task == NULL){
+		*stats = (neopixel_anim_stats_t){0};
+		return;
+	}
+	xSemaphoreTake(anim_mutex, portMAX_DELAY);
+	*stats = anim_stats;
+	if (reset){
+		anim_stats.max = 0;
+		anim_stats.latency = 0;
+		anim_total_us = 0;
+		anim_total_frames = 0;
+	}
+	xSemaphoreGive(anim_mutex);
+}
+
+/*==================[end of file]============================================*/
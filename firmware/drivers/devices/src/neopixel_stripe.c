@@ -21,10 +21,15 @@
 #define BLUE_OFFSET     0
 #define MAX_BRIGHT  	255
 #define BRIGHT_OFFSET   8
+#define LED_BYTES		3		/*!< Bytes per led in the wire buffer (GRB) */
 /*==================[internal data declaration]==============================*/
 uint16_t stripe_length;
 uint8_t stripe_bright = MAX_BRIGHT;
 neopixel_color_t *stripe_colors; 
+static uint8_t stripe_levels[256];							/*!< Level sent for each color level: gamma(level * bright) */
+static uint8_t stripe_wire[LED_BYTES * WS2812B_MAX_LEDS];	/*!< Colors as sent to the stripe (GRB) */
+static bool stripe_changed;									/*!< stripe_wire changed since last frame */
+static uint16_t stripe_base;								/*!< Color shown in the first NeoPixel (rotated by NeoPixelShift) */
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
@@ -32,89 +37,194 @@ neopixel_color_t *stripe_colors;
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Rebuild the color level table (gamma correction of the level scaled by the brightness)
+ */
+static void NeoPixelLevels(void){
+	for (uint16_t i = 0; i < 256; i++){
+		stripe_levels[i] = ws2812bGammaCorrection((i * stripe_bright) >> BRIGHT_OFFSET);
+	}
+}
+
+/**
+ * @brief Encode a NeoPixel color in the wire buffer (only written if it changed)
+ * 
+ * @param pixel NeoPixel number on the stripe
+ * @param color 24 bits color
+ */
+static inline void NeoPixelEncode(uint16_t pixel, neopixel_color_t color){
+	uint8_t *wire = &stripe_wire[LED_BYTES * pixel];
+	uint8_t green = stripe_levels[(color & GREEN_MSK) >> GREEN_OFFSET];
+	uint8_t red = stripe_levels[(color & RED_MSK) >> RED_OFFSET];
+	uint8_t blue = stripe_levels[(color & BLUE_MSK) >> BLUE_OFFSET];
+	if ((wire[0] != green) || (wire[1] != red) || (wire[2] != blue)){
+		wire[0] = green;
+		wire[1] = red;
+		wire[2] = blue;
+		stripe_changed = true;
+	}
+}
+
+/**
+ * @brief Color of a hue (in 1/255 steps from red, 0 to 1529), with saturation and value factors
+ * 
+ * @param hue Hue (0 to 1529)
+ * @param s1 1 + sat
+ * @param s2 255 - sat
+ * @param v1 1 + val
+ * @return neopixel_color_t 24 bits color
+ */
+static inline neopixel_color_t NeoPixelHue(uint16_t hue, uint16_t s1, uint8_t s2, uint32_t v1){
+  uint8_t r, g, b;
+
+  // Convert hue to R,G,B (nested ifs faster than divide+mod+switch):
+  if (hue < 510) { // Red to Green-1
+    b = 0;
+    if (hue < 255) { //   Red to Yellow-1
+      r = 255;
+      g = hue;       //     g = 0 to 254
+    } else {         //   Yellow to Green-1
+      r = 510 - hue; //     r = 255 to 1
+      g = 255;
+    }
+  } else if (hue < 1020) { // Green to Blue-1
+    r = 0;
+    if (hue < 765) { //   Green to Cyan-1
+      g = 255;
+      b = hue - 510;  //     b = 0 to 254
+    } else {          //   Cyan to Blue-1
+      g = 1020 - hue; //     g = 255 to 1
+      b = 255;
+    }
+  } else if (hue < 1530) { // Blue to Red-1
+    g = 0;
+    if (hue < 1275) { //   Blue to Magenta-1
+      r = hue - 1020; //     r = 0 to 254
+      b = 255;
+    } else { //   Magenta to Red-1
+      r = 255;
+      b = 1530 - hue; //     b = 255 to 1
+    }
+  } else { // Last 0.5 Red (quicker than % operator)
+    r = 255;
+    g = b = 0;
+  }
+
+  // Apply saturation and value to R,G,B, pack into 32-bit result:
+  return ((((((r * s1) >> 8) + s2) * v1) & 0xff00) << 8) |
+         (((((g * s1) >> 8) + s2) * v1) & 0xff00) |
+         (((((b * s1) >> 8) + s2) * v1) >> 8);
+}
+
+/**
+ * @brief Send the wire buffer to the stripe, unless nothing changed since last frame
+ */
+static void NeoPixelUpdate(void){
+	if (stripe_changed){
+		stripe_changed = false;
+		ws2812bSendFrame(stripe_wire, stripe_length);
+	}
+}
 
 /*==================[external functions definition]==========================*/
 
 void NeoPixelInit(gpio_t pin, uint16_t len, neopixel_color_t *color_array){
     stripe_length = len;
+	if (stripe_length > WS2812B_MAX_LEDS){
+		stripe_length = WS2812B_MAX_LEDS;
+	}
 	stripe_colors = color_array;
+	stripe_base = 0;
+	NeoPixelLevels();
+	/* Leds state is unknown: first frame is always sent */
+	for (uint16_t i = 0; i < LED_BYTES * stripe_length; i++){
+		stripe_wire[i] = 0;
+	}
+	stripe_changed = true;
     ws2812bInit(pin);
 }
 
 void NeoPixelAllOff(void){
-    rgb_led_t led;
-	ws2812bSendRet();
-	ws2812bSendRet();
-	ws2812bSendRet();
 	for (uint16_t i = 0; i < stripe_length; i++){
-		led.red = 0;
-		led.green = 0;
-		led.blue = 0;
-		ws2812bSend(led);
+		NeoPixelEncode(i, 0);
 	}
-	ws2812bSendRet();
+	NeoPixelUpdate();
 }
 
 void NeoPixelAllColor(neopixel_color_t color){
 	for (uint16_t i = 0; i < stripe_length; i++){
 		stripe_colors[i] = color;
 	}
+	stripe_base = 0;
 	NeoPixelSetArray(stripe_colors);
 }
 
 void NeoPixelSetPixel(uint16_t pixel, neopixel_color_t color){
-	stripe_colors[pixel] = color;
-	NeoPixelSetArray(stripe_colors);
+	if (pixel >= stripe_length){
+		return;
+	}
+	uint16_t index = stripe_base + pixel;
+	if (index >= stripe_length){
+		index -= stripe_length;
+	}
+	stripe_colors[index] = color;
+	NeoPixelEncode(pixel, color);
+	NeoPixelUpdate();
 }
 
 void NeoPixelSetArray(neopixel_color_t *color_array){
-    rgb_led_t led;
-	uint16_t red, green, blue;
-	ws2812bSendRet();
-	ws2812bSendRet();
-	ws2812bSendRet();
-	for (uint16_t i = 0; i < stripe_length; i++){
-		red = ((color_array[i] & RED_MSK) >> RED_OFFSET) * stripe_bright;
-		green = ((color_array[i] & GREEN_MSK) >> GREEN_OFFSET) * stripe_bright;
-		blue = ((color_array[i] & BLUE_MSK) >> BLUE_OFFSET) * stripe_bright;
-		led.red = red >> BRIGHT_OFFSET;
-		led.green = green >> BRIGHT_OFFSET;
-		led.blue = blue >> BRIGHT_OFFSET;
-		ws2812bSend(led);
+	uint16_t length = stripe_length;
+	uint16_t wrap = length - stripe_base;
+	neopixel_color_t *color = &color_array[stripe_base];
+	/* Array from stripe_base to its end, then from its start */
+	for (uint16_t i = 0; i < length; i++){
+		if (i == wrap){
+			color = color_array;
+		}
+		NeoPixelEncode(i, *color++);
 	}
-	ws2812bSendRet();
+	NeoPixelUpdate();
 }
 
-void NeoPixelShift(bool upwards){
-	neopixel_color_t carry;
+void NeoPixelSetCallback(void *func_p, void *param_p){
+	ws2812bSetCallback(func_p, param_p);
+}
 
+void NeoPixelWait(void){
+	ws2812bWait();
+}
+
+void NeoPixelShift(bool upwards){
+	if (stripe_length == 0){
+		return;
+	}
+	/* Colors aren't moved in the array: the color shown in the first NeoPixel is */
 	if(upwards){
-		carry = stripe_colors[stripe_length-1];
-		for (uint16_t i = 0; i < stripe_length-1; i++){
-			stripe_colors[stripe_length-1-i] = stripe_colors[stripe_length-2-i]; 
-		}
-		stripe_colors[0] = carry;
+		stripe_base = (stripe_base == 0) ? stripe_length - 1 : stripe_base - 1;
 	}else{
-		carry = stripe_colors[0];
-		for (uint16_t i = 0; i < stripe_length-1; i++){
-			stripe_colors[i] = stripe_colors[i+1]; 
-		}
-		stripe_colors[stripe_length-1] = carry;
+		stripe_base = (stripe_base == stripe_length - 1) ? 0 : stripe_base + 1;
 	}
 	NeoPixelSetArray(stripe_colors);
 }
 
 void NeoPixelBrightness(uint8_t bright){
+	if (bright == stripe_bright){
+		return;
+	}
 	stripe_bright = bright;
+	NeoPixelLevels();
 	NeoPixelSetArray(stripe_colors);
 }
 
 void NeoPixelRainbow(uint16_t first_hue, uint8_t sat, uint8_t val, uint8_t reps){
-	for (uint16_t i=0; i<stripe_length; i++) {
-		uint16_t hue = first_hue + (i * reps * 65536) / stripe_length;
-		neopixel_color_t color = NeoPixelHSV2Color(hue, sat, val);
-		stripe_colors[i] = color;
-  	}
+	uint32_t hue_step = 0;
+	if (stripe_length == 0){
+		return;
+	}
+	/* 16.16 hue increment: wraps around with the 16 bits hue */
+	hue_step = (((uint64_t)reps << 32) + stripe_length / 2) / stripe_length;
+	NeoPixelHSVGradient(stripe_colors, stripe_length, first_hue, hue_step, sat, val);
+	stripe_base = 0;
 	NeoPixelSetArray(stripe_colors);
 }
 
@@ -123,50 +233,20 @@ neopixel_color_t NeoPixelRgb2Color(uint8_t red, uint8_t green, uint8_t blue){
 }
 
 neopixel_color_t NeoPixelHSV2Color(uint16_t hue, uint8_t sat, uint8_t val){
+  return NeoPixelHue((hue * 1530L + 32768) / 65536, 1 + sat, 255 - sat, 1 + val);
+}
 
-  uint8_t r, g, b;
-
-  hue = (hue * 1530L + 32768) / 65536;
-  // Convert hue to R,G,B (nested ifs faster than divide+mod+switch):
-  if (hue < 510) { // Red to Green-1
-    b = 0;
-    if (hue < 255) { //   Red to Yellow-1
-      r = 255;
-      g = hue;       //     g = 0 to 254
-    } else {         //   Yellow to Green-1
-      r = 510 - hue; //     r = 255 to 1
-      g = 255;
-    }
-  } else if (hue < 1020) { // Green to Blue-1
-    r = 0;
-    if (hue < 765) { //   Green to Cyan-1
-      g = 255;
-      b = hue - 510;  //     b = 0 to 254
-    } else {          //   Cyan to Blue-1
-      g = 1020 - hue; //     g = 255 to 1
-      b = 255;
-    }
-  } else if (hue < 1530) { // Blue to Red-1
-    g = 0;
-    if (hue < 1275) { //   Blue to Magenta-1
-      r = hue - 1020; //     r = 0 to 254
-      b = 255;
-    } else { //   Magenta to Red-1
-      r = 255;
-      b = 1530 - hue; //     b = 255 to 1
-    }
-  } else { // Last 0.5 Red (quicker than % operator)
-    r = 255;
-    g = b = 0;
-  }
-
-  // Apply saturation and value to R,G,B, pack into 32-bit result:
+void NeoPixelHSVGradient(neopixel_color_t *colors, uint16_t len, uint16_t first_hue, uint32_t hue_step, uint8_t sat, uint8_t val){
+  // Saturation and value factors are computed once for all the colors
   uint32_t v1 = 1 + val;  // 1 to 256; allows >>8 instead of /255
   uint16_t s1 = 1 + sat;  // 1 to 256; same reason
   uint8_t s2 = 255 - sat; // 255 to 0
-  return ((((((r * s1) >> 8) + s2) * v1) & 0xff00) << 8) |
-         (((((g * s1) >> 8) + s2) * v1) & 0xff00) |
-         (((((b * s1) >> 8) + s2) * v1) >> 8);
+  uint32_t hue = (uint32_t)first_hue << 16;
+
+  for (uint16_t i = 0; i < len; i++) {
+    colors[i] = NeoPixelHue(((hue >> 16) * 1530 + 32768) >> 16, s1, s2, v1);
+    hue += hue_step;
+  }
 }
 
 /*==================[end of file]============================================*/
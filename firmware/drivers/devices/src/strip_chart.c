@@ -0,0 +1,319 @@
+/**
+ * @file strip_chart.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stddef.h>
+#include "strip_chart.h"
+/*==================[macros and definitions]=================================*/
+#define MIN_SPAN	2			/*!< Min. range of autoscale */
+#define MARGIN_DIV	8			/*!< Autoscale leaves span / MARGIN_DIV above and below the signals */
+#define SHRINK_DIV	4			/*!< Range shrinks when signals use less than 1 / SHRINK_DIV of it */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static strip_chart_t *scroll_owner = NULL;		/*!< Chart using the LCD hardware scrolling */
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief  		Row of a value (0: top row)
+ * @param[in]  	chart: Strip chart instance
+ * @param[in]  	value: Signal value
+ * @retval 		Row (clipped to the chart)
+ */
+static int16_t ValueRow(strip_chart_t *chart, int16_t value){
+	int32_t span = (int32_t)chart->max - chart->min;
+	int32_t row;
+	row = (((int32_t)value - chart->min) * (chart->config.height - 1) + span / 2) / span;
+	if (row < 0){
+		row = 0;
+	}
+	if (row > chart->config.height - 1){
+		row = chart->config.height - 1;
+	}
+	return chart->config.height - 1 - row;
+}
+
+/**
+ * @brief  		Renders a chart column into the pixel buffer
+ * @param[in]  	chart: Strip chart instance
+ * @param[in]  	column: Chart column
+ * @param[in]  	offset: First pixel in the buffer
+ * @param[in]  	stride: Pixels between consecutive rows in the buffer (columns written at once)
+ * @retval 		None
+ */
+static void RenderColumn(strip_chart_t *chart, uint16_t column, uint16_t offset, uint8_t stride){
+	strip_chart_config_t *config = &chart->config;
+	uint16_t width = config->width;
+	uint32_t time = column;
+	uint16_t color, row, grid_row = 0;
+	int16_t top, bottom;
+	uint8_t *px;
+
+	if (chart->scroll){
+		/* Vertical grid lines move with the signals: column number since last clear (plus a multiple of width) */
+		time = chart->columns + width - 1 - (chart->head + width - 1 - column) % width;
+	}
+	color = config->background;
+	if ((config->grid_x != 0) && ((time % config->grid_x) == 0)){
+		color = config->grid_color;
+	}
+	px = &chart->pixels[2 * offset];
+	for (row = 0; row < config->height; row++){
+		if ((config->grid_y != 0) && (grid_row == 0)){
+			px[0] = config->grid_color >> 8;
+			px[1] = config->grid_color & 0xFF;
+		}
+		else{
+			px[0] = color >> 8;
+			px[1] = color & 0xFF;
+		}
+		if (++grid_row == config->grid_y){
+			grid_row = 0;
+		}
+		px += 2 * stride;
+	}
+	for (uint8_t k = 0; k < config->n_traces; k++){
+		if (chart->low[k][column] > chart->high[k][column]){
+			continue;
+		}
+		top = ValueRow(chart, chart->high[k][column]);
+		bottom = ValueRow(chart, chart->low[k][column]);
+		px = &chart->pixels[2 * (offset + top * stride)];
+		for (row = top; row <= bottom; row++){
+			px[0] = config->color[k] >> 8;
+			px[1] = config->color[k] & 0xFF;
+			px += 2 * stride;
+		}
+	}
+}
+
+/**
+ * @brief  		Makes the newest column the last one displayed (scroll mode)
+ * @param[in]  	chart: Strip chart instance
+ * @retval 		None
+ */
+static void ScrollToHead(strip_chart_t *chart){
+	uint16_t width = chart->config.width;
+	if (ILI9341GetOrientation() == ILI9341_Landscape_1){
+		/* Frame memory lines grow from left to right */
+		ILI9341ScrollStart(chart->config.x + chart->head);
+	}
+	else{
+		/* Frame memory lines grow from right to left */
+		ILI9341ScrollStart(ILI9341_HEIGHT - chart->config.x - width + (width - chart->head) % width);
+	}
+}
+
+/**
+ * @brief  		Redraws all the chart columns
+ * @param[in]  	chart: Strip chart instance
+ * @retval 		None
+ */
+static void Redraw(strip_chart_t *chart){
+	for (uint16_t i = 0; i < chart->config.width; i++){
+		RenderColumn(chart, i, 0, 1);
+		ILI9341DrawPicture(chart->config.x + i, chart->config.y, 1, chart->config.height, chart->pixels);
+	}
+	if (chart->scroll){
+		ScrollToHead(chart);
+	}
+}
+
+/**
+ * @brief  		Fits the range to the stored columns
+ * @param[in]  	chart: Strip chart instance
+ * @param[in]  	shrink: Only change the range if the signals use less than 1 / SHRINK_DIV of it
+ * @retval 		true if the range changed
+ */
+static bool Autoscale(strip_chart_t *chart, bool shrink){
+	int32_t low = INT16_MAX, high = INT16_MIN, margin, span;
+	for (uint8_t k = 0; k < chart->config.n_traces; k++){
+		for (uint16_t i = 0; i < chart->config.width; i++){
+			if (chart->low[k][i] > chart->high[k][i]){
+				continue;
+			}
+			if (chart->low[k][i] < low){
+				low = chart->low[k][i];
+			}
+			if (chart->high[k][i] > high){
+				high = chart->high[k][i];
+			}
+		}
+	}
+	if (low > high){
+		return false;
+	}
+	span = (int32_t)chart->max - chart->min;
+	if (shrink && (SHRINK_DIV * (high - low) >= span)){
+		return false;
+	}
+	margin = (high - low) / MARGIN_DIV;
+	if (high - low + 2 * margin < MIN_SPAN){
+		margin = MIN_SPAN;
+	}
+	/* Growing signals: range is at least doubled, so the plot isn't redrawn on every new peak */
+	if (!shrink && (high - low + 2 * margin < 2 * span)){
+		margin = (2 * span - (high - low)) / 2;
+	}
+	low -= margin;
+	high += margin;
+	chart->min = (low < INT16_MIN) ? INT16_MIN : low;
+	chart->max = (high > INT16_MAX) ? INT16_MAX : high;
+	return true;
+}
+
+/**
+ * @brief  		Stores and draws the column just completed
+ * @param[in]  	chart: Strip chart instance
+ * @retval 		None
+ */
+static void ColumnDone(strip_chart_t *chart){
+	strip_chart_config_t *config = &chart->config;
+	uint16_t column = chart->head;
+	bool out = false;
+
+	for (uint8_t k = 0; k < config->n_traces; k++){
+		chart->low[k][column] = chart->col_low[k];
+		chart->high[k][column] = chart->col_high[k];
+		if ((chart->col_low[k] < chart->min) || (chart->col_high[k] > chart->max)){
+			out = true;
+		}
+	}
+	chart->columns++;
+	chart->head = (column + 1) % config->width;
+	if (config->autoscale && (out || (chart->head == 0))){
+		if (Autoscale(chart, !out)){
+			Redraw(chart);
+			return;
+		}
+	}
+	if (chart->scroll){
+		RenderColumn(chart, column, 0, 1);
+		ILI9341DrawPicture(config->x + column, config->y, 1, config->height, chart->pixels);
+		ScrollToHead(chart);
+	}
+	else if (chart->head != 0){
+		/* Newest column and a blank one ahead, in a single window */
+		for (uint8_t k = 0; k < config->n_traces; k++){
+			chart->low[k][chart->head] = 1;
+			chart->high[k][chart->head] = 0;
+		}
+		RenderColumn(chart, column, 0, 2);
+		RenderColumn(chart, chart->head, 1, 2);
+		ILI9341DrawPicture(config->x + column, config->y, 2, config->height, chart->pixels);
+	}
+	else{
+		RenderColumn(chart, column, 0, 1);
+		ILI9341DrawPicture(config->x + column, config->y, 1, config->height, chart->pixels);
+	}
+}
+
+/*==================[external functions definition]==========================*/
+bool StripChartInit(strip_chart_t *chart, const strip_chart_config_t *config){
+	ili9341_orientation_t orientation = ILI9341GetOrientation();
+	bool landscape = (orientation == ILI9341_Landscape_1) || (orientation == ILI9341_Landscape_2);
+	uint16_t lcd_width = landscape ? ILI9341_HEIGHT : ILI9341_WIDTH;
+	uint16_t lcd_height = landscape ? ILI9341_WIDTH : ILI9341_HEIGHT;
+
+	/* Scrolling is decided again for the new configuration */
+	if (scroll_owner == chart){
+		ILI9341ScrollDisable();
+		scroll_owner = NULL;
+	}
+	chart->scroll = false;
+	if ((config->n_traces == 0) || (config->n_traces > STRIP_CHART_MAX_TRACES) ||
+		(config->width < 2) || (config->height == 0) ||
+		(config->x + config->width > lcd_width) || (config->y + config->height > lcd_height) ||
+		(config->sample_frec == 0) || (config->column_frec == 0) ||
+		(!config->autoscale && (config->min >= config->max))){
+		return false;
+	}
+	chart->config = *config;
+	chart->decimation = (config->sample_frec + config->column_frec - 1) / config->column_frec;
+	chart->min = config->min;
+	chart->max = config->max;
+	if (chart->min >= chart->max){
+		chart->min = 0;
+		chart->max = MIN_SPAN;
+	}
+	/* Hardware scrolling moves whole LCD columns in landscape modes */
+	if (landscape && (config->y == 0) && (config->height == lcd_height) && (scroll_owner == NULL)){
+		chart->scroll = true;
+		scroll_owner = chart;
+		if (orientation == ILI9341_Landscape_1){
+			ILI9341ScrollArea(config->x, config->width);
+		}
+		else{
+			ILI9341ScrollArea(ILI9341_HEIGHT - config->x - config->width, config->width);
+		}
+	}
+	StripChartClear(chart);
+	return true;
+}
+
+void StripChartAddSample(strip_chart_t *chart, const int16_t *values){
+	for (uint8_t k = 0; k < chart->config.n_traces; k++){
+		if (chart->count == 0){
+			/* Columns start at the previous sample, so consecutive columns are connected */
+			if (chart->columns == 0){
+				chart->last[k] = values[k];
+			}
+			chart->col_low[k] = chart->last[k];
+			chart->col_high[k] = chart->last[k];
+		}
+		if (values[k] < chart->col_low[k]){
+			chart->col_low[k] = values[k];
+		}
+		if (values[k] > chart->col_high[k]){
+			chart->col_high[k] = values[k];
+		}
+		chart->last[k] = values[k];
+	}
+	if (++chart->count == chart->decimation){
+		chart->count = 0;
+		ColumnDone(chart);
+	}
+}
+
+void StripChartClear(strip_chart_t *chart){
+	for (uint8_t k = 0; k < STRIP_CHART_MAX_TRACES; k++){
+		for (uint16_t i = 0; i < ILI9341_HEIGHT; i++){
+			chart->low[k][i] = 1;
+			chart->high[k][i] = 0;
+		}
+	}
+	chart->columns = 0;
+	chart->head = 0;
+	chart->count = 0;
+	if (chart->config.autoscale){
+		chart->min = chart->config.min;
+		chart->max = chart->config.max;
+		if (chart->min >= chart->max){
+			chart->min = 0;
+			chart->max = MIN_SPAN;
+		}
+	}
+	Redraw(chart);
+}
+
+void StripChartDeinit(strip_chart_t *chart){
+	if (chart->scroll){
+		ILI9341ScrollDisable();
+		scroll_owner = NULL;
+		chart->scroll = false;
+	}
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,404 @@
+#!/usr/bin/env python3
+"""
+@file img2ili9341.py
+@author Albano Peñalva (albano.penalva@uner.edu.ar)
+@brief Converts images to the compressed format of ILI9341DrawImage() (see ili9341.h)
+@version 0.1
+@date 2026-10-17
+
+@copyright Copyright (c) 2026
+
+Inputs:
+  - PNG (8 bits/channel, not interlaced) and BMP (8, 24 or 32 bits/pixel, uncompressed)
+  - Other formats if Pillow is installed
+  - RGB565 C arrays (2 bytes/pixel, high byte first, as used by ILI9341DrawPicture),
+    with --size WxH
+
+Formats:
+  - rle16: RGB565 colors, lossless
+  - rle8:  up to 256 colors palette
+  - rle4:  up to 16 colors palette
+  - auto:  smallest lossless format (default)
+Palette formats reduce the number of colors (median cut) if needed.
+
+Usage:
+  python img2ili9341.py logo.png -n logo -o logo.c
+  python img2ili9341.py esp_edu_pic.c --size 240x320 -f rle8 -n esp_edu_pic -o esp_edu_pic.c
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+RUN_FLAG = 0x80         # Header bit of a run packet
+MAX_COUNT = 128         # Max. pixels of a packet
+FORMATS = {'rle16': 'ILI9341_IMAGE_RLE16', 'rle8': 'ILI9341_IMAGE_RLE8', 'rle4': 'ILI9341_IMAGE_RLE4'}
+MIN_RUN = {'rle16': 2, 'rle8': 3, 'rle4': 3}     # Shorter runs are cheaper as literals
+
+
+# ==================[image readers]==================
+
+def rgb565(r, g, b):
+    return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+
+
+def blend(r, g, b, a, background):
+    """Composite a RGBA pixel over a RGB background."""
+    br, bg, bb = background
+    return ((r * a + br * (255 - a)) // 255, (g * a + bg * (255 - a)) // 255, (b * a + bb * (255 - a)) // 255)
+
+
+def read_png(path, background):
+    with open(path, 'rb') as f:
+        raw = f.read()
+    if raw[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError('not a PNG file')
+    pos, idat, plte, trns = 8, b'', None, None
+    while pos < len(raw):
+        length, kind = struct.unpack('>I4s', raw[pos:pos + 8])
+        chunk = raw[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b'IHDR':
+            width, height, depth, color, _, _, interlace = struct.unpack('>IIBBBBB', chunk)
+        elif kind == b'PLTE':
+            plte = chunk
+        elif kind == b'tRNS':
+            trns = chunk
+        elif kind == b'IDAT':
+            idat += chunk
+    if depth != 8 or interlace:
+        raise ValueError('only 8 bits/channel, non interlaced PNG are supported (install Pillow for others)')
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+    stride = width * channels
+    data = zlib.decompress(idat)
+    prev = bytearray(stride)
+    pixels = []
+    for y in range(height):
+        line = data[y * (stride + 1):(y + 1) * (stride + 1)]
+        kind, cur = line[0], bytearray(line[1:])
+        for i in range(stride):
+            left = cur[i - channels] if i >= channels else 0
+            up = prev[i]
+            up_left = prev[i - channels] if i >= channels else 0
+            if kind == 1:
+                cur[i] = (cur[i] + left) & 0xFF
+            elif kind == 2:
+                cur[i] = (cur[i] + up) & 0xFF
+            elif kind == 3:
+                cur[i] = (cur[i] + ((left + up) >> 1)) & 0xFF
+            elif kind == 4:
+                p = left + up - up_left
+                pa, pb, pc = abs(p - left), abs(p - up), abs(p - up_left)
+                pred = left if pa <= pb and pa <= pc else (up if pb <= pc else up_left)
+                cur[i] = (cur[i] + pred) & 0xFF
+        for x in range(width):
+            px = cur[x * channels:(x + 1) * channels]
+            if color == 0:
+                rgb = (px[0], px[0], px[0])
+            elif color == 2:
+                rgb = tuple(px)
+            elif color == 3:
+                rgb = tuple(plte[px[0] * 3:px[0] * 3 + 3])
+                if trns is not None and px[0] < len(trns):
+                    rgb = blend(*rgb, trns[px[0]], background)
+            elif color == 4:
+                rgb = blend(px[0], px[0], px[0], px[1], background)
+            else:
+                rgb = blend(*px, background)
+            pixels.append(rgb565(*rgb))
+        prev = cur
+    return width, height, pixels
+
+
+def read_bmp(path):
+    with open(path, 'rb') as f:
+        raw = f.read()
+    if raw[:2] != b'BM':
+        raise ValueError('not a BMP file')
+    offset = struct.unpack('<I', raw[10:14])[0]
+    header_size, width, height, _, bpp, compression = struct.unpack('<IiiHHI', raw[14:34])
+    if compression not in (0, 3) or bpp not in (8, 24, 32):
+        raise ValueError('only uncompressed 8, 24 or 32 bits/pixel BMP are supported')
+    palette = raw[14 + header_size:offset]
+    bottom_up = height > 0
+    height = abs(height)
+    stride = (width * bpp // 8 + 3) & ~3
+    pixels = [0] * (width * height)
+    for row in range(height):
+        line = raw[offset + row * stride:offset + (row + 1) * stride]
+        y = height - 1 - row if bottom_up else row
+        for x in range(width):
+            # Alpha of 32 bits BMP is not used (most encoders leave it at 0)
+            if bpp == 8:
+                b, g, r = palette[line[x] * 4:line[x] * 4 + 3]
+            else:
+                b, g, r = line[x * bpp // 8:x * bpp // 8 + 3]
+            pixels[y * width + x] = rgb565(r, g, b)
+    return width, height, pixels
+
+
+def read_pillow(path, background):
+    try:
+        from PIL import Image
+    except ImportError:
+        raise ValueError('unsupported format (install Pillow to read it)')
+    img = Image.open(path).convert('RGBA')
+    pixels = [rgb565(*blend(r, g, b, a, background)) for r, g, b, a in img.getdata()]
+    return img.width, img.height, pixels
+
+
+def read_c_array(path, size):
+    if size is None:
+        raise ValueError('--size WxH is needed for C arrays')
+    width, height = (int(v) for v in size.lower().split('x'))
+    with open(path) as f:
+        text = f.read()
+    # Only the bytes between the first '{' and its '}'
+    body = text[text.index('{') + 1:text.index('}')]
+    data = [int(v, 16) for v in re.findall(r'0x([0-9a-fA-F]{1,2})\b', body)]
+    if len(data) != width * height * 2:
+        raise ValueError('array has %d bytes, %d expected' % (len(data), width * height * 2))
+    return width, height, [(data[i] << 8) | data[i + 1] for i in range(0, len(data), 2)]
+
+
+def read_image(path, size, background):
+    ext = os.path.splitext(path)[1].lower()
+    if ext in ('.c', '.h'):
+        return read_c_array(path, size)
+    if ext == '.png':
+        return read_png(path, background)
+    if ext == '.bmp':
+        return read_bmp(path)
+    return read_pillow(path, background)
+
+
+# ==================[palette]==================
+
+def unpack565(c):
+    return ((c >> 11) & 0x1F) << 3, ((c >> 5) & 0x3F) << 2, (c & 0x1F) << 3
+
+
+def median_cut(histogram, n_colors):
+    """Reduce a {rgb565: count} histogram to n_colors (weighted median cut).
+
+    Box averages are rounded to RGB565, so different boxes can get the same color: boxes
+    are split further until there are n_colors different colors (or none can be split)."""
+    boxes = [list(histogram.items())]
+
+    def split():
+        # Split the box with the largest (range * population) along its widest channel
+        best, best_score, best_channel = None, 0, 0
+        for i, box in enumerate(boxes):
+            if len(box) < 2:
+                continue
+            rgb = [unpack565(c) for c, _ in box]
+            population = sum(n for _, n in box)
+            for ch in range(3):
+                values = [p[ch] for p in rgb]
+                score = (max(values) - min(values)) * population
+                if score > best_score:
+                    best, best_score, best_channel = i, score, ch
+        if best is None:
+            return False
+        box = sorted(boxes.pop(best), key=lambda e: unpack565(e[0])[best_channel])
+        half, acc = sum(n for _, n in box) / 2, 0
+        for cut, (_, n) in enumerate(box):
+            acc += n
+            if acc >= half:
+                break
+        cut = min(max(cut, 0), len(box) - 2) + 1
+        boxes.extend((box[:cut], box[cut:]))
+        return True
+
+    def colors():
+        # {rgb565: population} of the box averages
+        result = {}
+        for box in boxes:
+            total = sum(n for _, n in box)
+            rgb = [sum(unpack565(c)[ch] * n for c, n in box) // total for ch in range(3)]
+            color = rgb565(*rgb)
+            result[color] = result.get(color, 0) + total
+        return result
+
+    while len(boxes) < n_colors and split():
+        pass
+    palette = colors()
+    while len(palette) < n_colors and split():
+        palette = colors()
+    # A last split can add two new colors: keep the most used ones
+    return sorted(palette, key=lambda c: -palette[c])[:n_colors]
+
+
+def nearest(color, palette):
+    r, g, b = unpack565(color)
+    def dist(p):
+        pr, pg, pb = unpack565(p)
+        return (r - pr) ** 2 + (g - pg) ** 2 + (b - pb) ** 2
+    return min(range(len(palette)), key=lambda i: dist(palette[i]))
+
+
+def to_palette(pixels, n_colors):
+    """Returns (palette, indexes). Exact if the image has n_colors or less."""
+    histogram = {}
+    for p in pixels:
+        histogram[p] = histogram.get(p, 0) + 1
+    if len(histogram) <= n_colors:
+        palette = sorted(histogram, key=lambda c: -histogram[c])
+    else:
+        # Colors nearest to no image color are dropped, and more boxes are cut to refill them
+        boxes = n_colors
+        while True:
+            cut = median_cut(histogram, boxes)
+            population = {}
+            for c, n in histogram.items():
+                i = nearest(c, cut)
+                population[i] = population.get(i, 0) + n
+            palette = [cut[i] for i in sorted(population, key=lambda i: -population[i])][:n_colors]
+            if len(palette) == n_colors or len(cut) < boxes:
+                break
+            boxes += n_colors - len(palette)
+    lookup = {c: nearest(c, palette) for c in histogram}
+    return palette, [lookup[p] for p in pixels]
+
+
+# ==================[encoder]==================
+
+def encode(values, fmt):
+    """Packets: header (bit 7: run, bits 6-0: pixels - 1) followed by one value (run) or
+    pixels values (literal). Values: 2 bytes high first (rle16), 1 byte (rle8), 4 bits
+    high nibble first (rle4, runs use the low nibble of 1 byte)."""
+    out = bytearray()
+    literal = []
+
+    def put_values(vals):
+        if fmt == 'rle16':
+            for v in vals:
+                out.extend((v >> 8, v & 0xFF))
+        elif fmt == 'rle8':
+            out.extend(vals)
+        else:
+            for i in range(0, len(vals), 2):
+                low = vals[i + 1] if i + 1 < len(vals) else 0
+                out.append((vals[i] << 4) | low)
+
+    def flush():
+        while literal:
+            chunk = literal[:MAX_COUNT]
+            del literal[:MAX_COUNT]
+            out.append(len(chunk) - 1)
+            put_values(chunk)
+
+    i, n = 0, len(values)
+    while i < n:
+        j = i
+        while j < n and values[j] == values[i] and j - i < MAX_COUNT:
+            j += 1
+        if j - i >= MIN_RUN[fmt]:
+            flush()
+            out.append(RUN_FLAG | (j - i - 1))
+            if fmt == 'rle16':
+                out.extend((values[i] >> 8, values[i] & 0xFF))
+            else:
+                out.append(values[i])
+            i = j
+        else:
+            literal.append(values[i])
+            i += 1
+    flush()
+    return bytes(out)
+
+
+def decode(data, fmt, palette, n_pixels):
+    """Reference decoder (same as ILI9341DrawImage)."""
+    pixels, pos = [], 0
+    while len(pixels) < n_pixels:
+        header = data[pos]
+        pos += 1
+        count = (header & 0x7F) + 1
+        if header & RUN_FLAG:
+            if fmt == 'rle16':
+                color = (data[pos] << 8) | data[pos + 1]
+                pos += 2
+            else:
+                color = palette[data[pos] & (0x0F if fmt == 'rle4' else 0xFF)]
+                pos += 1
+            pixels += [color] * count
+        elif fmt == 'rle16':
+            pixels += [(data[pos + 2 * k] << 8) | data[pos + 2 * k + 1] for k in range(count)]
+            pos += 2 * count
+        elif fmt == 'rle8':
+            pixels += [palette[v] for v in data[pos:pos + count]]
+            pos += count
+        else:
+            pixels += [palette[(data[pos + k // 2] >> (0 if k % 2 else 4)) & 0x0F] for k in range(count)]
+            pos += (count + 1) // 2
+    return pixels[:n_pixels]
+
+
+# ==================[C output]==================
+
+def c_array(values, per_line, fmt):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('\t' + ', '.join(fmt % v for v in values[i:i + per_line]) + ',')
+    return '\n'.join(lines)
+
+
+def write_c(path, name, source, width, height, fmt, palette, data):
+    with open(path, 'w') as f:
+        f.write('/* %s: %dx%d, %s, %d bytes (raw RGB565: %d bytes)\n' %
+                (os.path.basename(source), width, height, fmt, len(data) + 2 * len(palette), width * height * 2))
+        f.write(' * Generated by img2ili9341.py, to draw it: ILI9341DrawImage(x, y, &%s); */\n' % name)
+        f.write('#include <stddef.h>\n#include "ili9341.h"\n\n')
+        if palette:
+            f.write('static const uint16_t %s_palette[] = {\n%s\n};\n\n' % (name, c_array(palette, 12, '0x%04X')))
+        f.write('static const uint8_t %s_data[] = {\n%s\n};\n\n' % (name, c_array(data, 16, '0x%02X')))
+        f.write('const ili9341_image_t %s = {\n' % name)
+        f.write('\t.width = %d,\n\t.height = %d,\n\t.format = %s,\n' % (width, height, FORMATS[fmt]))
+        f.write('\t.palette = %s,\n' % ('%s_palette' % name if palette else 'NULL'))
+        f.write('\t.data = %s_data\n};\n' % name)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Converts images to ILI9341DrawImage() C arrays')
+    parser.add_argument('input', help='PNG, BMP (or any format with Pillow) image, or RGB565 C array')
+    parser.add_argument('-o', '--output', help='Output C file (default: <name>.c)')
+    parser.add_argument('-n', '--name', help='Image variable name (default: input file name)')
+    parser.add_argument('-f', '--format', choices=['auto'] + list(FORMATS), default='auto')
+    parser.add_argument('--size', help='WxH of a C array input')
+    parser.add_argument('--background', default='FFFFFF', help='RGB hex color under transparent pixels')
+    args = parser.parse_args()
+
+    background = tuple(int(args.background[i:i + 2], 16) for i in (0, 2, 4))
+    name = args.name or re.sub(r'\W', '_', os.path.splitext(os.path.basename(args.input))[0])
+    output = args.output or name + '.c'
+    try:
+        width, height, pixels = read_image(args.input, args.size, background)
+    except (ValueError, OSError) as e:
+        sys.exit('img2ili9341: %s' % e)
+
+    n_colors = len(set(pixels))
+    fmt = args.format
+    if fmt == 'auto':
+        fmt = 'rle4' if n_colors <= 16 else ('rle8' if n_colors <= 256 else 'rle16')
+    if fmt == 'rle16':
+        palette, values = [], pixels
+    else:
+        palette, values = to_palette(pixels, 16 if fmt == 'rle4' else 256)
+    data = encode(values, fmt)
+    decoded = decode(data, fmt, palette, width * height)
+    expected = pixels if fmt == 'rle16' else [palette[v] for v in values]
+    assert decoded == expected, 'encoder error'
+
+    write_c(output, name, args.input, width, height, fmt, palette, data)
+    error = sum(sum((a - b) ** 2 for a, b in zip(unpack565(p), unpack565(q))) for p, q in zip(pixels, decoded))
+    print('%s: %dx%d, %d colors -> %s, %d bytes (raw %d bytes, %.1f%%), RMS error %.2f' %
+          (output, width, height, n_colors, fmt, len(data) + 2 * len(palette), width * height * 2,
+           100.0 * (len(data) + 2 * len(palette)) / (width * height * 2), (error / (3 * width * height)) ** 0.5))
+
+
+if __name__ == '__main__':
+    main()
@@ -21,6 +21,8 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 24/02/2024 | Document creation		                         						|
+ * | 17/10/2026 | Continuous (DMA) mode implemented		                         		|
+ * | 17/10/2026 | Multi-channel scan groups		                         				|
  * 
  **/
 
@@ -40,6 +42,12 @@ typedef enum adc_mode {
 } adc_mode_t;
 
 #define DAC	0    			/*!< DAC pin. Override CH0 declaration*/
+
+#define ADC_FRAME_SAMPLES		256		/*!< Samples per DMA conversion frame (continuous mode) */
+#define ADC_FRAMES_POOL			4		/*!< Frames stored by the driver before overflow (continuous mode) */
+#define ADC_CONT_MIN_FREC		611		/*!< Min. continuous mode sample frequency (Hz) */
+#define ADC_CONT_MAX_FREC		83333	/*!< Max. continuous mode aggregate sample frequency (Hz) */
+#define ADC_SCAN_MAX_CH			4		/*!< Max. number of channels in a scan group */
 /*==================[typedef]================================================*/
 /**
  * @brief Analog inputs config structure
@@ -48,17 +56,34 @@ typedef enum adc_mode {
 typedef struct {			
 	adc_ch_t input;			/*!< Inputs: CH0, CH1, CH2, CH3 */
 	adc_mode_t mode;		/*!< Mode: single read or continuous read */
-	void *func_p;			/*!< Pointer to callback function for convertion end (only for continuous mode) */
+	void *func_p;			/*!< Pointer to callback function for frame convertion end, called from ISR (only for continuous mode) */
 	void *param_p;			/*!< Pointer to callback function parameters (only for continuous mode) */
-	uint16_t sample_frec;	/*!< Sample frequency min: 20kHz - max: 2MHz (only for continuous mode)  */
+	uint32_t sample_frec;	/*!< Sample frequency min: ADC_CONT_MIN_FREC - max: ADC_CONT_MAX_FREC (only for continuous mode)  */
 } analog_input_config_t;	
 
+/**
+ * @brief Scan group config structure (multi-channel continuous mode)
+ * 
+ */
+typedef struct {
+	adc_ch_t inputs[ADC_SCAN_MAX_CH];	/*!< Channels of the scan group, in convertion order */
+	uint8_t n_inputs;					/*!< Number of channels of the scan group (1 to ADC_SCAN_MAX_CH) */
+	void *func_p;						/*!< Pointer to callback function for frame convertion end, called from ISR */
+	void *param_p;						/*!< Pointer to callback function parameters */
+	uint32_t sample_frec;				/*!< Sample frequency of each channel (n_inputs * sample_frec <= ADC_CONT_MAX_FREC) */
+} analog_scan_config_t;
+
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
 /**
  * @brief Analog input initialization
  * 
+ * @note In continuous mode the ADC is driven by DMA: samples are stored in frames of 
+ * ADC_FRAME_SAMPLES and func_p is called (from ISR) each time a frame is completed. 
+ * Continuous mode can not be used at the same time as single mode (both share ADC unit 1). 
+ * To sample several channels in continuous mode use a scan group (see AnalogScanInit()).
+ * 
  * @param config Analog inputs config structure
  * @return null
  */
@@ -95,12 +120,60 @@ void AnalogStartContinuous(adc_ch_t channel);
 void AnalogStopContinuous(adc_ch_t channel);
 
 /**
- * @brief 
+ * @brief Read one complete frame converted in continuous mode.
+ * 
+ * @note Intended to be called from a task after the conversion end callback notifies it.
+ * This function does not block: if no frame is ready it returns 0.
  * 
  * @param channel Channel selected.
- * @param values Read variable array
+ * @param values Read variable array (in mV), of at least ADC_FRAME_SAMPLES elements
+ * @return Number of samples stored in values
+ */
+uint16_t AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values);
+
+/**
+ * @brief Scan group initialization (multi-channel continuous mode)
+ * 
+ * @note All channels of the group are sampled at the same rate by DMA, and func_p is called 
+ * (from ISR) each time a frame of ADC_FRAME_SAMPLES conversions is completed. A scan group 
+ * replaces any previous continuous mode configuration (if it was running, it is stopped: 
+ * call AnalogScanStart() again).
+ * 
+ * @param config Scan group config structure
+ */
+void AnalogScanInit(analog_scan_config_t *config);
+
+/**
+ * @brief Start convertion of the scan group
+ */
+void AnalogScanStart(void);
+
+/**
+ * @brief Stop convertion of the scan group
+ */
+void AnalogScanStop(void);
+
+/**
+ * @brief Read one frame of the scan group, split in one array per channel.
+ * 
+ * @note This function does not block: if no frame is ready it returns 0.
+ * 
+ * @param values Array of n_inputs pointers (in scan group order) to the channel arrays (in mV), 
+ * each one of at least ADC_FRAME_SAMPLES / n_inputs elements
+ * @return Number of samples stored in each channel array
+ */
+uint16_t AnalogScanRead(uint16_t *values[]);
+
+/**
+ * @brief Read one frame of the scan group, split in one float array per channel.
+ * 
+ * @note Output arrays can be passed directly to the signal processing middleware.
+ * 
+ * @param values Array of n_inputs pointers (in scan group order) to the channel arrays (in mV), 
+ * each one of at least ADC_FRAME_SAMPLES / n_inputs elements
+ * @return Number of samples stored in each channel array
  */
-void AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values);
+uint16_t AnalogScanReadFloat(float *values[]);
 
 /**
  * @brief Digital-to-Analog convert.
@@ -9,10 +9,16 @@
 
 /** \brief Functions to generate delays.
  *
- * This driver provide functions to generate delays FreeRTOS friendly, using one timer.
- * 
- * @note All delays will block the current RTOS task, with the exception of 
- * DelayUs with usec < 50.
+ * This driver provide functions to generate delays FreeRTOS friendly, using one persistent
+ * system timer (esp_timer) and a queue of alarms, so any number of tasks can be waiting at
+ * the same time, and no timer is created on each delay.
+ *
+ * Tasks sleep until shortly before the end of the delay (the measured wake-up latency, see
+ * DelayGetWakeLatency()) and busy-wait the rest, so the delay ends on time and the CPU is
+ * free meanwhile. Delays shorter than the wake-up latency plus DELAY_SLEEP_MIN_US, and delays
+ * from ISR, are a busy-wait calibrated in CPU cycles (the call overhead is discounted).
+ *
+ * @note The first delay from a task initializes the service (~200 us calibration).
  *
  * @author Albano Peñalva
  *
@@ -21,12 +27,16 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 20/10/2023 | Document creation		                         						|
+ * | 17/10/2026 | Persistent alarm queue and calibrated busy-wait (DelayUntilUs)		|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
 /*==================[macros]=================================================*/
+#define DELAY_SLEEP_MIN_US	50		/*!< Min. sleep time of a task (shorter delays are a busy-wait) */
+#define DELAY_WAKE_US		30		/*!< Initial estimate of the wake-up latency (us) */
+#define DELAY_WAKE_MAX_US	500		/*!< Max. wake-up latency compensated with busy-wait (us) */
 
 /*==================[typedef]================================================*/
 
@@ -54,6 +64,21 @@ void DelayMs(uint16_t msec);
  */
 void DelayUs(uint16_t usec);
 
+/**
+ * @brief Delay until a time, i.e. for periodic loops without drift
+ * (time += period; DelayUntilUs(time);)
+ * @param[in] time end of the delay (us, the time base of TimerGetTimestamp())
+ * @return None
+ */
+void DelayUntilUs(int64_t time);
+
+/**
+ * @brief Wake-up latency estimate: time from the alarm to the task running (busy-waited at
+ * the end of each sleep)
+ * @return Latency (us)
+ */
+uint32_t DelayGetWakeLatency(void);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -26,6 +26,8 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 17/10/2026 | GPIO input interruption can be disabled (GPIODeactivInt)				|
+ * | 17/10/2026 | GPIO input interruption on both edges (GPIOActivIntBothEdges)			|
  * 
  **/
 
@@ -134,6 +136,25 @@ bool GPIORead(gpio_t pin);
  */
 void GPIOActivInt(gpio_t pin, void *ptr_int_func, bool edge, void *args);
 
+/**
+ * @brief Configure GPIO input interruption on both edges
+ * 
+ * @note The callback can read the GPIO to know which edge it was (if pulses are longer than
+ * the interrupt latency).
+ * 
+ * @param pin GPIO number
+ * @param ptr_int_func Pointer to callback function
+ * @param args Parameter of the callback function
+ */
+void GPIOActivIntBothEdges(gpio_t pin, void *ptr_int_func, void *args);
+
+/**
+ * @brief Disable GPIO input interruption (configured with GPIOActivInt())
+ * 
+ * @param pin GPIO number
+ */
+void GPIODeactivInt(gpio_t pin);
+
 /**
  * @brief Configure an input glitch filter to a GPIO
  * 
@@ -21,6 +21,7 @@
  * |   Date	    | Description                                    |
  * |:----------:|:-----------------------------------------------|
  * | 30/01/2024 | Document creation		                         |
+ * | 17/10/2026 | Burst reads in a single transaction (I2C_readBurst) |
  *
  */
 
@@ -109,6 +110,20 @@ int8_t I2C_readWord(uint8_t devAddr, uint8_t regAddr, uint16_t *data, uint16_t t
  */
 int8_t I2C_readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data, uint16_t timeout);
 
+/** @fn I2C_readBurst(uint8_t devAddr, uint8_t regAddr, uint16_t length, uint8_t *data, uint16_t timeout)
+ * @brief Read a long block of bytes from an 8-bit device register.
+ * 
+ * Register is selected and read in a single transaction (repeated start), so there is no
+ * STOP in between and no length limit (i.e. draining a sensor FIFO).
+ * @param devAddr I2C slave device address
+ * @param regAddr First register regAddr to read from
+ * @param length Number of bytes to read
+ * @param data Buffer to store read data in
+ * @param timeout Read timeout in milliseconds
+ * @return Number of bytes read (0 on error)
+ */
+uint16_t I2C_readBurst(uint8_t devAddr, uint8_t regAddr, uint16_t length, uint8_t *data, uint16_t timeout);
+
 /** @fn I2C_writeBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t data);
  * @brief write a single bit in an 8-bit device register.
  * @param devAddr I2C slave device address
@@ -0,0 +1,200 @@
+#ifndef RING_BUFFER_MCU_H
+#define RING_BUFFER_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup Ring_Buffer Ring Buffer
+ ** @{ */
+
+/** \brief Lock-free single-producer/single-consumer ring buffer.
+ *
+ * This driver provide a FIFO to move samples from ISRs to tasks (or between two tasks)
+ * without queues, critical sections or copies of whole structs. One side (producer) only
+ * writes and the other side (consumer) only reads, so no locks are needed.
+ *
+ * Data can be moved in batches (RingBufferPush/RingBufferPop) or accessed in place through
+ * contiguous spans (reserve/commit and span/release), to be filled by DMA or processed
+ * without an extra copy.
+ *
+ * @note The buffer size (in elements) must be a power of two.
+ *
+ * @note All functions are placed in IRAM. The FromISR variants also notify the consumer
+ * task registered with RingBufferSetConsumer().
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdbool.h>
+#include <stdint.h>
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Ring buffer control structure
+ */
+typedef struct {
+	uint8_t *buffer;			/*!< Storage array (size * elem_size bytes) */
+	uint32_t size;				/*!< Capacity in elements (power of two) */
+	uint32_t mask;				/*!< size - 1 */
+	uint16_t elem_size;			/*!< Element size in bytes */
+	volatile uint32_t head;		/*!< Write index (only modified by producer) */
+	volatile uint32_t tail;		/*!< Read index (only modified by consumer) */
+	volatile uint32_t dropped;	/*!< Elements dropped by producer because buffer was full */
+	void *consumer;				/*!< Task notified by FromISR variants (TaskHandle_t, NULL if none) */
+} ring_buffer_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Ring buffer initialization
+ *
+ * @param rb Ring buffer control structure
+ * @param buffer Storage array (of size * elem_size bytes)
+ * @param size Capacity in elements (must be a power of two)
+ * @param elem_size Element size in bytes
+ * @return true Ring buffer initialized
+ * @return false size is not a power of two
+ */
+bool RingBufferInit(ring_buffer_t *rb, void *buffer, uint32_t size, uint16_t elem_size);
+
+/**
+ * @brief Discard all stored elements
+ *
+ * @note Must not be called while producer or consumer are using the buffer
+ *
+ * @param rb Ring buffer control structure
+ */
+void RingBufferReset(ring_buffer_t *rb);
+
+/**
+ * @brief Register the task to be notified by the FromISR variants
+ *
+ * @param rb Ring buffer control structure
+ * @param task Consumer task handle (TaskHandle_t)
+ */
+void RingBufferSetConsumer(ring_buffer_t *rb, void *task);
+
+/**
+ * @brief Number of elements stored
+ *
+ * @param rb Ring buffer control structure
+ * @return uint32_t Elements available to the consumer
+ */
+uint32_t RingBufferCount(ring_buffer_t *rb);
+
+/**
+ * @brief Number of free elements
+ *
+ * @param rb Ring buffer control structure
+ * @return uint32_t Elements that can be pushed by the producer
+ */
+uint32_t RingBufferSpace(ring_buffer_t *rb);
+
+/**
+ * @brief Push a batch of elements (producer side)
+ *
+ * @note Elements that do not fit are dropped and counted in rb->dropped
+ *
+ * @param rb Ring buffer control structure
+ * @param data Elements to push
+ * @param n Number of elements
+ * @return uint32_t Number of elements pushed
+ */
+uint32_t RingBufferPush(ring_buffer_t *rb, const void *data, uint32_t n);
+
+/**
+ * @brief Push a batch of elements from an ISR and notify the consumer task
+ *
+ * @param rb Ring buffer control structure
+ * @param data Elements to push
+ * @param n Number of elements
+ * @param task_woken Set to true if the consumer task must be scheduled on ISR exit (can be NULL)
+ * @return uint32_t Number of elements pushed
+ */
+uint32_t RingBufferPushFromISR(ring_buffer_t *rb, const void *data, uint32_t n, bool *task_woken);
+
+/**
+ * @brief Pop a batch of elements (consumer side)
+ *
+ * @param rb Ring buffer control structure
+ * @param data Array where elements are stored
+ * @param n Max. number of elements to pop
+ * @return uint32_t Number of elements popped
+ */
+uint32_t RingBufferPop(ring_buffer_t *rb, void *data, uint32_t n);
+
+/**
+ * @brief Get the largest contiguous free span (producer side)
+ *
+ * @note The span can be filled in place (i.e. by DMA) and then published with RingBufferWriteCommit()
+ *
+ * @param rb Ring buffer control structure
+ * @param n Returns the span length in elements
+ * @return void* Pointer to the first free element
+ */
+void * RingBufferWriteReserve(ring_buffer_t *rb, uint32_t *n);
+
+/**
+ * @brief Publish elements written in a reserved span (producer side)
+ *
+ * @param rb Ring buffer control structure
+ * @param n Number of elements written (not greater than the reserved span)
+ */
+void RingBufferWriteCommit(ring_buffer_t *rb, uint32_t n);
+
+/**
+ * @brief Publish elements written in a reserved span from an ISR and notify the consumer task
+ *
+ * @param rb Ring buffer control structure
+ * @param n Number of elements written (not greater than the reserved span)
+ * @param task_woken Set to true if the consumer task must be scheduled on ISR exit (can be NULL)
+ */
+void RingBufferWriteCommitFromISR(ring_buffer_t *rb, uint32_t n, bool *task_woken);
+
+/**
+ * @brief Get the largest contiguous span of stored elements (consumer side)
+ *
+ * @note Elements can be processed in place and then released with RingBufferReadRelease()
+ *
+ * @param rb Ring buffer control structure
+ * @param n Returns the span length in elements
+ * @return const void* Pointer to the first stored element
+ */
+const void * RingBufferReadSpan(ring_buffer_t *rb, uint32_t *n);
+
+/**
+ * @brief Release elements of a span already processed (consumer side)
+ *
+ * @param rb Ring buffer control structure
+ * @param n Number of elements to release (not greater than the span)
+ */
+void RingBufferReadRelease(ring_buffer_t *rb, uint32_t n);
+
+/**
+ * @brief Block the consumer task until there is data stored
+ *
+ * @note Requires the calling task to be registered with RingBufferSetConsumer() and
+ * the producer to use the FromISR variants.
+ *
+ * @param rb Ring buffer control structure
+ * @param timeout_ms Max. time to wait (in ms)
+ * @return true There is data stored
+ * @return false Timeout
+ */
+bool RingBufferWait(ring_buffer_t *rb, uint32_t timeout_ms);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* RING_BUFFER_MCU_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,97 @@
+#ifndef RMT_MCU_H
+#define RMT_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup RMT RMT
+ ** @{ */
+/** \brief RMT (Remote Control Transceiver) transmitter driver for the ESP-EDU Board.
+ *
+ * Sends bytes as pulse width coded bits (i.e. WS2812B LEDs): each bit is a high pulse
+ * followed by a low one, with different durations for 0 and 1. A low "reset" time is
+ * appended at the end of each frame. Frames are encoded by the RMT driver while they are
+ * sent (in background), so the CPU timing doesn't affect the waveform.
+ *
+ * @note Only one transmitter can be used at a time.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ *
+ **/
+/*==================[inclusions]=============================================*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "gpio_mcu.h"
+/*==================[macros]=================================================*/
+#define RMT_QUEUE_SIZE	4		/*!< Max. number of frames waiting to be sent */
+/*==================[typedef]================================================*/
+/**
+ * @brief RMT transmitter configuration structure
+ */
+typedef struct{
+	gpio_t pin;						/*!< Output GPIO */
+	uint32_t resolution;			/*!< Tick frequency (Hz), durations are in ticks */
+	uint16_t bit0_high;				/*!< High time of a 0 bit */
+	uint16_t bit0_low;				/*!< Low time of a 0 bit */
+	uint16_t bit1_high;				/*!< High time of a 1 bit */
+	uint16_t bit1_low;				/*!< Low time of a 1 bit */
+	uint16_t reset;					/*!< Low time after each frame (up to 65534) */
+	void *func_p;					/*!< Pointer to callback function for frame end (called from ISR, can be NULL) */
+	void *param_p;					/*!< Pointer to callback parameter */
+} rmt_mcu_config_t;
+/*==================[external data declaration]==============================*/
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize RMT transmitter with the corresponding configuration
+ *
+ * @param rmt Structure with the transmitter configuration
+ * @return uint8_t 0 when success
+ */
+uint8_t RmtInit(rmt_mcu_config_t *rmt);
+
+/**
+ * @brief Queue a frame to be sent in background (bits MSB first), and return without waiting
+ *
+ * @note The buffer must not be modified until the frame is sent (see RmtWait()). Waits if
+ * there are already RMT_QUEUE_SIZE frames pending. Frames that can't be queued (i.e. RmtInit()
+ * failed) are discarded and not counted as pending.
+ *
+ * @param tx_buffer pointer to buffer where data is stored
+ * @param tx_buffer_size numbers of bytes to send
+ */
+void RmtWrite(const uint8_t *tx_buffer, uint32_t tx_buffer_size);
+
+/**
+ * @brief Wait until the number of frames pending is not greater than max_pending
+ *
+ * @note Frames are sent in order: with max_pending = n, the buffer of the n-th last frame
+ * can be reused. With max_pending = 0 all frames are sent.
+ *
+ * @param max_pending Max. number of frames still pending on return
+ */
+void RmtWait(uint8_t max_pending);
+
+/**
+ * @brief Number of frames queued and not yet sent
+ *
+ * @return uint8_t Frames pending
+ */
+uint8_t RmtPending(void);
+
+/**
+ * @brief De-Initialize RMT transmitter
+ *
+ * @return uint8_t 0 when success
+ */
+uint8_t RmtDeInit(void);
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif
+/*==================[end of file]============================================*/
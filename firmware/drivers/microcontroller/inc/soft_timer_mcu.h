@@ -0,0 +1,174 @@
+#ifndef SOFT_TIMER_MCU_H
+#define SOFT_TIMER_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup Soft_Timer Software timers
+ ** @{ */
+
+/** \brief Software timers driven by one hardware timer.
+ *
+ * Any number of one-shot or periodic timers run on the tick of one of the timers of the
+ * Timer driver. Timers are kept in a hierarchical timing wheel (SOFT_TIMER_LEVELS levels of
+ * SOFT_TIMER_SLOTS slots), so starting or stopping a timer takes the same time no matter how
+ * many timers are running, and each tick only looks at the timers that expire on it.
+ *
+ * Periodic timers are rescheduled from their previous expiration (not from the time the
+ * callback runs), so they don't drift. Periods that are not a multiple of the tick are
+ * approximated in average (some periods are one tick longer).
+ *
+ * Callbacks run in the tick ISR (SOFT_TIMER_ISR: short functions only, FromISR FreeRTOS API)
+ * or in a task of the driver (SOFT_TIMER_TASK), in order of expiration.
+ *
+ * Timers are structs owned by the application (no dynamic memory), and they are used as
+ * handles: they must not be modified, copied or go out of scope while they are running.
+ *
+ * @note Times are rounded to the tick: a timer of n ticks expires n tick interrupts after
+ * it is started (between n - 1 and n ticks later).
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "timer_mcu.h"
+/*==================[macros]=================================================*/
+#define SOFT_TIMER_SLOT_BITS	6		/*!< log2 of the slots of each level */
+#define SOFT_TIMER_SLOTS		(1 << SOFT_TIMER_SLOT_BITS)	/*!< Slots of each wheel level */
+#define SOFT_TIMER_LEVELS		4		/*!< Wheel levels (range: 2^24 ticks, longer timers are re-queued) */
+/*==================[typedef]================================================*/
+/**
+ * @brief Timer mode
+ */
+typedef enum {
+	SOFT_TIMER_ONE_SHOT,		/*!< Expires once after each start */
+	SOFT_TIMER_PERIODIC			/*!< Expires every period until stopped */
+} soft_timer_mode_t;
+
+/**
+ * @brief Context where the callback runs
+ */
+typedef enum {
+	SOFT_TIMER_ISR,				/*!< Tick ISR */
+	SOFT_TIMER_TASK				/*!< Driver task */
+} soft_timer_context_t;
+
+/**
+ * @brief Software timer configuration
+ */
+typedef struct {
+	uint32_t period;				/*!< Period (one-shot: delay) in us */
+	soft_timer_mode_t mode;			/*!< One-shot or periodic */
+	soft_timer_context_t context;	/*!< Callback context */
+	void *func_p;					/*!< Pointer to callback function */
+	void *param_p;					/*!< Pointer to callback function parameter */
+} soft_timer_config_t;
+
+/**
+ * @brief Software timer (handle). Members are private to the driver.
+ */
+typedef struct soft_timer {
+	struct soft_timer *next;		/*!< Next timer in the wheel slot */
+	struct soft_timer **pprev;		/*!< Link pointing to this timer (NULL: not running) */
+	struct soft_timer *task_next;	/*!< Next timer waiting for the driver task */
+	uint32_t expires;				/*!< Tick of the next expiration */
+	uint32_t period;				/*!< Period (whole ticks) */
+	uint32_t period_rem;			/*!< Period remainder (us) */
+	uint32_t rem_acc;				/*!< Accumulated remainder (us) */
+	uint32_t overruns;				/*!< Periods skipped (see SoftTimerGetOverruns()) */
+	uint16_t pending;				/*!< Expirations waiting for the driver task */
+	bool queued;					/*!< Timer in the driver task queue */
+	soft_timer_mode_t mode;			/*!< One-shot or periodic */
+	soft_timer_context_t context;	/*!< Callback context */
+	void (*func_p)(void*);			/*!< Callback */
+	void *param_p;					/*!< Callback parameter */
+} soft_timer_t;
+
+/**
+ * @brief Software timers service configuration
+ */
+typedef struct {
+	timer_mcu_t timer;				/*!< Hardware timer used for the tick (not available for the application) */
+	uint32_t tick;					/*!< Tick period (us) */
+	uint8_t priority;				/*!< Priority of the task that runs SOFT_TIMER_TASK callbacks */
+} soft_timer_service_config_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize and start the software timers service (the tick runs from now on).
+ *
+ * @note It can only be initialized once.
+ * @param config Service configuration
+ * @return true when success
+ */
+bool SoftTimerServiceInit(const soft_timer_service_config_t *config);
+
+/**
+ * @brief Initialize a software timer (stopped after init)
+ *
+ * @note The service must be initialized first. Periods shorter than the tick are rounded up
+ * to one tick.
+ * @param timer Timer
+ * @param config Timer configuration
+ */
+void SoftTimerInit(soft_timer_t *timer, const soft_timer_config_t *config);
+
+/**
+ * @brief Start a timer: it expires after its period (if it was running, it is restarted).
+ *
+ * @note It can be called from ISR (i.e. from SOFT_TIMER_ISR callbacks).
+ * @param timer Timer
+ */
+void SoftTimerStart(soft_timer_t *timer);
+
+/**
+ * @brief Stop a timer (SOFT_TIMER_TASK expirations not yet served are discarded).
+ *
+ * @note It can be called from ISR. A callback that already started keeps running. Once
+ * stopped, the driver holds no reference to the timer (it can be reused or go out of scope).
+ * @param timer Timer
+ */
+void SoftTimerStop(soft_timer_t *timer);
+
+/**
+ * @brief Update the period of a timer (it applies from its next start or expiration)
+ *
+ * @param timer Timer
+ * @param period Period (one-shot: delay) in us
+ */
+void SoftTimerUpdatePeriod(soft_timer_t *timer, uint32_t period);
+
+/**
+ * @brief Check if a timer is running
+ *
+ * @param timer Timer
+ * @return true if it is waiting to expire
+ */
+bool SoftTimerIsRunning(const soft_timer_t *timer);
+
+/**
+ * @brief Number of expirations whose callback was not called: periodic timers that fell
+ * more than one period behind, and SOFT_TIMER_TASK expirations that found the previous one
+ * still waiting for the driver task.
+ *
+ * @param timer Timer
+ * @return uint32_t Expirations skipped since SoftTimerInit()
+ */
+uint32_t SoftTimerGetOverruns(const soft_timer_t *timer);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif
+
+/*==================[end of file]============================================*/
@@ -21,6 +21,7 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 09/02/2024 | Document creation		                         						|
+ * | 17/10/2026 | Queued (asynchronous DMA) writes										|
  * 
  **/
 /*==================[inclusions]=============================================*/
@@ -66,7 +67,7 @@ typedef struct{
 	clk_mode_t clk_mode;			/*!< Mode: phase and polarity */
 	uint32_t bitrate;				/*!< Transfer speed (up to 26MHz) */
 	transfer_mode_t transfer_mode;	/*!< Transfer mode */
-	void *func_p;					/*!< Pointer to callback function for transaction end */
+	void *func_p;					/*!< Pointer to callback function for transaction end (SPI_INTERRUPT mode or queued writes) */
 	void *param_p;					/*!< Pointer to callback parameter */
 } spi_mcu_config_t;
 /*==================[external data declaration]==============================*/
@@ -108,6 +109,39 @@ void SpiWrite(spi_dev_t device, uint8_t * tx_buffer, uint32_t tx_buffer_size);
  */
 void SpiReadWrite(spi_dev_t device, uint8_t * tx_buffer, uint8_t * rx_buffer, uint32_t buffer_size);
 
+/**
+ * @brief Queue a write to be sent by DMA in background, and return without waiting
+ * 
+ * @note The buffer must not be modified until the transaction is done (see SpiWaitQueued()). 
+ * If the device has a callback (func_p) it is called at the end of each queued write, in any 
+ * transfer mode. Blocking functions (SpiWrite, SpiRead...) must not be called while there are 
+ * queued writes pending.
+ * 
+ * @param device SPI device to write to
+ * @param tx_buffer pointer to buffer where data is stored (DMA capable memory)
+ * @param tx_buffer_size numbers of bytes to write (up to 4092)
+ */
+void SpiWriteQueued(spi_dev_t device, uint8_t * tx_buffer, uint32_t tx_buffer_size);
+
+/**
+ * @brief Wait until the number of queued writes pending is not greater than max_pending
+ * 
+ * @note Writes are done in order: with max_pending = n, the buffer of the n-th last write 
+ * can be reused. With max_pending = 0 all queued writes are done (fence).
+ * 
+ * @param device SPI device
+ * @param max_pending Max. number of queued writes still pending on return
+ */
+void SpiWaitQueued(spi_dev_t device, uint8_t max_pending);
+
+/**
+ * @brief Number of queued writes not yet waited for
+ * 
+ * @param device SPI device
+ * @return uint8_t Queued writes pending
+ */
+uint8_t SpiQueuedPending(spi_dev_t device);
+
 /**
  * @brief De-Initialize SPI module with the corresponding configuration
  * 
@@ -9,6 +9,17 @@
  ** @{ */
 
 /** \brief Timer driver for the ESP-EDU Board.
+ * 
+ * With TIMER_MCU_STATS defined as 1 (i.e. idf_build_set_property(COMPILE_OPTIONS
+ * "-DTIMER_MCU_STATS=1" APPEND) in the project CMakeLists.txt), each alarm records:
+ * - lateness: time from the alarm (the expected fire time) to the callback start.
+ * - ISR latency: time from the alarm to the timer ISR entry.
+ * - dispatch: time from the ISR entry to the callback start.
+ * - duration: time spent in the callback.
+ * 
+ * Each of them is accumulated (min., max., mean and histogram) and can be read with
+ * TimerGetStats() or sent to a serial port with TimerStatsDump(). With TIMER_MCU_STATS as 0
+ * (default) nothing is recorded and the functions are not available.
  * 
  * @author Albano Peñalva
  *
@@ -17,12 +28,22 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 20/10/2023 | Document creation		                         						|
+ * | 17/10/2026 | Free-running timestamp (TimerGetTimestamp)							|
+ * | 17/10/2026 | Alarm timing statistics (TIMER_MCU_STATS)								|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include "stdint.h"
+#include "stdbool.h"
+#ifndef TIMER_MCU_STATS
+#define TIMER_MCU_STATS		0		/*!< 1: record timing statistics of the alarms */
+#endif
+#if TIMER_MCU_STATS
+#include "uart_mcu.h"
+#endif
 /*==================[macros]=================================================*/
+#define TIMER_STATS_BINS	12		/*!< Histogram bins: 0, 1, 2-3, 4-7, ..., 512-1023, >= 1024 us */
 
 /*==================[typedef]================================================*/
 /**
@@ -42,6 +63,32 @@ typedef struct {
 	void *func_p;			/*!< Pointer to callback function to call periodically */
 	void *param_p;			/*!< Pointer to callback function parameter */
 } timer_config_t;
+
+#if TIMER_MCU_STATS
+/**
+ * @brief Statistics of a time measured on each alarm
+ */
+typedef struct {
+	uint32_t min;						/*!< Min. value (us) */
+	uint32_t max;						/*!< Max. value (us) */
+	uint32_t mean;						/*!< Mean value (us) */
+	uint32_t hist[TIMER_STATS_BINS];	/*!< Alarms in each bin: bin n > 0 counts values from 2^(n-1) to 2^n - 1 us */
+} timer_stat_t;
+
+/**
+ * @brief Timing statistics of a timer
+ */
+typedef struct {
+	uint32_t alarms;			/*!< Alarms recorded */
+	uint32_t overruns;			/*!< Callbacks longer than the period */
+	int64_t expected;			/*!< Last alarm: expected fire time (us, TimerGetTimestamp() time base) */
+	int64_t actual;				/*!< Last alarm: callback start time (us, TimerGetTimestamp() time base) */
+	timer_stat_t lateness;		/*!< From the alarm to the callback start */
+	timer_stat_t isr_latency;	/*!< From the alarm to the ISR entry */
+	timer_stat_t dispatch;		/*!< From the ISR entry to the callback start */
+	timer_stat_t duration;		/*!< Callback execution time */
+} timer_stats_t;
+#endif
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -98,6 +145,36 @@ void TimerReset(timer_mcu_t timer);
  */
 void TimerUpdatePeriod(timer_mcu_t timer, uint32_t period);
 
+/**
+ * @brief Time elapsed since boot, from the system free-running timer.
+ * 
+ * @note It can be called from ISR (i.e. to timestamp events).
+ * 
+ * @return uint64_t Time in us
+ */
+uint64_t TimerGetTimestamp(void);
+
+#if TIMER_MCU_STATS
+/**
+ * @brief Read the timing statistics of a timer
+ * 
+ * @param timer Timer number
+ * @param stats Statistics
+ * @param reset Restart the statistics
+ */
+void TimerGetStats(timer_mcu_t timer, timer_stats_t *stats, bool reset);
+
+/**
+ * @brief Send the timing statistics of a timer as text through a serial port
+ * 
+ * @note The port must be initialized (see UartInit()).
+ * 
+ * @param timer Timer number
+ * @param port Serial port
+ */
+void TimerStatsDump(timer_mcu_t timer, uart_mcu_port_t port);
+#endif
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -9,6 +9,15 @@
  ** @{ */
 
 /** \brief UART driver for the ESP-EDU Board.
+ * 
+ * A port can also be initialized in stream mode (UartStreamInit()), for high throughput
+ * transfers (i.e. sending raw sensor data at 921600 baud) with no byte-by-byte work:
+ * - TX: buffers owned by the application (one or several segments) are queued and the UART
+ * interrupt moves them to the hardware FIFO, with no copies. A callback tells when a buffer
+ * can be reused.
+ * - RX: the UART interrupt moves the received bytes to a ring buffer owned by the application
+ * (any power of 2 size). The consumer is woken when a number of bytes is received or when the
+ * line goes idle, and it reads them in place as contiguous spans.
  * 
  * @author Albano Peñalva
  *
@@ -17,13 +26,17 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 02/07/2024 | Document creation		                         						|
+ * | 17/10/2026 | Received data stored in ring buffer when callback is used				|
+ * | 17/10/2026 | Stream mode (zero-copy TX, span RX) and blocking send					|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include "stdint.h"
+#include "stdbool.h"
 /*==================[macros]=================================================*/
 #define UART_NO_INT	0		/*!< Flag used when no reading interruption is required */
+#define UART_STREAM_TX_QUEUE	16		/*!< Segments queued for transmission in stream mode (power of 2) */
 /*==================[typedef]================================================*/
 /**
  * @brief List of UART ports available in ESP-EDU
@@ -41,6 +54,39 @@ typedef struct {
 	void *func_p;			/*!< Pointer to callback function to call when receiving data (= UART_NO_INT if not requiered)*/
 	void *param_p;			/*!< Pointer to callback function parameters */
 } serial_config_t;
+
+/**
+ * @brief Stream mode configuration struct
+ */
+typedef struct {
+	uart_mcu_port_t port;	/*!< port */
+	uint32_t baud_rate;		/*!< baudrate (bits per second) */
+	uint8_t *rx_buffer;		/*!< RX ring buffer storage (owned by the application) */
+	uint32_t rx_size;		/*!< RX ring buffer size in bytes (power of 2) */
+	uint32_t rx_notify;		/*!< Received bytes that wake the consumer (0: every transfer from the FIFO). An idle line always wakes it */
+	uint8_t rx_idle;		/*!< Idle time that ends a reception (in characters, 1 to 100) */
+	void *consumer;			/*!< Task woken when data is received (TaskHandle_t, NULL if none) */
+} uart_stream_config_t;
+
+/**
+ * @brief Segment of a buffer to be transmitted in stream mode
+ */
+typedef struct {
+	const uint8_t *data;	/*!< Pointer to data (must be valid until the transmission ends) */
+	uint32_t length;		/*!< Number of bytes */
+} uart_segment_t;
+
+/**
+ * @brief Stream mode counters
+ */
+typedef struct {
+	uint32_t rx_bytes;		/*!< Bytes stored in the RX ring buffer */
+	uint32_t rx_dropped;	/*!< Bytes discarded because the RX ring buffer was full */
+	uint32_t rx_overflows;	/*!< Hardware FIFO overflows (bytes lost before the interrupt was served) */
+	uint32_t tx_bytes;		/*!< Bytes moved to the hardware FIFO */
+	uint32_t tx_segments;	/*!< Segments transmitted */
+	uint32_t interrupts;	/*!< UART interrupts served */
+} uart_stream_stats_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -54,6 +100,9 @@ void UartInit(serial_config_t *port_config);
 /**
  * @brief Read a single byte from serial port
  * 
+ * @note If the port was initialized with a reception callback, received bytes are stored 
+ * in a ring buffer and this function does not block.
+ * 
  * @param port Port to read from
  * @param data Pointer to variable where data will be stored
  * @return uint8_t 
@@ -63,6 +112,9 @@ uint8_t UartReadByte(uart_mcu_port_t port, uint8_t *data);
 /**
  * @brief Read multiple bytes from serial port
  * 
+ * @note If the port was initialized with a reception callback, received bytes are stored 
+ * in a ring buffer and this function does not block (it returns the bytes already received).
+ * 
  * @param port Port to read from
  * @param data Pointer to array where data will be stored
  * @param nbytes Number of bytes to be readed
@@ -73,6 +125,8 @@ uint8_t UartReadBuffer(uart_mcu_port_t port, uint8_t *data, uint16_t nbytes);
 /**
  * @brief Send a single byte trough serial port
  * 
+ * @note Send functions wait while the transmission buffer is full (bytes are not discarded).
+ * 
  * @param port Port for sending data
  * @param data Pointer to variable with data to be transmitted
  */
@@ -106,6 +160,102 @@ void UartSendBuffer(uart_mcu_port_t port, const char *data, uint8_t nbytes);
  */
 uint8_t* UartItoa(uint32_t val, uint8_t base);
 
+/**
+ * @brief Serial port initialization in stream mode
+ * 
+ * @note The port must not be initialized with UartInit(). The rest of the functions of this
+ * driver can still be used on the port (send functions wait for the transmission to end,
+ * read functions take data from the RX ring buffer without blocking).
+ * Log messages (ESP_LOG, printf) also use UART_PC: they are interleaved with the stream.
+ * 
+ * @param config Stream mode configuration
+ * @return true when success
+ */
+bool UartStreamInit(const uart_stream_config_t *config);
+
+/**
+ * @brief Queue a buffer for transmission in stream mode (returns without waiting)
+ * 
+ * @note It can be called from ISR (i.e. from a completion callback, to queue the next buffer).
+ * 
+ * @param port Port for sending data
+ * @param data Pointer to data (owned by the application, it must not be modified until the callback)
+ * @param length Number of bytes
+ * @param func_p Pointer to callback function called (from ISR) when the buffer can be reused (NULL if none)
+ * @param param_p Pointer to callback function parameter
+ * @return true if the buffer was queued, false if the queue is full
+ */
+bool UartStreamSend(uart_mcu_port_t port, const uint8_t *data, uint32_t length, void *func_p, void *param_p);
+
+/**
+ * @brief Queue several segments to be sent one after the other (i.e. header, payload and
+ * checksum from different buffers), without copying them
+ * 
+ * @note It can be called from ISR. Segments are queued all together or none.
+ * 
+ * @param port Port for sending data
+ * @param segments Segments (the array can be reused after the call, the data can't until the callback)
+ * @param n Number of segments
+ * @param func_p Pointer to callback function called (from ISR) after the last segment (NULL if none)
+ * @param param_p Pointer to callback function parameter
+ * @return true if the segments were queued, false if there is not enough room in the queue
+ */
+bool UartStreamSendSegments(uart_mcu_port_t port, const uart_segment_t *segments, uint8_t n, void *func_p, void *param_p);
+
+/**
+ * @brief Wait until the number of segments queued for transmission is max_pending or less
+ * 
+ * @param port Port for sending data
+ * @param max_pending Segments that can remain queued (0: wait for all of them)
+ */
+void UartStreamWaitTx(uart_mcu_port_t port, uint8_t max_pending);
+
+/**
+ * @brief Number of segments queued for transmission (not yet moved to the hardware FIFO)
+ * 
+ * @param port Port for sending data
+ * @return uint8_t Pending segments
+ */
+uint8_t UartStreamTxPending(uart_mcu_port_t port);
+
+/**
+ * @brief Received data, read in place: contiguous span from the oldest received byte
+ * 
+ * @note There may be more data after the span (when it reaches the end of the ring buffer):
+ * call it again after UartStreamRxRelease().
+ * 
+ * @param port Port to read from
+ * @param length Number of bytes available from the returned pointer (0 if none)
+ * @return const uint8_t* Pointer to the received data
+ */
+const uint8_t * UartStreamRxSpan(uart_mcu_port_t port, uint32_t *length);
+
+/**
+ * @brief Release received bytes already processed (the ring buffer can reuse their space)
+ * 
+ * @param port Port to read from
+ * @param length Number of bytes (at most the length of the last span)
+ */
+void UartStreamRxRelease(uart_mcu_port_t port, uint32_t length);
+
+/**
+ * @brief Wait until there is received data (called from the consumer task)
+ * 
+ * @param port Port to read from
+ * @param timeout_ms Max. time to wait (ms)
+ * @return true if there is received data
+ */
+bool UartStreamRxWait(uart_mcu_port_t port, uint32_t timeout_ms);
+
+/**
+ * @brief Read the stream mode counters
+ * 
+ * @param port Port
+ * @param stats Counters
+ * @param reset Restart the counters
+ */
+void UartStreamGetStats(uart_mcu_port_t port, uart_stream_stats_t *stats, bool reset);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
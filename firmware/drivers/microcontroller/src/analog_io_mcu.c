@@ -11,6 +11,7 @@
 
 /*==================[inclusions]=============================================*/
 #include "analog_io_mcu.h"
+#include "ring_buffer_mcu.h"
 #include "driver/gptimer.h"
 #include "driver/sdm.h"
 #include "esp_adc/adc_cali_scheme.h"
@@ -19,13 +20,41 @@
 /*==================[macros and definitions]=================================*/
 #define ADC_BITWIDTH 		SOC_ADC_DIGI_MAX_BITWIDTH	// 12 bit resolution
 #define ADC_ATTENUATION		ADC_ATTEN_DB_12				// 12dB attenuation (for 0-3,3V ADC range)
+#define ADC_CONT_FRAME_SIZE	(ADC_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES)	// DMA frame size in bytes
+#define ADC_RAW_MAX			((1 << ADC_BITWIDTH) - 1)						// Max. raw conversion value
+#define ADC_LUT_SHIFT		6												// Calibration table step: 64 raw counts
+#define ADC_LUT_SIZE		((ADC_RAW_MAX >> ADC_LUT_SHIFT) + 2)			// Calibration table points
 /*==================[internal data declaration]==============================*/
 adc_cali_handle_t adc_calibration_single_0, adc_calibration_single_1, adc_calibration_single_2, adc_calibration_single_3;
 adc_oneshot_unit_handle_t adc1_single; 
-adc_continuous_handle_t adc2_cont;
+adc_continuous_handle_t adc2_cont = NULL;
+adc_cali_handle_t adc_calibration_cont = NULL;
 sdm_channel_handle_t dac = NULL;
 bool adc1_single_used = false;
+adc_ch_t adc_cont_inputs[ADC_SCAN_MAX_CH];		/*!< Channels sampled in continuous mode (in convertion order) */
+uint8_t adc_cont_n_inputs = 0;					/*!< Number of channels sampled in continuous mode */
+bool adc_cont_running = false;					/*!< Continuous mode conversions started */
+uint32_t adc_cont_frame_size;					/*!< DMA frame size in bytes (whole scans only) */
+void (*adc_cont_isr_p)(void*) = NULL;			/*!< Pointer to the frame end callback */
+void *adc_cont_user_data;						/*!< Frame end callback parameter */
+static uint8_t adc_cont_frame[ADC_CONT_FRAME_SIZE];	/*!< Raw DMA frame read from ring buffer */
+static uint32_t adc_cont_data[ADC_FRAMES_POOL * ADC_FRAME_SAMPLES];	/*!< Ring buffer storage (raw results) */
+static ring_buffer_t adc_cont_ring;				/*!< Frames moved from DMA ISR to reading task */
+static uint16_t adc_cali_lut[ADC_LUT_SIZE];		/*!< Calibration curve sampled every 64 raw counts (in mV) */
 /*==================[internal functions declaration]=========================*/
+static bool IRAM_ATTR adc_cont_conv_done_isr(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data){
+	uint32_t n_results = edata->size / SOC_ADC_DIGI_RESULT_BYTES;
+	// whole frames only: a partial one would shift the scan layout of every later frame
+	if(RingBufferSpace(&adc_cont_ring) >= n_results){
+		RingBufferPush(&adc_cont_ring, edata->conv_frame_buffer, n_results);
+	}else{
+		adc_cont_ring.dropped += n_results;
+	}
+	if(adc_cont_isr_p != NULL){
+		adc_cont_isr_p(adc_cont_user_data);
+	}
+	return false;
+}
 
 /*==================[internal data definition]===============================*/
 adc_oneshot_unit_init_cfg_t init_config_single = {
@@ -39,6 +68,168 @@ adc_oneshot_chan_cfg_t adc_config_single = {
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Converts a raw value to mV interpolating the sampled calibration curve
+ * 
+ * @param raw Raw conversion value
+ * @return Voltage in mV
+ */
+static inline uint16_t AnalogRawToMv(uint32_t raw){
+	const uint16_t *point = &adc_cali_lut[raw >> ADC_LUT_SHIFT];
+	uint32_t frac = raw & ((1 << ADC_LUT_SHIFT) - 1);
+	return point[0] + (((point[1] - point[0]) * frac) >> ADC_LUT_SHIFT);
+}
+
+/**
+ * @brief Creates the continuous mode handle (and calibration curve) for a scan group
+ * 
+ * @param inputs Channels of the scan group (in convertion order)
+ * @param n_inputs Number of channels of the scan group
+ * @param sample_frec Aggregate sample frequency (all channels)
+ * @param func_p Pointer to frame end callback
+ * @param param_p Pointer to frame end callback parameters
+ */
+static void AnalogContinuousConfig(const adc_ch_t *inputs, uint8_t n_inputs, uint32_t sample_frec, void *func_p, void *param_p){
+	adc_digi_pattern_config_t pattern[ADC_SCAN_MAX_CH];
+	int voltage;
+	if(adc_calibration_cont == NULL){
+		adc_cali_curve_fitting_config_t cali_config = {
+			.unit_id = ADC_UNIT_1,
+			.chan = (adc_channel_t)inputs[0],
+			.atten = ADC_ATTENUATION,
+			.bitwidth = ADC_BITWIDTH,
+		};
+		ESP_ERROR_CHECK(adc_cali_create_scheme_curve_fitting(&cali_config, &adc_calibration_cont));
+		for(uint32_t i = 0; i < ADC_LUT_SIZE; i++){
+			uint32_t raw = i << ADC_LUT_SHIFT;
+			adc_cali_raw_to_voltage(adc_calibration_cont, (raw > ADC_RAW_MAX) ? ADC_RAW_MAX : raw, &voltage);
+			adc_cali_lut[i] = voltage;
+		}
+	}
+	// frame size is rebuilt for each scan group, so every frame holds whole scans
+	if(adc2_cont != NULL){
+		// a running unit can not be deleted
+		if(adc_cont_running){
+			ESP_ERROR_CHECK(adc_continuous_stop(adc2_cont));
+			adc_cont_running = false;
+		}
+		ESP_ERROR_CHECK(adc_continuous_deinit(adc2_cont));
+		adc2_cont = NULL;
+	}
+	adc_cont_frame_size = (ADC_FRAME_SAMPLES / n_inputs) * n_inputs * SOC_ADC_DIGI_RESULT_BYTES;
+	// frames are copied to the ring buffer in the ISR, driver pool is only kept to the minimum
+	RingBufferInit(&adc_cont_ring, adc_cont_data, ADC_FRAMES_POOL * ADC_FRAME_SAMPLES, SOC_ADC_DIGI_RESULT_BYTES);
+	adc_continuous_handle_cfg_t handle_config = {
+		.max_store_buf_size = adc_cont_frame_size,
+		.conv_frame_size = adc_cont_frame_size,
+		.flags.flush_pool = true,
+	};
+	ESP_ERROR_CHECK(adc_continuous_new_handle(&handle_config, &adc2_cont));
+	adc_continuous_evt_cbs_t cont_cbs = {
+		.on_conv_done = adc_cont_conv_done_isr,
+	};
+	ESP_ERROR_CHECK(adc_continuous_register_event_callbacks(adc2_cont, &cont_cbs, NULL));
+	if(sample_frec < ADC_CONT_MIN_FREC){
+		sample_frec = ADC_CONT_MIN_FREC;
+	}else if(sample_frec > ADC_CONT_MAX_FREC){
+		sample_frec = ADC_CONT_MAX_FREC;
+	}
+	for(uint8_t k = 0; k < n_inputs; k++){
+		pattern[k].atten = ADC_ATTENUATION;
+		pattern[k].channel = (adc_channel_t)inputs[k];	// CHx enumeration matches ADC_CHANNEL_x
+		pattern[k].unit = ADC_UNIT_1;
+		pattern[k].bit_width = ADC_BITWIDTH;
+		adc_cont_inputs[k] = inputs[k];
+	}
+	adc_continuous_config_t cont_config = {
+		.pattern_num = n_inputs,
+		.adc_pattern = pattern,
+		.sample_freq_hz = sample_frec,
+		.conv_mode = ADC_CONV_SINGLE_UNIT_1,
+		.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2,
+	};
+	ESP_ERROR_CHECK(adc_continuous_config(adc2_cont, &cont_config));
+	adc_cont_n_inputs = n_inputs;
+	adc_cont_isr_p = func_p;
+	adc_cont_user_data = param_p;
+}
+
+/**
+ * @brief Finds the first conversion of a scan in a DMA frame
+ * 
+ * @param frame Raw DMA frame
+ * @param length Frame length in bytes
+ * @param scans Number of complete scans found after the first conversion
+ * @return Pointer to the first conversion of the first complete scan
+ */
+static const adc_digi_output_data_t * AnalogScanAlign(const uint8_t *frame, uint32_t length, uint16_t *scans){
+	const adc_digi_output_data_t *result = (const adc_digi_output_data_t*)frame;
+	uint32_t n_results = length / SOC_ADC_DIGI_RESULT_BYTES;
+	uint32_t offset = 0;
+	while((offset < n_results) && (result[offset].type2.channel != (uint32_t)adc_cont_inputs[0])){
+		offset++;
+	}
+	*scans = (n_results - offset) / adc_cont_n_inputs;
+	return &result[offset];
+}
+
+/**
+ * @brief Splits an interleaved DMA frame into one array per channel (in mV)
+ * 
+ * @param frame Raw DMA frame
+ * @param length Frame length in bytes
+ * @param values Array of pointers to each channel output array
+ * @return Number of samples stored in each channel array
+ */
+static uint16_t AnalogScanDemux(const uint8_t *frame, uint32_t length, uint16_t *values[]){
+	uint16_t scans;
+	const adc_digi_output_data_t *scan = AnalogScanAlign(frame, length, &scans);
+	const uint8_t stride = adc_cont_n_inputs;
+	for(uint8_t k = 0; k < stride; k++){
+		const adc_digi_output_data_t *in = &scan[k];
+		uint16_t *out = values[k];
+		for(uint16_t s = 0; s < scans; s++){
+			out[s] = AnalogRawToMv(in->type2.data);
+			in += stride;
+		}
+	}
+	return scans;
+}
+
+/**
+ * @brief Splits an interleaved DMA frame into one float array per channel (in mV)
+ * 
+ * @param frame Raw DMA frame
+ * @param length Frame length in bytes
+ * @param values Array of pointers to each channel output array
+ * @return Number of samples stored in each channel array
+ */
+static uint16_t AnalogScanDemuxFloat(const uint8_t *frame, uint32_t length, float *values[]){
+	uint16_t scans;
+	const adc_digi_output_data_t *scan = AnalogScanAlign(frame, length, &scans);
+	const uint8_t stride = adc_cont_n_inputs;
+	for(uint8_t k = 0; k < stride; k++){
+		const adc_digi_output_data_t *in = &scan[k];
+		float *out = values[k];
+		for(uint16_t s = 0; s < scans; s++){
+			out[s] = AnalogRawToMv(in->type2.data);
+			in += stride;
+		}
+	}
+	return scans;
+}
+
+/**
+ * @brief Reads one DMA frame from the ring buffer (non blocking)
+ * 
+ * @return Frame length in bytes (0 if no frame is ready)
+ */
+static uint32_t AnalogContinuousFrame(void){
+	if(adc2_cont == NULL){
+		return 0;
+	}
+	return RingBufferPop(&adc_cont_ring, adc_cont_frame, adc_cont_frame_size / SOC_ADC_DIGI_RESULT_BYTES) * SOC_ADC_DIGI_RESULT_BYTES;
+}
 
 /*==================[external functions definition]==========================*/
 
@@ -99,20 +290,7 @@ void AnalogInputInit(analog_input_config_t *config){
 			}
 		break;
 		case ADC_CONTINUOUS:
-			switch(config->input){
-				case CH0:
-
-				break;
-				case CH1:
-
-				break;
-				case CH2:
-
-				break;
-				case CH3:
-
-				break;
-			}
+			AnalogContinuousConfig(&config->input, 1, config->sample_frec, config->func_p, config->param_p);
 		break;
 	}
 }
@@ -145,15 +323,68 @@ void AnalogInputReadSingle(adc_ch_t channel, uint16_t *value){
 }
 
 void AnalogStartContinuous(adc_ch_t channel){
-
+	if((adc2_cont == NULL) || (channel != adc_cont_inputs[0])){
+		return;
+	}
+	if(!adc_cont_running){
+		adc_continuous_start(adc2_cont);
+		adc_cont_running = true;
+	}
 }
 
 void AnalogStopContinuous(adc_ch_t channel){
+	if((adc2_cont == NULL) || (channel != adc_cont_inputs[0])){
+		return;
+	}
+	if(adc_cont_running){
+		adc_continuous_stop(adc2_cont);
+		adc_cont_running = false;
+	}
+}
+
+uint16_t AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values){
+	uint16_t *planar[1] = {values};
+	uint32_t length;
+	if((adc_cont_n_inputs != 1) || (channel != adc_cont_inputs[0])){
+		return 0;
+	}
+	length = AnalogContinuousFrame();
+	return AnalogScanDemux(adc_cont_frame, length, planar);
+}
 
+void AnalogScanInit(analog_scan_config_t *config){
+	uint8_t n_inputs = config->n_inputs;
+	if(n_inputs == 0){
+		return;
+	}
+	if(n_inputs > ADC_SCAN_MAX_CH){
+		n_inputs = ADC_SCAN_MAX_CH;
+	}
+	AnalogContinuousConfig(config->inputs, n_inputs, config->sample_frec * n_inputs, config->func_p, config->param_p);
+}
+
+void AnalogScanStart(void){
+	if((adc2_cont != NULL) && !adc_cont_running){
+		adc_continuous_start(adc2_cont);
+		adc_cont_running = true;
+	}
 }
 
-void AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values){
+void AnalogScanStop(void){
+	if((adc2_cont != NULL) && adc_cont_running){
+		adc_continuous_stop(adc2_cont);
+		adc_cont_running = false;
+	}
+}
+
+uint16_t AnalogScanRead(uint16_t *values[]){
+	uint32_t length = AnalogContinuousFrame();
+	return AnalogScanDemux(adc_cont_frame, length, values);
+}
 
+uint16_t AnalogScanReadFloat(float *values[]){
+	uint32_t length = AnalogContinuousFrame();
+	return AnalogScanDemuxFloat(adc_cont_frame, length, values);
 }
 
 void AnalogOutputWrite(uint8_t value){
@@ -1,41 +1,282 @@
 /**
  * @file delay_mcu.c
  * @author Albano Peñalva (albano.penalva@uner.edu.ar)
- * @brief 
+ * @brief
  * @version 0.1
  * @date 2023-10-20
- * 
+ *
  * @copyright Copyright (c) 2023
- * 
+ *
  */
 
 /*==================[inclusions]=============================================*/
+#include <stddef.h>
+#include <stdbool.h>
 #include "delay_mcu.h"
-#include "driver/gptimer.h"
+#include "esp_timer.h"
+#include "esp_cpu.h"
+#include "esp_attr.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "esp_rom_sys.h"
 /*==================[macros and definitions]=================================*/
-#define US_RESOLUTION_HZ	1000000	/*!< 1usec */
 #define MSEC				1000	/*!< 1msec = 1000usec */
 #define SEC					1000000	/*!< 1sec = 1000msec */
-#define MIN_US				50	    /*!< minimun delay in usec to use gptimer */
-#define MIN_MS				100	    /*!< minimun delay in msec to use vTaskDelay */
+#define CALIBRATION_US		200		/*!< Time used to measure the CPU cycles per usec */
+#define CALIBRATION_RUNS	8		/*!< Runs used to measure the busy-wait overhead */
+#define ALARM_GUARD_US		2		/*!< Alarms closer than this are served together */
+#define WAKE_DECAY			4		/*!< Wake-up latency estimate decays 1/2^WAKE_DECAY per delay */
+
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
+#define ALARM_DISPATCH		ESP_TIMER_ISR	/*!< Alarm served from the timer ISR */
+#else
+#define ALARM_DISPATCH		ESP_TIMER_TASK	/*!< Alarm served from the esp_timer task */
+#endif
 /*==================[internal data declaration]==============================*/
-SemaphoreHandle_t xDelaySemaphore = NULL;
+/**
+ * @brief Task sleeping on the alarm queue (lives on the stack of the task)
+ */
+typedef struct delay_waiter {
+    int64_t alarm;                  /*!< Wake-up time (us, esp_timer time base) */
+    struct delay_waiter *next;      /*!< Next waiter (later alarm) */
+    SemaphoreHandle_t wake;         /*!< Given when the alarm expires */
+    StaticSemaphore_t wake_buffer;  /*!< wake storage */
+} delay_waiter_t;
+
+/**
+ * @brief Service state (it is initialized on first use)
+ */
+typedef enum {
+    DELAY_NOT_INIT,
+    DELAY_INITIALIZING,
+    DELAY_READY
+} delay_state_t;
 /*==================[internal functions declaration]=========================*/
-static bool IRAM_ATTR delay_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
-	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-	gptimer_stop(timer);
-	xSemaphoreGiveFromISR(xDelaySemaphore, &xHigherPriorityTaskWoken);
-	return (xHigherPriorityTaskWoken == pdTRUE);
-}
-/*==================[internal data definition]===============================*/
 
+/*==================[internal data definition]===============================*/
+static volatile delay_state_t delay_state = DELAY_NOT_INIT;     /*!< Service state */
+static esp_timer_handle_t delay_timer = NULL;                   /*!< Alarm of the first waiter */
+static delay_waiter_t *delay_queue = NULL;                      /*!< Waiters, sorted by alarm */
+static portMUX_TYPE delay_lock = portMUX_INITIALIZER_UNLOCKED;  /*!< Protects the queue and estimates */
+static uint32_t delay_cycles_us;                                /*!< CPU cycles per usec */
+static uint32_t delay_overhead;                                 /*!< Busy-wait call overhead (CPU cycles) */
+static uint32_t delay_wake_us = DELAY_WAKE_US;                  /*!< Wake-up latency estimate (us) */
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Busy-wait counting CPU cycles
+ *
+ * @param start     Cycle count at the start of the delay
+ * @param cycles    Cycles to wait from start
+ */
+static inline void IRAM_ATTR DelayCycles(uint32_t start, uint32_t cycles){
+    while((uint32_t)(esp_cpu_get_cycle_count() - start) < cycles){
+    }
+}
+
+/**
+ * @brief Busy-wait, without the call overhead (calibrated on init)
+ *
+ * @param start     Cycle count at the start of the delay
+ * @param usec      Microseconds from start (less than 2^32 CPU cycles)
+ */
+static inline void IRAM_ATTR DelayBusy(uint32_t start, uint32_t usec){
+    uint32_t cycles = usec * delay_cycles_us;
+    DelayCycles(start, (cycles > delay_overhead) ? cycles - delay_overhead : 0);
+}
+
+/**
+ * @brief Program the alarm of the first waiter (called with delay_lock taken)
+ */
+static void IRAM_ATTR DelayProgram(void){
+    int64_t timeout;
+
+    esp_timer_stop(delay_timer);
+    if(delay_queue != NULL){
+        timeout = delay_queue->alarm - esp_timer_get_time();
+        esp_timer_start_once(delay_timer, (timeout > 0) ? timeout : 0);
+    }
+}
+
+/**
+ * @brief Alarm callback: wakes every waiter whose alarm expired
+ */
+static void IRAM_ATTR DelayAlarm(void *param){
+    delay_waiter_t *expired = NULL, *last = NULL, *next;
+    int64_t now;
+
+    portENTER_CRITICAL_SAFE(&delay_lock);
+    now = esp_timer_get_time() + ALARM_GUARD_US;
+    while((delay_queue != NULL) && (delay_queue->alarm <= now)){
+        if(last == NULL){
+            expired = delay_queue;
+        }
+        last = delay_queue;
+        delay_queue = delay_queue->next;
+    }
+    if(last != NULL){
+        last->next = NULL;
+        DelayProgram();
+    }
+    portEXIT_CRITICAL_SAFE(&delay_lock);
+
+    /* Waiters return (and their nodes go out of scope) once woken */
+    while(expired != NULL){
+        next = expired->next;
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        xSemaphoreGiveFromISR(expired->wake, &xHigherPriorityTaskWoken);
+        if(xHigherPriorityTaskWoken == pdTRUE){
+            esp_timer_isr_dispatch_need_yield();
+        }
+#else
+        xSemaphoreGive(expired->wake);
+#endif
+        expired = next;
+    }
+}
+
+/**
+ * @brief Create the alarm and calibrate the busy-wait
+ */
+static void DelayInit(void){
+    esp_timer_create_args_t timer_args = {
+        .callback = DelayAlarm,
+        .arg = NULL,
+        .dispatch_method = ALARM_DISPATCH,
+        .name = "delay",
+        .skip_unhandled_events = true
+    };
+    uint32_t start, used, cycles;
+    int64_t time;
+
+    esp_timer_create(&timer_args, &delay_timer);
+    /* CPU cycles per usec, against the system timer */
+    time = esp_timer_get_time();
+    while(esp_timer_get_time() == time){
+    }
+    start = esp_cpu_get_cycle_count();
+    time += CALIBRATION_US + 1;
+    while(esp_timer_get_time() < time){
+    }
+    delay_cycles_us = (esp_cpu_get_cycle_count() - start + CALIBRATION_US / 2) / CALIBRATION_US;
+    /* Overhead of a busy-wait call: the shortest of a few runs */
+    delay_overhead = 0;
+    cycles = UINT32_MAX;
+    for(uint8_t i = 0; i < CALIBRATION_RUNS; i++){
+        start = esp_cpu_get_cycle_count();
+        DelayBusy(esp_cpu_get_cycle_count(), 1);
+        used = esp_cpu_get_cycle_count() - start - delay_cycles_us;
+        if(used < cycles){
+            cycles = used;
+        }
+    }
+    delay_overhead = cycles;
+}
+
+/**
+ * @brief Check that the service is initialized, initializing it if needed
+ *
+ * @return true if the service can be used (false from ISR before the first delay from a task,
+ * or while another task initializes it)
+ */
+static bool DelayReady(void){
+    bool init = false;
+
+    if(delay_state == DELAY_READY){
+        return true;
+    }
+    if(xPortInIsrContext()){
+        return false;
+    }
+    portENTER_CRITICAL(&delay_lock);
+    if(delay_state == DELAY_NOT_INIT){
+        delay_state = DELAY_INITIALIZING;
+        init = true;
+    }
+    portEXIT_CRITICAL(&delay_lock);
+    if(init){
+        DelayInit();
+        delay_state = DELAY_READY;
+    }
+    return (delay_state == DELAY_READY);
+}
+
+/**
+ * @brief Wait until a time, sleeping on the alarm queue when possible
+ *
+ * @param start     Cycle count at the start of the delay
+ * @param time      End of the delay (us, esp_timer time base)
+ */
+static void DelayWait(uint32_t start, int64_t time){
+    delay_waiter_t waiter;
+    int64_t now = esp_timer_get_time();
+    uint32_t late;
+    bool sleep = false;
+
+    if(time <= now){
+        return;
+    }
+    if(!DelayReady()){
+        esp_rom_delay_us(time - now);
+        return;
+    }
+    /* Tasks sleep until the wake-up latency before the end, and busy-wait the rest */
+    if(!xPortInIsrContext() && (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)){
+        waiter.wake = xSemaphoreCreateBinaryStatic(&waiter.wake_buffer);
+        portENTER_CRITICAL(&delay_lock);
+        /* Init or preemption may have taken part of the delay: start again from here */
+        start = esp_cpu_get_cycle_count();
+        now = esp_timer_get_time();
+        waiter.alarm = time - delay_wake_us;
+        if(waiter.alarm >= now + DELAY_SLEEP_MIN_US){
+            delay_waiter_t **prev = &delay_queue;
+            while((*prev != NULL) && ((*prev)->alarm <= waiter.alarm)){
+                prev = &(*prev)->next;
+            }
+            waiter.next = *prev;
+            *prev = &waiter;
+            if(delay_queue == &waiter){
+                DelayProgram();
+            }
+            sleep = true;
+        }
+        portEXIT_CRITICAL(&delay_lock);
+    }
+    if(sleep){
+        xSemaphoreTake(waiter.wake, portMAX_DELAY);
+        now = esp_timer_get_time();
+        /* Estimate follows latency rises at once, and falls slowly */
+        late = (now > waiter.alarm) ? now - waiter.alarm : 0;
+        if(late > DELAY_WAKE_MAX_US){
+            late = DELAY_WAKE_MAX_US;
+        }
+        portENTER_CRITICAL(&delay_lock);
+        if(late > delay_wake_us){
+            delay_wake_us = late;
+        }
+        else{
+            delay_wake_us -= (delay_wake_us - late) >> WAKE_DECAY;
+        }
+        portEXIT_CRITICAL(&delay_lock);
+        if(time > now){
+            DelayBusy(esp_cpu_get_cycle_count(), time - now);
+        }
+        return;
+    }
+    /* Busy-wait (from ISR, or too short to sleep) in steps shorter than the cycle counter wrap */
+    if(time <= now){
+        return;
+    }
+    while(time - now > MSEC){
+        DelayBusy(start, MSEC);
+        start += MSEC * delay_cycles_us;
+        now += MSEC;
+    }
+    DelayBusy(start, time - now);
+}
 
 /*==================[external functions definition]==========================*/
 void DelaySec(uint16_t sec){
@@ -43,73 +284,27 @@ void DelaySec(uint16_t sec){
 }
 
 void DelayMs(uint16_t msec){
-    // If the delay is too short, use the ESP32's internal timer
-    if(msec<=MIN_MS){ 
-        if(xDelaySemaphore == NULL){
-            xDelaySemaphore = xSemaphoreCreateBinary();
-            gptimer_handle_t delay_timer = NULL;
-            gptimer_config_t delay_timer_config = {
-                .clk_src = GPTIMER_CLK_SRC_DEFAULT,
-                .direction = GPTIMER_COUNT_UP,
-                .resolution_hz = US_RESOLUTION_HZ,
-            };
-            gptimer_new_timer(&delay_timer_config, &delay_timer);
-            gptimer_event_callbacks_t delay_alarm = {
-                .on_alarm = delay_isr,
-            };
-            gptimer_register_event_callbacks(delay_timer, &delay_alarm, NULL);
-            gptimer_enable(delay_timer);
-            gptimer_alarm_config_t alarm_config = {
-                .alarm_count = msec*MSEC, 
-            };
-            gptimer_set_alarm_action(delay_timer, &alarm_config);
-            gptimer_start(delay_timer);
-            if(xDelaySemaphore != NULL){
-                xSemaphoreTake(xDelaySemaphore, portMAX_DELAY);
-                xDelaySemaphore = NULL;
-            }
-            gptimer_disable(delay_timer);
-            gptimer_del_timer(delay_timer);
-        }
-    }else{       
-        // If the delay is longer than the minimum delay, use vTaskDelay
-        vTaskDelay(msec / portTICK_PERIOD_MS);
-    }
+    uint32_t start = esp_cpu_get_cycle_count();
+    DelayWait(start, esp_timer_get_time() + (int64_t)msec * MSEC);
 }
 
 void DelayUs(uint16_t usec){
-    if(usec<=MIN_US){
-        /* If the delay is too short, use the ROM delay function */
-        esp_rom_delay_us(usec);
-    }else{
-        /* If the delay is longer than the minimum, use the ESP32's internal timer */
-        if(xDelaySemaphore == NULL){
-	        xDelaySemaphore = xSemaphoreCreateBinary();
-            gptimer_handle_t delay_timer = NULL;
-            gptimer_config_t delay_timer_config = {
-                .clk_src = GPTIMER_CLK_SRC_DEFAULT,
-                .direction = GPTIMER_COUNT_UP,
-                .resolution_hz = US_RESOLUTION_HZ,
-            };
-            gptimer_new_timer(&delay_timer_config, &delay_timer);
-            gptimer_event_callbacks_t delay_alarm = {
-                .on_alarm = delay_isr,
-            };
-            gptimer_register_event_callbacks(delay_timer, &delay_alarm, NULL);
-            gptimer_enable(delay_timer);
-            gptimer_alarm_config_t alarm_config = {
-                .alarm_count = usec, 
-            };
-            gptimer_set_alarm_action(delay_timer, &alarm_config);
-            gptimer_start(delay_timer);
-            if(xDelaySemaphore != NULL){
-                /* Wait for the timer to finish */
-                xSemaphoreTake(xDelaySemaphore, portMAX_DELAY);
-                xDelaySemaphore = NULL;
-            }
-            gptimer_disable(delay_timer);
-            gptimer_del_timer(delay_timer);
-        }
+    uint32_t start = esp_cpu_get_cycle_count();
+    if((delay_state == DELAY_READY) && (usec < delay_wake_us + DELAY_SLEEP_MIN_US)){
+        /* Short delays: only the calibrated busy-wait */
+        DelayBusy(start, usec);
     }
+    else{
+        DelayWait(start, esp_timer_get_time() + usec);
+    }
+}
+
+void DelayUntilUs(int64_t time){
+    DelayWait(esp_cpu_get_cycle_count(), time);
+}
+
+uint32_t DelayGetWakeLatency(void){
+    return delay_wake_us;
 }
 
+/*==================[end of file]============================================*/
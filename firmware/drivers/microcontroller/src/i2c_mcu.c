@@ -143,6 +143,36 @@ int8_t I2C_readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *
 	return length;
 }
 
+/** Read a long block of bytes from an 8-bit device register (single transaction).
+ * @param devAddr I2C slave device address
+ * @param regAddr First register regAddr to read from
+ * @param length Number of bytes to read
+ * @param data Buffer to store read data in
+ * @param timeout Read timeout in milliseconds
+ * @return Number of bytes read (0 on error)
+ */
+uint16_t I2C_readBurst(uint8_t devAddr, uint8_t regAddr, uint16_t length, uint8_t *data, uint16_t timeout) {
+	i2c_cmd_handle_t cmd;
+	esp_err_t rc;
+
+	if(length == 0){
+		return 0;
+	}
+	cmd = i2c_cmd_link_create();
+	ESP_ERROR_CHECK(i2c_master_start(cmd));
+	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, (devAddr << 1) | I2C_MASTER_WRITE, 1));
+	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, regAddr, 1));
+	/* Repeated start: the register stays selected */
+	ESP_ERROR_CHECK(i2c_master_start(cmd));
+	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, (devAddr << 1) | I2C_MASTER_READ, 1));
+	ESP_ERROR_CHECK(i2c_master_read(cmd, data, length, I2C_MASTER_LAST_NACK));
+	ESP_ERROR_CHECK(i2c_master_stop(cmd));
+	rc = i2c_master_cmd_begin(I2C_NUM, cmd, timeout/portTICK_PERIOD_MS);
+	i2c_cmd_link_delete(cmd);
+
+	return (rc == ESP_OK) ? length : 0;
+}
+
 bool I2C_writeWord(uint8_t devAddr, uint8_t regAddr, uint16_t data){
 
 	uint8_t data1[] = {(uint8_t)(data>>8), (uint8_t)(data & 0xff)};
@@ -0,0 +1,158 @@
+/**
+ * @file ring_buffer_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "ring_buffer_mcu.h"
+#include <string.h>
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+/*==================[macros and definitions]=================================*/
+/* Indexes are free running: only the producer writes head and only the consumer writes tail.
+ * Acquire/release ordering guarantees data is visible before the index that publishes it. */
+#define LOAD_ACQUIRE(x)		__atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(x, v)	__atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static void IRAM_ATTR RingBufferNotifyFromISR(ring_buffer_t *rb, bool *task_woken){
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	if(rb->consumer != NULL){
+		vTaskNotifyGiveFromISR((TaskHandle_t)rb->consumer, &xHigherPriorityTaskWoken);
+	}
+	if(task_woken != NULL){
+		*task_woken = (xHigherPriorityTaskWoken == pdTRUE);
+	}
+}
+
+/*==================[external functions definition]==========================*/
+bool RingBufferInit(ring_buffer_t *rb, void *buffer, uint32_t size, uint16_t elem_size){
+	if((size == 0) || ((size & (size - 1)) != 0)){
+		return false;
+	}
+	rb->buffer = buffer;
+	rb->size = size;
+	rb->mask = size - 1;
+	rb->elem_size = elem_size;
+	rb->head = 0;
+	rb->tail = 0;
+	rb->dropped = 0;
+	rb->consumer = NULL;
+	return true;
+}
+
+void RingBufferReset(ring_buffer_t *rb){
+	rb->head = 0;
+	rb->tail = 0;
+	rb->dropped = 0;
+}
+
+void RingBufferSetConsumer(ring_buffer_t *rb, void *task){
+	rb->consumer = task;
+}
+
+uint32_t IRAM_ATTR RingBufferCount(ring_buffer_t *rb){
+	return LOAD_ACQUIRE(rb->head) - LOAD_ACQUIRE(rb->tail);
+}
+
+uint32_t IRAM_ATTR RingBufferSpace(ring_buffer_t *rb){
+	return rb->size - (LOAD_ACQUIRE(rb->head) - LOAD_ACQUIRE(rb->tail));
+}
+
+uint32_t IRAM_ATTR RingBufferPush(ring_buffer_t *rb, const void *data, uint32_t n){
+	uint32_t head = rb->head;
+	uint32_t space = rb->size - (head - LOAD_ACQUIRE(rb->tail));
+	uint32_t first, index;
+	if(n > space){
+		rb->dropped += n - space;
+		n = space;
+	}
+	index = head & rb->mask;
+	first = rb->size - index;
+	if(first > n){
+		first = n;
+	}
+	memcpy(&rb->buffer[index * rb->elem_size], data, first * rb->elem_size);
+	memcpy(rb->buffer, (const uint8_t*)data + first * rb->elem_size, (n - first) * rb->elem_size);
+	STORE_RELEASE(rb->head, head + n);
+	return n;
+}
+
+uint32_t IRAM_ATTR RingBufferPushFromISR(ring_buffer_t *rb, const void *data, uint32_t n, bool *task_woken){
+	n = RingBufferPush(rb, data, n);
+	RingBufferNotifyFromISR(rb, task_woken);
+	return n;
+}
+
+uint32_t IRAM_ATTR RingBufferPop(ring_buffer_t *rb, void *data, uint32_t n){
+	uint32_t tail = rb->tail;
+	uint32_t count = LOAD_ACQUIRE(rb->head) - tail;
+	uint32_t first, index;
+	if(n > count){
+		n = count;
+	}
+	index = tail & rb->mask;
+	first = rb->size - index;
+	if(first > n){
+		first = n;
+	}
+	memcpy(data, &rb->buffer[index * rb->elem_size], first * rb->elem_size);
+	memcpy((uint8_t*)data + first * rb->elem_size, rb->buffer, (n - first) * rb->elem_size);
+	STORE_RELEASE(rb->tail, tail + n);
+	return n;
+}
+
+void * IRAM_ATTR RingBufferWriteReserve(ring_buffer_t *rb, uint32_t *n){
+	uint32_t head = rb->head;
+	uint32_t space = rb->size - (head - LOAD_ACQUIRE(rb->tail));
+	uint32_t index = head & rb->mask;
+	uint32_t contiguous = rb->size - index;
+	*n = (space < contiguous) ? space : contiguous;
+	return &rb->buffer[index * rb->elem_size];
+}
+
+void IRAM_ATTR RingBufferWriteCommit(ring_buffer_t *rb, uint32_t n){
+	STORE_RELEASE(rb->head, rb->head + n);
+}
+
+void IRAM_ATTR RingBufferWriteCommitFromISR(ring_buffer_t *rb, uint32_t n, bool *task_woken){
+	RingBufferWriteCommit(rb, n);
+	RingBufferNotifyFromISR(rb, task_woken);
+}
+
+const void * IRAM_ATTR RingBufferReadSpan(ring_buffer_t *rb, uint32_t *n){
+	uint32_t tail = rb->tail;
+	uint32_t count = LOAD_ACQUIRE(rb->head) - tail;
+	uint32_t index = tail & rb->mask;
+	uint32_t contiguous = rb->size - index;
+	*n = (count < contiguous) ? count : contiguous;
+	return &rb->buffer[index * rb->elem_size];
+}
+
+void IRAM_ATTR RingBufferReadRelease(ring_buffer_t *rb, uint32_t n){
+	STORE_RELEASE(rb->tail, rb->tail + n);
+}
+
+bool RingBufferWait(ring_buffer_t *rb, uint32_t timeout_ms){
+	if(RingBufferCount(rb) > 0){
+		return true;
+	}
+	ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms));
+	return (RingBufferCount(rb) > 0);
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,194 @@
+/**
+ * @file rmt_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "rmt_mcu.h"
+#include <stdint.h>
+#include <stddef.h>
+#include "driver/rmt_tx.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_attr.h"
+/*==================[macros and definitions]=================================*/
+#define RMT_MEM_SYMBOLS		96		/*!< RMT memory used by the channel (2 blocks of 48 symbols): refilled from ISR while sending */
+#define RMT_MAX_DURATION	32767	/*!< Max. duration of half a symbol (15 bits) */
+/*==================[internal data declaration]==============================*/
+/**
+ * @brief Frame encoder: data bits followed by the reset time
+ */
+typedef struct {
+	rmt_encoder_t base;				/*!< Encoder interface (must be the first member) */
+	rmt_encoder_t *bytes_encoder;	/*!< Data bits */
+	rmt_encoder_t *copy_encoder;	/*!< Reset symbol */
+	rmt_symbol_word_t reset_code;	/*!< Low level during reset time */
+	uint8_t state;					/*!< 0: encoding data, 1: encoding reset */
+} rmt_frame_encoder_t;
+
+static rmt_channel_handle_t rmt_channel = NULL;	/*!< TX channel (NULL if not initialized) */
+static rmt_frame_encoder_t rmt_encoder;			/*!< Frame encoder */
+static void (*rmt_isr_p)(void*);				/*!< Frame end callback */
+static void *rmt_user_data;						/*!< Frame end callback parameter */
+static volatile uint32_t rmt_queued;			/*!< Frames queued */
+static volatile uint32_t rmt_sent;				/*!< Frames sent */
+static SemaphoreHandle_t rmt_done = NULL;		/*!< Given at the end of each frame */
+static StaticSemaphore_t rmt_done_buffer;		/*!< rmt_done storage */
+/*==================[internal functions declaration]=========================*/
+/**
+ * @brief Encode a frame (called by the RMT driver each time its memory must be refilled)
+ */
+static size_t IRAM_ATTR RmtEncode(rmt_encoder_t *encoder, rmt_channel_handle_t channel, const void *data,
+	size_t data_size, rmt_encode_state_t *ret_state){
+	rmt_encode_state_t session_state = RMT_ENCODING_RESET;
+	rmt_encode_state_t state = RMT_ENCODING_RESET;
+	size_t encoded_symbols = 0;
+
+	if(rmt_encoder.state == 0){
+		encoded_symbols += rmt_encoder.bytes_encoder->encode(rmt_encoder.bytes_encoder, channel, data, data_size, &session_state);
+		if(session_state & RMT_ENCODING_COMPLETE){
+			rmt_encoder.state = 1;
+		}
+		if(session_state & RMT_ENCODING_MEM_FULL){
+			*ret_state = RMT_ENCODING_MEM_FULL;
+			return encoded_symbols;
+		}
+	}
+	if(rmt_encoder.state == 1){
+		encoded_symbols += rmt_encoder.copy_encoder->encode(rmt_encoder.copy_encoder, channel, &rmt_encoder.reset_code,
+			sizeof(rmt_encoder.reset_code), &session_state);
+		if(session_state & RMT_ENCODING_COMPLETE){
+			rmt_encoder.state = 0;
+			state |= RMT_ENCODING_COMPLETE;
+		}
+		if(session_state & RMT_ENCODING_MEM_FULL){
+			state |= RMT_ENCODING_MEM_FULL;
+		}
+	}
+	*ret_state = state;
+	return encoded_symbols;
+}
+
+static esp_err_t RmtEncoderReset(rmt_encoder_t *encoder){
+	rmt_encoder_reset(rmt_encoder.bytes_encoder);
+	rmt_encoder_reset(rmt_encoder.copy_encoder);
+	rmt_encoder.state = 0;
+	return ESP_OK;
+}
+
+static esp_err_t RmtEncoderDel(rmt_encoder_t *encoder){
+	rmt_del_encoder(rmt_encoder.bytes_encoder);
+	rmt_del_encoder(rmt_encoder.copy_encoder);
+	return ESP_OK;
+}
+
+static bool IRAM_ATTR RmtDone(rmt_channel_handle_t channel, const rmt_tx_done_event_data_t *edata, void *user_ctx){
+	BaseType_t task_woken = pdFALSE;
+	rmt_sent++;
+	xSemaphoreGiveFromISR(rmt_done, &task_woken);
+	if(rmt_isr_p != NULL){
+		rmt_isr_p(rmt_user_data);
+	}
+	return task_woken == pdTRUE;
+}
+/*==================[external data definition]===============================*/
+
+/*==================[external functions definition]==========================*/
+uint8_t RmtInit(rmt_mcu_config_t *rmt){
+	rmt_tx_channel_config_t channel_config = {
+		.gpio_num = rmt->pin,
+		.clk_src = RMT_CLK_SRC_DEFAULT,
+		.resolution_hz = rmt->resolution,
+		.mem_block_symbols = RMT_MEM_SYMBOLS,
+		.trans_queue_depth = RMT_QUEUE_SIZE,
+	};
+	rmt_bytes_encoder_config_t bytes_config = {
+		.bit0 = {.level0 = 1, .duration0 = rmt->bit0_high, .level1 = 0, .duration1 = rmt->bit0_low},
+		.bit1 = {.level0 = 1, .duration0 = rmt->bit1_high, .level1 = 0, .duration1 = rmt->bit1_low},
+		.flags.msb_first = 1,
+	};
+	rmt_copy_encoder_config_t copy_config = {};
+	rmt_tx_event_callbacks_t callbacks = {
+		.on_trans_done = RmtDone,
+	};
+	uint32_t reset = rmt->reset;
+
+	if(rmt_channel != NULL){
+		RmtDeInit();
+	}
+	if(rmt_done == NULL){
+		rmt_done = xSemaphoreCreateBinaryStatic(&rmt_done_buffer);
+	}
+	rmt_isr_p = rmt->func_p;
+	rmt_user_data = rmt->param_p;
+	rmt_queued = 0;
+	rmt_sent = 0;
+	if(rmt_new_tx_channel(&channel_config, &rmt_channel) != ESP_OK){
+		rmt_channel = NULL;
+		return 1;
+	}
+	rmt_new_bytes_encoder(&bytes_config, &rmt_encoder.bytes_encoder);
+	rmt_new_copy_encoder(&copy_config, &rmt_encoder.copy_encoder);
+	rmt_encoder.base.encode = RmtEncode;
+	rmt_encoder.base.reset = RmtEncoderReset;
+	rmt_encoder.base.del = RmtEncoderDel;
+	rmt_encoder.state = 0;
+	/* Reset time is split in both halves of a symbol (a zero duration would end the frame) */
+	if(reset < 2){
+		reset = 2;
+	}
+	if(reset > 2 * RMT_MAX_DURATION){
+		reset = 2 * RMT_MAX_DURATION;
+	}
+	rmt_encoder.reset_code.level0 = 0;
+	rmt_encoder.reset_code.duration0 = reset / 2;
+	rmt_encoder.reset_code.level1 = 0;
+	rmt_encoder.reset_code.duration1 = reset - reset / 2;
+	rmt_tx_register_event_callbacks(rmt_channel, &callbacks, NULL);
+	rmt_enable(rmt_channel);
+	return 0;
+}
+
+void RmtWrite(const uint8_t *tx_buffer, uint32_t tx_buffer_size){
+	rmt_transmit_config_t tx_config = {
+		.loop_count = 0,
+	};
+	if(rmt_channel == NULL){
+		return;
+	}
+	RmtWait(RMT_QUEUE_SIZE - 1);
+	/* Counted before the call (the frame can end before it returns), uncounted if not queued */
+	rmt_queued++;
+	if(rmt_transmit(rmt_channel, &rmt_encoder.base, tx_buffer, tx_buffer_size, &tx_config) != ESP_OK){
+		rmt_queued--;
+	}
+}
+
+void RmtWait(uint8_t max_pending){
+	while(RmtPending() > max_pending){
+		xSemaphoreTake(rmt_done, portMAX_DELAY);
+	}
+}
+
+uint8_t RmtPending(void){
+	return rmt_queued - rmt_sent;
+}
+
+uint8_t RmtDeInit(void){
+	if(rmt_channel == NULL){
+		return 0;
+	}
+	RmtWait(0);
+	rmt_disable(rmt_channel);
+	rmt_del_channel(rmt_channel);
+	rmt_del_encoder(&rmt_encoder.base);
+	rmt_channel = NULL;
+	return 0;
+}
+/*==================[end of file]============================================*/
@@ -0,0 +1,325 @@
+/**
+ * @file soft_timer_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "soft_timer_mcu.h"
+#include <stddef.h>
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+/*==================[macros and definitions]=================================*/
+#define SLOT_MASK			(SOFT_TIMER_SLOTS - 1)
+#define WHEEL_RANGE			(1UL << (SOFT_TIMER_LEVELS * SOFT_TIMER_SLOT_BITS))	/*!< Ticks covered by the wheel */
+#define TASK_STACK_SIZE		2048		/*!< Callbacks task stack (bytes) */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+/* The wheel: level n slot i holds the timers that expire on a tick whose bits n * SLOT_BITS
+ * and up match wheel_tick, and whose bits [n * SLOT_BITS, (n + 1) * SLOT_BITS) are i. When
+ * level 0 wraps, the next slot of level 1 is spread over level 0, and so on. */
+static soft_timer_t *wheel[SOFT_TIMER_LEVELS][SOFT_TIMER_SLOTS];	/*!< Timer lists of each slot */
+static uint32_t wheel_tick;											/*!< Next tick to be processed */
+static uint32_t wheel_tick_us;										/*!< Tick period (us) */
+static portMUX_TYPE wheel_lock = portMUX_INITIALIZER_UNLOCKED;		/*!< Protects the wheel and the task queue */
+static soft_timer_t *task_head = NULL;								/*!< Timers waiting for the driver task */
+static soft_timer_t *task_tail = NULL;								/*!< Last timer waiting for the driver task */
+static TaskHandle_t soft_timer_task = NULL;							/*!< Runs SOFT_TIMER_TASK callbacks */
+static StaticTask_t soft_timer_task_buffer;							/*!< soft_timer_task storage */
+static StackType_t soft_timer_stack[TASK_STACK_SIZE];				/*!< soft_timer_task stack */
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Put a running timer in its wheel slot (called with wheel_lock taken)
+ *
+ * @param timer Timer, with its expiration tick set
+ */
+static void IRAM_ATTR WheelInsert(soft_timer_t *timer){
+	uint32_t expires = timer->expires;
+	uint32_t delta = expires - wheel_tick;
+	soft_timer_t **slot;
+	uint8_t level = 0;
+
+	if((int32_t)delta < 0){
+		/* Already expired: next tick */
+		expires = wheel_tick;
+	}
+	else if(delta >= WHEEL_RANGE){
+		/* Out of range: last slot reachable, requeued from there */
+		expires = wheel_tick + WHEEL_RANGE - 1;
+		delta = WHEEL_RANGE - 1;
+	}
+	while((level < SOFT_TIMER_LEVELS - 1) && (delta >= (1UL << ((level + 1) * SOFT_TIMER_SLOT_BITS)))){
+		level++;
+	}
+	slot = &wheel[level][(expires >> (level * SOFT_TIMER_SLOT_BITS)) & SLOT_MASK];
+	timer->next = *slot;
+	if(timer->next != NULL){
+		timer->next->pprev = &timer->next;
+	}
+	*slot = timer;
+	timer->pprev = slot;
+}
+
+/**
+ * @brief Take a timer out of the wheel (called with wheel_lock taken)
+ *
+ * @param timer Running timer
+ */
+static void IRAM_ATTR WheelRemove(soft_timer_t *timer){
+	*timer->pprev = timer->next;
+	if(timer->next != NULL){
+		timer->next->pprev = timer->pprev;
+	}
+	timer->pprev = NULL;
+}
+
+/**
+ * @brief Spread the timers of a slot over the lower levels (called with wheel_lock taken)
+ *
+ * @param level Wheel level
+ * @param index Slot
+ */
+static void IRAM_ATTR WheelCascade(uint8_t level, uint32_t index){
+	soft_timer_t *timer = wheel[level][index], *next;
+
+	wheel[level][index] = NULL;
+	while(timer != NULL){
+		next = timer->next;
+		WheelInsert(timer);
+		timer = next;
+	}
+}
+
+/**
+ * @brief Next expiration of a periodic timer, a whole number of periods after the last one
+ * (called with wheel_lock taken)
+ *
+ * @param timer Periodic timer
+ * @param tick Tick being processed
+ */
+static void IRAM_ATTR TimerReschedule(soft_timer_t *timer, uint32_t tick){
+	do{
+		timer->expires += timer->period;
+		timer->rem_acc += timer->period_rem;
+		if(timer->rem_acc >= wheel_tick_us){
+			timer->rem_acc -= wheel_tick_us;
+			timer->expires++;
+		}
+		if((int32_t)(timer->expires - tick) <= 0){
+			timer->overruns++;
+		}
+	} while((int32_t)(timer->expires - tick) <= 0);
+	WheelInsert(timer);
+}
+
+/**
+ * @brief Take a timer out of the driver task queue (called with wheel_lock taken)
+ *
+ * @param timer Timer waiting for the driver task
+ */
+static void IRAM_ATTR TaskQueueRemove(soft_timer_t *timer){
+	soft_timer_t **link = &task_head, *prev = NULL;
+
+	while(*link != timer){
+		prev = *link;
+		link = &prev->task_next;
+	}
+	*link = timer->task_next;
+	if(task_tail == timer){
+		task_tail = prev;
+	}
+	timer->task_next = NULL;
+	timer->queued = false;
+}
+
+/**
+ * @brief Tick: expires the timers of the current tick
+ */
+static void IRAM_ATTR SoftTimerTick(void *param){
+	soft_timer_t *timer, *expired;
+	uint32_t tick, index;
+	bool notify = false;
+
+	portENTER_CRITICAL_SAFE(&wheel_lock);
+	tick = wheel_tick;
+	index = tick & SLOT_MASK;
+	/* Level 0 wrapped: bring down the next slot of the upper levels */
+	for(uint8_t level = 1; (level < SOFT_TIMER_LEVELS) && (index == 0); level++){
+		index = (tick >> (level * SOFT_TIMER_SLOT_BITS)) & SLOT_MASK;
+		WheelCascade(level, index);
+	}
+	index = tick & SLOT_MASK;
+	wheel_tick++;
+	/* Slot detached before running it: timers started or rescheduled a whole turn of level 0
+	 * later go to the same slot. Callbacks can still stop the timers of this list. */
+	expired = wheel[0][index];
+	wheel[0][index] = NULL;
+	if(expired != NULL){
+		expired->pprev = &expired;
+	}
+	while((timer = expired) != NULL){
+		WheelRemove(timer);
+		if(timer->mode == SOFT_TIMER_PERIODIC){
+			TimerReschedule(timer, tick);
+		}
+		if(timer->context == SOFT_TIMER_ISR){
+			portEXIT_CRITICAL_SAFE(&wheel_lock);
+			timer->func_p(timer->param_p);
+			portENTER_CRITICAL_SAFE(&wheel_lock);
+		}
+		else{
+			if(timer->pending > 0){
+				timer->overruns++;
+			}
+			else{
+				timer->pending = 1;
+			}
+			if(!timer->queued){
+				timer->queued = true;
+				timer->task_next = NULL;
+				if(task_tail != NULL){
+					task_tail->task_next = timer;
+				}
+				else{
+					task_head = timer;
+				}
+				task_tail = timer;
+			}
+			notify = true;
+		}
+	}
+	portEXIT_CRITICAL_SAFE(&wheel_lock);
+	/* Timer driver yields on return */
+	if(notify){
+		vTaskNotifyGiveFromISR(soft_timer_task, NULL);
+	}
+}
+
+/**
+ * @brief Driver task: runs the callbacks of the SOFT_TIMER_TASK timers, in order of expiration
+ */
+static void SoftTimerTask(void *param){
+	soft_timer_t *timer;
+	bool call;
+
+	while(true){
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		while(true){
+			portENTER_CRITICAL(&wheel_lock);
+			timer = task_head;
+			if(timer != NULL){
+				task_head = timer->task_next;
+				if(task_head == NULL){
+					task_tail = NULL;
+				}
+				timer->queued = false;
+				/* Stopped timers have no pending expirations */
+				call = (timer->pending > 0);
+				timer->pending = 0;
+			}
+			portEXIT_CRITICAL(&wheel_lock);
+			if(timer == NULL){
+				break;
+			}
+			if(call){
+				timer->func_p(timer->param_p);
+			}
+		}
+	}
+}
+
+/*==================[external functions definition]==========================*/
+bool SoftTimerServiceInit(const soft_timer_service_config_t *config){
+	timer_config_t timer = {
+		.timer = config->timer,
+		.period = config->tick,
+		.func_p = SoftTimerTick,
+		.param_p = NULL
+	};
+
+	if((soft_timer_task != NULL) || (config->tick == 0)){
+		return false;
+	}
+	wheel_tick_us = config->tick;
+	wheel_tick = 0;
+	soft_timer_task = xTaskCreateStatic(SoftTimerTask, "soft_timer", TASK_STACK_SIZE, NULL,
+		config->priority, soft_timer_stack, &soft_timer_task_buffer);
+	TimerInit(&timer);
+	TimerStart(config->timer);
+	return true;
+}
+
+void SoftTimerInit(soft_timer_t *timer, const soft_timer_config_t *config){
+	timer->next = NULL;
+	timer->pprev = NULL;
+	timer->task_next = NULL;
+	timer->expires = 0;
+	timer->overruns = 0;
+	timer->pending = 0;
+	timer->queued = false;
+	timer->mode = config->mode;
+	timer->context = config->context;
+	timer->func_p = config->func_p;
+	timer->param_p = config->param_p;
+	SoftTimerUpdatePeriod(timer, config->period);
+}
+
+void SoftTimerStart(soft_timer_t *timer){
+	portENTER_CRITICAL_SAFE(&wheel_lock);
+	if(timer->pprev != NULL){
+		WheelRemove(timer);
+	}
+	/* Remainder starts at half a tick: periods rounded to the nearest tick */
+	timer->rem_acc = wheel_tick_us / 2 + timer->period_rem;
+	timer->expires = wheel_tick + timer->period - 1;
+	if(timer->rem_acc >= wheel_tick_us){
+		timer->rem_acc -= wheel_tick_us;
+		timer->expires++;
+	}
+	WheelInsert(timer);
+	portEXIT_CRITICAL_SAFE(&wheel_lock);
+}
+
+void SoftTimerStop(soft_timer_t *timer){
+	portENTER_CRITICAL_SAFE(&wheel_lock);
+	if(timer->pprev != NULL){
+		WheelRemove(timer);
+	}
+	/* Unlinked: the handle can be reused or go out of scope once stopped */
+	if(timer->queued){
+		TaskQueueRemove(timer);
+	}
+	timer->pending = 0;
+	portEXIT_CRITICAL_SAFE(&wheel_lock);
+}
+
+void SoftTimerUpdatePeriod(soft_timer_t *timer, uint32_t period){
+	if(period < wheel_tick_us){
+		period = wheel_tick_us;
+	}
+	portENTER_CRITICAL_SAFE(&wheel_lock);
+	timer->period = period / wheel_tick_us;
+	timer->period_rem = period % wheel_tick_us;
+	portEXIT_CRITICAL_SAFE(&wheel_lock);
+}
+
+bool SoftTimerIsRunning(const soft_timer_t *timer){
+	return (timer->pprev != NULL);
+}
+
+uint32_t SoftTimerGetOverruns(const soft_timer_t *timer){
+	return timer->overruns;
+}
+
+/*==================[end of file]============================================*/
@@ -22,6 +22,8 @@
 #define PIN_NUM_CS1		GPIO_19	/*!<  */
 #define PIN_NUM_CS2		GPIO_18	/*!<  */
 #define PIN_NUM_CS3		GPIO_9	/*!<  */
+#define SPI_QUEUE_SIZE	8		/*!< Max. number of queued transactions per device */
+#define SPI_DEVICES		3		/*!< Number of SPI devices */
 /*==================[internal data declaration]==============================*/
 spi_device_handle_t spi_1, spi_2, spi_3;
 const spi_bus_config_t bus_cfg = {
@@ -39,21 +41,41 @@ void (*spi_3_isr_p)(void*);	/*!<  */
 void *spi_1_user_data;	    /*!<  */
 void *spi_2_user_data;	    /*!<  */
 void *spi_3_user_data;	    /*!<  */
+static spi_transaction_t spi_queue_trans[SPI_DEVICES][SPI_QUEUE_SIZE];	/*!< Transactions of SpiWriteQueued (must live until done) */
+static uint8_t spi_queue_head[SPI_DEVICES];								/*!< Next free transaction */
+static uint8_t spi_queue_pending[SPI_DEVICES];							/*!< Transactions queued and not yet collected */
 /*==================[internal functions declaration]=========================*/
+/* Queued transactions have a non NULL user field: the callback is called for them in any transfer mode */
 static void IRAM_ATTR spi_1_isr(spi_transaction_t *t){
-	spi_1_isr_p(spi_1_user_data);
+	if((transfer_mode_1 == SPI_INTERRUPT) || (t->user != NULL)){
+		spi_1_isr_p(spi_1_user_data);
+	}
 }
 static void IRAM_ATTR spi_2_isr(spi_transaction_t *t){
-	spi_2_isr_p(spi_2_user_data);
+	if((transfer_mode_2 == SPI_INTERRUPT) || (t->user != NULL)){
+		spi_2_isr_p(spi_2_user_data);
+	}
 }
 static void IRAM_ATTR spi_3_isr(spi_transaction_t *t){
-	spi_3_isr_p(spi_3_user_data);
+	if((transfer_mode_3 == SPI_INTERRUPT) || (t->user != NULL)){
+		spi_3_isr_p(spi_3_user_data);
+	}
 }
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static spi_device_handle_t SpiHandle(spi_dev_t device){
+    switch(device){
+        case SPI_2:
+            return spi_2;
+        case SPI_3:
+            return spi_3;
+        default:
+            return spi_1;
+    }
+}
 
 /*==================[external functions definition]==========================*/
 uint8_t SpiInit(spi_mcu_config_t* spi){
@@ -65,13 +87,13 @@ uint8_t SpiInit(spi_mcu_config_t* spi){
 	spi_device_interface_config_t dev_cfg = {
         .clock_speed_hz = spi->bitrate,     	
         .mode = spi->clk_mode,                  
-        .queue_size = 8,                        
+        .queue_size = SPI_QUEUE_SIZE,                        
     };
     switch(spi->device){
         case SPI_1:
             dev_cfg.spics_io_num = PIN_NUM_CS1;
             transfer_mode_1 = spi->transfer_mode;
-            if(transfer_mode_1 == SPI_INTERRUPT){
+            if((transfer_mode_1 == SPI_INTERRUPT) || (spi->func_p != NULL)){
                 dev_cfg.post_cb = spi_1_isr;
             } 
             spi_bus_add_device(SPI2_HOST, &dev_cfg, &spi_1);
@@ -80,20 +102,20 @@ uint8_t SpiInit(spi_mcu_config_t* spi){
             break;
         case SPI_2:
             dev_cfg.spics_io_num = PIN_NUM_CS2;
-            if(transfer_mode_2 == SPI_INTERRUPT){
+            transfer_mode_2 = spi->transfer_mode;
+            if((transfer_mode_2 == SPI_INTERRUPT) || (spi->func_p != NULL)){
                 dev_cfg.post_cb = spi_2_isr;
             } 
-            transfer_mode_1 = spi->transfer_mode;
             spi_bus_add_device(SPI2_HOST, &dev_cfg, &spi_2);
             spi_2_isr_p = spi->func_p;
             spi_2_user_data = spi->param_p;
             break;
         case SPI_3:
             dev_cfg.spics_io_num = PIN_NUM_CS3;
-            if(transfer_mode_3 == SPI_INTERRUPT){
+            transfer_mode_3 = spi->transfer_mode;
+            if((transfer_mode_3 == SPI_INTERRUPT) || (spi->func_p != NULL)){
                 dev_cfg.post_cb = spi_3_isr;
             } 
-            transfer_mode_1 = spi->transfer_mode;
             spi_bus_add_device(SPI2_HOST, &dev_cfg, &spi_3);
             spi_3_isr_p = spi->func_p;
             spi_3_user_data = spi->param_p;
@@ -222,6 +244,32 @@ void SpiReadWrite(spi_dev_t device, uint8_t * tx_buffer, uint8_t * rx_buffer, ui
     }
 }
 
+void SpiWriteQueued(spi_dev_t device, uint8_t * tx_buffer, uint32_t tx_buffer_size){
+    spi_transaction_t *t;
+    /* All transactions in use: wait for the oldest one */
+    SpiWaitQueued(device, SPI_QUEUE_SIZE - 1);
+    t = &spi_queue_trans[device][spi_queue_head[device]];
+    memset(t, 0, sizeof(spi_transaction_t));
+    t->length = tx_buffer_size * 8;
+    t->tx_buffer = tx_buffer;
+    t->user = t;                    // Marks the transaction as queued
+    spi_device_queue_trans(SpiHandle(device), t, portMAX_DELAY);
+    spi_queue_head[device] = (spi_queue_head[device] + 1) % SPI_QUEUE_SIZE;
+    spi_queue_pending[device]++;
+}
+
+void SpiWaitQueued(spi_dev_t device, uint8_t max_pending){
+    spi_transaction_t *t;
+    while(spi_queue_pending[device] > max_pending){
+        spi_device_get_trans_result(SpiHandle(device), &t, portMAX_DELAY);
+        spi_queue_pending[device]--;
+    }
+}
+
+uint8_t SpiQueuedPending(spi_dev_t device){
+    return spi_queue_pending[device];
+}
+
 uint8_t SpiDeInit(spi_dev_t device){
     return 0;
 }
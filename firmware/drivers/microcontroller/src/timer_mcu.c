@@ -12,12 +12,42 @@
 /*==================[inclusions]=============================================*/
 #include "timer_mcu.h"
 #include "driver/gptimer.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 /*==================[macros and definitions]=================================*/
 #define US_RESOLUTION_HZ	1000000	/*!< 1usec */
 #define RESET_COUNT_VALUE	0		/*!< Reset timer count to 0 */
+#define TIMERS_NUM			3		/*!< Number of timers */
 /*==================[internal data declaration]==============================*/
+#if TIMER_MCU_STATS
+/**
+ * @brief Accumulator of a time measured on each alarm
+ */
+typedef struct {
+	uint32_t min;						/*!< Min. value (us) */
+	uint32_t max;						/*!< Max. value (us) */
+	uint64_t sum;						/*!< Sum of the values (us) */
+	uint32_t hist[TIMER_STATS_BINS];	/*!< Histogram */
+} timer_acc_t;
+
+/**
+ * @brief Timing record of a timer
+ */
+typedef struct {
+	uint32_t alarms;			/*!< Alarms recorded */
+	uint32_t overruns;			/*!< Callbacks longer than the period */
+	int64_t expected;			/*!< Last alarm time */
+	int64_t actual;				/*!< Last callback start time */
+	timer_acc_t lateness;		/*!< From the alarm to the callback start */
+	timer_acc_t isr_latency;	/*!< From the alarm to the ISR entry */
+	timer_acc_t dispatch;		/*!< From the ISR entry to the callback start */
+	timer_acc_t duration;		/*!< Callback execution time */
+} timer_record_t;
+
+static timer_record_t timer_records[TIMERS_NUM];						/*!< Timing record of each timer */
+static portMUX_TYPE timer_stats_lock = portMUX_INITIALIZER_UNLOCKED;	/*!< Protects timer_records */
+#endif
 gptimer_handle_t timer_a = NULL;	/*!< Handle for timer A */	
 gptimer_handle_t timer_b = NULL;	/*!< Handle for timer B */			
 gptimer_handle_t timer_c = NULL;	/*!< Handle for timer C */	
@@ -45,16 +75,129 @@ gptimer_alarm_config_t alarm_config_a;  /*!< Configuration for alarm A */
 gptimer_alarm_config_t alarm_config_b;	/*!< Configuration for alarm B */
 gptimer_alarm_config_t alarm_config_c;	/*!< Configuration for alarm C */
 /*==================[internal functions declaration]=========================*/
+#if TIMER_MCU_STATS
+/**
+ * @brief Restart an accumulator
+ */
+static void TimerAccReset(timer_acc_t *acc){
+	*acc = (timer_acc_t){.min = UINT32_MAX};
+}
+
+/**
+ * @brief Restart the timing record of a timer
+ */
+static void TimerRecordReset(timer_record_t *record){
+	record->alarms = 0;
+	record->overruns = 0;
+	TimerAccReset(&record->lateness);
+	TimerAccReset(&record->isr_latency);
+	TimerAccReset(&record->dispatch);
+	TimerAccReset(&record->duration);
+}
+
+/**
+ * @brief Add a value to an accumulator
+ */
+static inline void IRAM_ATTR TimerAccAdd(timer_acc_t *acc, uint32_t value){
+	uint8_t bin = (value == 0) ? 0 : 32 - __builtin_clz(value);
+	if(value < acc->min){
+		acc->min = value;
+	}
+	if(value > acc->max){
+		acc->max = value;
+	}
+	acc->sum += value;
+	acc->hist[(bin < TIMER_STATS_BINS) ? bin : TIMER_STATS_BINS - 1]++;
+}
+
+/**
+ * @brief Call the callback of a timer, recording its timing
+ *
+ * @note The count restarts on each alarm: read at the callback start, it is the time since
+ * the alarm. The count captured by the driver on the ISR entry is the ISR latency.
+ * Callbacks are timed with the free-running system time (they can be longer than the period).
+ */
+static void IRAM_ATTR TimerRecordCallback(timer_mcu_t timer, gptimer_handle_t handle, const gptimer_alarm_event_data_t *edata,
+	void (*func_p)(void*), void *param_p){
+	uint64_t start;
+	uint32_t duration;
+	int64_t now;
+
+	gptimer_get_raw_count(handle, &start);
+	now = esp_timer_get_time();
+	func_p(param_p);
+	/* Free-running time: the count restarts if the callback takes longer than the period */
+	duration = esp_timer_get_time() - now;
+
+	portENTER_CRITICAL_ISR(&timer_stats_lock);
+	timer_record_t *record = &timer_records[timer];
+	record->alarms++;
+	if(duration >= edata->alarm_value){
+		record->overruns++;
+	}
+	record->expected = now - start;
+	record->actual = now;
+	TimerAccAdd(&record->lateness, start);
+	TimerAccAdd(&record->isr_latency, edata->count_value);
+	TimerAccAdd(&record->dispatch, (start > edata->count_value) ? start - edata->count_value : 0);
+	TimerAccAdd(&record->duration, duration);
+	portEXIT_CRITICAL_ISR(&timer_stats_lock);
+}
+
+/**
+ * @brief Statistics of an accumulator
+ */
+static void TimerAccGet(const timer_acc_t *acc, uint32_t alarms, timer_stat_t *stat){
+	stat->min = (alarms > 0) ? acc->min : 0;
+	stat->max = acc->max;
+	stat->mean = (alarms > 0) ? acc->sum / alarms : 0;
+	for(uint8_t i = 0; i < TIMER_STATS_BINS; i++){
+		stat->hist[i] = acc->hist[i];
+	}
+}
+
+/**
+ * @brief Send a line with the statistics of a measured time
+ */
+static void TimerStatLine(uart_mcu_port_t port, const char *name, const timer_stat_t *stat){
+	UartSendString(port, name);
+	UartSendString(port, ": min ");
+	UartSendString(port, (char*)UartItoa(stat->min, 10));
+	UartSendString(port, ", mean ");
+	UartSendString(port, (char*)UartItoa(stat->mean, 10));
+	UartSendString(port, ", max ");
+	UartSendString(port, (char*)UartItoa(stat->max, 10));
+	UartSendString(port, " us, hist");
+	for(uint8_t i = 0; i < TIMER_STATS_BINS; i++){
+		UartSendString(port, " ");
+		UartSendString(port, (char*)UartItoa(stat->hist[i], 10));
+	}
+	UartSendString(port, "\r\n");
+}
+#endif
+
 static bool IRAM_ATTR timer_a_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
+#if TIMER_MCU_STATS
+	TimerRecordCallback(TIMER_A, timer, edata, timer_a_isr_p, timer_a_user_data);
+#else
 	timer_a_isr_p(timer_a_user_data);
+#endif
 	return true;
 }
 static bool IRAM_ATTR timer_b_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
+#if TIMER_MCU_STATS
+	TimerRecordCallback(TIMER_B, timer, edata, timer_b_isr_p, timer_b_user_data);
+#else
 	timer_b_isr_p(timer_b_user_data);
+#endif
 	return true;
 }
 static bool IRAM_ATTR timer_c_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
+#if TIMER_MCU_STATS
+	TimerRecordCallback(TIMER_C, timer, edata, timer_c_isr_p, timer_c_user_data);
+#else
 	timer_c_isr_p(timer_c_user_data);
+#endif
 	return true;
 }
 /*==================[internal data definition]===============================*/
@@ -65,6 +208,9 @@ static bool IRAM_ATTR timer_c_isr(gptimer_handle_t timer, const gptimer_alarm_ev
 
 /*==================[external functions definition]==========================*/
 void TimerInit(timer_config_t *timer_ini){
+#if TIMER_MCU_STATS
+	TimerRecordReset(&timer_records[timer_ini->timer]);
+#endif
 	switch(timer_ini->timer){
 	 	case TIMER_A:
 			timer_a_isr_p = timer_ini->func_p;
@@ -188,4 +334,46 @@ void TimerUpdatePeriod(timer_mcu_t timer, uint32_t period){
 	}
 }
 
+uint64_t TimerGetTimestamp(void){
+	return esp_timer_get_time();
+}
+
+#if TIMER_MCU_STATS
+void TimerGetStats(timer_mcu_t timer, timer_stats_t *stats, bool reset){
+	timer_record_t record;
+
+	portENTER_CRITICAL(&timer_stats_lock);
+	record = timer_records[timer];
+	if(reset){
+		TimerRecordReset(&timer_records[timer]);
+	}
+	portEXIT_CRITICAL(&timer_stats_lock);
+	stats->alarms = record.alarms;
+	stats->overruns = record.overruns;
+	stats->expected = record.expected;
+	stats->actual = record.actual;
+	TimerAccGet(&record.lateness, record.alarms, &stats->lateness);
+	TimerAccGet(&record.isr_latency, record.alarms, &stats->isr_latency);
+	TimerAccGet(&record.dispatch, record.alarms, &stats->dispatch);
+	TimerAccGet(&record.duration, record.alarms, &stats->duration);
+}
+
+void TimerStatsDump(timer_mcu_t timer, uart_mcu_port_t port){
+	timer_stats_t stats;
+
+	TimerGetStats(timer, &stats, false);
+	UartSendString(port, "Timer ");
+	UartSendByte(port, (const char[]){'A' + timer});
+	UartSendString(port, ": alarms ");
+	UartSendString(port, (char*)UartItoa(stats.alarms, 10));
+	UartSendString(port, ", overruns ");
+	UartSendString(port, (char*)UartItoa(stats.overruns, 10));
+	UartSendString(port, "\r\n");
+	TimerStatLine(port, "lateness", &stats.lateness);
+	TimerStatLine(port, "isr latency", &stats.isr_latency);
+	TimerStatLine(port, "dispatch", &stats.dispatch);
+	TimerStatLine(port, "duration", &stats.duration);
+}
+#endif
+
 /*==================[end of file]============================================*/
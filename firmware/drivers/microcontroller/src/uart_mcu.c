@@ -10,11 +10,19 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <string.h>
 #include "uart_mcu.h"
 #include "gpio_mcu.h"
+#include "ring_buffer_mcu.h"
 #include "driver/uart.h"
+#include "hal/uart_ll.h"
+#include "soc/uart_periph.h"
+#include "esp_intr_alloc.h"
+#include "esp_attr.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
 /*==================[macros and definitions]=================================*/
 #define UART_CONN_TX        GPIO_18         /*!<  */
@@ -23,6 +31,11 @@
 #define RX_BUFFER_SIZE      256             /*!<  */
 #define EVENT_QUEUE_SIZE    16              /*!<  */
 #define READ_TIMEOUT        100             /*!<  */
+#define STREAM_RX_FULL_THR  96              /*!< RX FIFO level that moves data to the ring buffer (stream mode) */
+#define STREAM_TX_EMPTY_THR 32              /*!< TX FIFO level that triggers a refill (stream mode) */
+#define STREAM_TX_MASK      (UART_STREAM_TX_QUEUE - 1)
+#define STREAM_RX_INTR      (UART_INTR_RXFIFO_FULL | UART_INTR_RXFIFO_TOUT | UART_INTR_RXFIFO_OVF)
+#define STREAM_PORTS        2               /*!< Ports that can be used in stream mode */
 /*==================[internal data declaration]==============================*/
 void (*uart_pc_isr_p)(void*);	            /*!<  */
 void (*uart_conn_isr_p)(void*);	            /*!<  */
@@ -30,6 +43,44 @@ void *uart_pc_user_data;	                /*!<  */
 void *uart_conn_user_data;	                /*!<  */
 static QueueHandle_t uart_pc_queue;         /*!<  */
 static QueueHandle_t uart_conn_queue;       /*!<  */
+static uint8_t uart_pc_rx_data[RX_BUFFER_SIZE];     /*!< RX ring buffer storage for UART_PC */
+static uint8_t uart_conn_rx_data[RX_BUFFER_SIZE];   /*!< RX ring buffer storage for UART_CONNECTOR */
+static ring_buffer_t uart_pc_rx_ring;       /*!< Received bytes moved from event task to reader (UART_PC) */
+static ring_buffer_t uart_conn_rx_ring;     /*!< Received bytes moved from event task to reader (UART_CONNECTOR) */
+static bool uart_pc_rx_ring_used = false;   /*!< UART_PC received data is stored in ring buffer */
+static bool uart_conn_rx_ring_used = false; /*!< UART_CONNECTOR received data is stored in ring buffer */
+
+/**
+ * @brief Segment queued for transmission in stream mode
+ */
+typedef struct {
+    const uint8_t *data;                /*!< Data (owned by the application) */
+    uint32_t length;                    /*!< Number of bytes */
+    void (*func_p)(void*);              /*!< Completion callback (only in the last segment of a buffer) */
+    void *param_p;                      /*!< Completion callback parameter */
+} uart_stream_tx_t;
+
+/**
+ * @brief Stream mode state of a port
+ */
+typedef struct {
+    bool used;                                      /*!< Port initialized in stream mode */
+    uart_dev_t *hw;                                 /*!< UART registers */
+    intr_handle_t intr;                             /*!< UART interrupt */
+    portMUX_TYPE lock;                              /*!< Protects the TX queue and the interrupt enable */
+    ring_buffer_t rx_ring;                          /*!< Received bytes (ISR to consumer) */
+    uint32_t rx_notify;                             /*!< Bytes that wake the consumer */
+    uint32_t rx_unnotified;                         /*!< Bytes received since the consumer was woken */
+    TaskHandle_t consumer;                          /*!< Task woken when data is received */
+    uart_stream_tx_t tx_queue[UART_STREAM_TX_QUEUE];/*!< Segments to be sent */
+    volatile uint32_t tx_queued;                    /*!< Segments queued (free running) */
+    volatile uint32_t tx_sent;                      /*!< Segments moved to the FIFO (free running) */
+    uint32_t tx_offset;                             /*!< Bytes of the first segment already moved */
+    SemaphoreHandle_t tx_done;                      /*!< Given each time a segment is sent */
+    StaticSemaphore_t tx_done_buffer;               /*!< tx_done storage */
+    uart_stream_stats_t stats;                      /*!< Counters */
+} uart_stream_t;
+static uart_stream_t uart_stream[STREAM_PORTS];     /*!< Stream mode state (indexed by port) */
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
@@ -37,6 +88,249 @@ static QueueHandle_t uart_conn_queue;       /*!<  */
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Move bytes buffered by the UART driver directly into the ring buffer free spans
+ * 
+ * @param uart_num UART port
+ * @param rb Ring buffer
+ * @return uint32_t Number of bytes moved
+ */
+static uint32_t uart_rx_to_ring(uart_port_t uart_num, ring_buffer_t *rb){
+    size_t pending = 0;
+    uint32_t span, moved = 0;
+    int length;
+    uart_get_buffered_data_len(uart_num, &pending);
+    while(pending > 0){
+        uint8_t *dst = RingBufferWriteReserve(rb, &span);
+        if(span == 0){
+            // ring full: bytes remain in driver buffer until the reader frees space
+            break;
+        }
+        if(span > pending){
+            span = pending;
+        }
+        length = uart_read_bytes(uart_num, dst, span, 0);
+        if(length <= 0){
+            break;
+        }
+        RingBufferWriteCommit(rb, length);
+        pending -= length;
+        moved += length;
+    }
+    return moved;
+}
+
+/**
+ * @brief Indicates if received data of a port is moved to its ring buffer (reception callback
+ * or stream mode used)
+ * 
+ * @param port Port to read from
+ * @return true Data must be read from ring buffer
+ * @return false Data must be read from UART driver
+ */
+static bool uart_ring_used(uart_mcu_port_t port){
+    if(uart_stream[port].used){
+        return true;
+    }
+    return (port == UART_PC) ? uart_pc_rx_ring_used : uart_conn_rx_ring_used;
+}
+
+/**
+ * @brief Read bytes already moved to the port ring buffer (non blocking)
+ * 
+ * @param port Port to read from
+ * @param data Pointer to array where data will be stored
+ * @param nbytes Max. number of bytes to read
+ * @return uint16_t Number of bytes read
+ */
+static uint16_t uart_read_ring(uart_mcu_port_t port, uint8_t *data, uint16_t nbytes){
+    ring_buffer_t *rb = (port == UART_PC) ? &uart_pc_rx_ring : &uart_conn_rx_ring;
+    if(uart_stream[port].used){
+        rb = &uart_stream[port].rx_ring;
+    }
+    return RingBufferPop(rb, data, nbytes);
+}
+
+/**
+ * @brief Stream mode: move the RX FIFO to the ring buffer spans (called from the UART ISR)
+ * 
+ * @param stream Port state
+ * @param idle The line went idle
+ * @return true if a higher priority task was woken
+ */
+static bool IRAM_ATTR uart_stream_rx(uart_stream_t *stream, bool idle){
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t pending = uart_ll_get_rxfifo_len(stream->hw);
+    uint32_t span, n;
+    uint8_t discard[16];
+    uint8_t *dst;
+
+    while(pending > 0){
+        dst = RingBufferWriteReserve(&stream->rx_ring, &span);
+        if(span == 0){
+            /* Ring buffer full: the FIFO is emptied anyway, or the interrupt would not clear */
+            n = (pending < sizeof(discard)) ? pending : sizeof(discard);
+            uart_ll_read_rxfifo(stream->hw, discard, n);
+            stream->stats.rx_dropped += n;
+            stream->rx_ring.dropped += n;
+        }
+        else{
+            n = (pending < span) ? pending : span;
+            uart_ll_read_rxfifo(stream->hw, dst, n);
+            RingBufferWriteCommit(&stream->rx_ring, n);
+            stream->stats.rx_bytes += n;
+            stream->rx_unnotified += n;
+        }
+        pending -= n;
+    }
+    if((stream->rx_unnotified > 0) && (idle || (stream->rx_unnotified >= stream->rx_notify))){
+        stream->rx_unnotified = 0;
+        if(stream->consumer != NULL){
+            vTaskNotifyGiveFromISR(stream->consumer, &xHigherPriorityTaskWoken);
+        }
+    }
+    return (xHigherPriorityTaskWoken == pdTRUE);
+}
+
+/**
+ * @brief Stream mode: refill the TX FIFO from the queued segments (called from the UART ISR)
+ * 
+ * @param stream Port state
+ * @return true if a higher priority task was woken
+ */
+static bool IRAM_ATTR uart_stream_tx(uart_stream_t *stream){
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uart_stream_tx_t *segment;
+    void (*func_p)(void*);
+    void *param_p;
+    uint32_t room, n;
+
+    portENTER_CRITICAL_ISR(&stream->lock);
+    while(stream->tx_sent != stream->tx_queued){
+        room = uart_ll_get_txfifo_len(stream->hw);
+        if(room == 0){
+            break;
+        }
+        segment = &stream->tx_queue[stream->tx_sent & STREAM_TX_MASK];
+        n = segment->length - stream->tx_offset;
+        if(n > room){
+            n = room;
+        }
+        uart_ll_write_txfifo(stream->hw, segment->data + stream->tx_offset, n);
+        stream->tx_offset += n;
+        stream->stats.tx_bytes += n;
+        if(stream->tx_offset < segment->length){
+            break;
+        }
+        /* Segment in the FIFO: its buffer can be reused */
+        func_p = segment->func_p;
+        param_p = segment->param_p;
+        stream->tx_offset = 0;
+        stream->tx_sent++;
+        stream->stats.tx_segments++;
+        xSemaphoreGiveFromISR(stream->tx_done, &xHigherPriorityTaskWoken);
+        if(func_p != NULL){
+            /* Callback can queue more segments */
+            portEXIT_CRITICAL_ISR(&stream->lock);
+            func_p(param_p);
+            portENTER_CRITICAL_ISR(&stream->lock);
+        }
+    }
+    if(stream->tx_sent == stream->tx_queued){
+        uart_ll_disable_intr_mask(stream->hw, UART_INTR_TXFIFO_EMPTY);
+    }
+    portEXIT_CRITICAL_ISR(&stream->lock);
+    return (xHigherPriorityTaskWoken == pdTRUE);
+}
+
+/**
+ * @brief Stream mode UART ISR
+ * 
+ * @param arg Port state
+ */
+static void IRAM_ATTR uart_stream_isr(void *arg){
+    uart_stream_t *stream = arg;
+    uint32_t status = uart_ll_get_intsts_mask(stream->hw);
+    bool yield = false;
+
+    uart_ll_clr_intsts_mask(stream->hw, status);
+    stream->stats.interrupts++;
+    if(status & UART_INTR_RXFIFO_OVF){
+        stream->stats.rx_overflows++;
+    }
+    if(status & STREAM_RX_INTR){
+        yield |= uart_stream_rx(stream, (status & UART_INTR_RXFIFO_TOUT) != 0);
+    }
+    if(status & UART_INTR_TXFIFO_EMPTY){
+        yield |= uart_stream_tx(stream);
+    }
+    if(yield){
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+ * @brief Stream mode: queue segments for transmission
+ * 
+ * @param stream Port state
+ * @param segments Segments
+ * @param n Number of segments
+ * @param func_p Completion callback (called after the last segment)
+ * @param param_p Completion callback parameter
+ * @param index Position of the last segment in the queue (free running, NULL if not needed)
+ * @return true if the segments were queued
+ */
+static bool IRAM_ATTR uart_stream_queue(uart_stream_t *stream, const uart_segment_t *segments, uint8_t n,
+        void *func_p, void *param_p, uint32_t *index){
+    uart_stream_tx_t *segment;
+    bool queued = false;
+
+    portENTER_CRITICAL_SAFE(&stream->lock);
+    if((n > 0) && (UART_STREAM_TX_QUEUE - (stream->tx_queued - stream->tx_sent) >= n)){
+        for(uint8_t i = 0; i < n; i++){
+            segment = &stream->tx_queue[(stream->tx_queued + i) & STREAM_TX_MASK];
+            segment->data = segments[i].data;
+            segment->length = segments[i].length;
+            segment->func_p = (i == n - 1) ? func_p : NULL;
+            segment->param_p = param_p;
+        }
+        stream->tx_queued += n;
+        if(index != NULL){
+            *index = stream->tx_queued - 1;
+        }
+        /* The FIFO is below the threshold: the interrupt starts the transmission */
+        uart_ll_ena_intr_mask(stream->hw, UART_INTR_TXFIFO_EMPTY);
+        queued = true;
+    }
+    portEXIT_CRITICAL_SAFE(&stream->lock);
+    return queued;
+}
+
+/**
+ * @brief Stream mode: send a buffer and wait until it is in the FIFO (send functions of the
+ * driver, whose buffers can be reused on return)
+ * 
+ * @param port Port for sending data
+ * @param data Pointer to data
+ * @param length Number of bytes
+ */
+static void uart_stream_send_wait(uart_mcu_port_t port, const uint8_t *data, uint32_t length){
+    uart_stream_t *stream = &uart_stream[port];
+    uart_segment_t segment = {.data = data, .length = length};
+    uint32_t index;
+
+    if(length == 0){
+        return;
+    }
+    while(!uart_stream_queue(stream, &segment, 1, NULL, NULL, &index)){
+        xSemaphoreTake(stream->tx_done, 1);
+    }
+    while((int32_t)(stream->tx_sent - index) <= 0){
+        /* Timeout: another task waiting on the port may take the completion */
+        xSemaphoreTake(stream->tx_done, 1);
+    }
+}
+
 static void uart_pc_event_task(void *pvParameters){
     uart_event_t event;
     uart_driver_install(UART_NUM_0, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 16, &uart_pc_queue, 0);
@@ -45,7 +339,9 @@ static void uart_pc_event_task(void *pvParameters){
         if (xQueueReceive(uart_pc_queue, (void *)&event, (TickType_t)portMAX_DELAY)){
             switch(event.type) {
                 case UART_DATA:
-                    uart_pc_isr_p(uart_pc_user_data);
+                    while(uart_rx_to_ring(UART_NUM_0, &uart_pc_rx_ring) > 0){
+                        uart_pc_isr_p(uart_pc_user_data);
+                    }
                     break;
                 case UART_BREAK:
                     break;
@@ -78,7 +374,9 @@ static void uart_conn_event_task(void *pvParameters){
         if(xQueueReceive(uart_conn_queue, (void *)&event, (TickType_t)portMAX_DELAY)){
             switch(event.type) {
                 case UART_DATA:
-                    uart_conn_isr_p(uart_conn_user_data);
+                    while(uart_rx_to_ring(UART_NUM_1, &uart_conn_rx_ring) > 0){
+                        uart_conn_isr_p(uart_conn_user_data);
+                    }
                     break;
                 case UART_BREAK:
                     break;
@@ -120,6 +418,8 @@ void UartInit(serial_config_t *port_config){
             if(port_config->func_p != UART_NO_INT){
                 uart_pc_isr_p = port_config->func_p;
                 uart_pc_queue = port_config->param_p;
+                RingBufferInit(&uart_pc_rx_ring, uart_pc_rx_data, RX_BUFFER_SIZE, sizeof(uint8_t));
+                uart_pc_rx_ring_used = true;
                 xTaskCreate(uart_pc_event_task, "uart_pc_event_task", 2048, NULL, 12, 0);
             }else{
                 uart_driver_install(UART_NUM_0, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 0, NULL, 0);
@@ -131,6 +431,8 @@ void UartInit(serial_config_t *port_config){
             if(port_config->func_p != UART_NO_INT){
                 uart_conn_isr_p = port_config->func_p;
                 uart_conn_queue = port_config->param_p;
+                RingBufferInit(&uart_conn_rx_ring, uart_conn_rx_data, RX_BUFFER_SIZE, sizeof(uint8_t));
+                uart_conn_rx_ring_used = true;
                 xTaskCreate(uart_conn_event_task, "uart_conn_event_task", 2048, NULL, 12, NULL);
             }else{
                 uart_driver_install(UART_NUM_1, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 0, NULL, 0);
@@ -150,7 +452,11 @@ uint8_t UartReadByte(uart_mcu_port_t port, uint8_t* data){
                 uart_num = UART_NUM_1;
             break;
     }
-    length = uart_read_bytes(uart_num, data, 1, READ_TIMEOUT);
+    if(uart_ring_used(port)){
+        length = uart_read_ring(port, data, 1);
+    }else{
+        length = uart_read_bytes(uart_num, data, 1, READ_TIMEOUT);
+    }
     if(length > 0){
         return true;
     } else{
@@ -169,7 +475,11 @@ uint8_t UartReadBuffer(uart_mcu_port_t port, uint8_t* data, uint16_t nbytes){
                 uart_num = UART_NUM_1;
             break;
     }
-    length = uart_read_bytes(uart_num, data, nbytes, READ_TIMEOUT);
+    if(uart_ring_used(port)){
+        length = uart_read_ring(port, data, nbytes);
+    }else{
+        length = uart_read_bytes(uart_num, data, nbytes, READ_TIMEOUT);
+    }
     if(length > 0){
         return true;
     } else{
@@ -187,7 +497,11 @@ void UartSendByte(uart_mcu_port_t port, const char *data){
                 uart_num = UART_NUM_1;
             break;
     }
-    uart_tx_chars(uart_num, data, 1);
+    if(uart_stream[port].used){
+        uart_stream_send_wait(port, (const uint8_t*)data, 1);
+    }else{
+        uart_write_bytes(uart_num, data, 1);
+    }
 }
 
 void UartSendString(uart_mcu_port_t port, const char *msg){
@@ -200,10 +514,11 @@ void UartSendString(uart_mcu_port_t port, const char *msg){
                 uart_num = UART_NUM_1;
             break;
     }
-	while(*msg != 0){
-        uart_tx_chars(uart_num, msg, 1);
-		msg++;
-	}
+    if(uart_stream[port].used){
+        uart_stream_send_wait(port, (const uint8_t*)msg, strlen(msg));
+    }else{
+        uart_write_bytes(uart_num, msg, strlen(msg));
+    }
 }
 
 void UartSendBuffer(uart_mcu_port_t port, const char *data, uint8_t nbytes){
@@ -216,7 +531,11 @@ void UartSendBuffer(uart_mcu_port_t port, const char *data, uint8_t nbytes){
                 uart_num = UART_NUM_1;
             break;
     }
-    uart_tx_chars(uart_num, data, nbytes);
+    if(uart_stream[port].used){
+        uart_stream_send_wait(port, (const uint8_t*)data, nbytes);
+    }else{
+        uart_write_bytes(uart_num, data, nbytes);
+    }
 }
 
 uint8_t* UartItoa(uint32_t val, uint8_t base){
@@ -232,4 +551,104 @@ uint8_t* UartItoa(uint32_t val, uint8_t base){
     }
 }
 
+bool UartStreamInit(const uart_stream_config_t *config){
+    uart_stream_t *stream = &uart_stream[config->port];
+    uart_port_t uart_num = (config->port == UART_PC) ? UART_NUM_0 : UART_NUM_1;
+    uart_config_t uart_config = {
+        .baud_rate = config->baud_rate,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_DEFAULT,
+    };
+    uart_intr_config_t intr_config = {
+        .intr_enable_mask = STREAM_RX_INTR,
+        .rxfifo_full_thresh = STREAM_RX_FULL_THR,
+        .rx_timeout_thresh = config->rx_idle,
+        .txfifo_empty_intr_thresh = STREAM_TX_EMPTY_THR,
+    };
+
+    if(stream->used || uart_is_driver_installed(uart_num) || (config->rx_idle == 0)){
+        return false;
+    }
+    if(!RingBufferInit(&stream->rx_ring, config->rx_buffer, config->rx_size, sizeof(uint8_t))){
+        return false;
+    }
+    RingBufferSetConsumer(&stream->rx_ring, config->consumer);
+    stream->hw = UART_LL_GET_HW(uart_num);
+    portMUX_INITIALIZE(&stream->lock);
+    stream->rx_notify = config->rx_notify;
+    stream->rx_unnotified = 0;
+    stream->consumer = config->consumer;
+    stream->tx_queued = 0;
+    stream->tx_sent = 0;
+    stream->tx_offset = 0;
+    stream->tx_done = xSemaphoreCreateBinaryStatic(&stream->tx_done_buffer);
+    memset(&stream->stats, 0, sizeof(stream->stats));
+
+    uart_param_config(uart_num, &uart_config);
+    if(config->port == UART_PC){
+        uart_set_pin(UART_NUM_0, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    }else{
+        uart_set_pin(UART_NUM_1, UART_CONN_TX, UART_CONN_RX, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    }
+    /* No UART driver on the port: the stream ISR works directly on the FIFOs */
+    uart_ll_disable_intr_mask(stream->hw, UART_LL_INTR_MASK);
+    uart_ll_clr_intsts_mask(stream->hw, UART_LL_INTR_MASK);
+    uart_ll_rxfifo_rst(stream->hw);
+    if(esp_intr_alloc(uart_periph_signal[uart_num].irq, 0, uart_stream_isr, stream, &stream->intr) != ESP_OK){
+        return false;
+    }
+    uart_intr_config(uart_num, &intr_config);
+    stream->used = true;
+    return true;
+}
+
+bool UartStreamSend(uart_mcu_port_t port, const uint8_t *data, uint32_t length, void *func_p, void *param_p){
+    uart_segment_t segment = {.data = data, .length = length};
+    return UartStreamSendSegments(port, &segment, 1, func_p, param_p);
+}
+
+bool UartStreamSendSegments(uart_mcu_port_t port, const uart_segment_t *segments, uint8_t n, void *func_p, void *param_p){
+    if(!uart_stream[port].used){
+        return false;
+    }
+    return uart_stream_queue(&uart_stream[port], segments, n, func_p, param_p, NULL);
+}
+
+void UartStreamWaitTx(uart_mcu_port_t port, uint8_t max_pending){
+    while(UartStreamTxPending(port) > max_pending){
+        /* Timeout: another task waiting on the port may take the completion */
+        xSemaphoreTake(uart_stream[port].tx_done, 1);
+    }
+}
+
+uint8_t UartStreamTxPending(uart_mcu_port_t port){
+    return uart_stream[port].tx_queued - uart_stream[port].tx_sent;
+}
+
+const uint8_t * UartStreamRxSpan(uart_mcu_port_t port, uint32_t *length){
+    return RingBufferReadSpan(&uart_stream[port].rx_ring, length);
+}
+
+void UartStreamRxRelease(uart_mcu_port_t port, uint32_t length){
+    RingBufferReadRelease(&uart_stream[port].rx_ring, length);
+}
+
+bool UartStreamRxWait(uart_mcu_port_t port, uint32_t timeout_ms){
+    return RingBufferWait(&uart_stream[port].rx_ring, timeout_ms);
+}
+
+void UartStreamGetStats(uart_mcu_port_t port, uart_stream_stats_t *stats, bool reset){
+    uart_stream_t *stream = &uart_stream[port];
+
+    portENTER_CRITICAL(&stream->lock);
+    *stats = stream->stats;
+    if(reset){
+        memset(&stream->stats, 0, sizeof(stream->stats));
+    }
+    portEXIT_CRITICAL(&stream->lock);
+}
+
 /*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,139 @@
+#ifndef AHRS_H_
+#define AHRS_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup AHRS Orientation fusion
+ */
+
+/** \brief Orientation (attitude) from accelerometer and gyroscope samples
+ *
+ * Gyroscope rates are integrated into a quaternion, and the drift is corrected towards the
+ * gravity direction measured by the accelerometer, with one of two algorithms:
+ *
+ * - Madgwick: gradient descent step of gain beta.
+ * - Mahony: proportional-integral feedback of gains kp and ki (the integral term estimates
+ * the gyroscope bias).
+ *
+ * Samples are raw sensor counts (i.e. MPU6050_getMotion6() or the arrays of a
+ * mpu6050_frames_t), processed in blocks. Instances are plain structs (no dynamic memory),
+ * and each sample costs one quaternion product and two normalizations, done with an
+ * inverse square root approximation (no divisions or square roots), since the ESP32-C6
+ * has no floating point unit.
+ *
+ * @note Without a magnetometer yaw is only integrated from the gyroscope (it drifts).
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+/*==================[macros]=================================================*/
+#define AHRS_MADGWICK_BETA      0.033f      /*!< Default Madgwick gain (~2 deg/s gyroscope error) */
+#define AHRS_MAHONY_KP          1.0f        /*!< Default Mahony proportional gain */
+#define AHRS_MAHONY_KI          0.01f       /*!< Default Mahony integral gain */
+/*==================[typedef]================================================*/
+/**
+ * @brief Quaternion (w + xi + yj + zk)
+ */
+typedef struct {
+    float w;                /*!< Scalar part */
+    float x;                /*!< i component */
+    float y;                /*!< j component */
+    float z;                /*!< k component */
+} quaternion_t;
+
+/**
+ * @brief Fusion algorithm
+ */
+typedef enum {
+    AHRS_MADGWICK,          /*!< Gradient descent correction */
+    AHRS_MAHONY             /*!< PI feedback correction */
+} ahrs_algorithm_t;
+
+/**
+ * @brief AHRS instance
+ */
+typedef struct {
+    quaternion_t q;         /*!< Orientation of the sensor frame in the earth frame (z up) */
+    ahrs_algorithm_t algorithm;     /*!< Fusion algorithm */
+    float gyro_scale;       /*!< Gyroscope scale (rad/s per count) */
+    float dt;               /*!< Sample period (s) */
+    float beta;             /*!< Madgwick gain */
+    float kp;               /*!< Mahony proportional gain */
+    float ki;               /*!< Mahony integral gain */
+    float bias[3];          /*!< Mahony integral term: gyroscope bias correction (rad/s) */
+} ahrs_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a Madgwick AHRS (orientation is reset)
+ *
+ * @param ahrs          AHRS instance
+ * @param sample_frec   Samples frequency (Hz)
+ * @param gyro_scale    Gyroscope scale (rad/s per count, i.e. M_PI / 180 / 131 for +/- 250 deg/s)
+ * @param beta          Gain (i.e. AHRS_MADGWICK_BETA): higher values trust the accelerometer more
+ */
+void AHRSMadgwickInit(ahrs_t * ahrs, float sample_frec, float gyro_scale, float beta);
+
+/**
+ * @brief Initialize a Mahony AHRS (orientation and bias are reset)
+ *
+ * @param ahrs          AHRS instance
+ * @param sample_frec   Samples frequency (Hz)
+ * @param gyro_scale    Gyroscope scale (rad/s per count, i.e. M_PI / 180 / 131 for +/- 250 deg/s)
+ * @param kp            Proportional gain (i.e. AHRS_MAHONY_KP)
+ * @param ki            Integral gain (i.e. AHRS_MAHONY_KI, 0: no bias estimation)
+ */
+void AHRSMahonyInit(ahrs_t * ahrs, float sample_frec, float gyro_scale, float kp, float ki);
+
+/**
+ * @brief Reset the orientation to the identity (and the Mahony bias to 0)
+ *
+ * @param ahrs          AHRS instance
+ */
+void AHRSReset(ahrs_t * ahrs);
+
+/**
+ * @brief Update the orientation with a block of samples
+ *
+ * @note Accelerometer scale doesn't matter (only its direction is used). Samples with all
+ * accelerometer axes at 0 only integrate the gyroscope.
+ *
+ * @param ahrs          AHRS instance
+ * @param ax            Accelerometer X-axis samples (counts)
+ * @param ay            Accelerometer Y-axis samples (counts)
+ * @param az            Accelerometer Z-axis samples (counts)
+ * @param gx            Gyroscope X-axis samples (counts)
+ * @param gy            Gyroscope Y-axis samples (counts)
+ * @param gz            Gyroscope Z-axis samples (counts)
+ * @param lenght        Number of samples of each axis
+ */
+void AHRSUpdate(ahrs_t * ahrs, const int16_t * ax, const int16_t * ay, const int16_t * az,
+    const int16_t * gx, const int16_t * gy, const int16_t * gz, uint16_t lenght);
+
+/**
+ * @brief Orientation as Euler angles (aerospace sequence: yaw, then pitch, then roll)
+ *
+ * @param ahrs          AHRS instance
+ * @param roll          Rotation around X-axis (degrees, -180 to 180)
+ * @param pitch         Rotation around Y-axis (degrees, -90 to 90)
+ * @param yaw           Rotation around Z-axis (degrees, -180 to 180)
+ */
+void AHRSGetEuler(const ahrs_t * ahrs, float * roll, float * pitch, float * yaw);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* AHRS_H_ */
+
+/*==================[end of file]============================================*/
@@ -16,6 +16,8 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 15/03/2024 | Document creation		                         						|
+ * | 17/10/2026 | Real input FFT, cached window and selectable output					|
+ * | 17/10/2026 | Real input FFT with external window and power conversion				|
  * 
  **/
 
@@ -25,6 +27,14 @@
 /*==================[macros]=================================================*/
 #define MAX_SIGNAL_LENGHT   2048
 /*==================[typedef]================================================*/
+/**
+ * @brief FFT output format
+ */
+typedef enum fft_output {
+    FFT_MAGNITUDE,      /*!< Amplitude of each frequency component */
+    FFT_POWER,          /*!< Squared amplitude of each frequency component */
+    FFT_DB              /*!< Amplitude of each frequency component in dB (20 * log10) */
+} fft_output_t;
 
 /*==================[external data declaration]==============================*/
 
@@ -42,12 +52,66 @@ bool FFTInit(void);
  * 
  * @note  Lenght of signal array must be a power of two (with maximun value = MAX_SIGNAL_LENGHT)
  * 
+ * @note  Keeps the scale of previous versions: non DC components are twice the values 
+ * returned by FFTReal(signal, fft, signal_lenght, FFT_MAGNITUDE)
+ * 
  * @param signal            Array with signal values (of lenght = signal_lenght)
  * @param fft               Array to store FFT magnitude values (of lenght = signal_lenght / 2)
  * @param signal_lenght     Lenght of signal arrays
  */
 void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght);
 
+/**
+ * @brief Calculates the Fast Fourier Transform of a real signal, using a Hann window
+ * 
+ * @note  Values are scaled so a sinusoid of amplitude A gives a magnitude of A at its bin.
+ * 
+ * @note  Lenght of signal array must be a power of two (with maximun value = MAX_SIGNAL_LENGHT). 
+ * The signal is transformed as a complex signal of half the lenght, and the window is only 
+ * generated again when the lenght changes.
+ * 
+ * @param signal            Array with signal values (of lenght = signal_lenght)
+ * @param fft               Array to store FFT values (of lenght = signal_lenght / 2)
+ * @param signal_lenght     Lenght of signal arrays
+ * @param output            Output format (magnitude, power or dB)
+ */
+void FFTReal(float * signal, float * fft, uint16_t signal_lenght, fft_output_t output);
+
+/**
+ * @brief Calculates the Fast Fourier Transform of a real signal, using an external window
+ * 
+ * @note  Lenght of signal array must be a power of two (with maximun value = MAX_SIGNAL_LENGHT).
+ * 
+ * @param signal            Array with signal values (of lenght = signal_lenght)
+ * @param window            Window values (of lenght = signal_lenght)
+ * @param fft               Array to store FFT values (of lenght = signal_lenght / 2)
+ * @param signal_lenght     Lenght of signal arrays
+ * @param output            Output format (magnitude, power or dB)
+ * @param scale             Amplitude scale factor (see FFTWindowScale())
+ */
+void FFTRealWindowed(const float * signal, const float * window, float * fft, uint16_t signal_lenght, 
+                     fft_output_t output, float scale);
+
+/**
+ * @brief Amplitude scale factor of a window (2 / sum of window values)
+ * 
+ * @note  With this scale a sinusoid of amplitude A gives a magnitude of A at its bin.
+ * 
+ * @param window            Window values (of lenght = signal_lenght)
+ * @param signal_lenght     Lenght of window
+ * @return float            Scale factor
+ */
+float FFTWindowScale(const float * window, uint16_t signal_lenght);
+
+/**
+ * @brief Convert (in place) a power spectrum to the given output format
+ * 
+ * @param fft               Array with power values, returns converted values
+ * @param lenght            Lenght of fft array
+ * @param output            Output format (FFT_POWER leaves values unchanged)
+ */
+void FFTPowerConvert(float * fft, uint16_t lenght, fft_output_t output);
+
 /**
  * @brief Return the FFT frequency axis vector
  * 
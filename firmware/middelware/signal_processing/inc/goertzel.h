@@ -0,0 +1,162 @@
+#ifndef GOERTZEL_H_
+#define GOERTZEL_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Goertzel Tone detection
+ */
+
+/** \brief Amplitude of a few frequencies without a full FFT
+ *
+ * Two tools to track the amplitude of up to GOERTZEL_MAX_BINS frequencies (i.e. mains
+ * 50/60 Hz, stimulation frequency, SSVEP targets), both with a cost of O(k) per sample
+ * for k frequencies. The analysis window is not limited to MAX_SIGNAL_LENGHT nor to powers of two:
+ *
+ * - Goertzel bank: amplitudes are updated once per block of samples.
+ * - Sliding DFT: amplitudes of the last N samples are available after every sample.
+ *
+ * Frequencies do not need to be multiples of sample_frec / lenght. Amplitudes are those of
+ * a sinusoid (rectangular window), the amplitude of a DC component is returned doubled.
+ *
+ * Cost against FFTMagnitude() (test/host/goertzel, x86-64 -O2, us per block of N samples):
+ *
+ * |   N  | FFTMagnitude | 1 to 4 bins | 5 or 6 bins | 7 or 8 bins |
+ * |:----:|:------------:|:-----------:|:-----------:|:-----------:|
+ * |  256 |  1.8 - 2.2   | 0.65 - 0.8  |  1.3 - 1.5  | 0.7 - 0.8   |
+ * | 1024 |  8.1 - 8.7   | 2.6 - 3.2   |  5.3 - 5.9  | 2.6 - 3.1   |
+ * | 2048 | 14.7 - 25.4  | 5.1 - 6.1   | 11.4 - 11.9 | 5.8 - 6.0   |
+ *
+ * Measured break-even: the Goertzel bank is faster for any number of frequencies up to
+ * GOERTZEL_MAX_BINS; the smallest margin is 5 or 6 frequencies with N = 256. Frequencies are
+ * processed in passes of 8, 4, 2 or 1 (3 are run as 4 and 7 as 8). On the ESP32-C6 (no FPU)
+ * the cost grows with every frequency processed, so re-run the benchmark on target before
+ * choosing Goertzel for more than 4 frequencies with short blocks.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ * | 17/10/2026 | Frequencies processed in passes of 8, 4, 2 or 1, measured break-even	|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define GOERTZEL_MAX_BINS       8           /*!< Max. number of frequencies of an instance */
+#define SDFT_DAMPING            0.99999f    /*!< Damping of the sliding DFT (keeps rounding errors bounded) */
+/*==================[typedef]================================================*/
+/**
+ * @brief Goertzel filter bank instance
+ */
+typedef struct {
+    float coeff[GOERTZEL_MAX_BINS];         /*!< 2 * cos(w) of each frequency */
+    float s1[GOERTZEL_MAX_BINS];            /*!< Last state of each frequency */
+    float s2[GOERTZEL_MAX_BINS];            /*!< Previous state of each frequency */
+    float amplitude[GOERTZEL_MAX_BINS];     /*!< Amplitudes of last complete block */
+    float scale;                            /*!< Amplitude scale (2 / block_lenght) */
+    uint16_t block_lenght;                  /*!< Samples per block */
+    uint16_t count;                         /*!< Samples of current block */
+    uint8_t n_bins;                         /*!< Number of frequencies */
+} goertzel_t;
+
+/**
+ * @brief Sliding DFT instance
+ */
+typedef struct {
+    float * delay;                          /*!< Last lenght samples (circular) */
+    float rot_re[GOERTZEL_MAX_BINS];        /*!< Real part of r * exp(-jw) */
+    float rot_im[GOERTZEL_MAX_BINS];        /*!< Imaginary part of r * exp(-jw) */
+    float comb_re[GOERTZEL_MAX_BINS];       /*!< Real part of r^N * exp(-jwN) */
+    float comb_im[GOERTZEL_MAX_BINS];       /*!< Imaginary part of r^N * exp(-jwN) */
+    float re[GOERTZEL_MAX_BINS];            /*!< Real part of each bin */
+    float im[GOERTZEL_MAX_BINS];            /*!< Imaginary part of each bin */
+    float scale;                            /*!< Amplitude scale (2 / sum of damping weights) */
+    uint16_t lenght;                        /*!< Window lenght (N) */
+    uint16_t idx;                           /*!< Position of oldest sample in delay array */
+    uint8_t n_bins;                         /*!< Number of frequencies */
+} sdft_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a Goertzel filter bank
+ *
+ * @param bank          Goertzel instance
+ * @param frecs         Frequencies to track (Hz)
+ * @param n_bins        Number of frequencies (up to GOERTZEL_MAX_BINS)
+ * @param sample_frec   Signal's sample frequency (Hz)
+ * @param block_lenght  Samples per block
+ * @return true         Bank initialized
+ * @return false        Invalid configuration
+ */
+bool GoertzelInit(goertzel_t * bank, const float * frecs, uint8_t n_bins, float sample_frec, uint16_t block_lenght);
+
+/**
+ * @brief Discard the current block and clear amplitudes
+ *
+ * @param bank          Goertzel instance
+ */
+void GoertzelReset(goertzel_t * bank);
+
+/**
+ * @brief Process new samples
+ *
+ * @note bank->amplitude is updated each time a block is completed
+ *
+ * @param bank          Goertzel instance
+ * @param signal        Samples
+ * @param n             Number of samples (any number, blocks can span several calls)
+ * @return uint16_t     Number of blocks completed
+ */
+uint16_t GoertzelProcess(goertzel_t * bank, const float * signal, uint16_t n);
+
+/**
+ * @brief Initialize a sliding DFT
+ *
+ * @param sdft          Sliding DFT instance
+ * @param frecs         Frequencies to track (Hz)
+ * @param n_bins        Number of frequencies (up to GOERTZEL_MAX_BINS)
+ * @param sample_frec   Signal's sample frequency (Hz)
+ * @param delay         Array to store the last samples (lenght elements)
+ * @param lenght        Window lenght
+ * @return true         Sliding DFT initialized
+ * @return false        Invalid configuration
+ */
+bool SdftInit(sdft_t * sdft, const float * frecs, uint8_t n_bins, float sample_frec, float * delay, uint16_t lenght);
+
+/**
+ * @brief Clear the window and the bins
+ *
+ * @param sdft          Sliding DFT instance
+ */
+void SdftReset(sdft_t * sdft);
+
+/**
+ * @brief Process new samples
+ *
+ * @param sdft          Sliding DFT instance
+ * @param signal        Samples
+ * @param n             Number of samples
+ */
+void SdftProcess(sdft_t * sdft, const float * signal, uint16_t n);
+
+/**
+ * @brief Amplitudes of the last lenght samples
+ *
+ * @param sdft          Sliding DFT instance
+ * @param amplitude     Array to store amplitudes (n_bins elements)
+ */
+void SdftAmplitude(sdft_t * sdft, float * amplitude);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* GOERTZEL_H_ */
+
+/*==================[end of file]============================================*/
@@ -16,13 +16,21 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 15/03/2024 | Document creation		                         						|
+ * | 17/10/2026 | Multi-instance SOS cascade filters, band pass and notch designs		|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
 /*==================[macros]=================================================*/
-
+#define IIR_MAX_ORDER           16                  /*!< Max. order of Butterworth designs */
+#define IIR_MAX_SECTIONS        IIR_MAX_ORDER       /*!< Max. number of 2nd order sections of a filter */
+#define IIR_SOS_COEFF           5                   /*!< Coefficients per section: b0, b1, b2, a1, a2 */
+#define IIR_SOS_DELAY           2                   /*!< Delay elements per section and channel */
+/** @brief Length of the coefficients array of a filter with n sections */
+#define IIR_COEFF_SIZE(n_sections)                  (IIR_SOS_COEFF * (n_sections))
+/** @brief Length of the state array of a filter with n sections and m channels */
+#define IIR_STATE_SIZE(n_sections, n_channels)      (IIR_SOS_DELAY * (n_sections) * (n_channels))
 /*==================[typedef]================================================*/
 typedef enum filter_order {
     ORDER_2 = 2,        /*!< 2nd order filter */
@@ -30,6 +38,18 @@ typedef enum filter_order {
     ORDER_6 = 6,        /*!< 6th order filter */
     ORDER_8 = 8         /*!< 8th order filter */
 } filter_order_t;
+
+/**
+ * @brief IIR filter instance: cascade of 2nd order sections (SOS) applied to one or more channels
+ * 
+ * @note Coefficients are shared by all channels, each channel has its own state.
+ */
+typedef struct {
+    float * coeffs;         /*!< Sections coefficients (IIR_COEFF_SIZE(n_sections) elements) */
+    float * state;          /*!< Delay elements (IIR_STATE_SIZE(n_sections, n_channels) elements) */
+    uint8_t n_sections;     /*!< Number of 2nd order sections */
+    uint8_t n_channels;     /*!< Number of channels */
+} iir_filter_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -60,6 +80,86 @@ void HiPassInit(float sample_frec, float cut_frec, filter_order_t order);
  */
 void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght);
 
+/**
+ * @brief Initialize an IIR filter instance
+ * 
+ * @note Coefficients must be designed with IIRLowPassDesign(), IIRHiPassDesign(), IIRBandPassDesign(), 
+ * IIRNotchDesign() (or a combination of them). The state array is cleared.
+ * 
+ * @param filter        Filter instance
+ * @param coeffs        Coefficients array (IIR_COEFF_SIZE(n_sections) elements)
+ * @param state         State array (IIR_STATE_SIZE(n_sections, n_channels) elements)
+ * @param n_sections    Number of 2nd order sections
+ * @param n_channels    Number of independent channels
+ */
+void IIRFilterInit(iir_filter_t * filter, float * coeffs, float * state, uint8_t n_sections, uint8_t n_channels);
+
+/**
+ * @brief Clear the state of all channels of a filter
+ * 
+ * @param filter        Filter instance
+ */
+void IIRFilterReset(iir_filter_t * filter);
+
+/**
+ * @brief Design a Butterworth Low Pass Filter as a cascade of 2nd order sections
+ * 
+ * @param coeffs        Coefficients array (IIR_COEFF_SIZE(order / 2) elements)
+ * @param sample_frec   Signal's sample frequency
+ * @param cut_frec      Filter's cut-off frequency
+ * @param order         Filter's order (even, up to IIR_MAX_ORDER)
+ * @return uint8_t      Number of sections designed
+ */
+uint8_t IIRLowPassDesign(float * coeffs, float sample_frec, float cut_frec, uint8_t order);
+
+/**
+ * @brief Design a Butterworth Hi Pass Filter as a cascade of 2nd order sections
+ * 
+ * @param coeffs        Coefficients array (IIR_COEFF_SIZE(order / 2) elements)
+ * @param sample_frec   Signal's sample frequency
+ * @param cut_frec      Filter's cut-off frequency
+ * @param order         Filter's order (even, up to IIR_MAX_ORDER)
+ * @return uint8_t      Number of sections designed
+ */
+uint8_t IIRHiPassDesign(float * coeffs, float sample_frec, float cut_frec, uint8_t order);
+
+/**
+ * @brief Design a Band Pass Filter as a Butterworth Hi Pass cascaded with a Butterworth Low Pass
+ * 
+ * @param coeffs        Coefficients array (IIR_COEFF_SIZE(order) elements)
+ * @param sample_frec   Signal's sample frequency
+ * @param low_frec      Lower cut-off frequency
+ * @param high_frec     Upper cut-off frequency
+ * @param order         Order of each of the two filters (even, up to IIR_MAX_ORDER)
+ * @return uint8_t      Number of sections designed
+ */
+uint8_t IIRBandPassDesign(float * coeffs, float sample_frec, float low_frec, float high_frec, uint8_t order);
+
+/**
+ * @brief Design a 2nd order Notch Filter (i.e. for 50 Hz mains rejection)
+ * 
+ * @param coeffs        Coefficients array (IIR_COEFF_SIZE(1) elements)
+ * @param sample_frec   Signal's sample frequency
+ * @param notch_frec    Rejected frequency
+ * @param q_factor      Quality factor (notch_frec / bandwidth)
+ * @return uint8_t      Number of sections designed (1)
+ */
+uint8_t IIRNotchDesign(float * coeffs, float sample_frec, float notch_frec, float q_factor);
+
+/**
+ * @brief Apply a filter to a signal array of one channel
+ * 
+ * @note All sections are applied in a single pass over the signal. Input and output 
+ * arrays can be the same.
+ * 
+ * @param filter            Filter instance
+ * @param channel           Channel number (from 0 to n_channels - 1)
+ * @param input_signal      Input signal array
+ * @param output_signal     Filtered signal array
+ * @param signal_lenght     Number of samples of both signals
+ */
+void IIRFilterProcess(iir_filter_t * filter, uint8_t channel, const float * input_signal, float * output_signal, uint16_t signal_lenght);
+
 /**
  * @brief Apply a hi pass filter to a signal array
  * 
@@ -0,0 +1,174 @@
+#ifndef STFT_H_
+#define STFT_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup STFT Short-Time Fourier Transform
+ */
+
+/** \brief Streaming STFT (spectrogram) with band power reduction
+ *
+ * Samples are pushed as they arrive (i.e. from the ADC task). Every hop samples the last
+ * fft_lenght samples are windowed and transformed, and the resulting spectral frame is
+ * stored in an output ring together with the power of each configured band.
+ *
+ * The input buffer is written twice (mirrored), so the last fft_lenght samples are always
+ * contiguous in memory and the window is never copied before the FFT.
+ *
+ * A producer task (StftPush) and a consumer task (StftReadFrame/StftReleaseFrame) can
+ * share an instance without locks.
+ *
+ * @note FFTInit() must be called before using this module.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "fft.h"
+/*==================[macros]=================================================*/
+#define STFT_MAX_BANDS          8           /*!< Max. number of bands of an instance */
+/** @brief Length of the input array (mirrored samples and window) for a given FFT lenght */
+#define STFT_INPUT_SIZE(fft_lenght)                 (3 * (fft_lenght))
+/** @brief Length of the spectra ring array for a given FFT lenght and number of frames */
+#define STFT_SPECTRA_SIZE(fft_lenght, n_frames)     (((fft_lenght) / 2) * (n_frames))
+/** @brief Length of the band power ring array for a given number of bands and frames */
+#define STFT_BANDS_SIZE(n_bands, n_frames)          ((n_bands) * (n_frames))
+/*==================[typedef]================================================*/
+/**
+ * @brief Window applied to each frame
+ */
+typedef enum stft_window {
+    STFT_WINDOW_HANN,               /*!< Hann window */
+    STFT_WINDOW_BLACKMAN,           /*!< Blackman window */
+    STFT_WINDOW_BLACKMAN_HARRIS,    /*!< Blackman-Harris window */
+    STFT_WINDOW_FLAT_TOP,           /*!< Flat top window (accurate amplitudes) */
+    STFT_WINDOW_RECT                /*!< No window */
+} stft_window_t;
+
+/**
+ * @brief Frequency band for band power reduction
+ */
+typedef struct {
+    float low_frec;                 /*!< Lower frequency (Hz) */
+    float high_frec;                /*!< Upper frequency (Hz) */
+} stft_band_t;
+
+/**
+ * @brief STFT configuration
+ */
+typedef struct {
+    float sample_frec;              /*!< Signal's sample frequency (Hz) */
+    uint16_t fft_lenght;            /*!< Frame lenght (power of two, up to MAX_SIGNAL_LENGHT) */
+    uint16_t hop;                   /*!< Samples between consecutive frames */
+    stft_window_t window;           /*!< Window applied to each frame */
+    fft_output_t output;            /*!< Format of stored spectra */
+    const stft_band_t * bands;      /*!< Bands for band power reduction (NULL if n_bands = 0) */
+    uint8_t n_bands;                /*!< Number of bands (up to STFT_MAX_BANDS) */
+    uint8_t n_frames;               /*!< Capacity of the output ring (in frames) */
+} stft_config_t;
+
+/**
+ * @brief STFT instance
+ */
+typedef struct {
+    float * input;                  /*!< Mirrored input samples (2 * fft_lenght) and window (fft_lenght): STFT_INPUT_SIZE(fft_lenght) elements */
+    float * window;                 /*!< Window values (fft_lenght elements) */
+    float * spectra;                /*!< Spectra ring (NULL if spectra are not stored) */
+    float * band_power;             /*!< Band power ring (NULL if there are no bands) */
+    float scale;                    /*!< Amplitude scale of the window */
+    float band_norm;                /*!< Band power normalization (1 / (2 * ENBW)) */
+    uint16_t fft_lenght;            /*!< Frame lenght */
+    uint16_t hop;                   /*!< Samples between consecutive frames */
+    uint16_t write_idx;             /*!< Position of next sample in input array */
+    uint16_t pending;               /*!< Samples received since last frame */
+    uint16_t filled;                /*!< Samples received (up to fft_lenght) */
+    uint16_t band_bins[STFT_MAX_BANDS][2];  /*!< First and last bin of each band */
+    uint8_t n_bands;                /*!< Number of bands */
+    uint8_t n_frames;               /*!< Capacity of the output ring */
+    fft_output_t output;            /*!< Format of stored spectra */
+    volatile uint32_t head;         /*!< Frames produced (only modified by producer) */
+    volatile uint32_t tail;         /*!< Frames released (only modified by consumer) */
+    volatile uint32_t dropped;      /*!< Frames dropped because the output ring was full */
+} stft_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a STFT instance
+ *
+ * @param stft          STFT instance
+ * @param config        Configuration
+ * @param input         Input array (STFT_INPUT_SIZE(fft_lenght) elements)
+ * @param spectra       Spectra ring (STFT_SPECTRA_SIZE(fft_lenght, n_frames) elements),
+ *                      NULL if only band power is needed
+ * @param band_power    Band power ring (STFT_BANDS_SIZE(n_bands, n_frames) elements),
+ *                      NULL if n_bands = 0
+ * @return true         STFT initialized
+ * @return false        Invalid configuration
+ */
+bool StftInit(stft_t * stft, const stft_config_t * config, float * input, float * spectra, float * band_power);
+
+/**
+ * @brief Discard input samples and stored frames
+ *
+ * @note Must not be called while producer or consumer are using the instance
+ *
+ * @param stft          STFT instance
+ */
+void StftReset(stft_t * stft);
+
+/**
+ * @brief Push new samples, computing a frame every hop samples (producer side)
+ *
+ * @param stft          STFT instance
+ * @param samples       New samples
+ * @param n             Number of samples
+ * @return uint16_t     Number of frames computed
+ */
+uint16_t StftPush(stft_t * stft, const float * samples, uint16_t n);
+
+/**
+ * @brief Number of frames stored in the output ring
+ *
+ * @param stft          STFT instance
+ * @return uint8_t      Frames available to the consumer
+ */
+uint8_t StftFramesAvailable(stft_t * stft);
+
+/**
+ * @brief Get the oldest stored frame (consumer side)
+ *
+ * @note Values are valid until StftReleaseFrame() is called
+ *
+ * @param stft          STFT instance
+ * @param spectrum      Returns a pointer to the spectrum (fft_lenght / 2 values, NULL if not stored). Can be NULL.
+ * @param band_power    Returns a pointer to the power of each band (n_bands values, mean square
+ *                      of the signal in band). Can be NULL.
+ * @return true         Frame available
+ * @return false        Output ring empty
+ */
+bool StftReadFrame(stft_t * stft, const float ** spectrum, const float ** band_power);
+
+/**
+ * @brief Release the oldest stored frame (consumer side)
+ *
+ * @param stft          STFT instance
+ */
+void StftReleaseFrame(stft_t * stft);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* STFT_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,141 @@
+#ifndef WELCH_H_
+#define WELCH_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Welch Welch PSD
+ */
+
+/** \brief Power spectral density estimation (Welch method)
+ *
+ * The signal is split in overlapped segments, each segment is windowed (Hann) and its
+ * periodogram is averaged into an accumulator owned by the caller. Averaging can be by
+ * blocks (mean of all segments since last reset) or exponential (running estimate).
+ *
+ * PSD values are one-sided and normalized by the window power, in units^2 / Hz
+ * (the sum of all bins multiplied by sample_frec / fft_lenght gives the signal power).
+ *
+ * A fixed point variant (sc16) is provided for int16_t signals, when float throughput is
+ * the bottleneck. Its input should use the full int16_t range (i.e. ADC values without
+ * offset and shifted left) because the fixed point FFT scales data on each stage.
+ *
+ * @note FFTInit() must be called before using the float variant.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "fft.h"
+/*==================[macros]=================================================*/
+/** @brief Length of the PSD array for a given FFT lenght */
+#define WELCH_PSD_SIZE(fft_lenght)      ((fft_lenght) / 2)
+/*==================[typedef]================================================*/
+/**
+ * @brief Averaging of segments periodograms
+ */
+typedef enum welch_average {
+    WELCH_AVERAGE_BLOCK,        /*!< Mean of all segments since last reset */
+    WELCH_AVERAGE_EXP           /*!< Exponential average: psd += alpha * (periodogram - psd) */
+} welch_average_t;
+
+/**
+ * @brief Welch estimator configuration
+ */
+typedef struct {
+    float sample_frec;          /*!< Signal's sample frequency (Hz) */
+    uint16_t fft_lenght;        /*!< Segment lenght (power of two, up to MAX_SIGNAL_LENGHT) */
+    uint16_t overlap;           /*!< Samples shared by consecutive segments (i.e. fft_lenght / 2) */
+    welch_average_t average;    /*!< Averaging mode */
+    float alpha;                /*!< Weight of new segments in exponential averaging (0 to 1) */
+} welch_config_t;
+
+/**
+ * @brief Welch estimator instance
+ */
+typedef struct {
+    float * psd;                /*!< PSD estimate (WELCH_PSD_SIZE(fft_lenght) elements) */
+    float * window;             /*!< Window of float variant (fft_lenght elements) */
+    int16_t * window_q15;       /*!< Window of sc16 variant (fft_lenght elements) */
+    float norm;                 /*!< Periodogram normalization (window power and sample frequency) */
+    float alpha;                /*!< Weight of new segments in exponential averaging */
+    uint32_t segments;          /*!< Segments averaged since last reset */
+    uint16_t fft_lenght;        /*!< Segment lenght */
+    uint16_t step;              /*!< Samples between consecutive segments */
+    welch_average_t average;    /*!< Averaging mode */
+} welch_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a Welch estimator for float signals
+ *
+ * @param welch         Welch instance
+ * @param config        Configuration
+ * @param window        Window array (fft_lenght elements)
+ * @param psd           PSD array (WELCH_PSD_SIZE(fft_lenght) elements)
+ * @return true         Estimator initialized
+ * @return false        Invalid configuration
+ */
+bool WelchInit(welch_t * welch, const welch_config_t * config, float * window, float * psd);
+
+/**
+ * @brief Initialize a Welch estimator for int16_t signals (fixed point FFT)
+ *
+ * @param welch         Welch instance
+ * @param config        Configuration
+ * @param window        Window array (fft_lenght elements)
+ * @param psd           PSD array (WELCH_PSD_SIZE(fft_lenght) elements)
+ * @return true         Estimator initialized
+ * @return false        Invalid configuration
+ */
+bool WelchInitSc16(welch_t * welch, const welch_config_t * config, int16_t * window, float * psd);
+
+/**
+ * @brief Clear the PSD estimate
+ *
+ * @param welch         Welch instance
+ */
+void WelchReset(welch_t * welch);
+
+/**
+ * @brief Average all the segments of a block of samples into the PSD estimate (float variant)
+ *
+ * @note Segments do not span consecutive calls: blocks of k * step + overlap samples use
+ * every sample.
+ *
+ * @param welch         Welch instance
+ * @param signal        Samples
+ * @param signal_lenght Number of samples
+ * @return uint16_t     Number of segments averaged
+ */
+uint16_t WelchUpdate(welch_t * welch, const float * signal, uint16_t signal_lenght);
+
+/**
+ * @brief Average all the segments of a block of samples into the PSD estimate (sc16 variant)
+ *
+ * @note Segments do not span consecutive calls: blocks of k * step + overlap samples use
+ * every sample.
+ *
+ * @param welch         Welch instance
+ * @param signal        Samples
+ * @param signal_lenght Number of samples
+ * @return uint16_t     Number of segments averaged
+ */
+uint16_t WelchUpdateSc16(welch_t * welch, const int16_t * signal, uint16_t signal_lenght);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* WELCH_H_ */
+
+/*==================[end of file]============================================*/
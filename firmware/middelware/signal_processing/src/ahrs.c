@@ -0,0 +1,219 @@
+/**
+ * @file ahrs.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <math.h>
+#include "ahrs.h"
+/*==================[macros and definitions]=================================*/
+#define RAD_TO_DEG      (180.0f / (float)M_PI)
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief 1 / sqrt(x), with two Newton iterations (relative error < 5e-6)
+ *
+ * @param x         Positive value
+ * @return float    Inverse square root
+ */
+static inline float InvSqrt(float x){
+    union {
+        float f;
+        uint32_t i;
+    } conv = {.f = x};
+    float half = 0.5f * x;
+    conv.i = 0x5F3759DF - (conv.i >> 1);
+    conv.f *= 1.5f - half * conv.f * conv.f;
+    conv.f *= 1.5f - half * conv.f * conv.f;
+    return conv.f;
+}
+
+/**
+ * @brief Madgwick update of a block (IMU version: accelerometer and gyroscope)
+ */
+static void MadgwickUpdate(ahrs_t * ahrs, const int16_t * ax, const int16_t * ay, const int16_t * az,
+    const int16_t * gx, const int16_t * gy, const int16_t * gz, uint16_t lenght){
+    float q0 = ahrs->q.w, q1 = ahrs->q.x, q2 = ahrs->q.y, q3 = ahrs->q.z;
+    // Gyroscope counts to quaternion derivative times dt: q' = 0.5 * q * w
+    const float half_dt_scale = 0.5f * ahrs->dt * ahrs->gyro_scale;
+    const float beta_dt = ahrs->beta * ahrs->dt;
+
+    for(uint16_t i = 0; i < lenght; i++){
+        float wx = gx[i] * half_dt_scale;
+        float wy = gy[i] * half_dt_scale;
+        float wz = gz[i] * half_dt_scale;
+        float d0 = -q1 * wx - q2 * wy - q3 * wz;
+        float d1 = q0 * wx + q2 * wz - q3 * wy;
+        float d2 = q0 * wy - q1 * wz + q3 * wx;
+        float d3 = q0 * wz + q1 * wy - q2 * wx;
+
+        if((ax[i] != 0) || (ay[i] != 0) || (az[i] != 0)){
+            float a_x = ax[i], a_y = ay[i], a_z = az[i];
+            float norm = InvSqrt(a_x * a_x + a_y * a_y + a_z * a_z);
+            a_x *= norm;
+            a_y *= norm;
+            a_z *= norm;
+            // Gradient of the error between measured and estimated gravity directions
+            float _2q0 = 2.0f * q0, _2q1 = 2.0f * q1, _2q2 = 2.0f * q2, _2q3 = 2.0f * q3;
+            float _4q0 = 4.0f * q0, _4q1 = 4.0f * q1, _4q2 = 4.0f * q2;
+            float _8q1 = 8.0f * q1, _8q2 = 8.0f * q2;
+            float q0q0 = q0 * q0, q1q1 = q1 * q1, q2q2 = q2 * q2, q3q3 = q3 * q3;
+            float s0 = _4q0 * q2q2 + _2q2 * a_x + _4q0 * q1q1 - _2q1 * a_y;
+            float s1 = _4q1 * q3q3 - _2q3 * a_x + 4.0f * q0q0 * q1 - _2q0 * a_y - _4q1 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * a_z;
+            float s2 = 4.0f * q0q0 * q2 + _2q0 * a_x + _4q2 * q3q3 - _2q3 * a_y - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * a_z;
+            float s3 = 4.0f * q1q1 * q3 - _2q1 * a_x + 4.0f * q2q2 * q3 - _2q2 * a_y;
+            float s_norm = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+            // Zero gradient: estimate already matches the measure
+            if(s_norm > 0.0f){
+                s_norm = beta_dt * InvSqrt(s_norm);
+                d0 -= s0 * s_norm;
+                d1 -= s1 * s_norm;
+                d2 -= s2 * s_norm;
+                d3 -= s3 * s_norm;
+            }
+        }
+        q0 += d0;
+        q1 += d1;
+        q2 += d2;
+        q3 += d3;
+        float norm = InvSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+        q0 *= norm;
+        q1 *= norm;
+        q2 *= norm;
+        q3 *= norm;
+    }
+    ahrs->q.w = q0;
+    ahrs->q.x = q1;
+    ahrs->q.y = q2;
+    ahrs->q.z = q3;
+}
+
+/**
+ * @brief Mahony update of a block (IMU version: accelerometer and gyroscope)
+ */
+static void MahonyUpdate(ahrs_t * ahrs, const int16_t * ax, const int16_t * ay, const int16_t * az,
+    const int16_t * gx, const int16_t * gy, const int16_t * gz, uint16_t lenght){
+    float q0 = ahrs->q.w, q1 = ahrs->q.x, q2 = ahrs->q.y, q3 = ahrs->q.z;
+    float bx = ahrs->bias[0], by = ahrs->bias[1], bz = ahrs->bias[2];
+    const float scale = ahrs->gyro_scale;
+    const float half_dt = 0.5f * ahrs->dt;
+    const float two_kp = 2.0f * ahrs->kp;
+    const float two_ki_dt = 2.0f * ahrs->ki * ahrs->dt;
+
+    for(uint16_t i = 0; i < lenght; i++){
+        float wx = gx[i] * scale;
+        float wy = gy[i] * scale;
+        float wz = gz[i] * scale;
+
+        if((ax[i] != 0) || (ay[i] != 0) || (az[i] != 0)){
+            float a_x = ax[i], a_y = ay[i], a_z = az[i];
+            float norm = InvSqrt(a_x * a_x + a_y * a_y + a_z * a_z);
+            a_x *= norm;
+            a_y *= norm;
+            a_z *= norm;
+            // Half of the estimated gravity direction (third row of the rotation matrix)
+            float vx = q1 * q3 - q0 * q2;
+            float vy = q0 * q1 + q2 * q3;
+            float vz = q0 * q0 - 0.5f + q3 * q3;
+            // Error: cross product between measured and estimated directions
+            float ex = a_y * vz - a_z * vy;
+            float ey = a_z * vx - a_x * vz;
+            float ez = a_x * vy - a_y * vx;
+            if(two_ki_dt > 0.0f){
+                bx += two_ki_dt * ex;
+                by += two_ki_dt * ey;
+                bz += two_ki_dt * ez;
+            }
+            wx += two_kp * ex;
+            wy += two_kp * ey;
+            wz += two_kp * ez;
+        }
+        wx = (wx + bx) * half_dt;
+        wy = (wy + by) * half_dt;
+        wz = (wz + bz) * half_dt;
+        float p0 = q0, p1 = q1, p2 = q2;
+        q0 += -p1 * wx - p2 * wy - q3 * wz;
+        q1 += p0 * wx + p2 * wz - q3 * wy;
+        q2 += p0 * wy - p1 * wz + q3 * wx;
+        q3 += p0 * wz + p1 * wy - p2 * wx;
+        float norm = InvSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+        q0 *= norm;
+        q1 *= norm;
+        q2 *= norm;
+        q3 *= norm;
+    }
+    ahrs->q.w = q0;
+    ahrs->q.x = q1;
+    ahrs->q.y = q2;
+    ahrs->q.z = q3;
+    ahrs->bias[0] = bx;
+    ahrs->bias[1] = by;
+    ahrs->bias[2] = bz;
+}
+
+/*==================[external functions definition]==========================*/
+void AHRSMadgwickInit(ahrs_t * ahrs, float sample_frec, float gyro_scale, float beta){
+    ahrs->algorithm = AHRS_MADGWICK;
+    ahrs->gyro_scale = gyro_scale;
+    ahrs->dt = 1.0f / sample_frec;
+    ahrs->beta = beta;
+    ahrs->kp = 0.0f;
+    ahrs->ki = 0.0f;
+    AHRSReset(ahrs);
+}
+
+void AHRSMahonyInit(ahrs_t * ahrs, float sample_frec, float gyro_scale, float kp, float ki){
+    ahrs->algorithm = AHRS_MAHONY;
+    ahrs->gyro_scale = gyro_scale;
+    ahrs->dt = 1.0f / sample_frec;
+    ahrs->beta = 0.0f;
+    ahrs->kp = kp;
+    ahrs->ki = ki;
+    AHRSReset(ahrs);
+}
+
+void AHRSReset(ahrs_t * ahrs){
+    ahrs->q = (quaternion_t){.w = 1.0f, .x = 0.0f, .y = 0.0f, .z = 0.0f};
+    ahrs->bias[0] = 0.0f;
+    ahrs->bias[1] = 0.0f;
+    ahrs->bias[2] = 0.0f;
+}
+
+void AHRSUpdate(ahrs_t * ahrs, const int16_t * ax, const int16_t * ay, const int16_t * az,
+    const int16_t * gx, const int16_t * gy, const int16_t * gz, uint16_t lenght){
+    if(ahrs->algorithm == AHRS_MADGWICK){
+        MadgwickUpdate(ahrs, ax, ay, az, gx, gy, gz, lenght);
+    }
+    else{
+        MahonyUpdate(ahrs, ax, ay, az, gx, gy, gz, lenght);
+    }
+}
+
+void AHRSGetEuler(const ahrs_t * ahrs, float * roll, float * pitch, float * yaw){
+    const quaternion_t * q = &ahrs->q;
+    float sin_pitch = 2.0f * (q->w * q->y - q->z * q->x);
+    if(sin_pitch > 1.0f){
+        sin_pitch = 1.0f;
+    }
+    else if(sin_pitch < -1.0f){
+        sin_pitch = -1.0f;
+    }
+    *roll = atan2f(2.0f * (q->w * q->x + q->y * q->z), 1.0f - 2.0f * (q->x * q->x + q->y * q->y)) * RAD_TO_DEG;
+    *pitch = asinf(sin_pitch) * RAD_TO_DEG;
+    *yaw = atan2f(2.0f * (q->w * q->z + q->x * q->y), 1.0f - 2.0f * (q->y * q->y + q->z * q->z)) * RAD_TO_DEG;
+}
+
+/*==================[end of file]============================================*/
@@ -17,9 +17,13 @@
 #include "esp_log.h"
 /*==================[macros and definitions]=================================*/
 #define TAG "FFT Module"
+#define DB_FLOOR    1e-12f      /*!< Min. power used to calculate dB (avoids log10(0)) */
 /*==================[internal data declaration]==============================*/
-static float fft_complex[2 * MAX_SIGNAL_LENGHT];
-static float wind[MAX_SIGNAL_LENGHT];
+static float fft_complex[MAX_SIGNAL_LENGHT];                /*!< signal_lenght / 2 complex values */
+static float wind[MAX_SIGNAL_LENGHT];                       /*!< Hann window (cached) */
+static float twiddle[MAX_SIGNAL_LENGHT / 2 + 2];            /*!< exp(-j*2*pi*k/N), k = 0..N/4 (cached) */
+static uint16_t wind_lenght = 0;                            /*!< Lenght of cached window */
+static uint16_t twiddle_lenght = 0;                         /*!< Lenght of cached twiddle factors */
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
@@ -27,6 +31,102 @@ static float wind[MAX_SIGNAL_LENGHT];
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Generates (only if the lenght changed) the twiddle factors used to split the half lenght FFT
+ * 
+ * @param signal_lenght     Lenght of the real signal
+ */
+static void FFTTwiddleUpdate(uint16_t signal_lenght){
+    if(twiddle_lenght == signal_lenght){
+        return;
+    }
+    for(uint16_t k = 0; k <= signal_lenght / 4; k++){
+        float angle = 2 * M_PI * k / signal_lenght;
+        twiddle[2 * k + 0] = cosf(angle);
+        twiddle[2 * k + 1] = -sinf(angle);
+    }
+    twiddle_lenght = signal_lenght;
+}
+
+/**
+ * @brief Splits the FFT of a real signal packed as a complex signal of half lenght into its spectrum
+ * 
+ * @note On return data[2k], data[2k+1] hold the real and imaginary part of bin k (k = 1..N/2-1),
+ * data[0] holds bin 0 and data[1] holds bin N/2 (both real).
+ * 
+ * @param data              Complex FFT of signal_lenght / 2 points (in natural order)
+ * @param signal_lenght     Lenght of the real signal
+ */
+static void FFTRealSplit(float * data, uint16_t signal_lenght){
+    const uint16_t m = signal_lenght / 2;
+    float z0_re = data[0];
+    float z0_im = data[1];
+    data[0] = z0_re + z0_im;
+    data[1] = z0_re - z0_im;
+    for(uint16_t k = 1; k <= m / 2; k++){
+        float zk_re = data[2 * k], zk_im = data[2 * k + 1];
+        float zn_re = data[2 * (m - k)], zn_im = data[2 * (m - k) + 1];
+        // even and odd samples spectra
+        float e_re = 0.5f * (zk_re + zn_re);
+        float e_im = 0.5f * (zk_im - zn_im);
+        float o_re = 0.5f * (zk_im + zn_im);
+        float o_im = 0.5f * (zn_re - zk_re);
+        float w_re = twiddle[2 * k], w_im = twiddle[2 * k + 1];
+        float t_re = w_re * o_re - w_im * o_im;
+        float t_im = w_re * o_im + w_im * o_re;
+        data[2 * k] = e_re + t_re;
+        data[2 * k + 1] = e_im + t_im;
+        data[2 * (m - k)] = e_re - t_re;
+        data[2 * (m - k) + 1] = t_im - e_im;
+    }
+}
+
+/**
+ * @brief Calculates the windowed FFT of a real signal through a complex FFT of half lenght
+ * 
+ * @param signal            Array with signal values (of lenght = signal_lenght)
+ * @param window            Window to apply (of lenght = signal_lenght)
+ * @param fft               Array to store FFT values (of lenght = signal_lenght / 2)
+ * @param signal_lenght     Lenght of signal arrays
+ * @param output            Output format (magnitude, power or dB)
+ * @param scale             Scale factor for bins 1 to signal_lenght / 2 - 1
+ * @param dc_scale          Scale factor for bin 0
+ */
+static void FFTRealCompute(const float * signal, const float * window, float * fft, uint16_t signal_lenght, 
+                           fft_output_t output, float scale, float dc_scale){
+    const uint16_t m = signal_lenght / 2;
+    float re, im;
+    FFTTwiddleUpdate(signal_lenght);
+    // Multiply input array with window, even samples as real part and odd samples as imaginary part
+    dsps_mul_f32(signal, window, fft_complex, signal_lenght, 1, 1, 1);
+    // Calculate FFT of half lenght
+    dsps_fft2r_fc32(fft_complex, m);
+    // Bit reverse
+    dsps_bit_rev_fc32(fft_complex, m);
+    // Convert to spectrum of the real signal
+    FFTRealSplit(fft_complex, signal_lenght);
+    // DC component has its own scale, bin N/2 (stored in fft_complex[1]) is not returned
+    fft_complex[0] *= dc_scale / scale;
+    fft_complex[1] = 0;
+    for(uint16_t k = 0; k < m; k++){
+        re = fft_complex[2 * k] * scale;
+        im = fft_complex[2 * k + 1] * scale;
+        fft[k] = re * re + im * im;
+    }
+    FFTPowerConvert(fft, m, output);
+}
+
+/**
+ * @brief Generates the Hann window used by FFTReal and FFTMagnitude (only if the lenght changed)
+ * 
+ * @param signal_lenght     Lenght of the window
+ */
+static void FFTHannUpdate(uint16_t signal_lenght){
+    if(wind_lenght != signal_lenght){
+        dsps_wind_hann_f32(wind, signal_lenght);
+        wind_lenght = signal_lenght;
+    }
+}
 
 /*==================[external functions definition]==========================*/
 bool FFTInit(void){
@@ -37,26 +137,46 @@ bool FFTInit(void){
     return true;
 }
 
-void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght){
-    // Generate Hann window
-    dsps_wind_hann_f32(wind, signal_lenght);
-    // Clear fft array
-    memset(fft_complex, 0, 2 * MAX_SIGNAL_LENGHT * sizeof(float));
-    // Multiply input array with window and store as real part
-    dsps_mul_f32(signal, wind, fft_complex, signal_lenght, 1, 1, 2);    
-    // Calculate FFT  
-    dsps_fft2r_fc32(fft_complex, signal_lenght);
-    // Bit reverse
-    dsps_bit_rev_fc32(fft_complex, signal_lenght);
-    // Convert one complex vector to two complex vectors
-    dsps_cplx2reC_fc32(fft_complex, signal_lenght);
-    // Calculate FFT magnitude 
-    for (int j = 0; j < signal_lenght; j++){
-            fft_complex[j] = 2*(sqrt(fft_complex[j*2+0]*fft_complex[j*2+0] + fft_complex[j*2+1]*fft_complex[j*2+1])) / (signal_lenght/2);
+void FFTReal(float * signal, float * fft, uint16_t signal_lenght, fft_output_t output){
+    FFTHannUpdate(signal_lenght);
+    // Scale factor matches amplitude of a sinusoid after Hann window
+    FFTRealCompute(signal, wind, fft, signal_lenght, output, 4.0f / signal_lenght, 2.0f / signal_lenght);
+}
+
+void FFTRealWindowed(const float * signal, const float * window, float * fft, uint16_t signal_lenght, 
+                     fft_output_t output, float scale){
+    FFTRealCompute(signal, window, fft, signal_lenght, output, scale, scale / 2);
+}
+
+void FFTPowerConvert(float * fft, uint16_t lenght, fft_output_t output){
+    switch(output){
+        case FFT_MAGNITUDE:
+            for(uint16_t k = 0; k < lenght; k++){
+                fft[k] = sqrtf(fft[k]);
+            }
+        break;
+        case FFT_POWER:
+        break;
+        case FFT_DB:
+            for(uint16_t k = 0; k < lenght; k++){
+                fft[k] = 10.0f * log10f(fft[k] + DB_FLOOR);
+            }
+        break;
     }
-    fft_complex[0] = fft_complex[0] / 2;
-    // Copy result in fft array
-    memcpy(fft, fft_complex, (signal_lenght / 2) * sizeof(float));
+}
+
+float FFTWindowScale(const float * window, uint16_t signal_lenght){
+    float sum = 0;
+    for(uint16_t i = 0; i < signal_lenght; i++){
+        sum += window[i];
+    }
+    return 2.0f / sum;
+}
+
+void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght){
+    FFTHannUpdate(signal_lenght);
+    // Scale factor of previous versions of this function is kept
+    FFTRealCompute(signal, wind, fft, signal_lenght, FFT_MAGNITUDE, 8.0f / signal_lenght, 2.0f / signal_lenght);
 }
 
 void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f){
@@ -0,0 +1,302 @@
+/**
+ * @file goertzel.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <math.h>
+#include "goertzel.h"
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Run the recursions of eight consecutive frequencies over a chunk of samples
+ *
+ * @note The recursions are independent: interleaving them hides the latency of each one,
+ * and the states stay in registers during the whole chunk.
+ *
+ * @param bank          Goertzel instance
+ * @param k             First frequency
+ * @param signal        Samples
+ * @param n             Number of samples
+ */
+static void GoertzelRun8(goertzel_t * bank, uint8_t k, const float * signal, uint16_t n){
+    const float * c = &bank->coeff[k];
+    float s1_0 = bank->s1[k], s1_1 = bank->s1[k + 1], s1_2 = bank->s1[k + 2], s1_3 = bank->s1[k + 3];
+    float s1_4 = bank->s1[k + 4], s1_5 = bank->s1[k + 5], s1_6 = bank->s1[k + 6], s1_7 = bank->s1[k + 7];
+    float s2_0 = bank->s2[k], s2_1 = bank->s2[k + 1], s2_2 = bank->s2[k + 2], s2_3 = bank->s2[k + 3];
+    float s2_4 = bank->s2[k + 4], s2_5 = bank->s2[k + 5], s2_6 = bank->s2[k + 6], s2_7 = bank->s2[k + 7];
+    float x, s0;
+    for(uint16_t i = 0; i < n; i++){
+        x = signal[i];
+        s0 = (x - s2_0) + c[0] * s1_0;
+        s2_0 = s1_0;
+        s1_0 = s0;
+        s0 = (x - s2_1) + c[1] * s1_1;
+        s2_1 = s1_1;
+        s1_1 = s0;
+        s0 = (x - s2_2) + c[2] * s1_2;
+        s2_2 = s1_2;
+        s1_2 = s0;
+        s0 = (x - s2_3) + c[3] * s1_3;
+        s2_3 = s1_3;
+        s1_3 = s0;
+        s0 = (x - s2_4) + c[4] * s1_4;
+        s2_4 = s1_4;
+        s1_4 = s0;
+        s0 = (x - s2_5) + c[5] * s1_5;
+        s2_5 = s1_5;
+        s1_5 = s0;
+        s0 = (x - s2_6) + c[6] * s1_6;
+        s2_6 = s1_6;
+        s1_6 = s0;
+        s0 = (x - s2_7) + c[7] * s1_7;
+        s2_7 = s1_7;
+        s1_7 = s0;
+    }
+    bank->s1[k] = s1_0;
+    bank->s1[k + 1] = s1_1;
+    bank->s1[k + 2] = s1_2;
+    bank->s1[k + 3] = s1_3;
+    bank->s1[k + 4] = s1_4;
+    bank->s1[k + 5] = s1_5;
+    bank->s1[k + 6] = s1_6;
+    bank->s1[k + 7] = s1_7;
+    bank->s2[k] = s2_0;
+    bank->s2[k + 1] = s2_1;
+    bank->s2[k + 2] = s2_2;
+    bank->s2[k + 3] = s2_3;
+    bank->s2[k + 4] = s2_4;
+    bank->s2[k + 5] = s2_5;
+    bank->s2[k + 6] = s2_6;
+    bank->s2[k + 7] = s2_7;
+}
+
+/**
+ * @brief Run the recursions of four consecutive frequencies over a chunk of samples
+ *
+ * @param bank          Goertzel instance
+ * @param k             First frequency
+ * @param signal        Samples
+ * @param n             Number of samples
+ */
+static void GoertzelRun4(goertzel_t * bank, uint8_t k, const float * signal, uint16_t n){
+    const float c_0 = bank->coeff[k], c_1 = bank->coeff[k + 1], c_2 = bank->coeff[k + 2], c_3 = bank->coeff[k + 3];
+    float s1_0 = bank->s1[k], s1_1 = bank->s1[k + 1], s1_2 = bank->s1[k + 2], s1_3 = bank->s1[k + 3];
+    float s2_0 = bank->s2[k], s2_1 = bank->s2[k + 1], s2_2 = bank->s2[k + 2], s2_3 = bank->s2[k + 3];
+    float x, s0;
+    for(uint16_t i = 0; i < n; i++){
+        x = signal[i];
+        s0 = (x - s2_0) + c_0 * s1_0;
+        s2_0 = s1_0;
+        s1_0 = s0;
+        s0 = (x - s2_1) + c_1 * s1_1;
+        s2_1 = s1_1;
+        s1_1 = s0;
+        s0 = (x - s2_2) + c_2 * s1_2;
+        s2_2 = s1_2;
+        s1_2 = s0;
+        s0 = (x - s2_3) + c_3 * s1_3;
+        s2_3 = s1_3;
+        s1_3 = s0;
+    }
+    bank->s1[k] = s1_0;
+    bank->s1[k + 1] = s1_1;
+    bank->s1[k + 2] = s1_2;
+    bank->s1[k + 3] = s1_3;
+    bank->s2[k] = s2_0;
+    bank->s2[k + 1] = s2_1;
+    bank->s2[k + 2] = s2_2;
+    bank->s2[k + 3] = s2_3;
+}
+
+/**
+ * @brief Run the recursions of two consecutive frequencies over a chunk of samples
+ *
+ * @param bank          Goertzel instance
+ * @param k             First frequency
+ * @param signal        Samples
+ * @param n             Number of samples
+ */
+static void GoertzelRun2(goertzel_t * bank, uint8_t k, const float * signal, uint16_t n){
+    const float c_0 = bank->coeff[k], c_1 = bank->coeff[k + 1];
+    float s1_0 = bank->s1[k], s1_1 = bank->s1[k + 1];
+    float s2_0 = bank->s2[k], s2_1 = bank->s2[k + 1];
+    float x, s0;
+    for(uint16_t i = 0; i < n; i++){
+        x = signal[i];
+        s0 = (x - s2_0) + c_0 * s1_0;
+        s2_0 = s1_0;
+        s1_0 = s0;
+        s0 = (x - s2_1) + c_1 * s1_1;
+        s2_1 = s1_1;
+        s1_1 = s0;
+    }
+    bank->s1[k] = s1_0;
+    bank->s1[k + 1] = s1_1;
+    bank->s2[k] = s2_0;
+    bank->s2[k + 1] = s2_1;
+}
+
+/**
+ * @brief Run the recursion of one frequency over a chunk of samples
+ *
+ * @param bank          Goertzel instance
+ * @param k             Frequency
+ * @param signal        Samples
+ * @param n             Number of samples
+ */
+static void GoertzelRun1(goertzel_t * bank, uint8_t k, const float * signal, uint16_t n){
+    const float c_0 = bank->coeff[k];
+    float s1_0 = bank->s1[k];
+    float s2_0 = bank->s2[k];
+    float s0;
+    for(uint16_t i = 0; i < n; i++){
+        s0 = (signal[i] - s2_0) + c_0 * s1_0;
+        s2_0 = s1_0;
+        s1_0 = s0;
+    }
+    bank->s1[k] = s1_0;
+    bank->s2[k] = s2_0;
+}
+
+/*==================[external functions definition]==========================*/
+bool GoertzelInit(goertzel_t * bank, const float * frecs, uint8_t n_bins, float sample_frec, uint16_t block_lenght){
+    if((n_bins == 0) || (n_bins > GOERTZEL_MAX_BINS) || (block_lenght == 0)){
+        return false;
+    }
+    // Frequencies are processed in groups of 8, 4, 2 or 1: unused ones are left at 0
+    memset(bank->coeff, 0, sizeof(bank->coeff));
+    for(uint8_t k = 0; k < n_bins; k++){
+        bank->coeff[k] = 2.0f * cosf(2 * M_PI * frecs[k] / sample_frec);
+    }
+    bank->n_bins = n_bins;
+    bank->block_lenght = block_lenght;
+    bank->scale = 2.0f / block_lenght;
+    GoertzelReset(bank);
+    return true;
+}
+
+void GoertzelReset(goertzel_t * bank){
+    memset(bank->s1, 0, sizeof(bank->s1));
+    memset(bank->s2, 0, sizeof(bank->s2));
+    memset(bank->amplitude, 0, sizeof(bank->amplitude));
+    bank->count = 0;
+}
+
+uint16_t GoertzelProcess(goertzel_t * bank, const float * signal, uint16_t n){
+    uint16_t blocks = 0;
+    uint16_t chunk;
+    uint8_t k;
+    float s1, s2, power;
+    while(n > 0){
+        chunk = bank->block_lenght - bank->count;
+        if(chunk > n){
+            chunk = n;
+        }
+        // As many frequencies per pass over the chunk as possible: 7 are run as 8 and 3 as 4
+        // (unused frequencies have coeff 0), then a pair or a single one if left
+        k = 0;
+        if(bank->n_bins >= 7){
+            GoertzelRun8(bank, k, signal, chunk);
+            k = 8;
+        }else if(bank->n_bins >= 3){
+            GoertzelRun4(bank, k, signal, chunk);
+            k = 4;
+        }
+        if(k + 2 == bank->n_bins){
+            GoertzelRun2(bank, k, signal, chunk);
+        }else if(k + 1 == bank->n_bins){
+            GoertzelRun1(bank, k, signal, chunk);
+        }
+        bank->count += chunk;
+        signal += chunk;
+        n -= chunk;
+        if(bank->count == bank->block_lenght){
+            for(k = 0; k < bank->n_bins; k++){
+                s1 = bank->s1[k];
+                s2 = bank->s2[k];
+                power = s1 * s1 + s2 * s2 - bank->coeff[k] * s1 * s2;
+                bank->amplitude[k] = bank->scale * sqrtf(fmaxf(power, 0));
+                bank->s1[k] = 0;
+                bank->s2[k] = 0;
+            }
+            bank->count = 0;
+            blocks++;
+        }
+    }
+    return blocks;
+}
+
+bool SdftInit(sdft_t * sdft, const float * frecs, uint8_t n_bins, float sample_frec, float * delay, uint16_t lenght){
+    float w, r_n;
+    if((n_bins == 0) || (n_bins > GOERTZEL_MAX_BINS) || (lenght == 0)){
+        return false;
+    }
+    r_n = powf(SDFT_DAMPING, lenght);
+    for(uint8_t k = 0; k < n_bins; k++){
+        w = 2 * M_PI * frecs[k] / sample_frec;
+        sdft->rot_re[k] = SDFT_DAMPING * cosf(w);
+        sdft->rot_im[k] = -SDFT_DAMPING * sinf(w);
+        // Phase of the sample leaving the window, reduced to [0, 2pi) to keep precision
+        w = fmodf(w * lenght, 2 * M_PI);
+        sdft->comb_re[k] = r_n * cosf(w);
+        sdft->comb_im[k] = -r_n * sinf(w);
+    }
+    sdft->delay = delay;
+    sdft->lenght = lenght;
+    sdft->n_bins = n_bins;
+    // 2 / sum of the damping weights (2 / lenght without damping)
+    sdft->scale = 2.0f * (1.0f - SDFT_DAMPING) / (1.0f - r_n);
+    SdftReset(sdft);
+    return true;
+}
+
+void SdftReset(sdft_t * sdft){
+    memset(sdft->delay, 0, sdft->lenght * sizeof(float));
+    memset(sdft->re, 0, sizeof(sdft->re));
+    memset(sdft->im, 0, sizeof(sdft->im));
+    sdft->idx = 0;
+}
+
+void SdftProcess(sdft_t * sdft, const float * signal, uint16_t n){
+    float x, old, re, im;
+    for(uint16_t i = 0; i < n; i++){
+        x = signal[i];
+        old = sdft->delay[sdft->idx];
+        sdft->delay[sdft->idx] = x;
+        if(++sdft->idx == sdft->lenght){
+            sdft->idx = 0;
+        }
+        // X(n) = r * exp(-jw) * X(n-1) + x(n) - r^N * exp(-jwN) * x(n-N)
+        for(uint8_t k = 0; k < sdft->n_bins; k++){
+            re = sdft->re[k];
+            im = sdft->im[k];
+            sdft->re[k] = sdft->rot_re[k] * re - sdft->rot_im[k] * im + x - sdft->comb_re[k] * old;
+            sdft->im[k] = sdft->rot_re[k] * im + sdft->rot_im[k] * re - sdft->comb_im[k] * old;
+        }
+    }
+}
+
+void SdftAmplitude(sdft_t * sdft, float * amplitude){
+    for(uint8_t k = 0; k < sdft->n_bins; k++){
+        amplitude[k] = sdft->scale * sqrtf(sdft->re[k] * sdft->re[k] + sdft->im[k] * sdft->im[k]);
+    }
+}
+
+/*==================[end of file]============================================*/
@@ -10,43 +10,18 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <string.h>
+#include <math.h>
 #include "iir_filter.h"
 #include "esp_dsp.h"
 /*==================[macros and definitions]=================================*/
-#define N_SOS       5
-#define N_DELAY     2
-// 2nd order Butterworth 
-#define ORDER2_Q    (1 / 1.414)
-// 4th order Butterworth 
-#define ORDER4_Q1   (1 / 0.765)
-#define ORDER4_Q2   (1 / 1.848)
-// 6th order Butterworth 
-#define ORDER6_Q1   (1 / 0.518)
-#define ORDER6_Q2   (1 / 1.414)
-#define ORDER6_Q3   (1 / 1.932)
-// 8th order Butterworth 
-#define ORDER8_Q1   (1 / 0.390)
-#define ORDER8_Q2   (1 / 1.111)
-#define ORDER8_Q3   (1 / 1.663)
-#define ORDER8_Q4   (1 / 1.962)
+#define LEGACY_SECTIONS     (ORDER_8 / 2)   /*!< Sections of LowPassFilter/HiPassFilter (up to 8th order) */
 /*==================[internal data declaration]==============================*/
-static uint8_t lp_order, hp_order;
-float hp2_delay[N_DELAY] = {0, 0};  // delay
-float hp4_delay[N_DELAY] = {0, 0};  // delay
-float hp6_delay[N_DELAY] = {0, 0};  // delay
-float hp8_delay[N_DELAY] = {0, 0};  // delay
-float lp2_delay[N_DELAY] = {0, 0};  // delay
-float lp4_delay[N_DELAY] = {0, 0};  // delay
-float lp6_delay[N_DELAY] = {0, 0};  // delay
-float lp8_delay[N_DELAY] = {0, 0};  // delay
-float lp2_sos_coeff[N_SOS]; 
-float lp4_sos_coeff[N_SOS]; 
-float lp6_sos_coeff[N_SOS]; 
-float lp8_sos_coeff[N_SOS]; 
-float hp2_sos_coeff[N_SOS]; 
-float hp4_sos_coeff[N_SOS]; 
-float hp6_sos_coeff[N_SOS]; 
-float hp8_sos_coeff[N_SOS]; 
+static iir_filter_t lp_filter, hp_filter;
+static float lp_coeffs[IIR_COEFF_SIZE(LEGACY_SECTIONS)];
+static float hp_coeffs[IIR_COEFF_SIZE(LEGACY_SECTIONS)];
+static float lp_state[IIR_STATE_SIZE(LEGACY_SECTIONS, 1)];
+static float hp_state[IIR_STATE_SIZE(LEGACY_SECTIONS, 1)];
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
@@ -54,103 +29,137 @@ float hp8_sos_coeff[N_SOS];
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Q factor of one section of a Butterworth filter
+ * 
+ * @param section   Section number (from 0 to order / 2 - 1)
+ * @param order     Filter's order (even)
+ * @return float    Q factor
+ */
+static float ButterworthQ(uint8_t section, uint8_t order){
+    return 1.0f / (2.0f * cosf((2 * section + 1) * M_PI / (2 * order)));
+}
+
+/**
+ * @brief Number of sections of a Butterworth filter (odd orders are rounded up)
+ * 
+ * @param order     Filter's order
+ * @return uint8_t  Number of sections
+ */
+static uint8_t ButterworthSections(uint8_t order){
+    if(order > IIR_MAX_ORDER){
+        order = IIR_MAX_ORDER;
+    }
+    return (order + 1) / 2;
+}
 
 /*==================[external functions definition]==========================*/
+void IIRFilterInit(iir_filter_t * filter, float * coeffs, float * state, uint8_t n_sections, uint8_t n_channels){
+    if(n_sections > IIR_MAX_SECTIONS){
+        n_sections = IIR_MAX_SECTIONS;
+    }
+    filter->coeffs = coeffs;
+    filter->state = state;
+    filter->n_sections = n_sections;
+    filter->n_channels = n_channels;
+    IIRFilterReset(filter);
+}
 
-void LowPassInit(float sample_frec, float cut_frec, filter_order_t order){
+void IIRFilterReset(iir_filter_t * filter){
+    memset(filter->state, 0, IIR_STATE_SIZE(filter->n_sections, filter->n_channels) * sizeof(float));
+}
+
+uint8_t IIRLowPassDesign(float * coeffs, float sample_frec, float cut_frec, uint8_t order){
     float f = cut_frec / sample_frec;
-    lp_order = order;
-    switch(lp_order){
-        case ORDER_2:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER2_Q);
-        break;
-        case ORDER_4:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER4_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER4_Q2);
-        break;
-        case ORDER_6:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER6_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER6_Q2);
-            dsps_biquad_gen_lpf_f32(lp6_sos_coeff, f, ORDER6_Q3);
-        break;
-        case ORDER_8:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER8_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER8_Q2);
-            dsps_biquad_gen_lpf_f32(lp6_sos_coeff, f, ORDER8_Q3);
-            dsps_biquad_gen_lpf_f32(lp8_sos_coeff, f, ORDER8_Q4);
-        break;
+    uint8_t n_sections = ButterworthSections(order);
+    for(uint8_t i = 0; i < n_sections; i++){
+        dsps_biquad_gen_lpf_f32(&coeffs[IIR_COEFF_SIZE(i)], f, ButterworthQ(i, 2 * n_sections));
     }
+    return n_sections;
 }
 
-void HiPassInit(float sample_frec, float cut_frec, filter_order_t order){
+uint8_t IIRHiPassDesign(float * coeffs, float sample_frec, float cut_frec, uint8_t order){
     float f = cut_frec / sample_frec;
-    hp_order = order;
-    switch(hp_order){
-        case ORDER_2:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER2_Q);
-        break;
-        case ORDER_4:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER4_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER4_Q2);
-        break;
-        case ORDER_6:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER6_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER6_Q2);
-            dsps_biquad_gen_hpf_f32(hp6_sos_coeff, f, ORDER6_Q3);
-        break;
-        case ORDER_8:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER8_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER8_Q2);
-            dsps_biquad_gen_hpf_f32(hp6_sos_coeff, f, ORDER8_Q3);
-            dsps_biquad_gen_hpf_f32(hp8_sos_coeff, f, ORDER8_Q4);
-        break;
+    uint8_t n_sections = ButterworthSections(order);
+    for(uint8_t i = 0; i < n_sections; i++){
+        dsps_biquad_gen_hpf_f32(&coeffs[IIR_COEFF_SIZE(i)], f, ButterworthQ(i, 2 * n_sections));
+    }
+    return n_sections;
+}
+
+uint8_t IIRBandPassDesign(float * coeffs, float sample_frec, float low_frec, float high_frec, uint8_t order){
+    uint8_t n_sections = IIRHiPassDesign(coeffs, sample_frec, low_frec, order);
+    n_sections += IIRLowPassDesign(&coeffs[IIR_COEFF_SIZE(n_sections)], sample_frec, high_frec, order);
+    return n_sections;
+}
+
+uint8_t IIRNotchDesign(float * coeffs, float sample_frec, float notch_frec, float q_factor){
+    // RBJ notch (zeros on the unit circle, infinite rejection at notch_frec)
+    float w0 = 2 * M_PI * notch_frec / sample_frec;
+    float c = cosf(w0);
+    float alpha = sinf(w0) / (2 * q_factor);
+    float a0 = 1 + alpha;
+    coeffs[0] = 1 / a0;
+    coeffs[1] = -2 * c / a0;
+    coeffs[2] = 1 / a0;
+    coeffs[3] = -2 * c / a0;
+    coeffs[4] = (1 - alpha) / a0;
+    return 1;
+}
+
+void IIRFilterProcess(iir_filter_t * filter, uint8_t channel, const float * input_signal, float * output_signal, uint16_t signal_lenght){
+    const uint8_t n_sections = filter->n_sections;
+    float * state = &filter->state[IIR_STATE_SIZE(n_sections, channel)];
+    float w[IIR_MAX_SECTIONS][IIR_SOS_DELAY];
+    if(channel >= filter->n_channels){
+        return;
+    }
+    // state is kept in a local copy while the block is processed
+    memcpy(w, state, IIR_STATE_SIZE(n_sections, 1) * sizeof(float));
+    for(uint16_t i = 0; i < signal_lenght; i++){
+        const float * c = filter->coeffs;
+        float x = input_signal[i];
+        // sample goes through all sections before the next one is read (direct form II, as dsps_biquad_f32)
+        for(uint8_t s = 0; s < n_sections; s++){
+            float d0 = x - c[3] * w[s][0] - c[4] * w[s][1];
+            x = c[0] * d0 + c[1] * w[s][0] + c[2] * w[s][1];
+            w[s][1] = w[s][0];
+            w[s][0] = d0;
+            c += IIR_SOS_COEFF;
+        }
+        output_signal[i] = x;
+    }
+    memcpy(state, w, IIR_STATE_SIZE(n_sections, 1) * sizeof(float));
+}
+
+void LowPassInit(float sample_frec, float cut_frec, filter_order_t order){
+    if(order > ORDER_8){
+        order = ORDER_8;
+    }
+    uint8_t n_sections = IIRLowPassDesign(lp_coeffs, sample_frec, cut_frec, order);
+    IIRFilterInit(&lp_filter, lp_coeffs, lp_state, n_sections, 1);
+}
+
+void HiPassInit(float sample_frec, float cut_frec, filter_order_t order){
+    if(order > ORDER_8){
+        order = ORDER_8;
     }
+    uint8_t n_sections = IIRHiPassDesign(hp_coeffs, sample_frec, cut_frec, order);
+    IIRFilterInit(&hp_filter, hp_coeffs, hp_state, n_sections, 1);
 }
 
 void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
-    switch(lp_order){
-        case ORDER_2:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-        break;
-        case ORDER_4:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp4_sos_coeff, lp4_delay);
-        break;
-        case ORDER_6:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp4_sos_coeff, lp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp6_sos_coeff, lp6_delay);
-        break;
-        case ORDER_8:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp4_sos_coeff, lp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp6_sos_coeff, lp6_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp8_sos_coeff, lp8_delay);
-        break;
+    if((lp_filter.n_sections == 0) || (signal_lenght <= 0)){
+        return;
     }
+    IIRFilterProcess(&lp_filter, 0, input_signal, output_signal, signal_lenght);
 }
 
 void HiPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
-    switch(hp_order){
-        case ORDER_2:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-        break;
-        case ORDER_4:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp4_sos_coeff, hp4_delay);
-        break;
-        case ORDER_6:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp4_sos_coeff, hp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp6_sos_coeff, hp6_delay);
-        break;
-        case ORDER_8:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp4_sos_coeff, hp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp6_sos_coeff, hp6_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp8_sos_coeff, hp8_delay);
-        break;
+    if((hp_filter.n_sections == 0) || (signal_lenght <= 0)){
+        return;
     }
+    IIRFilterProcess(&hp_filter, 0, input_signal, output_signal, signal_lenght);
 }
 
 /*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,216 @@
+/**
+ * @file stft.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <math.h>
+#include "stft.h"
+#include "esp_dsp.h"
+/*==================[macros and definitions]=================================*/
+#define LOAD_ACQUIRE(x)		__atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(x, v)	__atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+/*==================[internal data declaration]==============================*/
+static float stft_scratch[MAX_SIGNAL_LENGHT / 2];      /*!< Spectrum of instances that do not store spectra */
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Generates the window of an instance and its scale factors
+ *
+ * @param stft      STFT instance
+ * @param window    Window type
+ */
+static void StftWindowInit(stft_t * stft, stft_window_t window){
+    uint16_t n = stft->fft_lenght;
+    float sum = 0, sum_sq = 0;
+    switch(window){
+        case STFT_WINDOW_HANN:
+            dsps_wind_hann_f32(stft->window, n);
+        break;
+        case STFT_WINDOW_BLACKMAN:
+            dsps_wind_blackman_f32(stft->window, n);
+        break;
+        case STFT_WINDOW_BLACKMAN_HARRIS:
+            dsps_wind_blackman_harris_f32(stft->window, n);
+        break;
+        case STFT_WINDOW_FLAT_TOP:
+            dsps_wind_flat_top_f32(stft->window, n);
+        break;
+        default:
+            for(uint16_t i = 0; i < n; i++){
+                stft->window[i] = 1.0f;
+            }
+        break;
+    }
+    for(uint16_t i = 0; i < n; i++){
+        sum += stft->window[i];
+        sum_sq += stft->window[i] * stft->window[i];
+    }
+    stft->scale = 2.0f / sum;
+    // Sum of bins of a sinusoid of amplitude A is A^2 * ENBW, its power is A^2 / 2
+    stft->band_norm = (sum * sum) / (2.0f * n * sum_sq);
+}
+
+/**
+ * @brief Computes a frame and stores it in the output ring
+ *
+ * @param stft      STFT instance
+ * @param frame     Last fft_lenght samples (contiguous)
+ * @return true     Frame stored
+ * @return false    Output ring full, frame dropped
+ */
+static bool StftProcess(stft_t * stft, const float * frame){
+    uint32_t head = stft->head;
+    uint8_t slot;
+    float * spectrum;
+    float * bands;
+    float sum;
+    if(head - LOAD_ACQUIRE(stft->tail) >= stft->n_frames){
+        stft->dropped++;
+        return false;
+    }
+    slot = head % stft->n_frames;
+    spectrum = (stft->spectra != NULL) ? &stft->spectra[slot * (stft->fft_lenght / 2)] : stft_scratch;
+    FFTRealWindowed(frame, stft->window, spectrum, stft->fft_lenght, FFT_POWER, stft->scale);
+    if(stft->n_bands > 0){
+        bands = &stft->band_power[slot * stft->n_bands];
+        for(uint8_t b = 0; b < stft->n_bands; b++){
+            sum = 0;
+            for(uint16_t k = stft->band_bins[b][0]; k <= stft->band_bins[b][1]; k++){
+                sum += spectrum[k];
+            }
+            bands[b] = sum * stft->band_norm;
+        }
+    }
+    if(stft->spectra != NULL){
+        FFTPowerConvert(spectrum, stft->fft_lenght / 2, stft->output);
+    }
+    STORE_RELEASE(stft->head, head + 1);
+    return true;
+}
+
+/*==================[external functions definition]==========================*/
+bool StftInit(stft_t * stft, const stft_config_t * config, float * input, float * spectra, float * band_power){
+    uint16_t n = config->fft_lenght;
+    float bin_frec;
+    int32_t first, last;
+    if((n < 4) || (n > MAX_SIGNAL_LENGHT) || ((n & (n - 1)) != 0) || (config->hop == 0) ||
+       (config->n_frames == 0) || (config->n_bands > STFT_MAX_BANDS) ||
+       ((config->n_bands > 0) && ((config->bands == NULL) || (band_power == NULL)))){
+        return false;
+    }
+    stft->input = input;
+    stft->window = &input[2 * n];
+    stft->spectra = spectra;
+    stft->band_power = band_power;
+    stft->fft_lenght = n;
+    stft->hop = config->hop;
+    stft->n_bands = config->n_bands;
+    stft->n_frames = config->n_frames;
+    stft->output = config->output;
+    StftWindowInit(stft, config->window);
+    // Bins inside each band (at least one bin per band)
+    bin_frec = config->sample_frec / n;
+    for(uint8_t b = 0; b < stft->n_bands; b++){
+        first = (int32_t)ceilf(config->bands[b].low_frec / bin_frec);
+        last = (int32_t)floorf(config->bands[b].high_frec / bin_frec);
+        if(first < 0){
+            first = 0;
+        }
+        if(last > n / 2 - 1){
+            last = n / 2 - 1;
+        }
+        if(first > last){
+            first = last = (int32_t)lroundf((config->bands[b].low_frec + config->bands[b].high_frec) / (2 * bin_frec));
+            if(first > n / 2 - 1){
+                first = last = n / 2 - 1;
+            }
+        }
+        stft->band_bins[b][0] = first;
+        stft->band_bins[b][1] = last;
+    }
+    StftReset(stft);
+    return true;
+}
+
+void StftReset(stft_t * stft){
+    stft->write_idx = 0;
+    stft->pending = 0;
+    stft->filled = 0;
+    stft->head = 0;
+    stft->tail = 0;
+    stft->dropped = 0;
+}
+
+uint16_t StftPush(stft_t * stft, const float * samples, uint16_t n){
+    uint16_t frames = 0;
+    uint16_t chunk;
+    while(n > 0){
+        // Copy up to the end of the hop or the end of the input array
+        chunk = stft->hop - stft->pending;
+        if(chunk > stft->fft_lenght - stft->write_idx){
+            chunk = stft->fft_lenght - stft->write_idx;
+        }
+        if(chunk > n){
+            chunk = n;
+        }
+        memcpy(&stft->input[stft->write_idx], samples, chunk * sizeof(float));
+        memcpy(&stft->input[stft->fft_lenght + stft->write_idx], samples, chunk * sizeof(float));
+        stft->write_idx = (stft->write_idx + chunk) & (stft->fft_lenght - 1);
+        stft->pending += chunk;
+        if(stft->filled < stft->fft_lenght){
+            stft->filled = (stft->filled + chunk > stft->fft_lenght) ? stft->fft_lenght : stft->filled + chunk;
+        }
+        samples += chunk;
+        n -= chunk;
+        if(stft->pending == stft->hop){
+            stft->pending = 0;
+            // Oldest sample is at write_idx, the mirror makes the frame contiguous
+            if((stft->filled == stft->fft_lenght) && StftProcess(stft, &stft->input[stft->write_idx])){
+                frames++;
+            }
+        }
+    }
+    return frames;
+}
+
+uint8_t StftFramesAvailable(stft_t * stft){
+    return LOAD_ACQUIRE(stft->head) - LOAD_ACQUIRE(stft->tail);
+}
+
+bool StftReadFrame(stft_t * stft, const float ** spectrum, const float ** band_power){
+    uint32_t tail = stft->tail;
+    uint8_t slot;
+    if(LOAD_ACQUIRE(stft->head) == tail){
+        return false;
+    }
+    slot = tail % stft->n_frames;
+    if(spectrum != NULL){
+        *spectrum = (stft->spectra != NULL) ? &stft->spectra[slot * (stft->fft_lenght / 2)] : NULL;
+    }
+    if(band_power != NULL){
+        *band_power = (stft->n_bands > 0) ? &stft->band_power[slot * stft->n_bands] : NULL;
+    }
+    return true;
+}
+
+void StftReleaseFrame(stft_t * stft){
+    uint32_t tail = stft->tail;
+    if(LOAD_ACQUIRE(stft->head) != tail){
+        STORE_RELEASE(stft->tail, tail + 1);
+    }
+}
+
+/*==================[end of file]============================================*/
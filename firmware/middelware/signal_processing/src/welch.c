@@ -0,0 +1,166 @@
+/**
+ * @file welch.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <math.h>
+#include "welch.h"
+#include "esp_dsp.h"
+/*==================[macros and definitions]=================================*/
+#define Q15_ONE         32767       /*!< 1.0 in Q15 format */
+#define Q15_SHIFT       15          /*!< Shift after multiplying by a Q15 value */
+#ifndef dsps_fft2r_sc16
+#define dsps_fft2r_sc16 dsps_fft2r_sc16_ansi     /*!< Not defined by esp-dsp when CONFIG_DSP_OPTIMIZED is disabled */
+#endif
+/*==================[internal data declaration]==============================*/
+static float welch_power[MAX_SIGNAL_LENGHT / 2];                /*!< Periodogram of current segment */
+static int16_t welch_sc16[2 * MAX_SIGNAL_LENGHT];               /*!< Complex data of sc16 FFT */
+static int16_t welch_sc16_table[MAX_SIGNAL_LENGHT];             /*!< Twiddle factors of sc16 FFT */
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Common initialization of both variants
+ *
+ * @param welch     Welch instance
+ * @param config    Configuration
+ * @param psd       PSD array
+ * @return true     Valid configuration
+ * @return false    Invalid configuration
+ */
+static bool WelchConfig(welch_t * welch, const welch_config_t * config, float * psd){
+    uint16_t n = config->fft_lenght;
+    if((n < 4) || (n > MAX_SIGNAL_LENGHT) || ((n & (n - 1)) != 0) || (config->overlap >= n)){
+        return false;
+    }
+    welch->psd = psd;
+    welch->window = NULL;
+    welch->window_q15 = NULL;
+    welch->fft_lenght = n;
+    welch->step = n - config->overlap;
+    welch->average = config->average;
+    welch->alpha = config->alpha;
+    WelchReset(welch);
+    return true;
+}
+
+/**
+ * @brief Hann window value (same as dsps_wind_hann_f32)
+ *
+ * @param i         Sample number
+ * @param n         Window lenght
+ * @return float    Window value
+ */
+static float WelchHann(uint16_t i, uint16_t n){
+    return 0.5f * (1 - cosf(i * 2 * M_PI / (float)(n - 1)));
+}
+
+/**
+ * @brief Averages the periodogram of the last segment (in welch_power) into the PSD estimate
+ *
+ * @param welch     Welch instance
+ * @param norm      Scale of non DC bins of welch_power
+ * @param dc_norm   Scale of DC bin of welch_power
+ */
+static void WelchAccumulate(welch_t * welch, float norm, float dc_norm){
+    uint16_t m = welch->fft_lenght / 2;
+    float weight;
+    welch->segments++;
+    if((welch->average == WELCH_AVERAGE_BLOCK) || (welch->segments == 1)){
+        weight = 1.0f / welch->segments;
+    } else{
+        weight = welch->alpha;
+    }
+    welch->psd[0] += weight * (welch_power[0] * dc_norm - welch->psd[0]);
+    norm *= weight;
+    weight = 1.0f - weight;
+    for(uint16_t k = 1; k < m; k++){
+        welch->psd[k] = weight * welch->psd[k] + norm * welch_power[k];
+    }
+}
+
+/*==================[external functions definition]==========================*/
+bool WelchInit(welch_t * welch, const welch_config_t * config, float * window, float * psd){
+    float sum_sq = 0;
+    if(!WelchConfig(welch, config, psd)){
+        return false;
+    }
+    welch->window = window;
+    dsps_wind_hann_f32(window, welch->fft_lenght);
+    for(uint16_t i = 0; i < welch->fft_lenght; i++){
+        sum_sq += window[i] * window[i];
+    }
+    // One-sided PSD: 2 * |X[k]|^2 / (fs * sum(w^2))
+    welch->norm = 2.0f / (config->sample_frec * sum_sq);
+    return true;
+}
+
+bool WelchInitSc16(welch_t * welch, const welch_config_t * config, int16_t * window, float * psd){
+    float w, sum_sq = 0;
+    if(!WelchConfig(welch, config, psd)){
+        return false;
+    }
+    if(dsps_fft2r_init_sc16(welch_sc16_table, MAX_SIGNAL_LENGHT) != ESP_OK){
+        return false;
+    }
+    welch->window_q15 = window;
+    for(uint16_t i = 0; i < welch->fft_lenght; i++){
+        w = WelchHann(i, welch->fft_lenght);
+        window[i] = (int16_t)lroundf(w * Q15_ONE);
+        sum_sq += w * w;
+    }
+    // Fixed point FFT divides by fft_lenght
+    welch->norm = 2.0f * welch->fft_lenght * welch->fft_lenght / (config->sample_frec * sum_sq);
+    return true;
+}
+
+void WelchReset(welch_t * welch){
+    memset(welch->psd, 0, (welch->fft_lenght / 2) * sizeof(float));
+    welch->segments = 0;
+}
+
+uint16_t WelchUpdate(welch_t * welch, const float * signal, uint16_t signal_lenght){
+    uint16_t segments = 0;
+    for(uint32_t start = 0; start + welch->fft_lenght <= signal_lenght; start += welch->step){
+        // Unscaled periodogram, DC bin is returned divided by 4
+        FFTRealWindowed(&signal[start], welch->window, welch_power, welch->fft_lenght, FFT_POWER, 1.0f);
+        WelchAccumulate(welch, welch->norm, 2.0f * welch->norm);
+        segments++;
+    }
+    return segments;
+}
+
+uint16_t WelchUpdateSc16(welch_t * welch, const int16_t * signal, uint16_t signal_lenght){
+    uint16_t segments = 0;
+    uint16_t m = welch->fft_lenght / 2;
+    int32_t re, im;
+    for(uint32_t start = 0; start + welch->fft_lenght <= signal_lenght; start += welch->step){
+        // Windowed samples as real part, imaginary part cleared
+        memset(welch_sc16, 0, 2 * welch->fft_lenght * sizeof(int16_t));
+        dsps_mul_s16(&signal[start], welch->window_q15, welch_sc16, welch->fft_lenght, 1, 1, 2, Q15_SHIFT);
+        dsps_fft2r_sc16(welch_sc16, welch->fft_lenght);
+        dsps_bit_rev_sc16_ansi(welch_sc16, welch->fft_lenght);
+        for(uint16_t k = 0; k < m; k++){
+            re = welch_sc16[2 * k];
+            im = welch_sc16[2 * k + 1];
+            welch_power[k] = (float)(re * re + im * im);
+        }
+        WelchAccumulate(welch, welch->norm, welch->norm / 2);
+        segments++;
+    }
+    return segments;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,42 @@
+/**
+ * @file ekf_bench.cpp
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host benchmark of the vendored esp-dsp EKF (reference for the AHRS benchmark)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * ekf_imu13states with a prediction every sample and an accelerometer and magnetometer
+ * update every 10 samples, as a 1 kHz IMU would use it.
+ * Usage: ekf_bench [updates]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include "host_test.h"
+#include "ekf_imu13states.h"
+/*==================[macros and definitions]=================================*/
+#define UPDATES         20000   /* Default predictions */
+#define DT              0.001f  /* Sample period (s) */
+#define UPDATE_EVERY    10      /* Predictions per measurement update */
+/*==================[external functions definition]==========================*/
+int main(int argc, char ** argv){
+    uint32_t updates = (argc > 1) ? strtoul(argv[1], NULL, 10) : UPDATES;
+    float gyro[3] = {0.01f, 0.02f, -0.01f}, accel[3] = {0, 0, 1}, magn[3] = {1, 0, 0};
+    float R[6] = {0.01f, 0.01f, 0.01f, 0.01f, 0.01f, 0.01f};
+    ekf_imu13states ekf;
+
+    ekf.Init();
+    double t0 = HostTimeUs();
+    for(uint32_t i = 0; i < updates; i++){
+        ekf.Process(gyro, DT);
+        if(i % UPDATE_EVERY == 0){
+            ekf.UpdateRefMeasurement(accel, magn, R);
+        }
+    }
+    double t = HostTimeUs() - t0;
+    printf("ekf_imu13states: %.1fk updates/s\n", updates / t * 1e3);
+    return HOST_TEST_RESULT();
+}
+/*==================[end of file]============================================*/
@@ -0,0 +1,115 @@
+/**
+ * @file imu_trace.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Synthetic MPU6050 traces with known orientation (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The true orientation is integrated exactly (10 rotation steps per sample), so the error
+ * of a filter only comes from its own integration and corrections.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <math.h>
+#include "imu_trace.h"
+/*==================[macros and definitions]=================================*/
+#define SUBSTEPS        10      /* Rotation steps per sample */
+#define ACCEL_NOISE     0.004   /* g RMS */
+#define GYRO_NOISE      0.05    /* deg/s RMS */
+#define DEG2RAD         (M_PI / 180)
+/*==================[external data definition]===============================*/
+imu_trace_t imu_trace;
+/*==================[internal functions definition]==========================*/
+static double Gauss(void){
+    double u = (rand() + 1.0) / (RAND_MAX + 2.0), v = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
+
+static int16_t Counts(double value, double lsb){
+    value = round(value * lsb);
+    return (value > INT16_MAX) ? INT16_MAX : (value < INT16_MIN) ? INT16_MIN : (int16_t)value;
+}
+
+static void QuaternionMult(const double * a, const double * b, double * r){
+    double t[4] = {
+        a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3],
+        a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2],
+        a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1],
+        a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0],
+    };
+    for(uint8_t i = 0; i < 4; i++){
+        r[i] = t[i];
+    }
+}
+
+/* Gravity direction in the sensor frame */
+static void Gravity(const double * q, double * g){
+    g[0] = 2 * (q[1] * q[3] - q[0] * q[2]);
+    g[1] = 2 * (q[0] * q[1] + q[2] * q[3]);
+    g[2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+}
+/*==================[external functions definition]==========================*/
+void ImuTraceGenerate(void){
+    double q[4] = {cos(M_PI / 12), sin(M_PI / 12), 0, 0};
+    const double bias[3] = {IMU_TRACE_BIAS_X, IMU_TRACE_BIAS_Y, IMU_TRACE_BIAS_Z};
+
+    srand(7);
+    for(uint32_t i = 0; i < IMU_TRACE_LENGHT; i++){
+        double t = (double)i / IMU_TRACE_FS, w[3] = {0, 0, 0}, lin[3] = {0, 0, 0}, g[3];
+        switch(ImuTracePhase(i)){
+        case IMU_TRACE_REST:
+            break;
+        case IMU_TRACE_SLOW:
+            w[0] = 40 * sin(2 * M_PI * 0.2 * t);
+            w[1] = 30 * sin(2 * M_PI * 0.13 * t + 1);
+            w[2] = 20 * sin(2 * M_PI * 0.07 * t);
+            break;
+        case IMU_TRACE_FAST:
+            w[0] = 200 * sin(2 * M_PI * 1.1 * t);
+            w[1] = 150 * sin(2 * M_PI * 0.7 * t + 2);
+            w[2] = 120 * sin(2 * M_PI * 0.9 * t + 1);
+            lin[0] = 0.2 * sin(2 * M_PI * 2.3 * t);
+            lin[1] = 0.15 * sin(2 * M_PI * 1.7 * t);
+            lin[2] = 0.1 * sin(2 * M_PI * 3.1 * t);
+            break;
+        }
+        for(uint8_t k = 0; k < 4; k++){
+            imu_trace.q[i][k] = q[k];
+        }
+        Gravity(q, g);
+        imu_trace.ax[i] = Counts(g[0] + lin[0] + ACCEL_NOISE * Gauss(), IMU_TRACE_ACCEL_LSB);
+        imu_trace.ay[i] = Counts(g[1] + lin[1] + ACCEL_NOISE * Gauss(), IMU_TRACE_ACCEL_LSB);
+        imu_trace.az[i] = Counts(g[2] + lin[2] + ACCEL_NOISE * Gauss(), IMU_TRACE_ACCEL_LSB);
+        imu_trace.gx[i] = Counts(w[0] + bias[0] + GYRO_NOISE * Gauss(), IMU_TRACE_GYRO_LSB);
+        imu_trace.gy[i] = Counts(w[1] + bias[1] + GYRO_NOISE * Gauss(), IMU_TRACE_GYRO_LSB);
+        imu_trace.gz[i] = Counts(w[2] + bias[2] + GYRO_NOISE * Gauss(), IMU_TRACE_GYRO_LSB);
+        for(uint8_t s = 0; s < SUBSTEPS; s++){
+            double h = DEG2RAD / IMU_TRACE_FS / SUBSTEPS / 2;
+            double d[3] = {w[0] * h, w[1] * h, w[2] * h}, dq[4];
+            double a = sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+            dq[0] = cos(a);
+            for(uint8_t k = 0; k < 3; k++){
+                dq[k + 1] = (a > 0) ? d[k] / a * sin(a) : 0;
+            }
+            QuaternionMult(q, dq, q);
+        }
+    }
+}
+
+imu_trace_phase_t ImuTracePhase(uint32_t sample){
+    return (imu_trace_phase_t)((sample / IMU_TRACE_FS / IMU_TRACE_PHASE_S) % 3);
+}
+
+double ImuTraceTiltError(const double * q, uint32_t sample){
+    double g_est[3], g_true[3];
+    Gravity(q, g_est);
+    Gravity(imu_trace.q[sample], g_true);
+    double c = g_est[0] * g_true[0] + g_est[1] * g_true[1] + g_est[2] * g_true[2];
+    c = (c > 1) ? 1 : (c < -1) ? -1 : c;
+    return acos(c) / DEG2RAD;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,75 @@
+/**
+ * @file imu_trace.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Synthetic MPU6050 traces with known orientation (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Raw counts (+-2 g, +-250 deg/s) of a known trajectory, repeated in periods of 20 s: rest,
+ * slow tilts (up to 40 deg/s) and fast rotations (up to 200 deg/s, with linear acceleration).
+ * Gyroscope bias of IMU_TRACE_BIAS_X/Y/Z, noise and quantization are added. The trace starts
+ * at 30 deg roll.
+ */
+#ifndef IMU_TRACE_H_
+#define IMU_TRACE_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+/*==================[macros]=================================================*/
+#define IMU_TRACE_FS            1000                    /*!< Sample frequency (Hz) */
+#define IMU_TRACE_SECONDS       180                     /*!< Trace lenght (s) */
+#define IMU_TRACE_LENGHT        (IMU_TRACE_FS * IMU_TRACE_SECONDS)
+#define IMU_TRACE_PHASE_S       20                      /*!< Lenght of each phase (s) */
+#define IMU_TRACE_GYRO_LSB      131.0                   /*!< Counts per deg/s */
+#define IMU_TRACE_ACCEL_LSB     16384.0                 /*!< Counts per g */
+#define IMU_TRACE_BIAS_X        1.5                     /*!< Gyroscope bias (deg/s) */
+#define IMU_TRACE_BIAS_Y        -0.8
+#define IMU_TRACE_BIAS_Z        0.5
+/*==================[typedef]================================================*/
+/**
+ * @brief Trace phases
+ */
+typedef enum {
+    IMU_TRACE_REST,
+    IMU_TRACE_SLOW,
+    IMU_TRACE_FAST,
+} imu_trace_phase_t;
+
+/**
+ * @brief Trace samples and true orientation
+ */
+typedef struct {
+    int16_t ax[IMU_TRACE_LENGHT];
+    int16_t ay[IMU_TRACE_LENGHT];
+    int16_t az[IMU_TRACE_LENGHT];
+    int16_t gx[IMU_TRACE_LENGHT];
+    int16_t gy[IMU_TRACE_LENGHT];
+    int16_t gz[IMU_TRACE_LENGHT];
+    double q[IMU_TRACE_LENGHT][4];      /*!< True orientation (w, x, y, z) */
+} imu_trace_t;
+/*==================[external data declaration]==============================*/
+extern imu_trace_t imu_trace;
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Generate the trace (always the same samples)
+ */
+void ImuTraceGenerate(void);
+
+/**
+ * @brief Phase of a sample
+ */
+imu_trace_phase_t ImuTracePhase(uint32_t sample);
+
+/**
+ * @brief Tilt error: angle between the true and the estimated gravity, in the sensor frame
+ *
+ * @param q             Estimated orientation (w, x, y, z)
+ * @param sample        Sample number
+ * @return double       Error (deg)
+ */
+double ImuTraceTiltError(const double * q, uint32_t sample);
+
+#endif /* IMU_TRACE_H_ */
+/*==================[end of file]============================================*/
@@ -0,0 +1,134 @@
+/**
+ * @file test_ahrs.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host accuracy test and benchmark of the Madgwick and Mahony AHRS
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Each filter runs over the synthetic trace (imu_trace.c) in blocks of 32 samples. Tilt errors
+ * after the first 5 s (RMS and max, per phase) and the time to converge under 2 deg are
+ * printed and checked against bounds with some margin over the measured values. Without
+ * corrections (Madgwick beta 0) the gyroscope bias must make the tilt diverge. The benchmark
+ * prints updates per second in blocks of 64 samples (see ekf_bench.cpp for the vendored
+ * EKF). Usage: test_ahrs [passes over the trace]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <math.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "imu_trace.h"
+#include "ahrs.h"
+/*==================[macros and definitions]=================================*/
+#define BLOCK           32      /* Samples per update */
+#define BENCH_BLOCK     64      /* Samples per update in the benchmark */
+#define BENCH_PASSES    2       /* Default passes over the trace in the benchmark */
+#define SETTLE_S        5       /* Errors are measured from here on */
+#define CONVERGED_DEG   2       /* Convergence threshold */
+#define GYRO_SCALE      ((float)(M_PI / 180 / IMU_TRACE_GYRO_LSB))
+#define RAD2DEG         (180 / M_PI)
+
+/**
+ * @brief Tilt errors of a run (deg)
+ */
+typedef struct {
+    double rms[3];          /* Per phase (imu_trace_phase_t) */
+    double max[3];
+    double converged_s;     /* First time under CONVERGED_DEG */
+} errors_t;
+/*==================[internal functions definition]==========================*/
+static errors_t Run(const char * name, ahrs_t * ahrs){
+    errors_t e = {.converged_s = -1};
+    double sum2[3] = {0};
+    uint32_t count[3] = {0};
+
+    for(uint32_t i = 0; i < IMU_TRACE_LENGHT; i += BLOCK){
+        uint32_t last = i + BLOCK - 1;
+        AHRSUpdate(ahrs, imu_trace.ax + i, imu_trace.ay + i, imu_trace.az + i,
+                   imu_trace.gx + i, imu_trace.gy + i, imu_trace.gz + i, BLOCK);
+        double q[4] = {ahrs->q.w, ahrs->q.x, ahrs->q.y, ahrs->q.z};
+        double error = ImuTraceTiltError(q, last);
+        if(e.converged_s < 0 && error < CONVERGED_DEG){
+            e.converged_s = (double)last / IMU_TRACE_FS;
+        }
+        if(last < SETTLE_S * IMU_TRACE_FS){
+            continue;
+        }
+        imu_trace_phase_t phase = ImuTracePhase(last);
+        sum2[phase] += error * error;
+        count[phase]++;
+        e.max[phase] = (error > e.max[phase]) ? error : e.max[phase];
+    }
+    for(uint8_t p = 0; p < 3; p++){
+        e.rms[p] = sqrt(sum2[p] / count[p]);
+    }
+    printf("%-20s converged at %.2f s | tilt RMS/max (deg): rest %.2f/%.2f, slow %.2f/%.2f, fast %.2f/%.2f\n",
+           name, e.converged_s, e.rms[0], e.max[0], e.rms[1], e.max[1], e.rms[2], e.max[2]);
+    return e;
+}
+
+static void CheckErrors(const errors_t * e, double rest, double slow, double fast){
+    CHECK(e->converged_s >= 0 && e->converged_s < 6);
+    CHECK(e->rms[IMU_TRACE_REST] < rest);
+    CHECK(e->rms[IMU_TRACE_SLOW] < slow);
+    CHECK(e->rms[IMU_TRACE_FAST] < fast);
+}
+
+static void TestEuler(void){
+    ahrs_t ahrs;
+    float roll, pitch, yaw;
+    AHRSMadgwickInit(&ahrs, IMU_TRACE_FS, GYRO_SCALE, 0);
+    ahrs.q = (quaternion_t){cosf(M_PI / 12), sinf(M_PI / 12), 0, 0};
+    AHRSGetEuler(&ahrs, &roll, &pitch, &yaw);
+    CHECK(fabsf(roll - 30) < 0.01f && fabsf(pitch) < 0.01f && fabsf(yaw) < 0.01f);
+    ahrs.q = (quaternion_t){cosf(M_PI / 8), 0, sinf(M_PI / 8), 0};
+    AHRSGetEuler(&ahrs, &roll, &pitch, &yaw);
+    CHECK(fabsf(roll) < 0.01f && fabsf(pitch - 45) < 0.01f && fabsf(yaw) < 0.01f);
+}
+
+static double Bench(ahrs_t * ahrs, uint32_t passes){
+    double t0 = HostTimeUs();
+    uint32_t n = 0;
+    for(uint32_t p = 0; p < passes; p++){
+        for(uint32_t i = 0; i + BENCH_BLOCK <= IMU_TRACE_LENGHT; i += BENCH_BLOCK){
+            AHRSUpdate(ahrs, imu_trace.ax + i, imu_trace.ay + i, imu_trace.az + i,
+                       imu_trace.gx + i, imu_trace.gy + i, imu_trace.gz + i, BENCH_BLOCK);
+            n += BENCH_BLOCK;
+        }
+    }
+    return n / (HostTimeUs() - t0) * 1e6;
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char ** argv){
+    uint32_t passes = (argc > 1) ? strtoul(argv[1], NULL, 10) : BENCH_PASSES;
+    ahrs_t ahrs;
+    errors_t e;
+
+    ImuTraceGenerate();
+    AHRSMadgwickInit(&ahrs, IMU_TRACE_FS, GYRO_SCALE, 0);
+    e = Run("gyro only (beta 0)", &ahrs);
+    CHECK(e.rms[IMU_TRACE_REST] > 20);
+    AHRSMadgwickInit(&ahrs, IMU_TRACE_FS, GYRO_SCALE, AHRS_MADGWICK_BETA);
+    e = Run("Madgwick beta 0.033", &ahrs);
+    CheckErrors(&e, 1.5, 1, 5);
+    AHRSMadgwickInit(&ahrs, IMU_TRACE_FS, GYRO_SCALE, 0.1f);
+    e = Run("Madgwick beta 0.1", &ahrs);
+    CheckErrors(&e, 0.5, 0.5, 2.5);
+    AHRSMahonyInit(&ahrs, IMU_TRACE_FS, GYRO_SCALE, AHRS_MAHONY_KP, AHRS_MAHONY_KI);
+    e = Run("Mahony kp 1 ki 0.01", &ahrs);
+    CheckErrors(&e, 2, 2, 2);
+    /* The integral term cancels the bias of the tilt axes (yaw has no reference) */
+    printf("Mahony bias correction (deg/s): %.2f %.2f %.2f (bias %.2f %.2f %.2f)\n",
+           ahrs.bias[0] * RAD2DEG, ahrs.bias[1] * RAD2DEG, ahrs.bias[2] * RAD2DEG,
+           IMU_TRACE_BIAS_X, IMU_TRACE_BIAS_Y, IMU_TRACE_BIAS_Z);
+    TestEuler();
+
+    AHRSMadgwickInit(&ahrs, IMU_TRACE_FS, GYRO_SCALE, AHRS_MADGWICK_BETA);
+    printf("Madgwick: %.2fM updates/s\n", Bench(&ahrs, passes) / 1e6);
+    AHRSMahonyInit(&ahrs, IMU_TRACE_FS, GYRO_SCALE, AHRS_MAHONY_KP, AHRS_MAHONY_KI);
+    printf("Mahony: %.2fM updates/s\n", Bench(&ahrs, passes) / 1e6);
+    return HOST_TEST_RESULT();
+}
+/*==================[end of file]============================================*/
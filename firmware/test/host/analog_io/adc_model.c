@@ -0,0 +1,184 @@
+/**
+ * @file adc_model.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host model of the ESP-IDF ADC drivers (continuous, oneshot and calibration)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "adc_model.h"
+#include <string.h>
+#include "esp_adc/adc_cali_scheme.h"
+#include "driver/sdm.h"
+#include "freertos/task.h"
+/*==================[macros and definitions]=================================*/
+#define MODEL_MAX_FRAME     4096    /* Largest DMA frame in bytes */
+/*==================[internal data declaration]==============================*/
+static uint8_t frame[MODEL_MAX_FRAME];
+static int dummy_handle;
+/*==================[external data definition]===============================*/
+adc_model_t adc_model;
+/*==================[external functions definition]==========================*/
+int AdcModelMv(int raw){
+    /* as the IDF curve fitting: scaled gain and offset of a typical ESP32-C6 12 dB curve,
+       plus a second order error term, in 64 bit integer arithmetic */
+    int64_t linear = ((int64_t)raw * 49152 + 10 * 65536) / 65536;
+    int64_t error = (int64_t)raw * raw * 20 / 1000000;
+    return (int)(linear + error);
+}
+
+uint32_t AdcModelRaw(uint8_t channel, uint32_t n){
+    return (n * 37 + channel * 1000) & 0xFFF;
+}
+
+void AdcModelSkip(uint32_t n){
+    adc_model.conversions += n;
+}
+
+uint32_t AdcModelRun(uint32_t frames){
+    adc_digi_output_data_t *result = (adc_digi_output_data_t*)frame;
+    uint32_t n_results = adc_model.conv_frame_size / SOC_ADC_DIGI_RESULT_BYTES;
+    adc_continuous_evt_data_t edata = {
+        .conv_frame_buffer = frame,
+        .size = adc_model.conv_frame_size,
+    };
+    if(!adc_model.started || (adc_model.on_conv_done == NULL)){
+        return 0;
+    }
+    for(uint32_t f = 0; f < frames; f++){
+        for(uint32_t i = 0; i < n_results; i++){
+            uint32_t n = adc_model.conversions++;
+            uint8_t channel = adc_model.pattern[n % adc_model.pattern_num];
+            result[i].val = 0;
+            result[i].type2.channel = channel;
+            result[i].type2.data = AdcModelRaw(channel, n);
+        }
+        adc_model.on_conv_done((adc_continuous_handle_t)&dummy_handle, &edata, NULL);
+    }
+    return frames;
+}
+
+/* esp_adc/adc_continuous.h */
+esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t *hdl_config, adc_continuous_handle_t *ret_handle){
+    if(adc_model.created || (hdl_config->conv_frame_size > MODEL_MAX_FRAME) ||
+            (hdl_config->conv_frame_size % SOC_ADC_DIGI_RESULT_BYTES)){
+        return ESP_ERR_INVALID_STATE;
+    }
+    adc_model.created = true;
+    adc_model.started = false;
+    adc_model.conv_frame_size = hdl_config->conv_frame_size;
+    adc_model.on_conv_done = NULL;
+    adc_model.conversions = 0;
+    *ret_handle = (adc_continuous_handle_t)&dummy_handle;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_config(adc_continuous_handle_t handle, const adc_continuous_config_t *config){
+    if(!adc_model.created || adc_model.started || (config->pattern_num > sizeof(adc_model.pattern))){
+        return ESP_ERR_INVALID_STATE;
+    }
+    if((config->sample_freq_hz < SOC_ADC_SAMPLE_FREQ_THRES_LOW) || (config->sample_freq_hz > SOC_ADC_SAMPLE_FREQ_THRES_HIGH)){
+        return ESP_ERR_INVALID_ARG;
+    }
+    adc_model.sample_freq_hz = config->sample_freq_hz;
+    adc_model.pattern_num = config->pattern_num;
+    for(uint32_t k = 0; k < config->pattern_num; k++){
+        adc_model.pattern[k] = config->adc_pattern[k].channel;
+    }
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_register_event_callbacks(adc_continuous_handle_t handle, const adc_continuous_evt_cbs_t *cbs, void *user_data){
+    if(!adc_model.created || adc_model.started){
+        return ESP_ERR_INVALID_STATE;
+    }
+    adc_model.on_conv_done = cbs->on_conv_done;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_start(adc_continuous_handle_t handle){
+    if(!adc_model.created || adc_model.started){
+        return ESP_ERR_INVALID_STATE;
+    }
+    adc_model.started = true;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_stop(adc_continuous_handle_t handle){
+    if(!adc_model.created || !adc_model.started){
+        return ESP_ERR_INVALID_STATE;
+    }
+    adc_model.started = false;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_read(adc_continuous_handle_t handle, uint8_t *buf, uint32_t length_max, uint32_t *out_length, uint32_t timeout_ms){
+    *out_length = 0;
+    return ESP_ERR_TIMEOUT;
+}
+
+esp_err_t adc_continuous_deinit(adc_continuous_handle_t handle){
+    /* as the IDF driver: a running unit can not be deleted */
+    if(!adc_model.created || adc_model.started){
+        return ESP_ERR_INVALID_STATE;
+    }
+    adc_model.created = false;
+    return ESP_OK;
+}
+
+/* esp_adc/adc_cali_scheme.h */
+esp_err_t adc_cali_create_scheme_curve_fitting(const adc_cali_curve_fitting_config_t *config, adc_cali_handle_t *ret_handle){
+    *ret_handle = (adc_cali_handle_t)&dummy_handle;
+    return ESP_OK;
+}
+
+esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t handle, int raw, int *voltage){
+    adc_model.cali_calls++;
+    *voltage = AdcModelMv(raw);
+    return ESP_OK;
+}
+
+/* esp_adc/adc_oneshot.h */
+esp_err_t adc_oneshot_new_unit(const adc_oneshot_unit_init_cfg_t *init_config, adc_oneshot_unit_handle_t *ret_unit){
+    *ret_unit = (adc_oneshot_unit_handle_t)&dummy_handle;
+    return ESP_OK;
+}
+
+esp_err_t adc_oneshot_config_channel(adc_oneshot_unit_handle_t handle, adc_channel_t channel, const adc_oneshot_chan_cfg_t *config){
+    return ESP_OK;
+}
+
+esp_err_t adc_oneshot_read(adc_oneshot_unit_handle_t handle, adc_channel_t chan, int *out_raw){
+    *out_raw = AdcModelRaw(chan, 0);
+    return ESP_OK;
+}
+
+/* driver/sdm.h */
+esp_err_t sdm_new_channel(const sdm_config_t *config, sdm_channel_handle_t *ret_chan){
+    *ret_chan = (sdm_channel_handle_t)&dummy_handle;
+    return ESP_OK;
+}
+
+esp_err_t sdm_channel_enable(sdm_channel_handle_t chan){
+    return ESP_OK;
+}
+
+esp_err_t sdm_channel_set_pulse_density(sdm_channel_handle_t chan, int8_t density){
+    return ESP_OK;
+}
+
+/* freertos/task.h (ring buffer notifications) */
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_task_woken){
+    adc_model.notifications++;
+    *higher_priority_task_woken = pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks){
+    return 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,70 @@
+/**
+ * @file adc_model.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host model of the ESP-IDF ADC drivers (continuous, oneshot and calibration)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef ADC_MODEL_H
+#define ADC_MODEL_H
+
+/*==================[inclusions]=============================================*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_adc/adc_continuous.h"
+/*==================[typedef]================================================*/
+/**
+ * @brief State of the modeled continuous mode unit
+ */
+typedef struct {
+    bool created;                               /*!< Handle created (and not deleted) */
+    bool started;                               /*!< Conversions running */
+    uint32_t conv_frame_size;                   /*!< DMA frame size in bytes */
+    uint32_t sample_freq_hz;                    /*!< Aggregate sample frequency */
+    uint32_t pattern_num;                       /*!< Channels in the conversion pattern */
+    uint8_t pattern[8];                         /*!< Channels in conversion order */
+    adc_continuous_callback_t on_conv_done;     /*!< Frame end callback registered by the driver */
+    uint32_t conversions;                       /*!< Conversions generated since the handle was created */
+    uint32_t cali_calls;                        /*!< adc_cali_raw_to_voltage() calls */
+    uint32_t notifications;                     /*!< Task notifications given from ISR */
+} adc_model_t;
+/*==================[external data declaration]==============================*/
+extern adc_model_t adc_model;
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Reference calibration curve of the model (slightly non linear, as the IDF curve fitting)
+ *
+ * @param raw Raw conversion value
+ * @return int Voltage in mV
+ */
+int AdcModelMv(int raw);
+
+/**
+ * @brief Raw value the model converts for a channel at a given conversion number
+ *
+ * @param channel ADC channel
+ * @param n Conversion number (since the handle was created)
+ * @return uint32_t Raw value (12 bits)
+ */
+uint32_t AdcModelRaw(uint8_t channel, uint32_t n);
+
+/**
+ * @brief Skips conversions, so the next frame does not start at the beginning of a scan
+ *
+ * @param n Conversions to skip
+ */
+void AdcModelSkip(uint32_t n);
+
+/**
+ * @brief Fills DMA frames and calls the frame end callback (as the DMA ISR)
+ *
+ * @param frames Number of frames
+ * @return uint32_t Frames generated (0 if the unit is not started)
+ */
+uint32_t AdcModelRun(uint32_t frames);
+
+#endif
+/*==================[end of file]============================================*/
@@ -0,0 +1,99 @@
+/**
+ * @file bench_analog_scan.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host benchmark of the scan group demux kernel
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Compares the driver demux (planar loops with fixed stride and calibration table) with a
+ * per-sample reference that branches on the channel of each result and calls the IDF
+ * calibration, as the first continuous mode implementation did.
+ */
+
+/*==================[inclusions]=============================================*/
+#include "analog_io_mcu.c"      /* static demux functions */
+#include "host_test.h"
+#include "adc_model.h"
+/*==================[macros and definitions]=================================*/
+#define ITERATIONS      20000
+#define N_INPUTS        4
+/*==================[internal data declaration]==============================*/
+static uint8_t frame[ADC_CONT_FRAME_SIZE];
+static uint16_t planar[N_INPUTS][ADC_FRAME_SAMPLES];
+static uint16_t reference[N_INPUTS][ADC_FRAME_SAMPLES];
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Per-sample reference demux
+ */
+static uint16_t ReferenceDemux(const uint8_t *data, uint32_t length, uint16_t *values[]){
+    uint16_t n[N_INPUTS] = {0};
+    int voltage;
+    for(uint32_t i = 0; i < length; i += SOC_ADC_DIGI_RESULT_BYTES){
+        const adc_digi_output_data_t *result = (const adc_digi_output_data_t*)&data[i];
+        for(uint8_t k = 0; k < adc_cont_n_inputs; k++){
+            if(result->type2.channel == (uint32_t)adc_cont_inputs[k]){
+                adc_cali_raw_to_voltage(adc_calibration_cont, result->type2.data, &voltage);
+                values[k][n[k]++] = voltage;
+                break;
+            }
+        }
+    }
+    return n[0];
+}
+
+/*==================[external functions definition]==========================*/
+int main(int argc, char *argv[]){
+    uint16_t *values[N_INPUTS] = {planar[0], planar[1], planar[2], planar[3]};
+    uint16_t *ref_values[N_INPUTS] = {reference[0], reference[1], reference[2], reference[3]};
+    int iterations = (argc > 1) ? atoi(argv[1]) : ITERATIONS;
+    analog_scan_config_t config = {
+        .inputs = {CH0, CH1, CH2, CH3},
+        .n_inputs = N_INPUTS,
+        .sample_frec = 5000,
+    };
+    adc_digi_output_data_t *result = (adc_digi_output_data_t*)frame;
+    volatile uint32_t sink = 0;
+    uint16_t scans = 0, ref_scans = 0;
+    double t0, t_demux, t_ref;
+    int max_error = 0;
+
+    AnalogScanInit(&config);
+    for(uint32_t i = 0; i < ADC_FRAME_SAMPLES; i++){
+        result[i].val = 0;
+        result[i].type2.channel = i % N_INPUTS;
+        result[i].type2.data = AdcModelRaw(i % N_INPUTS, i);
+    }
+
+    t0 = HostTimeUs();
+    for(int i = 0; i < iterations; i++){
+        scans = AnalogScanDemux(frame, adc_cont_frame_size, values);
+        sink += planar[i & 3][i & 63];
+    }
+    t_demux = (HostTimeUs() - t0) / iterations;
+
+    t0 = HostTimeUs();
+    for(int i = 0; i < iterations; i++){
+        ref_scans = ReferenceDemux(frame, adc_cont_frame_size, ref_values);
+        sink += reference[i & 3][i & 63];
+    }
+    t_ref = (HostTimeUs() - t0) / iterations;
+
+    CHECK(scans == ADC_FRAME_SAMPLES / N_INPUTS);
+    CHECK(scans == ref_scans);
+    for(uint8_t k = 0; k < N_INPUTS; k++){
+        for(uint16_t s = 0; s < scans; s++){
+            int error = abs(planar[k][s] - reference[k][s]);
+            max_error = (error > max_error) ? error : max_error;
+        }
+    }
+    CHECK(max_error <= 2);
+    printf("demux %d channels, %d results per frame\n", N_INPUTS, ADC_FRAME_SAMPLES);
+    printf("  per-sample reference: %8.3f us/frame\n", t_ref);
+    printf("  driver demux:         %8.3f us/frame (x%.1f)\n", t_demux, t_ref / t_demux);
+    printf("  max. difference:      %d mV\n", max_error);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
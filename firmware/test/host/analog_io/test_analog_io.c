@@ -0,0 +1,253 @@
+/**
+ * @file test_analog_io.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of the analog IO driver continuous (DMA) mode and scan groups
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "adc_model.h"
+#include "analog_io_mcu.h"
+/*==================[macros and definitions]=================================*/
+#define MAX_ERROR_MV    2       /* Calibration table interpolation error */
+/*==================[internal data declaration]==============================*/
+static uint32_t frame_callbacks;
+/*==================[internal functions definition]==========================*/
+static void FrameDone(void *param){
+    frame_callbacks++;
+}
+
+/**
+ * @brief Checks samples read from a channel against the model
+ *
+ * @param channel ADC channel
+ * @param first Conversion number of the first sample
+ * @param stride Conversions between samples of the channel
+ * @param values Samples read (in mV)
+ * @param n Number of samples
+ * @return int Max. error in mV
+ */
+static int MaxError(uint8_t channel, uint32_t first, uint32_t stride, const uint16_t *values, uint16_t n){
+    int max = 0;
+    for(uint16_t s = 0; s < n; s++){
+        int error = abs(values[s] - AdcModelMv(AdcModelRaw(channel, first + s * stride)));
+        if(error > max){
+            max = error;
+        }
+    }
+    return max;
+}
+
+static void TestContinuousSingleChannel(void){
+    uint16_t values[ADC_FRAME_SAMPLES];
+    analog_input_config_t config = {
+        .input = CH1,
+        .mode = ADC_CONTINUOUS,
+        .func_p = FrameDone,
+        .param_p = NULL,
+        .sample_frec = 10000,
+    };
+    AnalogInputInit(&config);
+    CHECK(adc_model.created);
+    CHECK(!adc_model.started);
+    CHECK(adc_model.pattern_num == 1);
+    CHECK(adc_model.pattern[0] == CH1);
+    CHECK(adc_model.sample_freq_hz == 10000);
+    CHECK(adc_model.conv_frame_size == ADC_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES);
+
+    /* only the configured channel starts the unit */
+    AnalogStartContinuous(CH2);
+    CHECK(!adc_model.started);
+    AnalogStartContinuous(CH1);
+    CHECK(adc_model.started);
+
+    /* nothing converted yet: reading does not block */
+    CHECK(AnalogInputReadContinuous(CH1, values) == 0);
+
+    frame_callbacks = 0;
+    CHECK(AdcModelRun(3) == 3);
+    CHECK(frame_callbacks == 3);
+    for(uint32_t f = 0; f < 3; f++){
+        uint16_t n = AnalogInputReadContinuous(CH1, values);
+        CHECK(n == ADC_FRAME_SAMPLES);
+        CHECK(MaxError(CH1, f * ADC_FRAME_SAMPLES, 1, values, n) <= MAX_ERROR_MV);
+    }
+    CHECK(AnalogInputReadContinuous(CH1, values) == 0);
+    /* other channels are not read */
+    CHECK(AdcModelRun(1) == 1);
+    CHECK(AnalogInputReadContinuous(CH0, values) == 0);
+    CHECK(AnalogInputReadContinuous(CH1, values) == ADC_FRAME_SAMPLES);
+
+    AnalogStopContinuous(CH1);
+    CHECK(!adc_model.started);
+    CHECK(AdcModelRun(1) == 0);
+}
+
+static void TestCalibrationTable(void){
+    uint16_t values[ADC_FRAME_SAMPLES];
+    uint32_t cali_calls = adc_model.cali_calls;
+    analog_input_config_t config = {
+        .input = CH0,
+        .mode = ADC_CONTINUOUS,
+        .sample_frec = 20000,
+    };
+    /* the calibration curve is sampled once, samples are converted from the table */
+    AnalogInputInit(&config);
+    AnalogStartContinuous(CH0);
+    for(uint32_t f = 0; f < 4 * ADC_FRAMES_POOL; f++){
+        uint16_t n;
+        if((f % ADC_FRAMES_POOL) == 0){
+            AdcModelRun(ADC_FRAMES_POOL);
+        }
+        n = AnalogInputReadContinuous(CH0, values);
+        CHECK(n == ADC_FRAME_SAMPLES);
+        CHECK(MaxError(CH0, f * ADC_FRAME_SAMPLES, 1, values, n) <= MAX_ERROR_MV);
+    }
+    CHECK(adc_model.cali_calls == cali_calls);
+    AnalogStopContinuous(CH0);
+}
+
+static void TestFrequencyLimits(void){
+    analog_input_config_t config = {
+        .input = CH0,
+        .mode = ADC_CONTINUOUS,
+        .sample_frec = 100,
+    };
+    AnalogInputInit(&config);
+    CHECK(adc_model.sample_freq_hz == ADC_CONT_MIN_FREC);
+    config.sample_frec = 90000;
+    AnalogInputInit(&config);
+    CHECK(adc_model.sample_freq_hz == ADC_CONT_MAX_FREC);
+}
+
+/**
+ * @brief Reads frames of a scan group that do not start at the beginning of a scan
+ */
+static void TestScanGroup(void){
+    uint16_t ch_a[ADC_FRAME_SAMPLES], ch_b[ADC_FRAME_SAMPLES], ch_c[ADC_FRAME_SAMPLES];
+    uint16_t *values[] = {ch_a, ch_b, ch_c};
+    float fl_a[ADC_FRAME_SAMPLES], fl_b[ADC_FRAME_SAMPLES], fl_c[ADC_FRAME_SAMPLES];
+    float *values_f[] = {fl_a, fl_b, fl_c};
+    analog_scan_config_t config = {
+        .inputs = {CH2, CH0, CH3},
+        .n_inputs = 3,
+        .func_p = FrameDone,
+        .sample_frec = 1000,
+    };
+    AnalogScanInit(&config);
+    CHECK(adc_model.sample_freq_hz == 3000);
+    CHECK(adc_model.pattern_num == 3);
+    CHECK((adc_model.pattern[0] == CH2) && (adc_model.pattern[1] == CH0) && (adc_model.pattern[2] == CH3));
+    /* whole scans only: 255 conversions per frame */
+    CHECK(adc_model.conv_frame_size == 255 * SOC_ADC_DIGI_RESULT_BYTES);
+    AnalogScanStart();
+    CHECK(adc_model.started);
+
+    /* the first frame starts in the middle of a scan */
+    AdcModelSkip(1);
+    for(uint32_t f = 0; f < 6; f++){
+        uint32_t base = 1 + f * 255;
+        uint32_t first = (base + 2) / 3 * 3;
+        uint16_t scans = (base + 255 - first) / 3;
+        uint16_t n;
+        AdcModelRun(1);
+        if(f & 1){
+            n = AnalogScanReadFloat(values_f);
+            for(uint8_t k = 0; k < 3; k++){
+                for(uint16_t s = 0; s < n; s++){
+                    values[k][s] = values_f[k][s];
+                }
+            }
+        }else{
+            n = AnalogScanRead(values);
+        }
+        CHECK(n == scans);
+        CHECK(MaxError(CH2, first, 3, ch_a, n) <= MAX_ERROR_MV);
+        CHECK(MaxError(CH0, first + 1, 3, ch_b, n) <= MAX_ERROR_MV);
+        CHECK(MaxError(CH3, first + 2, 3, ch_c, n) <= MAX_ERROR_MV);
+    }
+    CHECK(AnalogScanRead(values) == 0);
+    AnalogScanStop();
+    CHECK(!adc_model.started);
+}
+
+/**
+ * @brief A new scan group replaces a running one
+ */
+static void TestScanReconfigure(void){
+    uint16_t ch_a[ADC_FRAME_SAMPLES], ch_b[ADC_FRAME_SAMPLES];
+    uint16_t *values[] = {ch_a, ch_b};
+    analog_scan_config_t config = {
+        .inputs = {CH1, CH2, CH3, CH0},
+        .n_inputs = 4,
+        .sample_frec = 2000,
+    };
+    AnalogScanInit(&config);
+    AnalogScanStart();
+    AdcModelRun(1);
+    /* the running unit is stopped and rebuilt (the model aborts if it is deleted while started) */
+    config.n_inputs = 2;
+    AnalogScanInit(&config);
+    CHECK(adc_model.created);
+    CHECK(!adc_model.started);
+    CHECK(adc_model.pattern_num == 2);
+    CHECK(adc_model.conv_frame_size == ADC_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES);
+    /* frames of the previous group are discarded */
+    CHECK(AnalogScanRead(values) == 0);
+    AnalogScanStart();
+    CHECK(adc_model.started);
+    AdcModelRun(1);
+    CHECK(AnalogScanRead(values) == ADC_FRAME_SAMPLES / 2);
+    CHECK(MaxError(CH1, 0, 2, ch_a, ADC_FRAME_SAMPLES / 2) <= MAX_ERROR_MV);
+    CHECK(MaxError(CH2, 1, 2, ch_b, ADC_FRAME_SAMPLES / 2) <= MAX_ERROR_MV);
+    AnalogScanStop();
+}
+
+/**
+ * @brief Frames that do not fit in the ring buffer are dropped whole (scan layout is kept)
+ */
+static void TestScanOverflow(void){
+    uint16_t ch_a[ADC_FRAME_SAMPLES], ch_b[ADC_FRAME_SAMPLES], ch_c[ADC_FRAME_SAMPLES];
+    uint16_t *values[] = {ch_a, ch_b, ch_c};
+    analog_scan_config_t config = {
+        .inputs = {CH0, CH1, CH2},
+        .n_inputs = 3,
+        .sample_frec = 1000,
+    };
+    AnalogScanInit(&config);
+    AnalogScanStart();
+    /* 255 results per frame: a fifth frame finds 4 free places in the ring */
+    AdcModelRun(ADC_FRAMES_POOL + 1);
+    for(uint32_t f = 0; f < ADC_FRAMES_POOL; f++){
+        CHECK(AnalogScanRead(values) == 85);
+        CHECK(MaxError(CH0, f * 255, 3, ch_a, 85) <= MAX_ERROR_MV);
+    }
+    /* next frame is read complete and aligned */
+    AdcModelRun(1);
+    CHECK(AnalogScanRead(values) == 85);
+    CHECK(MaxError(CH0, (ADC_FRAMES_POOL + 1) * 255, 3, ch_a, 85) <= MAX_ERROR_MV);
+    CHECK(MaxError(CH1, (ADC_FRAMES_POOL + 1) * 255 + 1, 3, ch_b, 85) <= MAX_ERROR_MV);
+    CHECK(MaxError(CH2, (ADC_FRAMES_POOL + 1) * 255 + 2, 3, ch_c, 85) <= MAX_ERROR_MV);
+    CHECK(AnalogScanRead(values) == 0);
+    AnalogScanStop();
+}
+
+/*==================[external functions definition]==========================*/
+int main(void){
+    TestContinuousSingleChannel();
+    TestCalibrationTable();
+    TestFrequencyLimits();
+    TestScanGroup();
+    TestScanReconfigure();
+    TestScanOverflow();
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,56 @@
+/**
+ * @file host_test.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Checks and timing shared by the host tests
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+/*==================[macros]=================================================*/
+/** Check a condition, reporting the failure (the test goes on) */
+#define CHECK(cond)     do{ \
+                            if(!(cond)){ \
+                                printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+                                host_test_failures++; \
+                            } \
+                        }while(0)
+
+/** Test result, to be returned by main() */
+#define HOST_TEST_RESULT()  (printf("%s\n", host_test_failures ? "FAIL" : "PASS"), host_test_failures ? 1 : 0)
+/** Best time (us per iteration) of `repeats` runs of `iterations` executions of a statement */
+#define HOST_BENCH(time_us, repeats, iterations, statement)  do{ \
+                            time_us = 1e30; \
+                            for(uint32_t run_ = 0; run_ < (repeats); run_++){ \
+                                double t0_ = HostTimeUs(); \
+                                for(uint32_t it_ = 0; it_ < (iterations); it_++){ \
+                                    statement; \
+                                } \
+                                t0_ = (HostTimeUs() - t0_) / (iterations); \
+                                time_us = (t0_ < time_us) ? t0_ : time_us; \
+                            } \
+                        }while(0)
+/*==================[external data declaration]==============================*/
+static int host_test_failures = 0;     /*!< Failed checks */
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Monotonic time, for benchmarks
+ *
+ * @return double Time in us
+ */
+static inline double HostTimeUs(void){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+#endif
+/*==================[end of file]============================================*/
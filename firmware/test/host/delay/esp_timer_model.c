@@ -0,0 +1,147 @@
+/**
+ * @file esp_timer_model.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host model of esp_timer and of the FreeRTOS calls of the delay service
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * esp_timer runs on CLOCK_MONOTONIC, each timer is a thread that runs the callback (task
+ * dispatch) when its alarm expires. Tasks are the test threads and semaphores are POSIX
+ * semaphores. Host preemption shows up as wake-up latency, as on target it would be the
+ * latency of the esp_timer task.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <time.h>
+#include <pthread.h>
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+/*==================[macros and definitions]=================================*/
+#define MAX_TIMERS      2
+#define US_PER_SEC      1000000
+/*==================[internal data declaration]==============================*/
+struct esp_timer {
+    esp_timer_create_args_t args;
+    bool armed;
+    int64_t alarm;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    pthread_t thread;
+};
+
+static struct esp_timer timers[MAX_TIMERS];
+static uint8_t n_timers;
+/*==================[internal functions definition]==========================*/
+static void * TimerThread(void * param){
+    struct esp_timer * timer = param;
+    pthread_mutex_lock(&timer->lock);
+    for(;;){
+        if(!timer->armed){
+            pthread_cond_wait(&timer->changed, &timer->lock);
+            continue;
+        }
+        struct timespec alarm = {timer->alarm / US_PER_SEC, (timer->alarm % US_PER_SEC) * 1000};
+        if(pthread_cond_timedwait(&timer->changed, &timer->lock, &alarm) == 0){
+            /* Started again or stopped */
+            continue;
+        }
+        if(timer->armed && esp_timer_get_time() >= timer->alarm){
+            timer->armed = false;
+            pthread_mutex_unlock(&timer->lock);
+            timer->args.callback(timer->args.arg);
+            pthread_mutex_lock(&timer->lock);
+        }
+    }
+    return NULL;
+}
+/*==================[external functions definition]==========================*/
+int64_t esp_timer_get_time(void){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * (int64_t)US_PER_SEC + t.tv_nsec / 1000;
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle){
+    pthread_condattr_t attr;
+    if(n_timers == MAX_TIMERS){
+        return ESP_ERR_NO_MEM;
+    }
+    struct esp_timer * timer = &timers[n_timers++];
+    timer->args = *create_args;
+    pthread_mutex_init(&timer->lock, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&timer->changed, &attr);
+    pthread_create(&timer->thread, NULL, TimerThread, timer);
+    *out_handle = timer;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us){
+    pthread_mutex_lock(&timer->lock);
+    timer->armed = true;
+    timer->alarm = esp_timer_get_time() + timeout_us;
+    pthread_cond_signal(&timer->changed);
+    pthread_mutex_unlock(&timer->lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer){
+    pthread_mutex_lock(&timer->lock);
+    esp_err_t err = timer->armed ? ESP_OK : ESP_ERR_INVALID_STATE;
+    timer->armed = false;
+    pthread_cond_signal(&timer->changed);
+    pthread_mutex_unlock(&timer->lock);
+    return err;
+}
+
+void esp_timer_isr_dispatch_need_yield(void){
+}
+
+void esp_rom_delay_us(uint32_t us){
+    int64_t end = esp_timer_get_time() + us;
+    while(esp_timer_get_time() < end){
+    }
+}
+
+BaseType_t xPortInIsrContext(void){
+    return pdFALSE;
+}
+
+BaseType_t xTaskGetSchedulerState(void){
+    return taskSCHEDULER_RUNNING;
+}
+
+void vTaskDelay(TickType_t ticks){
+    struct timespec t = {ticks / configTICK_RATE_HZ, (ticks % configTICK_RATE_HZ) * (1000000000L / configTICK_RATE_HZ)};
+    nanosleep(&t, NULL);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *buffer){
+    sem_init(buffer, 0, 0);
+    return buffer;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks){
+    while(sem_wait(sem) != 0){
+    }
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem){
+    sem_post(sem);
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *higher_priority_task_woken){
+    sem_post(sem);
+    *higher_priority_task_woken = pdTRUE;
+    return pdTRUE;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,36 @@
+/* Host model of freertos/FreeRTOS.h for the delay service: tasks are pthreads, critical
+ * sections a mutex, 100 Hz tick (as the projects' sdkconfig) */
+#pragma once
+#include <stdint.h>
+#include <pthread.h>
+#include "esp_err.h"
+#include "esp_attr.h"
+
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
+typedef struct {
+    void * storage;
+} StaticTask_t;
+
+#define pdFALSE                 0
+#define pdTRUE                  1
+#define pdPASS                  1
+#define pdFAIL                  0
+#define portMAX_DELAY           0xffffffffUL
+#define configTICK_RATE_HZ      100
+#define portTICK_PERIOD_MS      (1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms) * configTICK_RATE_HZ / 1000)
+#define portYIELD_FROM_ISR(...) ((void)(0, ##__VA_ARGS__))
+
+typedef pthread_mutex_t portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED    PTHREAD_MUTEX_INITIALIZER
+#define portENTER_CRITICAL(mux)         pthread_mutex_lock(mux)
+#define portEXIT_CRITICAL(mux)          pthread_mutex_unlock(mux)
+#define portENTER_CRITICAL_ISR(mux)     pthread_mutex_lock(mux)
+#define portEXIT_CRITICAL_ISR(mux)      pthread_mutex_unlock(mux)
+#define portENTER_CRITICAL_SAFE(mux)    pthread_mutex_lock(mux)
+#define portEXIT_CRITICAL_SAFE(mux)     pthread_mutex_unlock(mux)
+
+BaseType_t xPortInIsrContext(void);
@@ -0,0 +1,13 @@
+/* Host model of freertos/semphr.h for the delay service: static semaphores hold a POSIX
+ * semaphore */
+#pragma once
+#include <semaphore.h>
+#include "freertos/FreeRTOS.h"
+
+typedef sem_t * SemaphoreHandle_t;
+typedef sem_t StaticSemaphore_t;
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *buffer);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *higher_priority_task_woken);
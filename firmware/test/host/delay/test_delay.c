@@ -0,0 +1,151 @@
+/**
+ * @file test_delay.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and jitter/overhead benchmark of the delay service
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * For delays from 1 us to 100 ms prints the error (actual minus requested: min, median, p99)
+ * and the CPU time used by the caller. Errors are timed with ns resolution: delays end on the
+ * esp_timer time base (1 us resolution), so they may end less than 1 us early. Then DelayUntilUs() drift over 1000 periods of 1 ms,
+ * and 2, 4 and 8 threads delaying 0.1 to 5 ms at random at the same time. No delay may end
+ * early (EARLY_US), delays of 10 ms and more must sleep (caller CPU under half the delay) and every
+ * thread must keep waking up. The p99 reflects host preemption.
+ * Usage: test_delay [runs]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <pthread.h>
+#include "host_test.h"
+#include "delay_mcu.h"
+#include "esp_timer.h"
+/*==================[macros and definitions]=================================*/
+#define RUNS                200     /* Default runs per delay (a tenth from 10 ms up) */
+#define MAX_RUNS            1000
+#define PERIODS             1000    /* DelayUntilUs() periods */
+#define MAX_THREADS         8
+#define THREADS_MS          500     /* Time the concurrent threads run */
+#define US_PER_MS           1000
+#define EARLY_US            1.0     /* Delays end on the 1 us esp_timer time base */
+
+typedef struct {
+    uint32_t seed;
+    uint32_t delays;
+    double min;
+    double max;
+} worker_t;
+/*==================[internal data declaration]==============================*/
+static const uint32_t delays[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000,
+                                  10000, 20000, 50000, 100000};
+static double errors[MAX_RUNS];
+static volatile bool stop;
+/*==================[internal functions definition]==========================*/
+static double CpuTimeUs(void){
+    struct timespec t;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+    return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+static int Compare(const void * a, const void * b){
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void Delay(uint32_t us){
+    if(us >= US_PER_MS && us % US_PER_MS == 0){
+        DelayMs(us / US_PER_MS);
+    } else{
+        DelayUs(us);
+    }
+}
+
+static void TestDelays(uint32_t runs){
+    printf("%10s %10s %10s %10s %16s\n", "delay (us)", "err min", "err median", "err p99", "caller CPU");
+    for(uint8_t d = 0; d < sizeof(delays) / sizeof(delays[0]); d++){
+        uint32_t us = delays[d];
+        uint32_t n = (us >= 10000) ? (runs + 9) / 10 : runs;
+        double cpu = 0;
+        for(uint32_t r = 0; r < n; r++){
+            double cpu_start = CpuTimeUs();
+            double start = HostTimeUs();
+            Delay(us);
+            errors[r] = HostTimeUs() - start - us;
+            cpu += CpuTimeUs() - cpu_start;
+        }
+        cpu /= n;
+        qsort(errors, n, sizeof(errors[0]), Compare);
+        printf("%10u %8.2fus %8.2fus %8.1fus %8.1fus (%3.0f%%)\n", us, errors[0], errors[n / 2],
+               errors[n * 99 / 100], cpu, 100 * cpu / us);
+        CHECK(errors[0] >= -EARLY_US);
+        if(us >= 10000){
+            CHECK(cpu < us / 2);
+        }
+    }
+    printf("wake-up latency estimate: %u us\n", DelayGetWakeLatency());
+}
+
+static void TestDelayUntil(void){
+    int64_t start = esp_timer_get_time(), time = start;
+    for(uint16_t i = 0; i < PERIODS; i++){
+        time += US_PER_MS;
+        DelayUntilUs(time);
+    }
+    int64_t late = esp_timer_get_time() - time;
+    printf("DelayUntilUs() %u x 1 ms: ended %lld us after the nominal end\n", PERIODS, (long long)late);
+    CHECK(late >= 0);
+}
+
+static void * Worker(void * param){
+    worker_t * w = param;
+    while(!stop){
+        uint32_t us = 100 + rand_r(&w->seed) % 4900;
+        double start = HostTimeUs();
+        DelayUs(us);
+        double error = HostTimeUs() - start - us;
+        w->min = (error < w->min) ? error : w->min;
+        w->max = (error > w->max) ? error : w->max;
+        w->delays++;
+    }
+    return NULL;
+}
+
+static void TestConcurrent(uint8_t n){
+    pthread_t threads[MAX_THREADS];
+    worker_t workers[MAX_THREADS];
+    struct timespec run = {0, THREADS_MS * 1000000L};
+    uint32_t total = 0;
+    double min = 1e9, max = 0;
+
+    stop = false;
+    for(uint8_t i = 0; i < n; i++){
+        workers[i] = (worker_t){.seed = i * 77 + 1, .min = 1e9};
+        pthread_create(&threads[i], NULL, Worker, &workers[i]);
+    }
+    nanosleep(&run, NULL);
+    stop = true;
+    for(uint8_t i = 0; i < n; i++){
+        /* A lost wake-up never returns */
+        pthread_join(threads[i], NULL);
+        CHECK(workers[i].delays > 0);
+        total += workers[i].delays;
+        min = (workers[i].min < min) ? workers[i].min : min;
+        max = (workers[i].max > max) ? workers[i].max : max;
+    }
+    printf("%u threads, random 0.1-5 ms delays: %u delays, error min %.2f us, max %.0f us\n", n, total, min, max);
+    CHECK(min >= -EARLY_US);
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char ** argv){
+    uint32_t runs = (argc > 1) ? strtoul(argv[1], NULL, 10) : RUNS;
+    runs = (runs > MAX_RUNS) ? MAX_RUNS : (runs == 0) ? 1 : runs;
+    TestDelays(runs);
+    TestDelayUntil();
+    for(uint8_t n = 2; n <= MAX_THREADS; n *= 2){
+        TestConcurrent(n);
+    }
+    return HOST_TEST_RESULT();
+}
+/*==================[end of file]============================================*/
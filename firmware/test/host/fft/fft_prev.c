@@ -0,0 +1,66 @@
+/**
+ * @file fft_prev.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief FFT module before the real-input path (reference for the host test)
+ * @version 0.1
+ * @date 2024-03-15
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * Copy of FFTInit() and FFTMagnitude() as they were before FFTReal() was added, renamed
+ * with the Prev prefix: full length complex FFT with zero imaginary part, window generated
+ * on every call and double precision sqrt per bin.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <math.h>
+#include "fft.h"
+#include "esp_dsp.h"
+#include "esp_log.h"
+#include "fft_prev.h"
+/*==================[macros and definitions]=================================*/
+#define TAG "FFT Module"
+/*==================[internal data declaration]==============================*/
+static float prev_fft_complex[2 * MAX_SIGNAL_LENGHT];
+static float prev_wind[MAX_SIGNAL_LENGHT];
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+bool PrevFFTInit(void){
+    esp_err_t ret = dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE);
+    if (ret != ESP_OK){
+        return false;
+    }
+    return true;
+}
+
+void PrevFFTMagnitude(float * signal, float * fft, uint16_t signal_lenght){
+    // Generate Hann window
+    dsps_wind_hann_f32(prev_wind, signal_lenght);
+    // Clear fft array
+    memset(prev_fft_complex, 0, 2 * MAX_SIGNAL_LENGHT * sizeof(float));
+    // Multiply input array with window and store as real part
+    dsps_mul_f32(signal, prev_wind, prev_fft_complex, signal_lenght, 1, 1, 2);    
+    // Calculate FFT  
+    dsps_fft2r_fc32(prev_fft_complex, signal_lenght);
+    // Bit reverse
+    dsps_bit_rev_fc32(prev_fft_complex, signal_lenght);
+    // Convert one complex vector to two complex vectors
+    dsps_cplx2reC_fc32(prev_fft_complex, signal_lenght);
+    // Calculate FFT magnitude 
+    for (int j = 0; j < signal_lenght; j++){
+            prev_fft_complex[j] = 2*(sqrt(prev_fft_complex[j*2+0]*prev_fft_complex[j*2+0] + prev_fft_complex[j*2+1]*prev_fft_complex[j*2+1])) / (signal_lenght/2);
+    }
+    prev_fft_complex[0] = prev_fft_complex[0] / 2;
+    // Copy result in fft array
+    memcpy(fft, prev_fft_complex, (signal_lenght / 2) * sizeof(float));
+}
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,23 @@
+/**
+ * @file fft_prev.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief FFT module before the real-input path (reference for the host test)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef FFT_PREV_H_
+#define FFT_PREV_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[external functions declaration]=========================*/
+bool PrevFFTInit(void);
+
+void PrevFFTMagnitude(float * signal, float * fft, uint16_t signal_lenght);
+
+#endif /* FFT_PREV_H_ */
+/*==================[end of file]============================================*/
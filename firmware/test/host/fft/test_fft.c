@@ -0,0 +1,117 @@
+/**
+ * @file test_fft.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of the real-input FFT path
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * FFTMagnitude() is checked against the previous implementation (fft_prev.c), both on the
+ * esp-dsp ANSI C kernels. Usage: test_fft [iterations]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "fft.h"
+#include "fft_prev.h"
+/*==================[macros and definitions]=================================*/
+#define BENCH_ITERATIONS    40      /* Default FFTs per length and run in the benchmark */
+/*==================[internal data declaration]==============================*/
+static float signal[MAX_SIGNAL_LENGHT];
+static float spectrum[MAX_SIGNAL_LENGHT / 2], reference[MAX_SIGNAL_LENGHT / 2];
+/*==================[internal functions definition]==========================*/
+static void Signal(uint16_t n){
+    srand(n);
+    for(uint16_t i = 0; i < n; i++){
+        signal[i] = 0.7f + 1.5f * sinf(2 * M_PI * 5.3f * i / n) + (rand() / (float)RAND_MAX - 0.5f);
+    }
+}
+
+static void TestMatchesPrevious(void){
+    for(uint16_t n = 8; n <= MAX_SIGNAL_LENGHT; n *= 2){
+        float max_diff = 0;
+        Signal(n);
+        PrevFFTMagnitude(signal, reference, n);
+        FFTMagnitude(signal, spectrum, n);
+        for(uint16_t k = 0; k < n / 2; k++){
+            max_diff = fmaxf(max_diff, fabsf(spectrum[k] - reference[k]));
+        }
+        CHECK(max_diff < 1e-5f);
+    }
+}
+
+static void TestOutputs(void){
+    const uint16_t n = 1024;
+    float power[MAX_SIGNAL_LENGHT / 2], db[MAX_SIGNAL_LENGHT / 2];
+    /* a sinusoid of amplitude A gives A at its bin */
+    for(uint16_t i = 0; i < n; i++){
+        signal[i] = 2.0f * sinf(2 * M_PI * 64 * i / n);
+    }
+    FFTReal(signal, spectrum, n, FFT_MAGNITUDE);
+    FFTReal(signal, power, n, FFT_POWER);
+    FFTReal(signal, db, n, FFT_DB);
+    /* (esp-dsp Hann window is normalized to N - 1: values are 1 / N lower) */
+    CHECK(fabsf(spectrum[64] - 2.0f) < 0.005f);
+    CHECK(fabsf(power[64] - 4.0f) < 0.02f);
+    CHECK(fabsf(db[64] - 20 * log10f(2.0f)) < 0.02f);
+    CHECK(spectrum[200] < 1e-4f);
+    /* FFTMagnitude() keeps its previous scale: twice FFTReal() out of DC */
+    FFTMagnitude(signal, reference, n);
+    CHECK(fabsf(reference[64] - 2 * spectrum[64]) < 1e-3f);
+    /* DC */
+    for(uint16_t i = 0; i < n; i++){
+        signal[i] = 3.0f;
+    }
+    FFTReal(signal, spectrum, n, FFT_MAGNITUDE);
+    CHECK(fabsf(spectrum[0] - 3.0f) < 0.005f);
+}
+
+static void TestWindowCache(void){
+    float first[MAX_SIGNAL_LENGHT / 2];
+    float window[256];
+    /* the cached window follows length changes */
+    Signal(512);
+    FFTReal(signal, first, 512, FFT_MAGNITUDE);
+    FFTReal(signal, spectrum, 256, FFT_MAGNITUDE);
+    FFTReal(signal, spectrum, 512, FFT_MAGNITUDE);
+    CHECK(memcmp(first, spectrum, 256 * sizeof(float)) == 0);
+    /* external window: a Hann window gives the result of the cached one (scaled by the exact
+       window sum instead of N / 2) */
+    for(uint16_t i = 0; i < 256; i++){
+        window[i] = 0.5f * (1 - cosf(2 * M_PI * i / 255));
+    }
+    FFTReal(signal, first, 256, FFT_POWER);
+    FFTRealWindowed(signal, window, spectrum, 256, FFT_POWER, FFTWindowScale(window, 256));
+    for(uint16_t k = 0; k < 128; k++){
+        CHECK(fabsf(first[k] - spectrum[k]) <= 0.01f * first[k] + 1e-9f);
+    }
+}
+
+static void Benchmark(uint32_t iterations){
+    printf("FFT magnitude, us per call (previous / FFTMagnitude / FFTReal), best of 5 runs:\n");
+    for(uint16_t n = 256; n <= MAX_SIGNAL_LENGHT; n *= 2){
+        double t_prev, t_mag, t_real;
+        Signal(n);
+        HOST_BENCH(t_prev, 5, iterations, PrevFFTMagnitude(signal, reference, n));
+        HOST_BENCH(t_mag, 5, iterations, FFTMagnitude(signal, spectrum, n));
+        HOST_BENCH(t_real, 5, iterations, FFTReal(signal, spectrum, n, FFT_MAGNITUDE));
+        printf("  N = %4u: %7.2f / %7.2f / %7.2f (x%.1f)\n", n, t_prev, t_mag, t_real, t_prev / t_mag);
+    }
+}
+
+/*==================[external functions definition]==========================*/
+int main(int argc, char *argv[]){
+    uint32_t iterations = (argc > 1) ? strtoul(argv[1], NULL, 0) : BENCH_ITERATIONS;
+    CHECK(FFTInit());
+    TestMatchesPrevious();
+    TestOutputs();
+    TestWindowCache();
+    Benchmark(iterations);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
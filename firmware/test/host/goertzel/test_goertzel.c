@@ -0,0 +1,140 @@
+/**
+ * @file test_goertzel.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of the Goertzel bank and sliding DFT
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The benchmark times GoertzelProcess() on one block for 1 to GOERTZEL_MAX_BINS frequencies
+ * against FFTMagnitude() on the same block, and prints the break-even number of
+ * frequencies. Usage: test_goertzel [iterations]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <math.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "goertzel.h"
+#include "fft.h"
+/*==================[macros and definitions]=================================*/
+#define FS                  1000.0f     /* Sample frequency (Hz) */
+#define BENCH_SAMPLES       200000      /* Default samples per run in the benchmark */
+/*==================[internal data declaration]==============================*/
+static const float frecs[GOERTZEL_MAX_BINS] = {50, 60, 7.5f, 8.57f, 10, 12, 15, 20};
+static float signal[MAX_SIGNAL_LENGHT], spectrum[MAX_SIGNAL_LENGHT / 2];
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Sum of one tone per frequency (amplitude 0.1 * (k + 1)) and an out of band tone
+ */
+static void Signal(uint16_t n){
+    for(uint16_t i = 0; i < n; i++){
+        signal[i] = 0.3f * sinf(2 * M_PI * 123.4f * i / FS);
+        for(uint8_t k = 0; k < GOERTZEL_MAX_BINS; k++){
+            signal[i] += 0.1f * (k + 1) * sinf(2 * M_PI * frecs[k] * i / FS + k);
+        }
+    }
+}
+
+/**
+ * @brief Reference: amplitude of the DFT of the block at a frequency (double precision)
+ */
+static float Dft(const float *x, uint16_t n, float frec){
+    double re = 0, im = 0;
+    for(uint16_t i = 0; i < n; i++){
+        re += x[i] * cos(2 * M_PI * frec * i / FS);
+        im -= x[i] * sin(2 * M_PI * frec * i / FS);
+    }
+    return 2 * sqrt(re * re + im * im) / n;
+}
+
+static void TestGoertzel(void){
+    const uint16_t n = 1000;
+    goertzel_t bank;
+    Signal(n);
+    CHECK(!GoertzelInit(&bank, frecs, 0, FS, n));
+    CHECK(!GoertzelInit(&bank, frecs, GOERTZEL_MAX_BINS + 1, FS, n));
+    /* every grouping of frequencies (4, 2 and 1 per pass) */
+    for(uint8_t n_bins = 1; n_bins <= GOERTZEL_MAX_BINS; n_bins++){
+        CHECK(GoertzelInit(&bank, frecs, n_bins, FS, n));
+        CHECK(GoertzelProcess(&bank, signal, n) == 1);
+        for(uint8_t k = 0; k < n_bins; k++){
+            CHECK(fabsf(bank.amplitude[k] - Dft(signal, n, frecs[k])) < 1e-4f);
+        }
+    }
+    /* a tone with whole periods in the block gives its amplitude */
+    for(uint16_t i = 0; i < n; i++){
+        signal[i] = 0.5f * sinf(2 * M_PI * 50 * i / FS) + 0.25f * sinf(2 * M_PI * 60 * i / FS);
+    }
+    GoertzelProcess(&bank, signal, n);
+    CHECK(fabsf(bank.amplitude[0] - 0.5f) < 1e-4f);
+    CHECK(fabsf(bank.amplitude[1] - 0.25f) < 1e-4f);
+    CHECK(bank.amplitude[4] < 1e-4f);
+    Signal(n);
+    /* blocks span calls */
+    GoertzelReset(&bank);
+    CHECK(GoertzelProcess(&bank, signal, 333) == 0);
+    CHECK(GoertzelProcess(&bank, &signal[333], 333) == 0);
+    CHECK(GoertzelProcess(&bank, &signal[666], n - 666) == 1);
+    for(uint8_t k = 0; k < GOERTZEL_MAX_BINS; k++){
+        CHECK(fabsf(bank.amplitude[k] - Dft(signal, n, frecs[k])) < 1e-4f);
+    }
+}
+
+static void TestSdft(void){
+    const uint16_t n = 1000;
+    static float delay[1000];
+    float amplitude[GOERTZEL_MAX_BINS];
+    sdft_t sdft;
+    Signal(MAX_SIGNAL_LENGHT);
+    CHECK(SdftInit(&sdft, frecs, GOERTZEL_MAX_BINS, FS, delay, n));
+    /* after every sample, the amplitudes are those of the last n samples */
+    SdftProcess(&sdft, signal, n);
+    SdftAmplitude(&sdft, amplitude);
+    for(uint8_t k = 0; k < GOERTZEL_MAX_BINS; k++){
+        CHECK(fabsf(amplitude[k] - Dft(signal, n, frecs[k])) < 2e-3f);
+    }
+    SdftProcess(&sdft, &signal[n], 517);
+    SdftAmplitude(&sdft, amplitude);
+    for(uint8_t k = 0; k < GOERTZEL_MAX_BINS; k++){
+        CHECK(fabsf(amplitude[k] - Dft(&signal[517], n, frecs[k])) < 2e-3f);
+    }
+}
+
+static void Benchmark(uint32_t samples){
+    printf("us per block, best of 5 runs (break-even: largest number of frequencies faster than the FFT)\n");
+    for(uint16_t n = 256; n <= MAX_SIGNAL_LENGHT; n *= 4){
+        uint32_t iterations = samples / n;
+        uint8_t break_even = 0;
+        double t_fft, t_goertzel;
+        goertzel_t bank;
+        Signal(n);
+        HOST_BENCH(t_fft, 5, iterations, FFTMagnitude(signal, spectrum, n));
+        printf("  N = %4u: FFTMagnitude %6.2f | Goertzel", n, t_fft);
+        for(uint8_t n_bins = 1; n_bins <= GOERTZEL_MAX_BINS; n_bins++){
+            GoertzelInit(&bank, frecs, n_bins, FS, n);
+            HOST_BENCH(t_goertzel, 5, iterations, GoertzelProcess(&bank, signal, n));
+            printf(" %.2f", t_goertzel);
+            if((t_goertzel < t_fft) && (break_even == n_bins - 1)){
+                break_even = n_bins;
+            }
+        }
+        printf(" | break-even %u\n", break_even);
+        if(n == 1024){
+            n = 512;    /* 256, 1024 and 2048 */
+        }
+    }
+}
+
+/*==================[external functions definition]==========================*/
+int main(int argc, char *argv[]){
+    uint32_t samples = (argc > 1) ? strtoul(argv[1], NULL, 0) : BENCH_SAMPLES;
+    CHECK(FFTInit());
+    TestGoertzel();
+    TestSdft();
+    Benchmark(samples);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,237 @@
+/**
+ * @file echo_model.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Software model of HC-SR04 sensors on virtual time (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Time advances from event to event (echo edges, interrupts due, timer alarms), so long
+ * scans run fast. Code running in an interrupt can delay (DelayUs()): edges are applied
+ * meanwhile, and their interrupts run when the current one returns.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "echo_model.h"
+#include "timer_mcu.h"
+#include "delay_mcu.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+/*==================[macros and definitions]=================================*/
+#define MAX_PINS            32
+#define MAX_PENDING_ISR     16
+#define NEVER               UINT64_MAX
+
+typedef struct {
+    uint64_t rise;          /* Echo rising edge time */
+    uint64_t fall;          /* Echo falling edge time */
+    bool armed;             /* Echo pending or in flight */
+    bool level;             /* Echo level */
+} echo_state_t;
+
+typedef struct {
+    uint64_t time;
+    gpio_t pin;
+} pending_isr_t;
+/*==================[internal data declaration]==============================*/
+static echo_state_t state[ECHO_MODEL_SENSORS];
+static void (*gpio_isr[MAX_PINS])(void *);
+static void * gpio_isr_param[MAX_PINS];
+static pending_isr_t pending[MAX_PENDING_ISR];
+static uint8_t n_pending;
+static bool in_isr;
+static void (*timer_isr)(void *);
+static void * timer_param;
+static uint32_t timer_period;
+static uint64_t timer_next = NEVER;
+/*==================[external data definition]===============================*/
+echo_model_t echo_model = {
+    .latency_min_us = 2,
+    .latency_max_us = 12,
+};
+/*==================[internal functions definition]==========================*/
+static int8_t Sensor(gpio_t pin, bool trigger){
+    for(uint8_t i = 0; i < echo_model.n_sensors; i++){
+        if((trigger ? echo_model.sensor[i].trigger : echo_model.sensor[i].echo) == pin){
+            return i;
+        }
+    }
+    return -1;
+}
+
+static uint64_t NextEdge(uint8_t i){
+    if(!state[i].armed){
+        return NEVER;
+    }
+    return state[i].level ? state[i].fall : state[i].rise;
+}
+
+/* Echo levels at the current time, edges with an interrupt enabled are queued */
+static void ApplyEdges(void){
+    for(uint8_t i = 0; i < echo_model.n_sensors; i++){
+        echo_state_t * s = &state[i];
+        bool level = s->armed && (echo_model.now_us >= s->rise) && (echo_model.now_us < s->fall);
+        if(s->armed && echo_model.now_us >= s->fall){
+            s->armed = false;
+        }
+        if(level != s->level){
+            gpio_t pin = echo_model.sensor[i].echo;
+            s->level = level;
+            if(gpio_isr[pin] != NULL && n_pending < MAX_PENDING_ISR){
+                uint8_t span = echo_model.latency_max_us - echo_model.latency_min_us + 1;
+                pending[n_pending].time = echo_model.now_us + echo_model.latency_min_us + rand() % span;
+                pending[n_pending].pin = pin;
+                n_pending++;
+            }
+        }
+    }
+}
+
+/* Interrupts due (oldest first), then the timer alarm */
+static void RunInterrupts(void){
+    if(in_isr){
+        return;
+    }
+    in_isr = true;
+    for(;;){
+        int8_t first = -1;
+        for(uint8_t q = 0; q < n_pending; q++){
+            if(pending[q].time <= echo_model.now_us && (first < 0 || pending[q].time < pending[first].time)){
+                first = q;
+            }
+        }
+        if(first < 0){
+            break;
+        }
+        gpio_t pin = pending[first].pin;
+        pending[first] = pending[--n_pending];
+        if(gpio_isr[pin] != NULL){
+            gpio_isr[pin](gpio_isr_param[pin]);
+        }
+    }
+    if(echo_model.now_us >= timer_next){
+        timer_next += timer_period;
+        timer_isr(timer_param);
+    }
+    in_isr = false;
+}
+/*==================[external functions definition]==========================*/
+void EchoModelAdvance(uint64_t us){
+    uint64_t until = echo_model.now_us + us;
+    while(echo_model.now_us < until){
+        uint64_t next = until;
+        for(uint8_t i = 0; i < echo_model.n_sensors; i++){
+            uint64_t edge = NextEdge(i);
+            next = (edge > echo_model.now_us && edge < next) ? edge : next;
+        }
+        for(uint8_t q = 0; q < n_pending; q++){
+            next = (pending[q].time > echo_model.now_us && pending[q].time < next) ? pending[q].time : next;
+        }
+        next = (timer_next > echo_model.now_us && timer_next < next) ? timer_next : next;
+        echo_model.now_us = next;
+        ApplyEdges();
+        RunInterrupts();
+    }
+}
+
+/* gpio_mcu */
+void GPIOInit(gpio_t pin, io_t io){
+}
+
+void GPIOOn(gpio_t pin){
+}
+
+void GPIOOff(gpio_t pin){
+    int8_t k = Sensor(pin, true);
+    if(k < 0){
+        return;
+    }
+    echo_sensor_t * sensor = &echo_model.sensor[k];
+    for(uint8_t i = 0; i < echo_model.n_sensors; i++){
+        if(i != k && state[i].armed){
+            echo_model.crosstalk++;
+        }
+    }
+    if(sensor->distance_mm < 0){
+        return;
+    }
+    sensor->triggers++;
+    double width = ECHO_MODEL_NO_OBJECT_US;
+    if(sensor->distance_mm < ECHO_MODEL_MAX_MM){
+        width = sensor->distance_mm * ECHO_MODEL_US_PER_MM + (rand() % 200 - 100) / 100.0;
+        if(sensor->outlier_every && (sensor->triggers % sensor->outlier_every) == 0){
+            /* Early echo from a closer object */
+            width *= 0.4;
+        }
+    }
+    state[k].rise = echo_model.now_us + ECHO_MODEL_DELAY_US;
+    state[k].fall = state[k].rise + (uint64_t)(width + 0.5);
+    state[k].armed = true;
+}
+
+bool GPIORead(gpio_t pin){
+    int8_t k = Sensor(pin, false);
+    if(!in_isr){
+        /* Polling loop */
+        echo_model.now_us++;
+        ApplyEdges();
+    }
+    return (k >= 0) && state[k].level;
+}
+
+void GPIOActivIntBothEdges(gpio_t pin, void * ptr_int_func, void * args){
+    gpio_isr[pin] = (void (*)(void *))ptr_int_func;
+    gpio_isr_param[pin] = args;
+}
+
+void GPIODeactivInt(gpio_t pin){
+    gpio_isr[pin] = NULL;
+}
+
+void GPIODeinit(void){
+}
+
+/* timer_mcu (one timer, 1 us timestamps) */
+void TimerInit(timer_config_t * timer_ini){
+    timer_isr = (void (*)(void *))timer_ini->func_p;
+    timer_param = timer_ini->param_p;
+    timer_period = timer_ini->period;
+}
+
+void TimerStart(timer_mcu_t timer){
+    timer_next = echo_model.now_us + timer_period;
+}
+
+void TimerStop(timer_mcu_t timer){
+    timer_next = NEVER;
+}
+
+uint64_t TimerGetTimestamp(void){
+    return echo_model.now_us;
+}
+
+/* delay_mcu */
+void DelayUs(uint16_t usec){
+    for(uint16_t i = 0; i < usec; i++){
+        echo_model.now_us++;
+        ApplyEdges();
+    }
+    RunInterrupts();
+}
+
+/* FreeRTOS notifications of the readings ring buffer */
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t * higher_priority_task_woken){
+    echo_model.notifications++;
+    if(higher_priority_task_woken != NULL){
+        *higher_priority_task_woken = pdTRUE;
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks){
+    return 1;
+}
+
+/*==================[end of file]============================================*/
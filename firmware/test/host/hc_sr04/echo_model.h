@@ -0,0 +1,64 @@
+/**
+ * @file echo_model.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Software model of HC-SR04 sensors on virtual time (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Implements the gpio_mcu, timer_mcu and delay_mcu functions used by the driver on a virtual
+ * microsecond clock. A sensor answers the falling edge of its trigger with an echo pulse
+ * ECHO_MODEL_DELAY_US later, ECHO_MODEL_US_PER_MM wide per mm of distance (+-1 us noise).
+ * Echo edge interrupts run after a random latency. Polling (GPIORead() outside interrupts)
+ * costs 1 us per call.
+ */
+#ifndef ECHO_MODEL_H_
+#define ECHO_MODEL_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "gpio_mcu.h"
+/*==================[macros]=================================================*/
+#define ECHO_MODEL_SENSORS          4       /*!< Max. number of sensors */
+#define ECHO_MODEL_DELAY_US         450     /*!< Trigger to echo rising edge */
+#define ECHO_MODEL_US_PER_MM        5.9     /*!< Echo width per mm (58 us/cm sound speed, 59 us/cm driver scale) */
+#define ECHO_MODEL_NO_OBJECT_US     38000   /*!< Echo width without an object in range */
+#define ECHO_MODEL_MAX_MM           5000    /*!< Distances from here on have no object in range */
+/*==================[typedef]================================================*/
+/**
+ * @brief Simulated sensor
+ */
+typedef struct {
+    gpio_t echo;                /*!< Echo GPIO */
+    gpio_t trigger;             /*!< Trigger GPIO */
+    float distance_mm;          /*!< Object distance (< 0: disconnected, >= ECHO_MODEL_MAX_MM: none) */
+    uint16_t outlier_every;     /*!< Every n-th echo comes back early (0: never) */
+    uint32_t triggers;          /*!< Triggers received */
+} echo_sensor_t;
+
+/**
+ * @brief Model state
+ */
+typedef struct {
+    echo_sensor_t sensor[ECHO_MODEL_SENSORS];   /*!< Sensors */
+    uint8_t n_sensors;                          /*!< Number of sensors */
+    uint64_t now_us;                            /*!< Virtual time */
+    uint8_t latency_min_us;                     /*!< Min. interrupt latency */
+    uint8_t latency_max_us;                     /*!< Max. interrupt latency */
+    uint32_t crosstalk;                         /*!< Triggers while another echo was pending */
+    uint32_t notifications;                     /*!< Task notifications from interrupts */
+} echo_model_t;
+/*==================[external data declaration]==============================*/
+extern echo_model_t echo_model;
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Advance the virtual time, running the interrupts due
+ *
+ * @param us            Time to advance
+ */
+void EchoModelAdvance(uint64_t us);
+
+#endif /* ECHO_MODEL_H_ */
+/*==================[end of file]============================================*/
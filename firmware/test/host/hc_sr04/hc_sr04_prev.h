@@ -0,0 +1,28 @@
+/**
+ * @file hc_sr04_prev.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief HC-SR04 driver before the interrupt driven scan (reference for the host test)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef HC_SR04_PREV_H_
+#define HC_SR04_PREV_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "gpio_mcu.h"
+/*==================[external functions declaration]=========================*/
+bool PrevHcSr04Init(gpio_t echo, gpio_t trigger);
+
+uint16_t PrevHcSr04ReadDistanceInCentimeters(void);
+
+uint16_t PrevHcSr04ReadDistanceInInches(void);
+
+bool PrevHcSr04Deinit(void);
+
+#endif /* HC_SR04_PREV_H_ */
+/*==================[end of file]============================================*/
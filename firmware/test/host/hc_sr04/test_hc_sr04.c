@@ -0,0 +1,170 @@
+/**
+ * @file test_hc_sr04.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host simulation of the HC-SR04 blocking reads and of the interrupt driven scan
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Blocking reads: random distances (middle of each cm) are read with the previous driver
+ * (hc_sr04_prev.c, 10 us polling) and with the driver, counting exact readings.
+ * Scan: four sensors (an object, an object with early echoes every 7 triggers, disconnected,
+ * no object in range) are scanned with a median of 3. Readings must not be dropped, must keep
+ * the slot period and stay within 2 mm of the object. With slots shorter than the longest
+ * echo the model must see triggers while another echo is pending (see HcSr04ScanInit()).
+ * HcSr04Deinit() during a scan must stop the triggers and the readings.
+ * Usage: test_hc_sr04 [slot_ms] [rounds]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <math.h>
+#include "host_test.h"
+#include "echo_model.h"
+#include "hc_sr04.h"
+#include "hc_sr04_prev.h"
+/*==================[macros and definitions]=================================*/
+#define READS           200     /* Blocking reads per driver */
+#define SLOT_MS         60      /* Default scan slot */
+#define ROUNDS          500     /* Default scan rounds (one slot per sensor) */
+#define OBJECT_MM       1234    /* Object in front of sensor 0 */
+#define OUTLIER_MM      800     /* Object in front of sensor 1 (early echoes) */
+#define US_PER_MS       1000
+/*==================[internal data declaration]==============================*/
+static hc_sr04_reading_t readings[HC_SR04_BUFFER_SIZE];
+/*==================[internal functions definition]==========================*/
+static void TestBlocking(void){
+    uint16_t exact[2] = {0, 0};
+    echo_model.n_sensors = 1;
+    echo_model.sensor[0] = (echo_sensor_t){.echo = GPIO_3, .trigger = GPIO_2};
+    for(uint8_t prev = 0; prev < 2; prev++){
+        srand(1);
+        if(prev){
+            PrevHcSr04Init(GPIO_3, GPIO_2);
+        } else{
+            HcSr04Init(GPIO_3, GPIO_2);
+        }
+        for(uint16_t i = 0; i < READS; i++){
+            uint16_t cm = 2 + rand() % 297;
+            echo_model.sensor[0].distance_mm = cm * 10 + 5;
+            uint16_t read = prev ? PrevHcSr04ReadDistanceInCentimeters() : HcSr04ReadDistanceInCentimeters();
+            exact[prev] += (read == cm);
+            EchoModelAdvance(SLOT_MS * US_PER_MS);
+        }
+    }
+    printf("blocking reads: %u/%u exact cm (previous driver %u/%u)\n", exact[0], READS, exact[1], READS);
+    CHECK(exact[0] >= READS * 98 / 100);
+}
+
+static void TestScan(uint16_t slot_ms, uint32_t rounds){
+    hc_sr04_scan_config_t config = {
+        .n_sensors = 4,
+        .echo = {GPIO_3, GPIO_18, GPIO_20, GPIO_22},
+        .trigger = {GPIO_2, GPIO_19, GPIO_21, GPIO_23},
+        .timer = TIMER_B,
+        .slot_ms = slot_ms,
+        .median = 3,
+        .consumer = (void *)1,
+    };
+    const float distance[4] = {OBJECT_MM, OUTLIER_MM, -1, ECHO_MODEL_MAX_MM};
+    uint64_t last_time[4] = {0};
+    uint32_t count[4] = {0}, early = 0, period_errors = 0, total = 0;
+    uint16_t max_error = 0;
+    double sum_error = 0;
+
+    echo_model.n_sensors = 4;
+    echo_model.crosstalk = 0;
+    for(uint8_t i = 0; i < 4; i++){
+        echo_model.sensor[i] = (echo_sensor_t){.echo = config.echo[i], .trigger = config.trigger[i],
+                                               .distance_mm = distance[i], .outlier_every = (i == 1) ? 7 : 0};
+    }
+    CHECK(HcSr04ScanInit(&config));
+    HcSr04ScanStart();
+    for(uint32_t slot = 0; slot < rounds * 4; slot++){
+        EchoModelAdvance(slot_ms * US_PER_MS);
+        uint32_t n = HcSr04ScanRead(readings, HC_SR04_BUFFER_SIZE);
+        for(uint32_t r = 0; r < n; r++){
+            hc_sr04_reading_t * reading = &readings[r];
+            uint8_t s = reading->sensor;
+            if(count[s] && (reading->time - last_time[s] != 4 * slot_ms * US_PER_MS)){
+                period_errors++;
+            }
+            last_time[s] = reading->time;
+            count[s]++;
+            total++;
+            if(s < 2){
+                uint16_t error = abs((int)reading->distance - (int)distance[s]);
+                sum_error += error;
+                max_error = (error > max_error) ? error : max_error;
+                CHECK(reading->valid);
+                early += (reading->echo_us < distance[s] * ECHO_MODEL_US_PER_MM / 2);
+            } else if(s == 2){
+                CHECK(!reading->valid);
+            } else{
+                CHECK(reading->valid && reading->distance == HC_SR04_MAX_MM);
+            }
+        }
+    }
+    HcSr04ScanStop();
+    printf("scan (%u ms slots, %u rounds): %u readings, %u dropped, %u period errors, %u triggers during "
+           "another echo\n", slot_ms, rounds, total, HcSr04ScanDropped(), period_errors, echo_model.crosstalk);
+    printf("objects: mean error %.2f mm, max %u mm, %u early echoes rejected\n",
+           sum_error / (count[0] + count[1]), max_error, early);
+    for(uint8_t i = 0; i < 4; i++){
+        CHECK(count[i] >= rounds - 1);
+    }
+    CHECK(HcSr04ScanDropped() == 0);
+    CHECK(period_errors == 0);
+    CHECK(max_error <= 2);
+    CHECK(early >= rounds / 7 - 1);
+    CHECK(echo_model.notifications == total);
+    if(slot_ms * US_PER_MS > ECHO_MODEL_DELAY_US + ECHO_MODEL_NO_OBJECT_US){
+        CHECK(echo_model.crosstalk == 0);
+    } else{
+        CHECK(echo_model.crosstalk > 0);
+    }
+}
+/**
+ * @brief Deinit stops a running scan: no more triggers nor readings, the scan can start again
+ */
+static void TestDeinit(uint16_t slot_ms){
+    hc_sr04_scan_config_t config = {
+        .n_sensors = 1,
+        .echo = {GPIO_3},
+        .trigger = {GPIO_2},
+        .timer = TIMER_B,
+        .slot_ms = slot_ms,
+        .median = 1,
+    };
+    uint32_t triggers, notifications;
+    HcSr04ScanStart();
+    EchoModelAdvance(10 * slot_ms * US_PER_MS + slot_ms * US_PER_MS / 2);
+    CHECK(HcSr04Deinit());
+    while(HcSr04ScanRead(readings, HC_SR04_BUFFER_SIZE) > 0){
+    }
+    triggers = echo_model.sensor[0].triggers + echo_model.sensor[1].triggers;
+    notifications = echo_model.notifications;
+    EchoModelAdvance(10 * slot_ms * US_PER_MS);
+    CHECK(echo_model.sensor[0].triggers + echo_model.sensor[1].triggers == triggers);
+    CHECK(echo_model.notifications == notifications);
+    CHECK(HcSr04ScanRead(readings, HC_SR04_BUFFER_SIZE) == 0);
+    printf("deinit during the scan: %u triggers and %u readings after it\n",
+           (unsigned)(echo_model.sensor[0].triggers + echo_model.sensor[1].triggers - triggers),
+           (unsigned)(echo_model.notifications - notifications));
+    CHECK(HcSr04ScanInit(&config));
+    HcSr04ScanStart();
+    EchoModelAdvance(3 * slot_ms * US_PER_MS);
+    CHECK(HcSr04ScanRead(readings, HC_SR04_BUFFER_SIZE) >= 1);
+    CHECK(HcSr04Deinit());
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char ** argv){
+    uint16_t slot_ms = (argc > 1) ? atoi(argv[1]) : SLOT_MS;
+    uint32_t rounds = (argc > 2) ? strtoul(argv[2], NULL, 10) : ROUNDS;
+    TestBlocking();
+    TestScan(slot_ms, rounds);
+    TestDeinit(slot_ms);
+    return HOST_TEST_RESULT();
+}
+/*==================[end of file]============================================*/
@@ -0,0 +1,189 @@
+/**
+ * @file hx711_model.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Software model of an HX711 on virtual time (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Time advances from conversion to conversion. Code running in the interrupt can delay
+ * (DelayUs()): the time advances without running conversions, as a reading lasts much less
+ * than a conversion period.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include "hx711_model.h"
+#include "timer_mcu.h"
+#include "delay_mcu.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+/*==================[macros and definitions]=================================*/
+#define DATA_BITS       24
+/*==================[internal data declaration]==============================*/
+static bool sck;                    /* SCK level */
+static bool dout = true;            /* DOUT level */
+static bool powered = true;         /* Chip powered up */
+static int8_t pulses = -1;          /* SCK pulses since the last conversion (-1: no data) */
+static uint32_t shift;              /* Conversion being shifted out */
+static uint8_t gain_pulses = 1;     /* Gain of the next conversion */
+static uint64_t next_conversion;    /* Next data ready time */
+static uint64_t sck_high_since;     /* Last SCK rising edge */
+static void (*dout_isr)(void *);
+static void * dout_isr_param;
+static bool in_isr;
+static bool latched;                /* Edge while the interrupt was running */
+/*==================[external data definition]===============================*/
+hx711_model_t hx711_model = {
+    .period_us = 12500,             /* 80 SPS */
+};
+/*==================[internal functions definition]==========================*/
+static void SetDout(bool level){
+    bool fall = dout && !level;
+    dout = level;
+    if(!fall || dout_isr == NULL){
+        return;
+    }
+    if(in_isr){
+        latched = true;
+        return;
+    }
+    uint64_t start = hx711_model.now_us;
+    in_isr = true;
+    do{
+        latched = false;
+        hx711_model.isr_calls++;
+        dout_isr(dout_isr_param);
+    }while(latched);
+    in_isr = false;
+    if(hx711_model.now_us - start > hx711_model.isr_max_us){
+        hx711_model.isr_max_us = hx711_model.now_us - start;
+    }
+}
+
+/* Conversions due until the given time, power down if SCK is held high */
+static void Run(uint64_t until){
+    for(;;){
+        if(powered && sck && until - sck_high_since > HX711_MODEL_POWER_DOWN_US){
+            powered = false;
+        }
+        if(!powered || next_conversion > until){
+            hx711_model.now_us = until;
+            return;
+        }
+        hx711_model.now_us = next_conversion;
+        next_conversion += hx711_model.period_us;
+        if(pulses > DATA_BITS){
+            gain_pulses = pulses - DATA_BITS;
+        }
+        if(hx711_model.conversions >= hx711_model.n_values){
+            continue;
+        }
+        shift = (uint32_t)hx711_model.value[hx711_model.conversions] & 0xFFFFFF;
+        hx711_model.ready[hx711_model.conversions] = hx711_model.now_us;
+        hx711_model.gain_pulses[hx711_model.conversions] = gain_pulses;
+        hx711_model.conversions++;
+        pulses = 0;
+        if(!sck){
+            SetDout(false);
+        }
+    }
+}
+/*==================[external functions definition]==========================*/
+void HX711ModelAdvance(uint64_t us){
+    Run(hx711_model.now_us + us);
+}
+
+/* gpio_mcu */
+void GPIOInit(gpio_t pin, io_t io){
+}
+
+void GPIOOn(gpio_t pin){
+    if(pin != HX711_MODEL_SCK || sck){
+        return;
+    }
+    sck = true;
+    sck_high_since = hx711_model.now_us;
+    if(powered && pulses >= 0){
+        pulses++;
+        SetDout((pulses <= DATA_BITS) ? (shift >> (DATA_BITS - pulses)) & 1 : true);
+    }
+}
+
+void GPIOOff(gpio_t pin){
+    if(pin != HX711_MODEL_SCK || !sck){
+        return;
+    }
+    uint32_t high = hx711_model.now_us - sck_high_since;
+    sck = false;
+    if(!powered || high > HX711_MODEL_POWER_DOWN_US){
+        powered = true;
+        hx711_model.resets++;
+        gain_pulses = 1;
+        pulses = -1;
+        dout = true;
+        next_conversion = hx711_model.now_us + hx711_model.period_us;
+        return;
+    }
+    if(pulses >= 0 && high > hx711_model.sck_high_max_us){
+        hx711_model.sck_high_max_us = high;
+    }
+}
+
+bool GPIORead(gpio_t pin){
+    if(pin != HX711_MODEL_DOUT){
+        return false;
+    }
+    if(!in_isr){
+        /* Polling loop */
+        Run(hx711_model.now_us + 1);
+    }
+    return dout;
+}
+
+void GPIOActivInt(gpio_t pin, void * ptr_int_func, bool edge, void * args){
+    if(pin != HX711_MODEL_DOUT || edge){
+        printf("hx711 model: interrupt on pin %d, %s edge\n", pin, edge ? "rising" : "falling");
+        hx711_model.errors++;
+    }
+    dout_isr = (void (*)(void *))ptr_int_func;
+    dout_isr_param = args;
+}
+
+void GPIODeactivInt(gpio_t pin){
+    dout_isr = NULL;
+}
+
+/* timer_mcu */
+uint64_t TimerGetTimestamp(void){
+    return hx711_model.now_us;
+}
+
+/* delay_mcu */
+void DelayUs(uint16_t usec){
+    if(in_isr){
+        hx711_model.now_us += usec;
+    }else{
+        Run(hx711_model.now_us + usec);
+    }
+}
+
+/* FreeRTOS notifications of the samples ring buffer */
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t * higher_priority_task_woken){
+    hx711_model.notifications++;
+    if(higher_priority_task_woken != NULL){
+        *higher_priority_task_woken = pdTRUE;
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks){
+    /* The consumer sleeps until the next conversion is read */
+    uint32_t calls = hx711_model.isr_calls;
+    for(TickType_t t = 0; t < ticks && hx711_model.isr_calls == calls; t++){
+        Run(hx711_model.now_us + 1000);
+    }
+    return hx711_model.isr_calls != calls;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,60 @@
+/**
+ * @file hx711_model.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Software model of an HX711 on virtual time (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Implements the gpio_mcu, timer_mcu and delay_mcu functions used by the driver on a virtual
+ * microsecond clock. A conversion is ready every period_us: DOUT falls and each SCK rising
+ * edge shifts out a bit (24 bits, MSB first). 1 to 3 more pulses select the gain of the
+ * conversion after the next one. SCK high for more than 60 us powers the chip down; on power
+ * up the gain is reset to 128 and the first conversion is ready a period later. The DOUT
+ * falling edge interrupt runs with no latency; edges while it runs are latched and run it
+ * again when it returns. Polling DOUT outside the interrupt costs 1 us per read.
+ */
+#ifndef HX711_MODEL_H_
+#define HX711_MODEL_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "gpio_mcu.h"
+/*==================[macros]=================================================*/
+#define HX711_MODEL_SCK             GPIO_3      /*!< PD_SCK pin */
+#define HX711_MODEL_DOUT            GPIO_2      /*!< DOUT pin */
+#define HX711_MODEL_CONVERSIONS     2048        /*!< Max. number of conversions */
+#define HX711_MODEL_POWER_DOWN_US   60          /*!< SCK high time that powers the chip down */
+/*==================[typedef]================================================*/
+/**
+ * @brief Model state
+ */
+typedef struct {
+    uint64_t now_us;                                    /*!< Virtual time */
+    uint32_t period_us;                                 /*!< Conversion period */
+    int32_t value[HX711_MODEL_CONVERSIONS];             /*!< Conversion results (set by the test) */
+    uint32_t n_values;                                  /*!< Conversion results available */
+    uint32_t conversions;                               /*!< Conversions done (index of the next result) */
+    uint64_t ready[HX711_MODEL_CONVERSIONS];            /*!< Data ready time of each conversion */
+    uint8_t gain_pulses[HX711_MODEL_CONVERSIONS];       /*!< Gain of each conversion (pulses after 24 bits) */
+    uint32_t resets;                                    /*!< Power ups */
+    uint32_t isr_calls;                                 /*!< DOUT interrupts run (latched edges included) */
+    uint32_t isr_max_us;                                /*!< Max. time spent in the interrupt */
+    uint32_t sck_high_max_us;                           /*!< Max. SCK high time while reading */
+    uint32_t notifications;                             /*!< Task notifications from the interrupt */
+    uint32_t errors;                                    /*!< Misuses detected */
+} hx711_model_t;
+/*==================[external data declaration]==============================*/
+extern hx711_model_t hx711_model;
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Advance the virtual time, running the conversions and interrupts due
+ *
+ * @param us            Time to advance
+ */
+void HX711ModelAdvance(uint64_t us);
+
+#endif /* HX711_MODEL_H_ */
+/*==================[end of file]============================================*/
@@ -0,0 +1,204 @@
+/**
+ * @file test_hx711.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of the HX711 sample stream and streaming filter
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The stream runs at 80 SPS on the HX711 model (hx711_model.c) with each gain, and every
+ * sample is compared with the value and data ready time of its conversion. The filter is
+ * compared with an independent model (median of each window with qsort(), mean of the
+ * medians, mean of the first filtered values as tare) on a step with noise and spikes.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include "host_test.h"
+#include "hx711_model.h"
+#include "hx711.h"
+/*==================[macros and definitions]=================================*/
+#define CONVERSIONS     600         /* Conversions of each stream test */
+#define READ_EVERY_MS   37          /* Consumer period */
+#define FILTER_SAMPLES  400         /* Samples of the filter test */
+#define CONSUMER        ((void *)1) /* Consumer task handle */
+/*==================[internal data declaration]==============================*/
+static hx711_sample_t samples[HX711_BUFFER_SIZE];
+static int32_t input[FILTER_SAMPLES];
+/*==================[internal functions definition]==========================*/
+static int Compare(const void * a, const void * b){
+    int32_t x = *(const int32_t *)a, y = *(const int32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Conversion results over the whole 24 bits range, with full scale negative values
+ */
+static void Values(void){
+    hx711_model.conversions = 0;
+    hx711_model.n_values = CONVERSIONS;
+    for(uint32_t i = 0; i < CONVERSIONS; i++){
+        hx711_model.value[i] = (i % 7 == 3) ? -8388608 + (int32_t)i : (int32_t)((i * 123457) % 16777216) - 8388608;
+    }
+}
+
+/**
+ * @brief Stream with a gain: samples match their conversions, later conversions use the gain
+ *
+ * @param gain          Driver gain
+ * @param pulses        Gain pulses of the chip for that gain
+ */
+static void TestStream(uint8_t gain, uint8_t pulses){
+    uint32_t legacy, first, n, read = 0, bad = 0, other_gain = 0;
+    Values();
+    /* HX711_Init() does a blocking reading */
+    HX711_Init(gain, HX711_MODEL_SCK, HX711_MODEL_DOUT);
+    legacy = hx711_model.conversions;
+    CHECK(HX711_startStream(NULL));
+    CHECK(!HX711_startStream(NULL));
+    /* Gains other than 128 are set by the first conversion after the reset, that is discarded */
+    first = legacy + (pulses != 1);
+    while(hx711_model.conversions < CONVERSIONS){
+        HX711ModelAdvance(READ_EVERY_MS * 1000);
+        while((n = HX711_readSamples(samples, HX711_BUFFER_SIZE)) > 0){
+            for(uint32_t k = 0; k < n; k++, read++){
+                uint32_t c = first + read;
+                if((samples[k].value != hx711_model.value[c]) || (samples[k].time != hx711_model.ready[c])){
+                    if(bad < 3){
+                        printf("  conversion %u: %d at %llu us, sample %d at %llu us\n", (unsigned)c,
+                               (int)hx711_model.value[c], (unsigned long long)hx711_model.ready[c],
+                               (int)samples[k].value, (unsigned long long)samples[k].time);
+                    }
+                    bad++;
+                }
+            }
+        }
+    }
+    HX711_stopStream();
+    HX711ModelAdvance(100000);
+    CHECK(HX711_readSamples(samples, HX711_BUFFER_SIZE) == 0);
+    for(uint32_t c = first + 1; c < CONVERSIONS; c++){
+        other_gain += (hx711_model.gain_pulses[c] != pulses);
+    }
+    CHECK(read == CONVERSIONS - first);
+    CHECK(bad == 0);
+    CHECK(other_gain == 0);
+    CHECK(HX711_droppedSamples() == 0);
+    printf("gain %3d: %u conversions, %u samples, %u value/timestamp mismatches, %u later conversions at "
+           "another gain, %u dropped\n", gain, (unsigned)(CONVERSIONS - legacy), (unsigned)read, (unsigned)bad,
+           (unsigned)other_gain, (unsigned)HX711_droppedSamples());
+}
+
+/**
+ * @brief Consumer task notified on each sample, full ring drops samples
+ */
+static void TestConsumer(void){
+    uint32_t notifications, read = 0, n;
+    Values();
+    HX711_Init(128, HX711_MODEL_SCK, HX711_MODEL_DOUT);
+    notifications = hx711_model.notifications;
+    CHECK(HX711_startStream(CONSUMER));
+    CHECK(HX711_waitSamples(1000));
+    CHECK(HX711_readSamples(samples, HX711_BUFFER_SIZE) == 1);
+    CHECK(hx711_model.notifications == notifications + 1);
+    CHECK(!HX711_waitSamples(5));
+    /* Consumer stalled for 50 conversions */
+    HX711ModelAdvance(50 * hx711_model.period_us);
+    while((n = HX711_readSamples(samples, HX711_BUFFER_SIZE)) > 0){
+        read += n;
+    }
+    HX711_stopStream();
+    CHECK(read == HX711_BUFFER_SIZE);
+    CHECK(HX711_droppedSamples() == 50 - HX711_BUFFER_SIZE);
+    printf("stalled consumer: %u samples read, %u dropped, %u notifications\n", (unsigned)read,
+           (unsigned)HX711_droppedSamples(), (unsigned)(hx711_model.notifications - notifications));
+}
+
+/**
+ * @brief Filter model: mean of the medians of the last average windows
+ */
+static int32_t Reference(uint16_t i, uint8_t median, uint8_t average){
+    int32_t window[HX711_MEDIAN_MAX];
+    int64_t sum = 0;
+    for(uint8_t a = 0; a < average; a++){
+        for(uint8_t m = 0; m < median; m++){
+            window[m] = input[i - a - m];
+        }
+        qsort(window, median, sizeof(int32_t), Compare);
+        sum += window[median / 2];
+    }
+    return sum / average;
+}
+
+/**
+ * @brief Filter against the model on a step from 100000 to 150000 counts
+ *
+ * @param median        Median window
+ * @param average       Average window
+ * @param tare          Filtered values averaged for the tare (0: none)
+ * @param scale         Counts per unit
+ */
+static void TestFilter(uint8_t median, uint8_t average, uint16_t tare, float scale){
+    hx711_filter_t filter;
+    uint16_t latency = median - 1 + average - 1;
+    uint32_t valid = 0, bad = 0;
+    int32_t offset = 0;
+    float units, error = 0;
+    srand(3);
+    for(uint16_t i = 0; i < FILTER_SAMPLES; i++){
+        input[i] = ((i < FILTER_SAMPLES / 2) ? 100000 : 150000) + rand() % 201 - 100;
+        if(i % 23 == 11){
+            input[i] += (i & 1) ? 2000000 : -2000000;
+        }
+    }
+    for(uint16_t i = latency; i < latency + tare; i++){
+        offset += Reference(i, median, average);
+    }
+    offset = tare ? offset / tare : 0;
+    HX711_filterInit(&filter, median, average);
+    HX711_filterTare(&filter, tare);
+    HX711_filterSetScale(&filter, scale);
+    for(uint16_t i = 0; i < FILTER_SAMPLES; i++){
+        bool ok = HX711_filterPush(&filter, input[i], &units);
+        if(ok != (i >= latency + tare)){
+            bad++;
+            continue;
+        }
+        if(ok){
+            bad += (units != (Reference(i, median, average) - offset) / scale);
+            valid++;
+            /* Spikes are removed by the median: the output settles after the step */
+            if(i >= FILTER_SAMPLES / 2 + latency){
+                float e = units - (150000 - offset) / scale;
+                error = (e > error) ? e : (-e > error) ? -e : error;
+            }
+        }
+    }
+    CHECK(bad == 0);
+    CHECK(valid == FILTER_SAMPLES - latency - tare);
+    if(median > 1){
+        CHECK(error < 100 / scale);
+    }
+    printf("filter median %u, average %2u, tare %2u: %u valid outputs, %u mismatches with the model, "
+           "max. error after the step %.2f units\n", median, average, tare, (unsigned)valid, (unsigned)bad, error);
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+    TestStream(128, 1);
+    TestStream(64, 3);
+    TestStream(32, 2);
+    printf("%u interrupts (latched edges of the data bits included), max. time in the interrupt %u us, "
+           "max. SCK high %u us, %u resets\n", (unsigned)hx711_model.isr_calls, (unsigned)hx711_model.isr_max_us,
+           (unsigned)hx711_model.sck_high_max_us, (unsigned)hx711_model.resets);
+    CHECK(hx711_model.sck_high_max_us < HX711_MODEL_POWER_DOWN_US);
+    CHECK(hx711_model.resets == 3);
+    TestConsumer();
+    TestFilter(5, 8, 16, 50.0f);
+    TestFilter(7, 32, 0, 1.0f);
+    TestFilter(1, 1, 4, 2.0f);
+    CHECK(hx711_model.errors == 0);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
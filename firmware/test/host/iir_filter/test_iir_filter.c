@@ -0,0 +1,206 @@
+/**
+ * @file test_iir_filter.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of the SOS cascade IIR filter engine
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The reference is the multi-pass path iir_filter.c used before the engine: one
+ * dsps_biquad_f32 pass over the whole block per section. Usage: test_iir_filter [blocks]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "iir_filter.h"
+#include "esp_dsp.h"
+/*==================[macros and definitions]=================================*/
+#define FS              1000.0f     /* Sample frequency (Hz) */
+#define BLOCK           1024        /* Samples per block */
+#define BENCH_BLOCKS    2000        /* Default blocks filtered by the benchmark */
+/*==================[internal data declaration]==============================*/
+static float input[BLOCK], output[BLOCK], reference[BLOCK];
+/*==================[internal functions definition]==========================*/
+static void Tone(float *signal, uint16_t n, float frec, uint32_t start){
+    for(uint16_t i = 0; i < n; i++){
+        signal[i] = sinf(2 * M_PI * frec * (start + i) / FS);
+    }
+}
+
+/**
+ * @brief Peak amplitude of the last samples of a block (filter settled)
+ */
+static float Peak(const float *signal){
+    float peak = 0;
+    for(uint16_t i = BLOCK / 2; i < BLOCK; i++){
+        peak = fmaxf(peak, fabsf(signal[i]));
+    }
+    return peak;
+}
+
+/**
+ * @brief Amplitude of the last 500 samples of a block (from the RMS: peaks of a sampled tone are
+ * not the tone amplitude)
+ */
+static float Amplitude(const float *signal){
+    float sum = 0;
+    for(uint16_t i = BLOCK - 500; i < BLOCK; i++){
+        sum += signal[i] * signal[i];
+    }
+    return sqrtf(2 * sum / 500);
+}
+
+/**
+ * @brief Multi-pass reference: one dsps_biquad_f32 pass per section
+ */
+static void MultiPass(const float *coeffs, float (*delay)[2], uint8_t n_sections, const float *in, float *out, int n){
+    dsps_biquad_f32_ansi(in, out, n, (float*)coeffs, delay[0]);
+    for(uint8_t s = 1; s < n_sections; s++){
+        dsps_biquad_f32_ansi(out, out, n, (float*)&coeffs[IIR_SOS_COEFF * s], delay[s]);
+    }
+}
+
+static void TestMatchesMultiPass(void){
+    float coeffs[IIR_COEFF_SIZE(IIR_MAX_SECTIONS)], state[IIR_STATE_SIZE(IIR_MAX_SECTIONS, 1)];
+    float delay[IIR_MAX_SECTIONS][2];
+    iir_filter_t filter;
+    for(uint8_t order = 2; order <= IIR_MAX_ORDER; order += 2){
+        uint8_t n = IIRLowPassDesign(coeffs, FS, 40, order);
+        float max_diff = 0;
+        CHECK(n == order / 2);
+        IIRFilterInit(&filter, coeffs, state, n, 1);
+        memset(delay, 0, sizeof(delay));
+        /* state is kept between blocks */
+        for(uint32_t b = 0; b < 4; b++){
+            for(uint16_t i = 0; i < BLOCK; i++){
+                input[i] = sinf((b * BLOCK + i) * 0.05f) + 0.3f * sinf((b * BLOCK + i) * 1.3f) + ((i % 7) * 0.01f);
+            }
+            MultiPass(coeffs, delay, n, input, reference, BLOCK);
+            IIRFilterProcess(&filter, 0, input, output, BLOCK);
+            for(uint16_t i = 0; i < BLOCK; i++){
+                max_diff = fmaxf(max_diff, fabsf(output[i] - reference[i]));
+            }
+        }
+        CHECK(max_diff == 0);
+    }
+}
+
+static void TestChannels(void){
+    float coeffs[IIR_COEFF_SIZE(3)], state[IIR_STATE_SIZE(3, 2)], state_1[IIR_STATE_SIZE(3, 1)];
+    float ch_0[BLOCK], ch_1[BLOCK];
+    iir_filter_t filter, filter_1;
+    uint8_t n = IIRHiPassDesign(coeffs, FS, 5, 6);
+    IIRFilterInit(&filter, coeffs, state, n, 2);
+    IIRFilterInit(&filter_1, coeffs, state_1, n, 1);
+    /* each channel keeps its own state: interleaved blocks give the same result as one channel alone */
+    for(uint32_t b = 0; b < 3; b++){
+        Tone(input, BLOCK, 3, b * BLOCK);
+        Tone(reference, BLOCK, 50, b * BLOCK);
+        IIRFilterProcess(&filter, 0, input, ch_0, BLOCK);
+        IIRFilterProcess(&filter, 1, reference, ch_1, BLOCK);
+        IIRFilterProcess(&filter_1, 0, input, output, BLOCK);
+        CHECK(memcmp(ch_0, output, sizeof(output)) == 0);
+    }
+    CHECK(Peak(ch_0) < 0.2f);
+    CHECK(Peak(ch_1) > 0.99f);
+    /* input and output can be the same array */
+    IIRFilterReset(&filter_1);
+    IIRFilterProcess(&filter_1, 0, input, output, BLOCK);
+    IIRFilterReset(&filter_1);
+    IIRFilterProcess(&filter_1, 0, input, input, BLOCK);
+    CHECK(memcmp(input, output, sizeof(output)) == 0);
+}
+
+static void TestDesigns(void){
+    float coeffs[IIR_COEFF_SIZE(IIR_MAX_SECTIONS)], state[IIR_STATE_SIZE(IIR_MAX_SECTIONS, 1)];
+    iir_filter_t filter;
+    uint8_t n;
+    /* 8th order low pass: -3 dB at cut-off */
+    n = IIRLowPassDesign(coeffs, FS, 100, 8);
+    IIRFilterInit(&filter, coeffs, state, n, 1);
+    Tone(input, BLOCK, 100, 0);
+    IIRFilterProcess(&filter, 0, input, output, BLOCK);
+    CHECK(fabsf(Amplitude(output) - 0.7071f) < 0.01f);
+
+    /* 50 Hz notch */
+    n = IIRNotchDesign(coeffs, FS, 50, 5);
+    CHECK(n == 1);
+    IIRFilterInit(&filter, coeffs, state, n, 1);
+    Tone(input, BLOCK, 50, 0);
+    IIRFilterProcess(&filter, 0, input, output, BLOCK);
+    CHECK(Peak(output) < 0.01f);
+    IIRFilterReset(&filter);
+    Tone(input, BLOCK, 10, 0);
+    IIRFilterProcess(&filter, 0, input, output, BLOCK);
+    CHECK(Peak(output) > 0.98f);
+
+    /* 20-100 Hz band pass */
+    n = IIRBandPassDesign(coeffs, FS, 20, 100, 4);
+    CHECK(n == 4);
+    IIRFilterInit(&filter, coeffs, state, n, 1);
+    Tone(input, BLOCK, 45, 0);
+    IIRFilterProcess(&filter, 0, input, output, BLOCK);
+    CHECK(Peak(output) > 0.95f);
+    IIRFilterReset(&filter);
+    Tone(input, BLOCK, 300, 0);
+    IIRFilterProcess(&filter, 0, input, output, BLOCK);
+    CHECK(Peak(output) < 0.05f);
+}
+
+static void TestLegacy(void){
+    LowPassInit(FS, 40, ORDER_8);
+    HiPassInit(FS, 1, ORDER_2);
+    for(uint16_t i = 0; i < BLOCK; i++){
+        output[i] = -1;
+    }
+    Tone(input, BLOCK, 10, 0);
+    /* non positive lengths are ignored */
+    LowPassFilter(input, output, -1);
+    HiPassFilter(input, output, 0);
+    CHECK((output[0] == -1) && (output[BLOCK - 1] == -1));
+    LowPassFilter(input, output, BLOCK);
+    CHECK(Peak(output) > 0.95f);
+}
+
+static void Benchmark(uint32_t blocks){
+    float coeffs[IIR_COEFF_SIZE(4)], state[IIR_STATE_SIZE(4, 1)];
+    float delay[4][2] = {{0}};
+    iir_filter_t filter;
+    double t0, t_multi, t_fused;
+    uint8_t n = IIRLowPassDesign(coeffs, FS, 40, 8);
+    IIRFilterInit(&filter, coeffs, state, n, 1);
+    for(uint16_t i = 0; i < BLOCK; i++){
+        input[i] = sinf(i * 0.05f) + 0.3f * sinf(i * 1.3f);
+    }
+    t0 = HostTimeUs();
+    for(uint32_t b = 0; b < blocks; b++){
+        MultiPass(coeffs, delay, n, input, reference, BLOCK);
+    }
+    t_multi = HostTimeUs() - t0;
+    t0 = HostTimeUs();
+    for(uint32_t b = 0; b < blocks; b++){
+        IIRFilterProcess(&filter, 0, input, output, BLOCK);
+    }
+    t_fused = HostTimeUs() - t0;
+    CHECK(memcmp(output, reference, sizeof(output)) == 0);
+    printf("8th order low pass, %d sample blocks:\n", BLOCK);
+    printf("  multi-pass (dsps_biquad_f32 per section): %6.1f Msps\n", (double)blocks * BLOCK / t_multi);
+    printf("  single pass (IIRFilterProcess):           %6.1f Msps\n", (double)blocks * BLOCK / t_fused);
+}
+
+/*==================[external functions definition]==========================*/
+int main(int argc, char *argv[]){
+    uint32_t blocks = (argc > 1) ? strtoul(argv[1], NULL, 0) : BENCH_BLOCKS;
+    TestMatchesMultiPass();
+    TestChannels();
+    TestDesigns();
+    TestLegacy();
+    Benchmark(blocks);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
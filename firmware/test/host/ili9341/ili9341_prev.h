@@ -0,0 +1,55 @@
+/**
+ * @file ili9341_prev.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief ILI9341 driver before the framebuffer (reference panel for the host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef ILI9341_PREV_H_
+#define ILI9341_PREV_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include "ili9341.h"
+/*==================[external functions declaration]=========================*/
+uint8_t PrevILI9341Init(spi_dev_t spi_dev, uint8_t gpio_dc, uint8_t gpio_rst);
+
+void PrevILI9341DrawPixel(uint16_t x, uint16_t y, uint16_t color);
+
+void PrevILI9341Fill(uint16_t color);
+
+void PrevILI9341Rotate(ili9341_orientation_t orientation);
+
+void PrevILI9341DrawChar(uint16_t x, uint16_t y, char data, Font_t* font, uint16_t foreground, uint16_t background);
+
+void PrevILI9341DrawIcon(uint16_t x, uint16_t y, icon_t icon, icon_font_t* icon_font, uint16_t foreground, uint16_t background);
+
+void PrevILI9341DrawInt(uint16_t x, uint16_t y, uint32_t num, uint8_t dig, Font_t* font, uint16_t foreground, uint16_t background);
+
+void PrevILI9341DrawString(uint16_t x, uint16_t y, char* str, Font_t *font, uint16_t foreground, uint16_t background);
+
+void PrevILI9341GetStringSize(char* str, Font_t* font, uint16_t* width, uint16_t* height);
+
+void PrevILI9341DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
+
+void PrevILI9341DrawRectangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
+
+void PrevILI9341DrawFilledRectangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
+
+void PrevILI9341DrawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+
+void PrevILI9341DrawFilledCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+
+void PrevILI9341DrawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+
+void PrevILI9341DrawFilledTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+
+void PrevILI9341DrawPicture(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* pic);
+
+uint8_t PrevILI9341DeInit(void);
+
+#endif /* ILI9341_PREV_H_ */
+/*==================[end of file]============================================*/
@@ -0,0 +1,278 @@
+/**
+ * @file panel_model.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Software model of the ILI9341 panel behind spi_mcu and gpio_mcu (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Queued writes are executed lazily (when the driver waits for them or the queue is full),
+ * so a buffer reused or a DC change while a transfer is in flight is detected.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <string.h>
+#include "panel_model.h"
+#include "spi_mcu.h"
+#include "gpio_mcu.h"
+#include "delay_mcu.h"
+/*==================[macros and definitions]=================================*/
+#define COLUMN_ADDR_SET     0x2A
+#define PAGE_ADDR_SET       0x2B
+#define MEM_WRITE           0x2C
+#define MEM_ACC_CTRL        0x36
+#define NORMAL_MODE_ON      0x13
+#define VERT_SCROLL_DEF     0x33
+#define VERT_SCROLL_START   0x37
+#define MADCTL_MY           0x80
+#define MADCTL_MV           0x20
+#define MAX_QUEUED_BYTES    ILI9341_MAX_BURST
+
+typedef struct {
+    uint8_t * buffer;
+    uint32_t size;
+    uint8_t snapshot[MAX_QUEUED_BYTES];
+} queued_t;
+/*==================[internal data declaration]==============================*/
+static bool dc;
+static uint8_t cmd, n_param, param[6], high_byte, madctl;
+static bool low_byte_next;
+static uint16_t col_start, col_end, page_start, page_end, col, page;
+static queued_t queue[PANEL_MODEL_QUEUE];
+static uint8_t queue_head, queue_pending;
+static void (*queue_func)(void *);
+static void * queue_param;
+/*==================[external data definition]===============================*/
+panel_model_t panel_model = {.scroll_lines = ILI9341_HEIGHT};
+/*==================[internal functions definition]==========================*/
+static void StorePixel(uint16_t color){
+    if(page <= page_end){
+        if(madctl & MADCTL_MV){
+            /* Landscape: columns of the window are rows of the panel */
+            int16_t row = (madctl & MADCTL_MY) ? ILI9341_HEIGHT - 1 - col : col;
+            if(row >= 0 && row < ILI9341_HEIGHT && page < ILI9341_WIDTH){
+                panel_model.gram[row][page] = color;
+            }
+        }else if(page < ILI9341_HEIGHT && col < ILI9341_WIDTH){
+            panel_model.gram[page][col] = color;
+        }
+    }
+    if(++col > col_end){
+        col = col_start;
+        page++;
+    }
+}
+
+static void Wire(const uint8_t * data, uint32_t size){
+    panel_model.transactions++;
+    panel_model.bytes += size;
+    if(panel_model.off){
+        return;
+    }
+    for(uint32_t i = 0; i < size; i++){
+        if(!dc){
+            cmd = data[i];
+            n_param = 0;
+            if(cmd == MEM_WRITE){
+                col = col_start;
+                page = page_start;
+                low_byte_next = false;
+            }
+            if(cmd == NORMAL_MODE_ON){
+                panel_model.scroll_top = 0;
+                panel_model.scroll_lines = ILI9341_HEIGHT;
+                panel_model.scroll_start = 0;
+            }
+            continue;
+        }
+        switch(cmd){
+        case MEM_ACC_CTRL:
+            madctl = data[i];
+            break;
+        case VERT_SCROLL_DEF:
+            param[n_param++] = data[i];
+            if(n_param == 6){
+                panel_model.scroll_top = (param[0] << 8) | param[1];
+                panel_model.scroll_lines = (param[2] << 8) | param[3];
+                if(panel_model.scroll_top + panel_model.scroll_lines + ((param[4] << 8) | param[5]) != ILI9341_HEIGHT){
+                    printf("panel model: scroll areas don't add up to %d lines\n", ILI9341_HEIGHT);
+                    panel_model.errors++;
+                }
+                panel_model.scroll_cmds++;
+                n_param = 0;
+            }
+            break;
+        case VERT_SCROLL_START:
+            param[n_param++] = data[i];
+            if(n_param == 2){
+                panel_model.scroll_start = (param[0] << 8) | param[1];
+                panel_model.scroll_cmds++;
+                n_param = 0;
+            }
+            break;
+        case COLUMN_ADDR_SET:
+        case PAGE_ADDR_SET:
+            if(n_param < 4){
+                param[n_param++] = data[i];
+            }
+            if(n_param == 4){
+                uint16_t start = (param[0] << 8) | param[1], end = (param[2] << 8) | param[3];
+                if(cmd == COLUMN_ADDR_SET){
+                    col_start = start;
+                    col_end = end;
+                }else{
+                    page_start = start;
+                    page_end = end;
+                }
+            }
+            break;
+        case MEM_WRITE:
+            if(low_byte_next){
+                StorePixel((high_byte << 8) | data[i]);
+            }else{
+                high_byte = data[i];
+            }
+            low_byte_next = !low_byte_next;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+static void CompleteQueued(void){
+    queued_t * t = &queue[(queue_head + PANEL_MODEL_QUEUE - queue_pending) % PANEL_MODEL_QUEUE];
+    if(memcmp(t->buffer, t->snapshot, t->size)){
+        printf("panel model: buffer modified while queued\n");
+        panel_model.errors++;
+    }
+    Wire(t->buffer, t->size);
+    queue_pending--;
+    if(queue_func){
+        queue_func(queue_param);
+    }
+}
+/*==================[external functions definition]==========================*/
+void PanelModelReset(void){
+    memset(panel_model.gram, 0, sizeof(panel_model.gram));
+    panel_model.scroll_cmds = 0;
+    PanelModelResetCount();
+    panel_model.spi_inits = 0;
+}
+
+void PanelModelResetCount(void){
+    panel_model.transactions = 0;
+    panel_model.queued = 0;
+    panel_model.bytes = 0;
+}
+
+uint32_t PanelModelDiff(const uint16_t ref[ILI9341_HEIGHT][ILI9341_WIDTH]){
+    uint32_t diff = 0;
+    for(uint16_t y = 0; y < ILI9341_HEIGHT; y++){
+        for(uint16_t x = 0; x < ILI9341_WIDTH; x++){
+            diff += (panel_model.gram[y][x] != ref[y][x]);
+        }
+    }
+    return diff;
+}
+
+void PanelModelView(uint16_t view[ILI9341_WIDTH][ILI9341_HEIGHT]){
+    uint16_t top = panel_model.scroll_top, lines = panel_model.scroll_lines;
+    for(uint16_t x = 0; x < ILI9341_HEIGHT; x++){
+        /* Displayed line of the column, and frame memory line shown on it */
+        uint16_t line = (madctl & MADCTL_MY) ? ILI9341_HEIGHT - 1 - x : x;
+        if(line >= top && line < top + lines){
+            line = top + (line - top + panel_model.scroll_start - top) % lines;
+        }
+        for(uint16_t y = 0; y < ILI9341_WIDTH; y++){
+            view[y][x] = panel_model.gram[line][y];
+        }
+    }
+}
+
+/* spi_mcu */
+uint8_t SpiInit(spi_mcu_config_t * spi){
+    panel_model.spi_inits++;
+    queue_func = (void (*)(void *))spi->func_p;
+    queue_param = spi->param_p;
+    return 0;
+}
+
+void SpiWrite(spi_dev_t device, uint8_t * tx_buffer, uint32_t tx_buffer_size){
+    if(queue_pending){
+        printf("panel model: polling write with %d queued\n", queue_pending);
+        panel_model.errors++;
+    }
+    Wire(tx_buffer, tx_buffer_size);
+}
+
+void SpiWriteQueued(spi_dev_t device, uint8_t * tx_buffer, uint32_t tx_buffer_size){
+    if(tx_buffer_size == 0 || tx_buffer_size > MAX_QUEUED_BYTES){
+        printf("panel model: queued write of %u bytes\n", (unsigned)tx_buffer_size);
+        panel_model.errors++;
+        return;
+    }
+    if(!dc){
+        printf("panel model: queued write with DC low\n");
+        panel_model.errors++;
+    }
+    if(queue_pending == PANEL_MODEL_QUEUE){
+        CompleteQueued();
+    }
+    queue[queue_head].buffer = tx_buffer;
+    queue[queue_head].size = tx_buffer_size;
+    memcpy(queue[queue_head].snapshot, tx_buffer, tx_buffer_size);
+    queue_head = (queue_head + 1) % PANEL_MODEL_QUEUE;
+    queue_pending++;
+    panel_model.queued++;
+}
+
+void SpiWaitQueued(spi_dev_t device, uint8_t max_pending){
+    while(queue_pending > max_pending){
+        CompleteQueued();
+    }
+}
+
+uint8_t SpiQueuedPending(spi_dev_t device){
+    return queue_pending;
+}
+
+uint8_t SpiDeInit(spi_dev_t device){
+    return 0;
+}
+
+/* gpio_mcu (only DC is modelled) */
+void GPIOInit(gpio_t pin, io_t io){
+}
+
+void GPIOOn(gpio_t pin){
+    if(pin == PANEL_MODEL_DC){
+        dc = true;
+    }
+}
+
+void GPIOOff(gpio_t pin){
+    if(pin != PANEL_MODEL_DC){
+        return;
+    }
+    if(queue_pending){
+        printf("panel model: DC low with %d queued\n", queue_pending);
+        panel_model.errors++;
+    }
+    dc = false;
+}
+
+void GPIOState(gpio_t pin, bool state){
+    state ? GPIOOn(pin) : GPIOOff(pin);
+}
+
+/* delay_mcu */
+void DelayMs(uint16_t msec){
+}
+
+void DelayUs(uint16_t usec){
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,73 @@
+/**
+ * @file panel_model.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Software model of the ILI9341 panel behind spi_mcu and gpio_mcu (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The model decodes the bytes written to the SPI port (DC low: command, DC high: data) and
+ * keeps the panel memory and the vertical scrolling registers, so drivers can be compared
+ * pixel by pixel. It also counts SPI transactions and bytes, and checks the queued (DMA)
+ * writes: buffers modified while in flight, DC changes with writes pending and polling
+ * writes mixed with queued ones.
+ */
+#ifndef PANEL_MODEL_H_
+#define PANEL_MODEL_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "ili9341.h"
+#include "gpio_mcu.h"
+/*==================[macros]=================================================*/
+#define PANEL_MODEL_DC          GPIO_0  /*!< DC pin to pass to ILI9341Init() */
+#define PANEL_MODEL_QUEUE       8       /*!< Queued transactions (as the SPI driver queue) */
+/*==================[typedef]================================================*/
+/**
+ * @brief Panel model state
+ */
+typedef struct {
+    uint16_t gram[ILI9341_HEIGHT][ILI9341_WIDTH];   /*!< Panel memory (portrait rows) */
+    uint32_t transactions;                          /*!< SPI transactions */
+    uint32_t queued;                                /*!< SPI transactions queued (DMA) */
+    uint32_t bytes;                                 /*!< SPI bytes */
+    uint32_t spi_inits;                             /*!< Calls to SpiInit() */
+    uint32_t errors;                                /*!< Protocol errors detected */
+    uint16_t scroll_top;                            /*!< Top fixed lines (VSCRDEF) */
+    uint16_t scroll_lines;                          /*!< Scrolling lines (VSCRDEF) */
+    uint16_t scroll_start;                          /*!< Line shown at the top of the scrolling area (VSCRSADD) */
+    uint32_t scroll_cmds;                           /*!< Scrolling commands */
+    bool off;                                       /*!< Count only, without decoding (benchmarks) */
+} panel_model_t;
+/*==================[external data declaration]==============================*/
+extern panel_model_t panel_model;
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Clear the panel memory and the counters (errors are kept)
+ */
+void PanelModelReset(void);
+
+/**
+ * @brief Clear the transaction, queued and byte counters
+ */
+void PanelModelResetCount(void);
+
+/**
+ * @brief Number of pixels that differ from a reference panel memory
+ *
+ * @param ref           Reference panel memory
+ * @return uint32_t     Different pixels
+ */
+uint32_t PanelModelDiff(const uint16_t ref[ILI9341_HEIGHT][ILI9341_WIDTH]);
+
+/**
+ * @brief What the viewer sees in landscape, with vertical scrolling applied
+ *
+ * @param view          Displayed image (landscape rows)
+ */
+void PanelModelView(uint16_t view[ILI9341_WIDTH][ILI9341_HEIGHT]);
+
+#endif /* PANEL_MODEL_H_ */
+/*==================[end of file]============================================*/
@@ -0,0 +1,143 @@
+/**
+ * @file test_ili9341_framebuffer.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and transaction count of the ILI9341 off-screen framebuffer
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The same scene is drawn with the previous driver (ili9341_prev.c, straight to the panel),
+ * with the driver drawing directly and through the framebuffer (full screen, in bands and
+ * with partial updates). The panel model (panel_model.c) must end up with the same pixels.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include "host_test.h"
+#include "panel_model.h"
+#include "ili9341.h"
+#include "ili9341_prev.h"
+/*==================[macros and definitions]=================================*/
+#define BAND_HEIGHT     40      /* Height of the banded framebuffer */
+
+/* Scene drawn with any of the drivers (P: function prefix). Filled triangles are left out:
+ * their edge pixels changed with the span based geometry (see test_ili9341_geometry.c) */
+#define SCENE(P)    do{ \
+                        P##ILI9341Fill(ILI9341_WHITE); \
+                        P##ILI9341DrawLine(10, 10, 200, 150, ILI9341_RED); \
+                        P##ILI9341DrawLine(5, 300, 230, 20, ILI9341_BLUE); \
+                        P##ILI9341DrawCircle(120, 160, 60, ILI9341_BLACK); \
+                        P##ILI9341DrawFilledCircle(60, 250, 30, ILI9341_GREEN); \
+                        P##ILI9341DrawRectangle(20, 20, 100, 60, ILI9341_NAVY); \
+                        P##ILI9341DrawFilledRectangle(150, 200, 220, 300, ILI9341_ORANGE); \
+                        P##ILI9341DrawTriangle(10, 100, 80, 180, 30, 200, ILI9341_PURPLE); \
+                        P##ILI9341DrawChar(5, 5, 'H', &font_22, ILI9341_BLACK, ILI9341_YELLOW); \
+                        P##ILI9341DrawInt(100, 270, 4567, 4, &font_30, ILI9341_RED, ILI9341_WHITE); \
+                        P##ILI9341DrawIcon(180, 10, 0, &icon_30, ILI9341_BLUE, ILI9341_WHITE); \
+                        P##ILI9341DrawPicture(20, 180, 50, 40, picture); \
+                    }while(0)
+
+/* Partial update of the scene */
+#define UPDATE(P)   do{ \
+                        P##ILI9341DrawCircle(120, 160, 40, ILI9341_RED); \
+                        P##ILI9341DrawInt(100, 270, 1234, 4, &font_30, ILI9341_RED, ILI9341_WHITE); \
+                    }while(0)
+/*==================[internal data declaration]==============================*/
+static uint16_t reference[ILI9341_HEIGHT][ILI9341_WIDTH];
+static uint16_t framebuffer[ILI9341_WIDTH * ILI9341_HEIGHT];
+static uint8_t picture[50 * 40 * 2];
+static uint32_t prev_transactions;
+/*==================[internal functions definition]==========================*/
+/* Both drivers share the panel: the driver under test must not trust the address window
+ * it set last (re-selecting the orientation invalidates it) */
+static void UseDriver(void){
+    ILI9341Rotate(ILI9341GetOrientation());
+}
+
+static void Report(const char * name){
+    printf("  %-24s %6u transactions %7u bytes\n", name, (unsigned)panel_model.transactions,
+           (unsigned)panel_model.bytes);
+}
+
+static void TestDirect(void){
+    PanelModelReset();
+    SCENE(Prev);
+    prev_transactions = panel_model.transactions;
+    memcpy(reference, panel_model.gram, sizeof(reference));
+    Report("previous driver");
+    PanelModelReset();
+    UseDriver();
+    SCENE();
+    CHECK(PanelModelDiff(reference) == 0);
+    Report("direct");
+}
+
+static void TestFullFramebuffer(void){
+    PanelModelReset();
+    ILI9341FramebufferEnable(framebuffer, 0, 0, ILI9341_WIDTH, ILI9341_HEIGHT);
+    SCENE();
+    CHECK(panel_model.transactions == 0);
+    ILI9341FramebufferFlush();
+    ILI9341FramebufferDisable();
+    CHECK(PanelModelDiff(reference) == 0);
+    CHECK(panel_model.transactions < prev_transactions / 10);
+    Report("full framebuffer");
+}
+
+static void TestBanded(void){
+    PanelModelReset();
+    ILI9341FramebufferEnable(framebuffer, 0, 0, ILI9341_WIDTH, BAND_HEIGHT);
+    for(uint16_t y = 0; y < ILI9341_HEIGHT; y += BAND_HEIGHT){
+        ILI9341FramebufferMove(0, y);
+        SCENE();
+        ILI9341FramebufferFlush();
+    }
+    ILI9341FramebufferDisable();
+    CHECK(PanelModelDiff(reference) == 0);
+    CHECK(panel_model.transactions < prev_transactions);
+    Report("240x40 bands");
+}
+
+static void TestPartialUpdate(void){
+    uint32_t transactions, bytes;
+    /* Framebuffer with the scene already on the panel: only dirty regions are sent */
+    PanelModelReset();
+    ILI9341FramebufferEnable(framebuffer, 0, 0, ILI9341_WIDTH, ILI9341_HEIGHT);
+    SCENE();
+    ILI9341FramebufferFlush();
+    PanelModelResetCount();
+    UPDATE();
+    ILI9341FramebufferFlush();
+    ILI9341FramebufferDisable();
+    transactions = panel_model.transactions;
+    bytes = panel_model.bytes;
+    Report("update, framebuffer");
+    memcpy(reference, panel_model.gram, sizeof(reference));
+    /* Same update straight to the panel */
+    PanelModelReset();
+    SCENE(Prev);
+    PanelModelResetCount();
+    UPDATE(Prev);
+    Report("update, previous driver");
+    CHECK(PanelModelDiff(reference) == 0);
+    CHECK(transactions < panel_model.transactions / 10);
+    CHECK(bytes < ILI9341_WIDTH * ILI9341_HEIGHT * 2 / 4);
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+    for(uint16_t i = 0; i < sizeof(picture); i++){
+        picture[i] = i * 7;
+    }
+    PrevILI9341Init(SPI_1, PANEL_MODEL_DC, GPIO_1);
+    ILI9341Init(SPI_1, PANEL_MODEL_DC, GPIO_1);
+    printf("SPI traffic of the test scene:\n");
+    TestDirect();
+    TestFullFramebuffer();
+    TestBanded();
+    TestPartialUpdate();
+    CHECK(panel_model.errors == 0);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
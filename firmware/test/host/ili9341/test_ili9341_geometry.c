@@ -0,0 +1,161 @@
+/**
+ * @file test_ili9341_geometry.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and SPI traffic of the ILI9341 span based geometry
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Each primitive is drawn with the previous driver (ili9341_prev.c) and with the driver:
+ * pixels must be the same (filled triangles: all interior pixels covered) and the SPI
+ * transactions and bytes of both are printed.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include "host_test.h"
+#include "panel_model.h"
+#include "ili9341.h"
+#include "ili9341_prev.h"
+/*==================[macros and definitions]=================================*/
+/* Draw a primitive with the previous driver and with the driver (same arguments), compare
+ * and report the SPI traffic of both */
+#define COMPARE(name, exact, func, ...)  do{ \
+                        uint32_t t_, b_; \
+                        PanelModelReset(); \
+                        Prev##func(__VA_ARGS__); \
+                        t_ = panel_model.transactions; \
+                        b_ = panel_model.bytes; \
+                        memcpy(reference, panel_model.gram, sizeof(reference)); \
+                        UseDriver(); \
+                        PanelModelReset(); \
+                        func(__VA_ARGS__); \
+                        if(exact){ \
+                            CHECK(PanelModelDiff(reference) == 0); \
+                        } \
+                        CHECK(panel_model.transactions <= t_); \
+                        printf("  %-20s %6u / %-6u -> %6u / %-6u\n", name, (unsigned)t_, (unsigned)b_, \
+                               (unsigned)panel_model.transactions, (unsigned)panel_model.bytes); \
+                    }while(0)
+
+/* Draw a new primitive and report its SPI traffic */
+#define REPORT(name, statement)  do{ \
+                        PanelModelReset(); \
+                        statement; \
+                        printf("  %-20s %22u / %-6u\n", name, (unsigned)panel_model.transactions, \
+                               (unsigned)panel_model.bytes); \
+                    }while(0)
+/*==================[internal data declaration]==============================*/
+static uint16_t reference[ILI9341_HEIGHT][ILI9341_WIDTH];
+static uint16_t framebuffer[ILI9341_WIDTH * ILI9341_HEIGHT];
+/*==================[internal functions definition]==========================*/
+/* Both drivers share the panel: the address window set last must not be trusted */
+static void UseDriver(void){
+    ILI9341Rotate(ILI9341GetOrientation());
+}
+
+static void Scene(void){
+    ILI9341Fill(ILI9341_WHITE);
+    ILI9341DrawThickLine(10, 10, 230, 60, 5, ILI9341_RED);
+    ILI9341DrawCircle(10, 10, 40, ILI9341_BLACK);
+    ILI9341DrawFilledRoundRectangle(20, 100, 200, 280, 15, ILI9341_BLUE);
+    ILI9341DrawRoundRectangle(5, 5, 100, 80, 9, ILI9341_GREEN);
+    ILI9341DrawFilledTriangle(0, 0, 239, 150, 30, 319, ILI9341_MAROON);
+    ILI9341DrawFilledCircle(200, 300, 50, ILI9341_ORANGE);
+}
+
+static void TestPrimitives(void){
+    printf("SPI transactions / bytes, previous driver -> span based:\n");
+    COMPARE("line horizontal", true, ILI9341DrawLine, 10, 100, 200, 100, ILI9341_RED);
+    COMPARE("line 45 deg", true, ILI9341DrawLine, 10, 10, 200, 200, ILI9341_RED);
+    COMPARE("line shallow", true, ILI9341DrawLine, 10, 10, 230, 60, ILI9341_RED);
+    COMPARE("line steep", true, ILI9341DrawLine, 20, 10, 70, 300, ILI9341_RED);
+    COMPARE("circle r=60", true, ILI9341DrawCircle, 120, 160, 60, ILI9341_BLACK);
+    COMPARE("circle r=5", true, ILI9341DrawCircle, 50, 50, 5, ILI9341_BLACK);
+    COMPARE("filled circle r=60", true, ILI9341DrawFilledCircle, 120, 160, 60, ILI9341_GREEN);
+    COMPARE("filled circle r=3", true, ILI9341DrawFilledCircle, 50, 50, 3, ILI9341_GREEN);
+    COMPARE("filled circle r=0", true, ILI9341DrawFilledCircle, 50, 50, 0, ILI9341_GREEN);
+    COMPARE("rectangle", true, ILI9341DrawRectangle, 20, 20, 200, 280, ILI9341_BLUE);
+    /* Edge pixels of filled triangles changed with integer edge walking */
+    COMPARE("filled triangle", false, ILI9341DrawFilledTriangle, 130, 30, 230, 90, 160, 130, ILI9341_MAROON);
+    COMPARE("filled triangle big", false, ILI9341DrawFilledTriangle, 0, 0, 239, 150, 30, 319, ILI9341_MAROON);
+    REPORT("thick line 5 shallow", ILI9341DrawThickLine(10, 10, 230, 60, 5, ILI9341_RED));
+    REPORT("thick line 5 steep", ILI9341DrawThickLine(20, 10, 70, 300, 5, ILI9341_RED));
+    REPORT("thick line 8 45 deg", ILI9341DrawThickLine(20, 20, 220, 220, 8, ILI9341_RED));
+    REPORT("round rect r=12", ILI9341DrawRoundRectangle(20, 20, 200, 280, 12, ILI9341_BLUE));
+    REPORT("filled round rect", ILI9341DrawFilledRoundRectangle(20, 20, 200, 280, 12, ILI9341_BLUE));
+}
+
+static void TestClippedCircle(void){
+    /* Partly off-screen: the previous driver wrapped around, spans are clipped now */
+    PanelModelReset();
+    ILI9341DrawCircle(10, 10, 40, ILI9341_BLACK);
+    CHECK(panel_model.gram[10][50] == ILI9341_BLACK);
+    CHECK(panel_model.gram[50][10] == ILI9341_BLACK);
+    CHECK(panel_model.gram[ILI9341_HEIGHT - 30][10] == 0);
+    CHECK(panel_model.gram[10][ILI9341_WIDTH - 30] == 0);
+}
+
+static void TestTriangleCoverage(void){
+    /* Every pixel strictly inside the triangle must be drawn */
+    const int32_t x0 = 130, y0 = 30, x1 = 230, y1 = 90, x2 = 160, y2 = 130;
+    uint32_t inside = 0, missed = 0;
+    PanelModelReset();
+    ILI9341DrawFilledTriangle(x0, y0, x1, y1, x2, y2, 1);
+    for(int32_t y = 0; y < ILI9341_HEIGHT; y++){
+        for(int32_t x = 0; x < ILI9341_WIDTH; x++){
+            int32_t e0 = (x1 - x0) * (y - y0) - (y1 - y0) * (x - x0);
+            int32_t e1 = (x2 - x1) * (y - y1) - (y2 - y1) * (x - x1);
+            int32_t e2 = (x0 - x2) * (y - y2) - (y0 - y2) * (x - x2);
+            if((e0 < 0 && e1 < 0 && e2 < 0) || (e0 > 0 && e1 > 0 && e2 > 0)){
+                inside++;
+                missed += (panel_model.gram[y][x] != 1);
+            }
+        }
+    }
+    CHECK(inside > 4000);
+    CHECK(missed == 0);
+}
+
+static void TestRoundRectangles(void){
+    /* Radius 0 is a rectangle; a square of side 2r with radius r is a disc */
+    PanelModelReset();
+    ILI9341DrawRectangle(20, 20, 200, 280, ILI9341_BLUE);
+    memcpy(reference, panel_model.gram, sizeof(reference));
+    PanelModelReset();
+    ILI9341DrawRoundRectangle(20, 20, 200, 280, 0, ILI9341_BLUE);
+    CHECK(PanelModelDiff(reference) == 0);
+    PanelModelReset();
+    ILI9341DrawFilledCircle(120, 160, 60, ILI9341_BLUE);
+    memcpy(reference, panel_model.gram, sizeof(reference));
+    PanelModelReset();
+    ILI9341DrawFilledRoundRectangle(60, 100, 180, 220, 60, ILI9341_BLUE);
+    CHECK(PanelModelDiff(reference) == 0);
+}
+
+static void TestFramebuffer(void){
+    PanelModelReset();
+    Scene();
+    memcpy(reference, panel_model.gram, sizeof(reference));
+    PanelModelReset();
+    ILI9341FramebufferEnable(framebuffer, 0, 0, ILI9341_WIDTH, ILI9341_HEIGHT);
+    Scene();
+    ILI9341FramebufferFlush();
+    ILI9341FramebufferDisable();
+    CHECK(PanelModelDiff(reference) == 0);
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+    PrevILI9341Init(SPI_1, PANEL_MODEL_DC, GPIO_1);
+    ILI9341Init(SPI_1, PANEL_MODEL_DC, GPIO_1);
+    TestPrimitives();
+    TestClippedCircle();
+    TestTriangleCoverage();
+    TestRoundRectangles();
+    TestFramebuffer();
+    CHECK(panel_model.errors == 0);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,205 @@
+/**
+ * @file test_ili9341_glyph.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of the ILI9341 glyph cache and single window strings
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Characters must be identical to the previous driver (ili9341_prev.c) with the cache off,
+ * on, with a pool small enough to force evictions and with the DMA pipeline. Strings (which
+ * now paint the gap between characters) must be identical to the framebuffer path.
+ * Usage: test_ili9341_glyph [redraws]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "panel_model.h"
+#include "ili9341.h"
+#include "ili9341_prev.h"
+/*==================[macros and definitions]=================================*/
+#define BENCH_REDRAWS       2000    /* Default redraws of the 4 digits readout */
+#define STRESS_DRAWINGS     3000    /* Random strings and characters of the stress test */
+
+/* Characters drawn with any of the drivers (P: function prefix) */
+#define CHARS(P)    do{ \
+                        P##ILI9341Fill(ILI9341_WHITE); \
+                        for(uint8_t i_ = 0; i_ < 30; i_++){ \
+                            P##ILI9341DrawChar(10 + (i_ % 10) * 22, 10 + (i_ / 10) * 60, '0' + i_ % 10, \
+                                               &font_59, ILI9341_RED, ILI9341_BLACK); \
+                        } \
+                        P##ILI9341DrawInt(10, 200, 98765, 5, &font_30, ILI9341_BLUE, ILI9341_WHITE); \
+                        P##ILI9341DrawChar(230, 250, 'W', &font_22, ILI9341_BLUE, ILI9341_WHITE); \
+                    }while(0)
+/*==================[internal data declaration]==============================*/
+static uint16_t reference[ILI9341_HEIGHT][ILI9341_WIDTH];
+static uint16_t framebuffer[ILI9341_WIDTH * ILI9341_HEIGHT];
+static uint8_t dma[2 * ILI9341_MAX_BURST] __attribute__((aligned(4)));
+static uint8_t pool[32768];
+static Font_t * fonts[] = {&font_11, &font_19, &font_30, &font_59};
+static const uint16_t colors[] = {ILI9341_RED, ILI9341_BLACK, ILI9341_WHITE, ILI9341_BLUE};
+/*==================[internal functions definition]==========================*/
+/* Both drivers share the panel: the address window set last must not be trusted */
+static void UseDriver(void){
+    ILI9341Rotate(ILI9341GetOrientation());
+}
+
+static void Strings(void){
+    ILI9341Fill(ILI9341_WHITE);
+    ILI9341DrawString(5, 5, "Temp 36.5 C\nHR 072 bpm\n\rSpO2: 98%", &font_22, ILI9341_BLACK, ILI9341_YELLOW);
+    ILI9341DrawString(5, 120, "123.4", &font_59, ILI9341_RED, ILI9341_WHITE);
+    ILI9341DrawString(150, 200, "too long for line", &font_19, ILI9341_RED, ILI9341_WHITE);
+}
+
+static void Stress(void){
+    char str[8];
+    srand(7);
+    for(uint16_t i = 0; i < STRESS_DRAWINGS; i++){
+        uint8_t n = 1 + rand() % 6;
+        for(uint8_t k = 0; k < n; k++){
+            str[k] = ' ' + rand() % 95;
+        }
+        str[n] = 0;
+        Font_t * font = fonts[rand() % 4];
+        uint16_t x = rand() % 200, y = rand() % 250;
+        if(rand() % 3){
+            uint16_t fg = colors[rand() % 4];
+            ILI9341DrawString(x, y, str, font, fg, colors[rand() % 4]);
+        }else{
+            uint16_t fg = colors[rand() % 4];
+            ILI9341DrawChar(x, y, str[0], font, fg, colors[rand() % 4]);
+        }
+    }
+}
+
+static void TestChars(void){
+    PanelModelReset();
+    CHARS(Prev);
+    memcpy(reference, panel_model.gram, sizeof(reference));
+    UseDriver();
+    PanelModelReset();
+    CHARS();
+    CHECK(PanelModelDiff(reference) == 0);
+    /* Second pass with all glyphs already cached */
+    ILI9341GlyphCacheEnable(pool, sizeof(pool));
+    PanelModelReset();
+    CHARS();
+    CHARS();
+    CHECK(PanelModelDiff(reference) == 0);
+    /* Pool smaller than two font_59 glyphs: evictions on every character */
+    ILI9341GlyphCacheEnable(pool, 5000);
+    PanelModelReset();
+    CHARS();
+    CHECK(PanelModelDiff(reference) == 0);
+    ILI9341PipelineEnable(dma, ILI9341_MAX_BURST, 2, NULL, NULL);
+    PanelModelReset();
+    CHARS();
+    ILI9341PipelineWait();
+    CHECK(PanelModelDiff(reference) == 0);
+    ILI9341PipelineDisable();
+    ILI9341GlyphCacheDisable();
+}
+
+static void TestStrings(void){
+    uint32_t transactions;
+    /* Framebuffer path (character by character, gaps filled) is the reference */
+    ILI9341FramebufferEnable(framebuffer, 0, 0, ILI9341_WIDTH, ILI9341_HEIGHT);
+    PanelModelReset();
+    Strings();
+    ILI9341FramebufferDisable();
+    memcpy(reference, panel_model.gram, sizeof(reference));
+    PanelModelReset();
+    Strings();
+    CHECK(PanelModelDiff(reference) == 0);
+    ILI9341GlyphCacheEnable(pool, sizeof(pool));
+    PanelModelReset();
+    Strings();
+    Strings();
+    CHECK(PanelModelDiff(reference) == 0);
+    ILI9341GlyphCacheEnable(pool, 4000);
+    PanelModelReset();
+    Strings();
+    Strings();
+    CHECK(PanelModelDiff(reference) == 0);
+    ILI9341PipelineEnable(dma, ILI9341_MAX_BURST, 2, NULL, NULL);
+    PanelModelReset();
+    Strings();
+    ILI9341PipelineWait();
+    CHECK(PanelModelDiff(reference) == 0);
+    ILI9341PipelineDisable();
+    ILI9341GlyphCacheDisable();
+    /* Previous driver: one window per character */
+    PanelModelReset();
+    PrevILI9341Fill(ILI9341_WHITE);
+    PrevILI9341DrawString(5, 120, "123.4", &font_59, ILI9341_RED, ILI9341_WHITE);
+    UseDriver();
+    transactions = panel_model.transactions;
+    PanelModelReset();
+    ILI9341Fill(ILI9341_WHITE);
+    ILI9341DrawString(5, 120, "123.4", &font_59, ILI9341_RED, ILI9341_WHITE);
+    CHECK(panel_model.transactions < transactions);
+}
+
+static void TestStress(void){
+    static const uint32_t pool_sizes[] = {1000, 3500, 7000, 20000};
+    PanelModelReset();
+    Stress();
+    memcpy(reference, panel_model.gram, sizeof(reference));
+    for(uint8_t i = 0; i < sizeof(pool_sizes) / sizeof(pool_sizes[0]); i++){
+        ILI9341GlyphCacheEnable(pool, pool_sizes[i]);
+        PanelModelReset();
+        Stress();
+        CHECK(PanelModelDiff(reference) == 0);
+    }
+    ILI9341GlyphCacheDisable();
+}
+
+static void Bench(uint32_t redraws){
+    static const char * names[] = {"previous DrawInt", "DrawInt, no cache", "DrawInt, cache", "DrawString, cache"};
+    char str[8];
+    printf("font_59 4 digits readout, %u redraws (host CPU, panel not decoded):\n", (unsigned)redraws);
+    panel_model.off = true;
+    for(uint8_t mode = 0; mode < 4; mode++){
+        if(mode == 2){
+            ILI9341GlyphCacheEnable(pool, sizeof(pool));
+        }
+        PanelModelResetCount();
+        double t0 = HostTimeUs();
+        for(uint32_t r = 0; r < redraws; r++){
+            switch(mode){
+            case 0:
+                PrevILI9341DrawInt(10, 100, r % 10000, 4, &font_59, ILI9341_RED, ILI9341_BLACK);
+                break;
+            case 3:
+                snprintf(str, sizeof(str), "%04u", (unsigned)(r % 10000));
+                ILI9341DrawString(10, 100, str, &font_59, ILI9341_RED, ILI9341_BLACK);
+                break;
+            default:
+                ILI9341DrawInt(10, 100, r % 10000, 4, &font_59, ILI9341_RED, ILI9341_BLACK);
+                break;
+            }
+        }
+        double t = HostTimeUs() - t0;
+        printf("  %-20s %8.0f glyphs/s %6.2f transactions/glyph\n", names[mode], 4e6 * redraws / t,
+               (double)panel_model.transactions / (4 * redraws));
+    }
+    ILI9341GlyphCacheDisable();
+    panel_model.off = false;
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char * argv[]){
+    uint32_t redraws = (argc > 1) ? atoi(argv[1]) : BENCH_REDRAWS;
+    PrevILI9341Init(SPI_1, PANEL_MODEL_DC, GPIO_1);
+    ILI9341Init(SPI_1, PANEL_MODEL_DC, GPIO_1);
+    TestChars();
+    TestStrings();
+    TestStress();
+    CHECK(panel_model.errors == 0);
+    Bench(redraws);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,284 @@
+/**
+ * @file test_ili9341_image.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and decode benchmark of the ILI9341 compressed images
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Test images are encoded here (runs and literals of every length, crossing the 128 pixels
+ * packet limit and the image rows) in the three formats, drawn directly, through the
+ * pipeline, through the full framebuffer and through 240x40 bands, and compared pixel by
+ * pixel with the panel model. The shipped esp_edu_pic is decoded by a reference decoder, must
+ * use 256 different colors and must match the raw array drawn with ILI9341DrawPicture().
+ * Usage: test_ili9341_image [frames]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "panel_model.h"
+#include "ili9341.h"
+/*==================[macros and definitions]=================================*/
+#define RLE_RUN         0x80        /* Run packet flag */
+#define RLE_MAX         128         /* Pixels per packet */
+#define BAND_HEIGHT     40          /* Height of the banded framebuffer */
+#define PIXELS          (ILI9341_WIDTH * ILI9341_HEIGHT)
+#define BENCH_FRAMES    100         /* Default frames per run in the benchmark */
+/*==================[internal data declaration]==============================*/
+extern const ili9341_image_t esp_edu_pic;
+
+static uint16_t reference[ILI9341_HEIGHT][ILI9341_WIDTH];
+static uint16_t framebuffer[PIXELS];
+static uint8_t dma[2 * ILI9341_MAX_BURST] __attribute__((aligned(4)));
+static uint16_t palette[256];
+static uint8_t index_of[PIXELS];            /* Palette index of each pixel */
+static uint16_t color_of[PIXELS];           /* Color of each pixel */
+static uint8_t encoded[3][3 * PIXELS];      /* Data of each format (worst case: RLE16 literals) */
+static uint8_t raw[PIXELS * 2];             /* esp_edu_pic as a DrawPicture() array */
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Value of a pixel in the given format (color or palette index)
+ */
+static uint16_t Value(ili9341_image_format_t format, uint32_t i){
+    return (format == ILI9341_IMAGE_RLE16) ? color_of[i] : index_of[i];
+}
+
+/**
+ * @brief Reference encoder: runs of 3 or more pixels, literals for the rest
+ *
+ * @return uint32_t Bytes of data
+ */
+static uint32_t Encode(ili9341_image_format_t format, uint32_t pixels, uint8_t * out){
+    uint8_t * start = out;
+    uint32_t i = 0;
+    while(i < pixels){
+        uint32_t run = 1;
+        while((i + run < pixels) && (run < RLE_MAX) && (Value(format, i + run) == Value(format, i))){
+            run++;
+        }
+        if(run >= 3){
+            *out++ = RLE_RUN | (run - 1);
+            if(format == ILI9341_IMAGE_RLE16){
+                *out++ = color_of[i] >> 8;
+                *out++ = color_of[i] & 0xFF;
+            }else{
+                *out++ = index_of[i];
+            }
+            i += run;
+            continue;
+        }
+        /* Literal until the next run of 3 */
+        uint32_t n = 0;
+        while((i + n < pixels) && (n < RLE_MAX) &&
+              !((i + n + 2 < pixels) && (Value(format, i + n) == Value(format, i + n + 1)) &&
+                (Value(format, i + n) == Value(format, i + n + 2)))){
+            n++;
+        }
+        if(n == 0){
+            n = 1;
+        }
+        *out++ = n - 1;
+        for(uint32_t k = 0; k < n; k++){
+            switch(format){
+            case ILI9341_IMAGE_RLE16:
+                *out++ = color_of[i + k] >> 8;
+                *out++ = color_of[i + k] & 0xFF;
+                break;
+            case ILI9341_IMAGE_RLE8:
+                *out++ = index_of[i + k];
+                break;
+            case ILI9341_IMAGE_RLE4:
+                if(k % 2){
+                    out[-1] |= index_of[i + k];
+                }else{
+                    *out++ = index_of[i + k] << 4;
+                }
+                break;
+            }
+        }
+        i += n;
+    }
+    return out - start;
+}
+
+/**
+ * @brief Test pattern: long runs, short runs, single pixels and noise, 16 colors
+ */
+static void Pattern(uint16_t width, uint16_t height){
+    srand(3);
+    for(uint16_t i = 0; i < 16; i++){
+        palette[i] = (uint16_t)(i * 0x1111) ^ 0x0841;
+    }
+    for(uint32_t i = 0; i < (uint32_t)width * height; i++){
+        uint16_t x = i % width, y = i / width;
+        uint8_t v;
+        if(y < height / 4){
+            v = (x + y) / 50;                       /* runs longer than a packet, across rows */
+        }else if(y < height / 2){
+            v = (x / (1 + y % 5)) % 3 + 4;          /* runs of 1 to 5 */
+        }else if(y < 3 * height / 4){
+            v = rand() % 16;                        /* literals */
+        }else{
+            v = (x % 7 < 2) ? rand() % 16 : 9;      /* literals between runs */
+        }
+        index_of[i] = v % 16;
+        color_of[i] = palette[index_of[i]];
+    }
+}
+
+static void Expected(uint16_t x0, uint16_t y0, uint16_t width, uint16_t height){
+    memset(reference, 0, sizeof(reference));
+    for(uint16_t y = 0; y < height; y++){
+        for(uint16_t x = 0; x < width; x++){
+            reference[y0 + y][x0 + x] = color_of[y * width + x];
+        }
+    }
+}
+
+/**
+ * @brief Draw an image in every mode, checking the panel after each one
+ */
+static void DrawAll(const char * name, uint16_t x, uint16_t y, const ili9341_image_t * image, uint32_t size){
+    uint32_t transactions;
+    PanelModelReset();
+    ILI9341DrawImage(x, y, image);
+    CHECK(PanelModelDiff(reference) == 0);
+    transactions = panel_model.transactions;
+    ILI9341PipelineEnable(dma, ILI9341_MAX_BURST, 2, NULL, NULL);
+    PanelModelReset();
+    ILI9341DrawImage(x, y, image);
+    ILI9341PipelineDisable();
+    CHECK(PanelModelDiff(reference) == 0);
+    PanelModelReset();
+    ILI9341FramebufferEnable(framebuffer, 0, 0, ILI9341_WIDTH, ILI9341_HEIGHT);
+    memset(framebuffer, 0, sizeof(framebuffer));
+    ILI9341DrawImage(x, y, image);
+    ILI9341FramebufferDisable();
+    CHECK(PanelModelDiff(reference) == 0);
+    PanelModelReset();
+    ILI9341FramebufferEnable(framebuffer, 0, 0, ILI9341_WIDTH, BAND_HEIGHT);
+    for(uint16_t band = 0; band < ILI9341_HEIGHT; band += BAND_HEIGHT){
+        ILI9341FramebufferMove(0, band);
+        memset(framebuffer, 0, ILI9341_WIDTH * BAND_HEIGHT * 2);
+        ILI9341DrawImage(x, y, image);
+        ILI9341FramebufferFlush();
+    }
+    ILI9341FramebufferDisable();
+    CHECK(PanelModelDiff(reference) == 0);
+    printf("  %-6s %6u bytes of data, %3u transactions (direct)\n", name, (unsigned)size, (unsigned)transactions);
+}
+
+static void TestFormats(void){
+    static const struct {
+        uint16_t x, y, width, height;
+    } places[] = {{0, 0, ILI9341_WIDTH, ILI9341_HEIGHT}, {101, 37, 67, 131}};
+    static const char * names[] = {"RLE16", "RLE8", "RLE4"};
+    for(uint8_t p = 0; p < 2; p++){
+        printf("%ux%u image at (%u, %u):\n", places[p].width, places[p].height, places[p].x, places[p].y);
+        Pattern(places[p].width, places[p].height);
+        Expected(places[p].x, places[p].y, places[p].width, places[p].height);
+        for(ili9341_image_format_t f = ILI9341_IMAGE_RLE16; f <= ILI9341_IMAGE_RLE4; f++){
+            ili9341_image_t image = {places[p].width, places[p].height, f,
+                                     (f == ILI9341_IMAGE_RLE16) ? NULL : palette, encoded[f]};
+            uint32_t size = Encode(f, (uint32_t)places[p].width * places[p].height, encoded[f]);
+            DrawAll(names[f], places[p].x, places[p].y, &image, size);
+        }
+    }
+}
+
+/**
+ * @brief Reference decoder of the shipped picture to a DrawPicture() array
+ */
+static void Decode(const ili9341_image_t * image, uint8_t * out){
+    const uint8_t * data = image->data;
+    uint32_t pixels = (uint32_t)image->width * image->height;
+    while(pixels > 0){
+        uint8_t header = *data++;
+        uint32_t count = (header & ~RLE_RUN) + 1;
+        count = (count > pixels) ? pixels : count;
+        pixels -= count;
+        for(uint32_t k = 0; k < count; k++){
+            uint16_t color;
+            switch(image->format){
+            case ILI9341_IMAGE_RLE16:
+                color = (header & RLE_RUN) ? (data[0] << 8) | data[1] : (data[2 * k] << 8) | data[2 * k + 1];
+                break;
+            case ILI9341_IMAGE_RLE8:
+                color = image->palette[(header & RLE_RUN) ? data[0] : data[k]];
+                break;
+            default:
+                color = image->palette[(header & RLE_RUN) ? data[0] & 0x0F : (data[k / 2] >> ((k % 2) ? 0 : 4)) & 0x0F];
+                break;
+            }
+            *out++ = color >> 8;
+            *out++ = color & 0xFF;
+        }
+        if(header & RLE_RUN){
+            data += (image->format == ILI9341_IMAGE_RLE16) ? 2 : 1;
+        }else{
+            data += (image->format == ILI9341_IMAGE_RLE16) ? 2 * count :
+                    (image->format == ILI9341_IMAGE_RLE8) ? count : (count + 1) / 2;
+        }
+    }
+}
+
+static void TestPicture(void){
+    static bool used[0x10000];
+    uint32_t transactions, colors = 0;
+    Decode(&esp_edu_pic, raw);
+    /* Every palette entry is a different color */
+    for(uint32_t i = 0; i < sizeof(raw); i += 2){
+        uint16_t color = (raw[i] << 8) | raw[i + 1];
+        colors += !used[color];
+        used[color] = true;
+    }
+    CHECK(colors == 256);
+    /* Re-selecting the orientation makes both draws send the window */
+    ILI9341Rotate(ILI9341GetOrientation());
+    PanelModelReset();
+    ILI9341DrawPicture(0, 0, ILI9341_WIDTH, ILI9341_HEIGHT, raw);
+    memcpy(reference, panel_model.gram, sizeof(reference));
+    transactions = panel_model.transactions;
+    ILI9341Rotate(ILI9341GetOrientation());
+    PanelModelReset();
+    ILI9341DrawImage(0, 0, &esp_edu_pic);
+    CHECK(PanelModelDiff(reference) == 0);
+    CHECK(panel_model.transactions == transactions);
+    printf("esp_edu_pic: %u colors, %u transactions, as DrawPicture() of the raw array\n", (unsigned)colors,
+           (unsigned)transactions);
+}
+
+static void Benchmark(uint32_t frames){
+    ili9341_image_t rle16 = {ILI9341_WIDTH, ILI9341_HEIGHT, ILI9341_IMAGE_RLE16, NULL, encoded[0]};
+    ili9341_image_t rle4 = {ILI9341_WIDTH, ILI9341_HEIGHT, ILI9341_IMAGE_RLE4, palette, encoded[2]};
+    double t_raw, t_pic, t_rle16, t_rle4;
+    Pattern(ILI9341_WIDTH, ILI9341_HEIGHT);
+    Encode(ILI9341_IMAGE_RLE16, PIXELS, encoded[0]);
+    Encode(ILI9341_IMAGE_RLE4, PIXELS, encoded[2]);
+    panel_model.off = true;
+    HOST_BENCH(t_raw, 5, frames, ILI9341DrawPicture(0, 0, ILI9341_WIDTH, ILI9341_HEIGHT, raw));
+    HOST_BENCH(t_pic, 5, frames, ILI9341DrawImage(0, 0, &esp_edu_pic));
+    HOST_BENCH(t_rle16, 5, frames, ILI9341DrawImage(0, 0, &rle16));
+    HOST_BENCH(t_rle4, 5, frames, ILI9341DrawImage(0, 0, &rle4));
+    panel_model.off = false;
+    printf("Full screen, ms per frame on the host CPU (best of 5 runs, SPI not modelled):\n");
+    printf("  DrawPicture() raw:          %6.3f\n", t_raw / 1000);
+    printf("  esp_edu_pic (RLE8):         %6.3f\n", t_pic / 1000);
+    printf("  test pattern RLE16:         %6.3f\n", t_rle16 / 1000);
+    printf("  test pattern RLE4:          %6.3f\n", t_rle4 / 1000);
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char *argv[]){
+    uint32_t frames = (argc > 1) ? strtoul(argv[1], NULL, 0) : BENCH_FRAMES;
+    ILI9341Init(SPI_1, PANEL_MODEL_DC, GPIO_1);
+    TestFormats();
+    TestPicture();
+    Benchmark(frames);
+    CHECK(panel_model.errors == 0);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
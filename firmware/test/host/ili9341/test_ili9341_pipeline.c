@@ -0,0 +1,136 @@
+/**
+ * @file test_ili9341_pipeline.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and transaction count of the ILI9341 queued DMA pipeline
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A full screen fill is sent with the previous driver (ili9341_prev.c, a SpiInit() call and
+ * a 256 bytes write per chunk), with blocking bursts and through the pipeline. The test scene
+ * is then drawn through pipelines of several sizes, and must match the blocking mode pixel
+ * by pixel. The panel model (panel_model.c) runs queued writes lazily and counts as errors
+ * the buffers modified while in flight and the DC changes with writes pending.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include "host_test.h"
+#include "panel_model.h"
+#include "ili9341.h"
+#include "ili9341_prev.h"
+/*==================[macros and definitions]=================================*/
+#define WINDOW_BYTES    11      /* Full screen window: CASET + 4, PASET + 4 and RAMWR */
+#define BAND_HEIGHT     40      /* Height of the framebuffer band of the scene */
+
+/* Scene with every primitive, plus a framebuffer band flushed over it */
+#define SCENE()     do{ \
+                        ILI9341Fill(ILI9341_WHITE); \
+                        ILI9341DrawLine(10, 10, 200, 150, ILI9341_RED); \
+                        ILI9341DrawCircle(120, 160, 60, ILI9341_BLACK); \
+                        ILI9341DrawFilledCircle(60, 250, 30, ILI9341_GREEN); \
+                        ILI9341DrawFilledRectangle(150, 200, 220, 300, ILI9341_ORANGE); \
+                        ILI9341DrawTriangle(10, 100, 80, 180, 30, 200, ILI9341_PURPLE); \
+                        ILI9341DrawFilledTriangle(130, 20, 230, 90, 160, 140, ILI9341_CYAN); \
+                        ILI9341DrawString(5, 5, "Pipeline 123", &font_22, ILI9341_BLACK, ILI9341_YELLOW); \
+                        ILI9341DrawIcon(180, 10, 0, &icon_30, ILI9341_BLUE, ILI9341_WHITE); \
+                        ILI9341DrawPicture(20, 180, 50, 40, picture); \
+                        ILI9341FramebufferEnable(framebuffer, 0, 100, ILI9341_WIDTH, BAND_HEIGHT); \
+                        ILI9341DrawFilledRectangle(0, 100, 239, 139, ILI9341_NAVY); \
+                        ILI9341DrawInt(60, 105, 4567, 4, &font_30, ILI9341_WHITE, ILI9341_NAVY); \
+                        ILI9341FramebufferDisable(); \
+                    }while(0)
+/*==================[internal data declaration]==============================*/
+static uint16_t reference[ILI9341_HEIGHT][ILI9341_WIDTH];
+static uint16_t framebuffer[ILI9341_WIDTH * BAND_HEIGHT];
+static uint8_t picture[50 * 40 * 2];
+static uint8_t dma[3 * ILI9341_MAX_BURST] __attribute__((aligned(4)));
+static uint32_t empty_calls;
+/*==================[internal functions definition]==========================*/
+static void QueueEmpty(void * param){
+    (*(uint32_t *)param)++;
+}
+
+static void Report(const char * name){
+    printf("  %-20s %4u transactions (%4u queued) %7u bytes %4u SpiInit\n", name,
+           (unsigned)panel_model.transactions, (unsigned)panel_model.queued,
+           (unsigned)panel_model.bytes, (unsigned)panel_model.spi_inits);
+}
+
+static void TestFill(void){
+    uint32_t prev_transactions;
+    printf("Full screen fill:\n");
+    PanelModelReset();
+    PrevILI9341Fill(ILI9341_RED);
+    prev_transactions = panel_model.transactions;
+    Report("previous driver");
+    CHECK(panel_model.spi_inits > 600);
+    /* The previous SpiInit() calls took the device callback: register it again */
+    ILI9341Init(SPI_1, PANEL_MODEL_DC, GPIO_1);
+    ILI9341Rotate(ILI9341GetOrientation());
+    PanelModelReset();
+    ILI9341Fill(ILI9341_BLUE);
+    Report("blocking 4092");
+    CHECK(panel_model.spi_inits == 0);
+    CHECK(panel_model.queued == 0);
+    CHECK(panel_model.transactions < prev_transactions / 10);
+    /* Window of the screen size, not one pixel larger */
+    CHECK(panel_model.bytes == ILI9341_WIDTH * ILI9341_HEIGHT * 2 + WINDOW_BYTES);
+    for(uint16_t y = 0; y < ILI9341_HEIGHT; y++){
+        for(uint16_t x = 0; x < ILI9341_WIDTH; x++){
+            reference[y][x] = ILI9341_GREEN;
+        }
+    }
+    ILI9341PipelineEnable(dma, ILI9341_MAX_BURST, 2, QueueEmpty, &empty_calls);
+    PanelModelReset();
+    empty_calls = 0;
+    ILI9341Fill(ILI9341_GREEN);
+    /* Fill returns with the last burst still on the wire */
+    CHECK(SpiQueuedPending(SPI_1) > 0);
+    ILI9341PipelineWait();
+    CHECK(SpiQueuedPending(SPI_1) == 0);
+    Report("pipeline 2x4092");
+    CHECK(PanelModelDiff(reference) == 0);
+    CHECK(panel_model.queued == (ILI9341_WIDTH * ILI9341_HEIGHT * 2 + ILI9341_MAX_BURST - 1) / ILI9341_MAX_BURST);
+    CHECK(empty_calls >= 1);
+    ILI9341PipelineDisable();
+}
+
+static void TestScene(void){
+    static const struct {
+        uint16_t size;
+        uint8_t n;
+    } pipelines[] = {{ILI9341_MAX_BURST, 2}, {2048, 3}, {1000, 2}, {256, 2}};
+    printf("Test scene:\n");
+    PanelModelReset();
+    SCENE();
+    memcpy(reference, panel_model.gram, sizeof(reference));
+    Report("blocking 4092");
+    for(uint8_t i = 0; i < sizeof(pipelines) / sizeof(pipelines[0]); i++){
+        char name[24];
+        ILI9341PipelineEnable(dma, pipelines[i].size, pipelines[i].n, NULL, NULL);
+        PanelModelReset();
+        SCENE();
+        ILI9341PipelineDisable();
+        CHECK(SpiQueuedPending(SPI_1) == 0);
+        CHECK(PanelModelDiff(reference) == 0);
+        CHECK(panel_model.queued > 0);
+        snprintf(name, sizeof(name), "pipeline %dx%d", pipelines[i].n, pipelines[i].size);
+        Report(name);
+    }
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+    for(uint16_t i = 0; i < sizeof(picture); i++){
+        picture[i] = i * 7;
+    }
+    PrevILI9341Init(SPI_1, PANEL_MODEL_DC, GPIO_1);
+    TestFill();
+    TestScene();
+    CHECK(panel_model.errors == 0);
+    printf("panel model errors: %u\n", (unsigned)panel_model.errors);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
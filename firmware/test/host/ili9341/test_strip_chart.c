@@ -0,0 +1,252 @@
+/**
+ * @file test_strip_chart.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and SPI traffic of the strip chart widget
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Two signals at 1 kHz are plotted at 250 columns/s in scroll mode (Landscape_1 and
+ * Landscape_2, full height) and in sweep mode (portrait, partial height). The span of the
+ * top trace on every displayed column is compared with an independent min/max envelope
+ * model. In landscape the displayed image is taken from the panel model with vertical
+ * scrolling applied. A scrolling chart initialized again in sweep mode must release
+ * the hardware scrolling.
+ * Usage: test_strip_chart [runs]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "host_test.h"
+#include "panel_model.h"
+#include "ili9341.h"
+#include "strip_chart.h"
+/*==================[macros and definitions]=================================*/
+#define SAMPLES         3000        /* Samples of each signal */
+#define DECIMATION      4           /* 1000 samples/s, 250 columns/s */
+#define COLUMNS         (SAMPLES / DECIMATION)
+#define TRACE           1           /* Trace checked (drawn over the other one) */
+#define BENCH_RUNS      20          /* Default runs of the signal in the benchmark */
+/*==================[internal data declaration]==============================*/
+static strip_chart_t chart;
+static uint16_t view[ILI9341_WIDTH][ILI9341_HEIGHT];
+static int16_t signal[SAMPLES][2];
+static int16_t env_low[COLUMNS], env_high[COLUMNS];
+static const strip_chart_config_t base = {
+    .x = 10, .y = 0, .width = 300, .height = 240, .sample_frec = 1000, .column_frec = 250, .n_traces = 2,
+    .color = {ILI9341_BLUE, ILI9341_RED}, .background = ILI9341_BLACK, .grid_color = ILI9341_DARKGREY,
+    .grid_x = 25, .grid_y = 40, .autoscale = false, .min = -1000, .max = 1500
+};
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Envelope model: each column spans its samples and the last sample of the previous one
+ */
+static void Envelope(void){
+    int16_t last = signal[0][TRACE];
+    for(uint16_t col = 0; col < COLUMNS; col++){
+        env_low[col] = env_high[col] = last;
+        for(uint16_t s = col * DECIMATION; s < (col + 1) * DECIMATION; s++){
+            env_low[col] = (signal[s][TRACE] < env_low[col]) ? signal[s][TRACE] : env_low[col];
+            env_high[col] = (signal[s][TRACE] > env_high[col]) ? signal[s][TRACE] : env_high[col];
+            last = signal[s][TRACE];
+        }
+    }
+}
+
+/**
+ * @brief Chart row of a value (row 0 at the top)
+ */
+static int16_t Row(int16_t value, const strip_chart_config_t * config){
+    int32_t span = config->max - config->min;
+    int32_t r = ((value - config->min) * (config->height - 1) + span / 2) / span;
+    r = (r < 0) ? 0 : (r > config->height - 1) ? config->height - 1 : r;
+    return config->height - 1 - r;
+}
+
+/**
+ * @brief Compare the top trace of every chart column with the envelope model
+ *
+ * @param scroll    Chart scrolls (the newest column at the right edge), otherwise it sweeps
+ * @return uint32_t Mismatching columns
+ */
+static uint32_t Compare(const strip_chart_config_t * config, bool scroll){
+    uint32_t bad = 0;
+    bool landscape = (ILI9341GetOrientation() == ILI9341_Landscape_1) ||
+                     (ILI9341GetOrientation() == ILI9341_Landscape_2);
+    if(landscape){
+        PanelModelView(view);
+    }
+    for(uint16_t c = 0; c < config->width; c++){
+        int32_t col;
+        int16_t top = -1, bottom = -1;
+        if(scroll){
+            col = COLUMNS - config->width + c;
+        }else{
+            /* Column ring written left to right, blank column ahead of the newest one */
+            col = c + ((COLUMNS - 1 - c) / config->width) * config->width;
+            if(c == COLUMNS % config->width){
+                col = -1;
+            }
+        }
+        for(uint16_t y = 0; y < config->height; y++){
+            uint16_t x_lcd = config->x + c, y_lcd = config->y + y;
+            uint16_t pixel = landscape ? view[y_lcd][x_lcd] : panel_model.gram[y_lcd][x_lcd];
+            if(pixel == config->color[TRACE]){
+                top = (top < 0) ? y : top;
+                bottom = y;
+            }
+        }
+        if(col < 0){
+            bad += (top >= 0);
+        }else if((top != Row(env_high[col], config)) || (bottom != Row(env_low[col], config))){
+            if(bad < 3){
+                printf("  column %u (#%d): rows %d..%d, expected %d..%d\n", c, (int)col, top, bottom,
+                       Row(env_high[col], config), Row(env_low[col], config));
+            }
+            bad++;
+        }
+    }
+    return bad;
+}
+
+static void Plot(const char * name, const strip_chart_config_t * config, bool scroll){
+    uint32_t bad;
+    memset(panel_model.gram, 0, sizeof(panel_model.gram));
+    CHECK(StripChartInit(&chart, config));
+    CHECK(chart.scroll == scroll);
+    PanelModelResetCount();
+    for(uint16_t i = 0; i < SAMPLES; i++){
+        StripChartAddSample(&chart, signal[i]);
+    }
+    CHECK(chart.columns == COLUMNS);
+    bad = Compare(config, scroll);
+    CHECK(bad == 0);
+    printf("%-20s %u columns checked, %u mismatches, per column: %.1f transactions, %.0f bytes\n", name,
+           config->width, (unsigned)bad, (double)panel_model.transactions / COLUMNS,
+           (double)panel_model.bytes / COLUMNS);
+}
+
+static void TestModes(void){
+    strip_chart_config_t config = base;
+    ILI9341Rotate(ILI9341_Landscape_1);
+    Plot("Landscape_1 scroll", &config, true);
+    CHECK(panel_model.scroll_top + panel_model.scroll_lines <= ILI9341_HEIGHT);
+    StripChartDeinit(&chart);
+    ILI9341Rotate(ILI9341_Landscape_2);
+    Plot("Landscape_2 scroll", &config, true);
+    StripChartDeinit(&chart);
+    CHECK((panel_model.scroll_top == 0) && (panel_model.scroll_lines == ILI9341_HEIGHT));
+    CHECK(panel_model.scroll_start == 0);
+    ILI9341Rotate(ILI9341_Portrait_1);
+    config.x = 5;
+    config.y = 40;
+    config.width = 230;
+    config.height = 200;
+    Plot("Portrait sweep", &config, false);
+    StripChartDeinit(&chart);
+    /* Partial height in landscape can't scroll */
+    ILI9341Rotate(ILI9341_Landscape_1);
+    config = base;
+    config.y = 20;
+    config.height = 200;
+    Plot("Landscape_1 sweep", &config, false);
+    StripChartDeinit(&chart);
+}
+
+/**
+ * @brief A scrolling chart initialized again where it can't scroll releases the scrolling
+ */
+static void TestReinit(void){
+    strip_chart_config_t config = base;
+    strip_chart_t other;
+    uint32_t cmds;
+    ILI9341Rotate(ILI9341_Landscape_1);
+    Plot("Landscape_1 scroll", &config, true);
+    CHECK(panel_model.scroll_start != 0);
+    config.y = 20;
+    config.height = 200;
+    Plot("again, sweep", &config, false);
+    CHECK((panel_model.scroll_top == 0) && (panel_model.scroll_lines == ILI9341_HEIGHT));
+    CHECK(panel_model.scroll_start == 0);
+    /* Another chart can scroll now */
+    CHECK(StripChartInit(&other, &base));
+    CHECK(other.scroll);
+    StripChartDeinit(&other);
+    StripChartDeinit(&chart);
+    /* Areas that don't fit the frame memory are rejected */
+    cmds = panel_model.scroll_cmds;
+    CHECK(ILI9341ScrollArea(100, ILI9341_HEIGHT - 99) == 0);
+    CHECK(ILI9341ScrollArea(ILI9341_HEIGHT, 0xFFFF) == 0);
+    CHECK(panel_model.scroll_cmds == cmds);
+    CHECK(ILI9341ScrollArea(100, ILI9341_HEIGHT - 100) == 1);
+    ILI9341ScrollDisable();
+}
+
+/**
+ * @brief Amplitude grows from 10 to 2400, then drops to 200
+ */
+static void TestAutoscale(void){
+    strip_chart_config_t config = base;
+    uint32_t changes = 0, clipped = 0;
+    int16_t min, max;
+    config.autoscale = true;
+    config.min = 0;
+    config.max = 0;
+    ILI9341Rotate(ILI9341_Landscape_1);
+    CHECK(StripChartInit(&chart, &config));
+    min = chart.min;
+    max = chart.max;
+    for(uint32_t i = 0; i < 20000; i++){
+        double amplitude = (i < 8000) ? 10 + i * 0.3 : 200;
+        int16_t v[2] = {(int16_t)(amplitude * sin(i * 0.02)), (int16_t)(amplitude * 0.5 * cos(i * 0.03))};
+        StripChartAddSample(&chart, v);
+        if((chart.min != min) || (chart.max != max)){
+            changes++;
+            min = chart.min;
+            max = chart.max;
+        }
+        clipped += (i >= 8000) && ((v[0] < chart.min) || (v[0] > chart.max));
+    }
+    /* The range doubles when exceeded and shrinks once per chart width */
+    CHECK(changes < 20);
+    CHECK(clipped == 0);
+    CHECK((chart.max >= 200) && (chart.max < 4 * 200) && (chart.min <= -200) && (chart.min > -4 * 200));
+    printf("autoscale: %u range changes, final range %d..%d\n", (unsigned)changes, chart.min, chart.max);
+    StripChartDeinit(&chart);
+}
+
+static void Benchmark(uint32_t runs){
+    double t;
+    ILI9341Rotate(ILI9341_Landscape_1);
+    StripChartInit(&chart, &base);
+    panel_model.off = true;
+    HOST_BENCH(t, 5, runs, {
+        for(uint16_t i = 0; i < SAMPLES; i++){
+            StripChartAddSample(&chart, signal[i]);
+        }
+    });
+    panel_model.off = false;
+    StripChartDeinit(&chart);
+    printf("host CPU: %.3f us per sample, 2 traces, scroll mode (best of 5 runs)\n", t / SAMPLES);
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char *argv[]){
+    uint32_t runs = (argc > 1) ? strtoul(argv[1], NULL, 0) : BENCH_RUNS;
+    for(uint16_t i = 0; i < SAMPLES; i++){
+        signal[i][0] = (int16_t)(800 * sin(i * 0.013));
+        signal[i][1] = (int16_t)(500 * sin(i * 0.05) + ((i % 250) < 6 ? 900 : 0));
+    }
+    Envelope();
+    ILI9341Init(SPI_1, PANEL_MODEL_DC, GPIO_1);
+    TestModes();
+    TestReinit();
+    TestAutoscale();
+    Benchmark(runs);
+    CHECK(panel_model.errors == 0);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,265 @@
+/**
+ * @file mpu_model.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Software model of the MPU6050 registers and FIFO on virtual time (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Transactions are counted as on the bus: I2C_readBytes() writes the register address and
+ * reads in two transactions (STOP in between), I2C_readBurst() uses a repeated start.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include "mpu_model.h"
+#include "mpu6050.h"
+#include "timer_mcu.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+/*==================[macros and definitions]=================================*/
+#define FRAME_SIZE          12
+#define FIFO_EN_STREAM      0x78    /* XG, YG, ZG and ACCEL */
+#define POLL_US             50      /* Time step while a task waits */
+/*==================[internal data declaration]==============================*/
+static uint8_t fifo[MPU_MODEL_FIFO_SIZE];
+static uint16_t fifo_head, fifo_count;
+static uint64_t next_sample;
+static void (*data_ready)(void *);
+static uint32_t notifications;
+/*==================[external data definition]===============================*/
+mpu_model_t mpu_model;
+/*==================[internal functions definition]==========================*/
+static uint32_t SamplePeriod(void){
+    uint8_t dlpf = mpu_model.regs[MPU6050_RA_CONFIG] & 0x07;
+    uint32_t gyro_rate = (dlpf == 0 || dlpf == 7) ? 8000 : 1000;
+    return 1000000 / (gyro_rate / (mpu_model.regs[MPU6050_RA_SMPLRT_DIV] + 1));
+}
+
+static void FifoPush(uint8_t byte){
+    if(fifo_count == MPU_MODEL_FIFO_SIZE){
+        fifo_head = (fifo_head + 1) % MPU_MODEL_FIFO_SIZE;
+        fifo_count--;
+    }
+    fifo[(fifo_head + fifo_count) % MPU_MODEL_FIFO_SIZE] = byte;
+    fifo_count++;
+}
+
+static uint8_t ReadRegister(uint8_t reg){
+    if(reg == MPU6050_RA_FIFO_COUNTH){
+        return fifo_count >> 8;
+    }
+    if(reg == MPU6050_RA_FIFO_COUNTL){
+        return fifo_count & 0xFF;
+    }
+    if(reg >= MPU6050_RA_ACCEL_XOUT_H && reg <= MPU6050_RA_GYRO_ZOUT_L){
+        uint8_t frame[FRAME_SIZE + 2];
+        MpuModelFrame(mpu_model.samples, frame);
+        /* Temperature (2 bytes) sits between accel and gyro */
+        reg -= MPU6050_RA_ACCEL_XOUT_H;
+        return (reg < 6) ? frame[reg] : (reg < 8) ? 0 : frame[reg - 2];
+    }
+    return mpu_model.regs[reg & 0x7F];
+}
+
+static void WriteRegister(uint8_t reg, uint8_t value){
+    if(reg == MPU6050_RA_USER_CTRL && (value & (1 << MPU6050_USERCTRL_FIFO_RESET_BIT))){
+        fifo_count = 0;
+        value &= ~(1 << MPU6050_USERCTRL_FIFO_RESET_BIT);
+    }
+    mpu_model.regs[reg & 0x7F] = value;
+}
+/*==================[external functions definition]==========================*/
+void MpuModelFrame(uint32_t sample, uint8_t * frame){
+    int16_t v[6] = {(int16_t)sample, (int16_t)-sample, (int16_t)(16384 + (sample & 0xFFFF) % 7),
+                    (int16_t)(sample * 3), (int16_t)(0x8000 ^ sample), (int16_t)(sample * 7919)};
+    for(uint8_t i = 0; i < 6; i++){
+        frame[2 * i] = (uint16_t)v[i] >> 8;
+        frame[2 * i + 1] = v[i] & 0xFF;
+    }
+}
+
+void MpuModelAdvance(uint64_t us){
+    uint64_t until = mpu_model.now_us + us;
+    if(next_sample < mpu_model.now_us){
+        next_sample = mpu_model.now_us;
+    }
+    while(next_sample <= until){
+        mpu_model.now_us = next_sample;
+        next_sample += SamplePeriod();
+        mpu_model.samples++;
+        if((mpu_model.regs[MPU6050_RA_USER_CTRL] & (1 << MPU6050_USERCTRL_FIFO_EN_BIT)) &&
+            mpu_model.regs[MPU6050_RA_FIFO_EN] == FIFO_EN_STREAM){
+            uint8_t frame[FRAME_SIZE];
+            MpuModelFrame(mpu_model.samples, frame);
+            for(uint8_t i = 0; i < FRAME_SIZE; i++){
+                FifoPush(frame[i]);
+            }
+        }
+        if((mpu_model.regs[MPU6050_RA_INT_ENABLE] & (1 << MPU6050_INTERRUPT_DATA_RDY_BIT)) && data_ready != NULL){
+            data_ready(NULL);
+        }
+    }
+    mpu_model.now_us = until;
+}
+
+/* i2c_mcu */
+int8_t I2C_readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data, uint16_t timeout){
+    mpu_model.transactions += 2;
+    mpu_model.bus_bytes += 3 + length;
+    for(uint8_t i = 0; i < length; i++){
+        data[i] = ReadRegister(regAddr + i);
+    }
+    return length;
+}
+
+uint16_t I2C_readBurst(uint8_t devAddr, uint8_t regAddr, uint16_t length, uint8_t *data, uint16_t timeout){
+    mpu_model.transactions++;
+    mpu_model.bus_bytes += 3 + length;
+    for(uint16_t i = 0; i < length; i++){
+        if(regAddr != MPU6050_RA_FIFO_R_W){
+            data[i] = ReadRegister(regAddr + i);
+        } else if(fifo_count == 0){
+            printf("FIFO read past its count\n");
+            return i;
+        } else{
+            data[i] = fifo[fifo_head];
+            fifo_head = (fifo_head + 1) % MPU_MODEL_FIFO_SIZE;
+            fifo_count--;
+        }
+    }
+    return length;
+}
+
+int8_t I2C_readByte(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t timeout){
+    return I2C_readBytes(devAddr, regAddr, 1, data, timeout);
+}
+
+int8_t I2C_readWord(uint8_t devAddr, uint8_t regAddr, uint16_t *data, uint16_t timeout){
+    uint8_t bytes[2];
+    I2C_readBytes(devAddr, regAddr, 2, bytes, timeout);
+    *data = (bytes[0] << 8) | bytes[1];
+    return 1;
+}
+
+int8_t I2C_readBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t *data, uint16_t timeout){
+    I2C_readByte(devAddr, regAddr, data, timeout);
+    *data = (*data >> bitNum) & 0x01;
+    return 1;
+}
+
+int8_t I2C_readBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t *data, uint16_t timeout){
+    I2C_readByte(devAddr, regAddr, data, timeout);
+    *data = (*data >> (bitStart - length + 1)) & ((1 << length) - 1);
+    return 1;
+}
+
+bool I2C_writeByte(uint8_t devAddr, uint8_t regAddr, uint8_t data){
+    mpu_model.transactions++;
+    mpu_model.bus_bytes += 3;
+    WriteRegister(regAddr, data);
+    return true;
+}
+
+bool I2C_writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data){
+    mpu_model.transactions++;
+    mpu_model.bus_bytes += 2 + length;
+    for(uint8_t i = 0; i < length; i++){
+        WriteRegister(regAddr + i, data[i]);
+    }
+    return true;
+}
+
+bool I2C_writeWord(uint8_t devAddr, uint8_t regAddr, uint16_t data){
+    uint8_t bytes[2] = {data >> 8, data & 0xFF};
+    return I2C_writeBytes(devAddr, regAddr, 2, bytes);
+}
+
+bool I2C_writeBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t data){
+    uint8_t value;
+    I2C_readByte(devAddr, regAddr, &value, 0);
+    value = data ? (value | (1 << bitNum)) : (value & ~(1 << bitNum));
+    return I2C_writeByte(devAddr, regAddr, value);
+}
+
+bool I2C_writeBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t data){
+    uint8_t value, mask = ((1 << length) - 1) << (bitStart - length + 1);
+    I2C_readByte(devAddr, regAddr, &value, 0);
+    value = (value & ~mask) | ((data << (bitStart - length + 1)) & mask);
+    return I2C_writeByte(devAddr, regAddr, value);
+}
+
+void I2C_SelectRegister(uint8_t devAddr, uint8_t reg){
+    mpu_model.transactions++;
+    mpu_model.bus_bytes += 2;
+}
+
+/* Command link API (MPU6050_ReadRegister()): not modelled */
+i2c_cmd_handle_t i2c_cmd_link_create(void){
+    return NULL;
+}
+
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd_handle){
+}
+
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd_handle){
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd_handle){
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd_handle, uint8_t data, bool ack_en){
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd_handle, uint8_t *data, size_t data_len, i2c_ack_type_t ack){
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_read_byte(i2c_cmd_handle_t cmd_handle, uint8_t *data, i2c_ack_type_t ack){
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, uint32_t ticks_to_wait){
+    return ESP_OK;
+}
+
+/* gpio_mcu (INT pin) */
+void GPIOInit(gpio_t pin, io_t io){
+}
+
+void GPIOActivInt(gpio_t pin, void *ptr_int_func, bool edge, void *args){
+    data_ready = (void (*)(void *))ptr_int_func;
+}
+
+void GPIODeactivInt(gpio_t pin){
+    data_ready = NULL;
+}
+
+/* timer_mcu */
+uint64_t TimerGetTimestamp(void){
+    return mpu_model.now_us;
+}
+
+/* Consumer task notifications */
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_task_woken){
+    notifications++;
+    *higher_priority_task_woken = pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks){
+    uint64_t timeout = mpu_model.now_us + (uint64_t)ticks * portTICK_PERIOD_MS * 1000;
+    while(notifications == 0 && mpu_model.now_us < timeout){
+        MpuModelAdvance(POLL_US);
+    }
+    uint32_t value = notifications;
+    if(clear_on_exit){
+        notifications = 0;
+    }
+    return value;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,54 @@
+/**
+ * @file mpu_model.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Software model of the MPU6050 registers and FIFO on virtual time (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Implements the i2c_mcu functions used by the driver, the data ready interrupt (gpio_mcu),
+ * TimerGetTimestamp() and the task notifications. At the sample rate set by SMPLRT_DIV and
+ * CONFIG a 12 bytes frame is appended to the 1024 bytes FIFO (the oldest bytes are
+ * overwritten when it is full) and the data ready interrupt runs. Frames encode the sample
+ * number (see MpuModelFrame()). Waiting for a notification advances the virtual time.
+ */
+#ifndef MPU_MODEL_H_
+#define MPU_MODEL_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define MPU_MODEL_FIFO_SIZE     1024    /*!< FIFO size (bytes) */
+/*==================[typedef]================================================*/
+/**
+ * @brief Model state
+ */
+typedef struct {
+    uint8_t regs[128];          /*!< Registers */
+    uint64_t now_us;            /*!< Virtual time */
+    uint32_t samples;           /*!< Samples taken */
+    uint32_t transactions;      /*!< I2C transactions (START to STOP) */
+    uint32_t bus_bytes;         /*!< Bytes on the bus (addresses included) */
+} mpu_model_t;
+/*==================[external data declaration]==============================*/
+extern mpu_model_t mpu_model;
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Bytes of the FIFO frame of a sample (big endian accel X, Y, Z, gyro X, Y, Z)
+ *
+ * @param sample        Sample number (accel X holds its 16 lower bits)
+ * @param frame         12 bytes
+ */
+void MpuModelFrame(uint32_t sample, uint8_t * frame);
+
+/**
+ * @brief Advance the virtual time, taking the samples due
+ *
+ * @param us            Time to advance
+ */
+void MpuModelAdvance(uint64_t us);
+
+#endif /* MPU_MODEL_H_ */
+/*==================[end of file]============================================*/
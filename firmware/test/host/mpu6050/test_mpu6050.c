@@ -0,0 +1,151 @@
+/**
+ * @file test_mpu6050.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of the MPU6050 FIFO parser and burst streaming
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Parser: FIFO bytes captured from a board at rest (+Z up), int16 extremes, a trailing
+ * partial frame and the capacity of the frames buffer.
+ * Stream: 1 kHz samples from the register and FIFO model, the consumer task is delayed
+ * 20 ms (10 % of the reads, the FIFO holds 85 ms) or 150 ms (0.5 %, the FIFO overflows).
+ * Frames read must keep the sample sequence outside overflows, and frames read plus frames
+ * reported lost must add up to the samples taken. I2C transactions per sample are compared
+ * with MPU6050_getMotion6(). Usage: test_mpu6050 [seconds]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "mpu_model.h"
+#include "mpu6050.h"
+/*==================[macros and definitions]=================================*/
+#define SECONDS         30      /* Default stream time per burst size */
+#define RATE            1000    /* Samples per second */
+/*==================[internal data declaration]==============================*/
+static mpu6050_frames_t frames;
+
+/* FIFO bytes captured from a board at rest, the third frame edited to the int16 extremes */
+static const uint8_t capture[] = {
+    0x00, 0x9C, 0xFF, 0x38, 0x40, 0x2E, 0xFF, 0xF0, 0x00, 0x12, 0xFF, 0xFB,
+    0x00, 0xA4, 0xFF, 0x30, 0x40, 0x1A, 0xFF, 0xEE, 0x00, 0x15, 0xFF, 0xFA,
+    0x80, 0x00, 0x7F, 0xFF, 0x3F, 0xF2, 0x00, 0x01, 0x7F, 0xFF, 0x80, 0x00,
+    0x12, 0x34, 0x56,   /* Incomplete frame */
+};
+static const int16_t expected[3][6] = {
+    {156, -200, 16430, -16, 18, -5},
+    {164, -208, 16410, -18, 21, -6},
+    {-32768, 32767, 16370, 1, 32767, -32768},
+};
+/*==================[internal functions definition]==========================*/
+static bool FrameIs(const mpu6050_frames_t * f, uint16_t i, const int16_t * v){
+    return f->ax[i] == v[0] && f->ay[i] == v[1] && f->az[i] == v[2] &&
+           f->gx[i] == v[3] && f->gy[i] == v[4] && f->gz[i] == v[5];
+}
+
+static void TestParser(void){
+    static uint8_t bytes[100 * MPU6050_FIFO_FRAME_SIZE];
+
+    frames.count = 0;
+    CHECK(MPU6050_parseFIFO(capture, sizeof(capture), &frames) == 3);
+    CHECK(frames.count == 3);
+    for(uint8_t i = 0; i < 3; i++){
+        CHECK(FrameIs(&frames, i, expected[i]));
+    }
+    /* Frames are appended up to the capacity */
+    for(uint16_t i = 0; i < sizeof(bytes); i++){
+        bytes[i] = i * 37;
+    }
+    frames.count = 80;
+    CHECK(MPU6050_parseFIFO(bytes, sizeof(bytes), &frames) == MPU6050_STREAM_FRAMES - 80);
+    CHECK(frames.count == MPU6050_STREAM_FRAMES);
+    CHECK(frames.ax[80] == (int16_t)((bytes[0] << 8) | bytes[1]));
+    CHECK(frames.gz[84] == (int16_t)((bytes[4 * 12 + 10] << 8) | bytes[4 * 12 + 11]));
+    frames.count = 0;
+    CHECK(MPU6050_parseFIFO(bytes, MPU6050_FIFO_FRAME_SIZE - 1, &frames) == 0);
+}
+
+static double TestStream(uint8_t burst, uint32_t seconds){
+    mpu6050_stream_config_t config = {
+        .rate = RATE,
+        .dlpf = MPU6050_DLPF_BW_188,
+        .int_pin = GPIO_1,
+        .burst = burst,
+        .consumer = (void *)1,
+    };
+    uint32_t next = 0, read = 0, misaligned = 0, gaps = 0, overflows = 0;
+    uint64_t end;
+
+    srand(1);
+    mpu_model.samples = 0;
+    mpu_model.transactions = 0;
+    CHECK(MPU6050_startStream(&config));
+    uint32_t setup = mpu_model.transactions;
+    end = mpu_model.now_us + (uint64_t)seconds * 1000000;
+    while(mpu_model.now_us < end){
+        CHECK(MPU6050_waitStream(100));
+        int delay = rand() % 200;
+        if(delay == 0){
+            MpuModelAdvance(150000);
+        } else if(delay < 20){
+            MpuModelAdvance(20000);
+        }
+        MPU6050_readStream(&frames);
+        if(frames.overflow){
+            overflows++;
+            next = 0;
+            continue;
+        }
+        for(uint16_t i = 0; i < frames.count; i++){
+            /* Accel X holds the sample number */
+            uint16_t sample = frames.ax[i];
+            uint8_t bytes[MPU6050_FIFO_FRAME_SIZE];
+            mpu6050_frames_t frame = {.count = 0};
+            MpuModelFrame(sample, bytes);
+            MPU6050_parseFIFO(bytes, sizeof(bytes), &frame);
+            if(!(frame.ay[0] == frames.ay[i] && frame.az[0] == frames.az[i] && frame.gx[0] == frames.gx[i] &&
+                 frame.gy[0] == frames.gy[i] && frame.gz[0] == frames.gz[i])){
+                misaligned++;
+                continue;
+            }
+            gaps += (next != 0) && (sample != (uint16_t)next);
+            next = sample + 1;
+            read++;
+        }
+    }
+    MPU6050_stopStream();
+    double per_sample = (double)(mpu_model.transactions - setup) / mpu_model.samples;
+    printf("burst %2u: %u samples, %u read, %u lost, %u overflows, %u misaligned, %u gaps, "
+           "%.3f I2C transactions per sample\n", burst, mpu_model.samples, read, frames.lost, overflows,
+           misaligned, gaps, per_sample);
+    CHECK(misaligned == 0);
+    CHECK(gaps == 0);
+    CHECK(overflows > 0);
+    /* Samples of the last read still in the FIFO at stop */
+    CHECK(read + frames.lost <= mpu_model.samples);
+    CHECK(mpu_model.samples - read - frames.lost <= MPU6050_STREAM_FRAMES);
+    return per_sample;
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char ** argv){
+    uint32_t seconds = (argc > 1) ? strtoul(argv[1], NULL, 10) : SECONDS;
+    int16_t ax, ay, az, gx, gy, gz;
+
+    TestParser();
+    MPU6050_initialize();
+    uint32_t transactions = mpu_model.transactions;
+    MPU6050_getMotion6(&ax, &ay, &az, &gx, &gy, &gz);
+    transactions = mpu_model.transactions - transactions;
+    printf("MPU6050_getMotion6: %u I2C transactions per sample\n", transactions);
+
+    double burst_1 = TestStream(1, seconds);
+    double burst_8 = TestStream(8, seconds);
+    double burst_36 = TestStream(36, seconds);
+    CHECK(burst_1 < transactions);
+    CHECK(burst_8 < burst_1 && burst_36 < burst_8);
+    return HOST_TEST_RESULT();
+}
+/*==================[end of file]============================================*/
@@ -0,0 +1,91 @@
+/**
+ * @file frame_model.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Simulated frame timer and animation task of the NeoPixel animation engine (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The task function never returns: when it would block in ulTaskNotifyTake() the model jumps
+ * back to FrameModelRunTask(), and the next run enters the task function again.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "frame_model.h"
+#include "rmt_model.h"
+#include "timer_mcu.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+/*==================[internal data declaration]==============================*/
+static void (*tick_func)(void *);
+static void * tick_param;
+static TaskFunction_t task_func;
+static uint32_t notifications;
+static jmp_buf task_wait;
+/*==================[external data definition]===============================*/
+frame_model_t frame_model;
+/*==================[external functions definition]==========================*/
+void FrameModelTick(void){
+    if(frame_model.running){
+        frame_model.time_us = frame_model.latency_us;
+        tick_func(tick_param);
+    }
+}
+
+void FrameModelRunTask(void){
+    if(setjmp(task_wait) == 0){
+        task_func(NULL);
+    }
+}
+
+/* timer_mcu */
+void TimerInit(timer_config_t *timer_ini){
+    tick_func = (void (*)(void *))timer_ini->func_p;
+    tick_param = timer_ini->param_p;
+    frame_model.period = timer_ini->period;
+    frame_model.inits++;
+}
+
+void TimerStart(timer_mcu_t timer){
+    frame_model.running = true;
+}
+
+void TimerStop(timer_mcu_t timer){
+    frame_model.running = false;
+}
+
+uint32_t TimerRead(timer_mcu_t timer){
+    uint32_t time = frame_model.time_us;
+    frame_model.time_us += frame_model.read_step_us;
+    return time;
+}
+
+/* freertos/task.h */
+TaskHandle_t xTaskCreateStatic(TaskFunction_t task, const char *name, uint32_t stack, void *param, UBaseType_t priority,
+                               StackType_t *stack_buffer, StaticTask_t *task_buffer){
+    task_func = task;
+    return (TaskHandle_t)task_buffer;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_task_woken){
+    notifications++;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks){
+    if(rmt_model.mutexes_held){
+        printf("frame model: task blocks with a mutex taken\n");
+        frame_model.errors++;
+    }
+    if(notifications == 0){
+        longjmp(task_wait, 1);
+    }
+    uint32_t value = notifications;
+    notifications = clear_on_exit ? 0 : value - 1;
+    return value;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,49 @@
+/**
+ * @file frame_model.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Simulated frame timer and animation task of the NeoPixel animation engine (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * TimerInit() keeps the frame tick callback, that the test calls with FrameModelTick() while
+ * the timer is started. The animation task created with xTaskCreateStatic() runs with
+ * FrameModelRunTask() until it waits for a notification with nothing pending (waiting with a
+ * mutex taken is reported). TimerRead() returns a virtual time that starts at latency_us on
+ * each tick and advances read_step_us on each read.
+ */
+#ifndef FRAME_MODEL_H_
+#define FRAME_MODEL_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[typedef]================================================*/
+/**
+ * @brief Frame timer model state
+ */
+typedef struct {
+    uint32_t period;            /*!< Timer period set by TimerInit() (us) */
+    uint32_t inits;             /*!< Calls to TimerInit() */
+    bool running;               /*!< Timer started */
+    uint32_t time_us;           /*!< Timer count */
+    uint32_t latency_us;        /*!< Timer count when the task wakes up after a tick */
+    uint32_t read_step_us;      /*!< Timer count increment after each TimerRead() */
+    uint32_t errors;            /*!< Misuses detected */
+} frame_model_t;
+/*==================[external data declaration]==============================*/
+extern frame_model_t frame_model;
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Run the timer callback once (nothing happens if the timer is stopped)
+ */
+void FrameModelTick(void);
+
+/**
+ * @brief Run the animation task until it waits with no notifications pending
+ */
+void FrameModelRunTask(void);
+
+#endif /* FRAME_MODEL_H_ */
+/*==================[end of file]============================================*/
@@ -0,0 +1,58 @@
+/**
+ * @file neopixel_prev.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief NeoPixel stripe and WS2812B driver before the gamma and brightness table (reference
+ * for the host benchmark)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef NEOPIXEL_PREV_H_
+#define NEOPIXEL_PREV_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "ws2812b.h"
+#include "neopixel_stripe.h"
+/*==================[external functions declaration]=========================*/
+uint8_t PrevWs2812bGammaCorrection(uint8_t component);
+
+void PrevWs2812bInit(gpio_t pin);
+
+void PrevWs2812bSetCallback(void *func_p, void *param_p);
+
+void PrevWs2812bSend(rgb_led_t led_color);
+
+void PrevWs2812bSendRet(void);
+
+void PrevWs2812bWait(void);
+
+void PrevNeoPixelInit(gpio_t pin, uint16_t len, neopixel_color_t *color_array);
+
+void PrevNeoPixelAllOff(void);
+
+void PrevNeoPixelAllColor(neopixel_color_t color);
+
+void PrevNeoPixelSetPixel(uint16_t pixel, neopixel_color_t color);
+
+void PrevNeoPixelSetArray(neopixel_color_t *color_array);
+
+void PrevNeoPixelSetCallback(void *func_p, void *param_p);
+
+void PrevNeoPixelWait(void);
+
+void PrevNeoPixelShift(bool upwards);
+
+void PrevNeoPixelBrightness(uint8_t bright);
+
+void PrevNeoPixelRainbow(uint16_t first_hue, uint8_t sat, uint8_t val, uint8_t reps);
+
+neopixel_color_t PrevNeoPixelRgb2Color(uint8_t red, uint8_t green, uint8_t blue);
+
+neopixel_color_t PrevNeoPixelHSV2Color(uint16_t hue, uint8_t sat, uint8_t val);
+
+#endif /* NEOPIXEL_PREV_H_ */
+/*==================[end of file]============================================*/
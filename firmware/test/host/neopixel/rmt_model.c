@@ -0,0 +1,307 @@
+/**
+ * @file rmt_model.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Software model of the ESP-IDF RMT TX driver (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Also models the FreeRTOS binary semaphore the driver waits on: a blocking take lets the
+ * "hardware" finish the oldest frame, and a take with nothing pending is reported (it would
+ * block forever on target). Any other semaphore is a mutex of a single task: taking it twice
+ * or giving it while not taken is reported.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <string.h>
+#include "rmt_model.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+/*==================[macros and definitions]=================================*/
+#define MAX_ENCODERS    4
+
+typedef struct {
+    rmt_encoder_t base;
+    rmt_bytes_encoder_config_t config;
+    size_t position;
+    bool used;
+} model_encoder_t;
+
+typedef struct {
+    rmt_encoder_t * encoder;
+    const uint8_t * payload;
+    size_t size;
+    uint8_t snapshot[RMT_MODEL_MAX_FRAME];
+} transaction_t;
+/*==================[internal data declaration]==============================*/
+static model_encoder_t encoders[MAX_ENCODERS];
+static transaction_t queue[RMT_MODEL_QUEUE];
+static uint8_t queue_head, queue_pending;
+static size_t mem_free;
+static rmt_tx_done_callback_t done_func;
+static void * done_ctx;
+static bool enabled;
+static int channel;
+static bool semaphore;
+static int binary_tag;      /* storage of the binary semaphores */
+/*==================[external data definition]===============================*/
+rmt_model_t rmt_model;
+/*==================[internal functions definition]==========================*/
+static void Put(rmt_symbol_word_t symbol){
+    if(rmt_model.n_symbols < RMT_MODEL_MAX_SYMBOLS){
+        rmt_model.symbols[rmt_model.n_symbols++] = symbol;
+    }
+    mem_free--;
+}
+
+static size_t BytesEncode(rmt_encoder_t * encoder, rmt_channel_handle_t tx_channel, const void * data,
+                          size_t size, rmt_encode_state_t * state){
+    model_encoder_t * enc = (model_encoder_t *)encoder;
+    const uint8_t * bytes = data;
+    size_t encoded = 0;
+    *state = RMT_ENCODING_RESET;
+    while(enc->position < 8 * size){
+        if(mem_free == 0){
+            *state = RMT_ENCODING_MEM_FULL;
+            return encoded;
+        }
+        uint8_t shift = enc->config.flags.msb_first ? 7 - enc->position % 8 : enc->position % 8;
+        Put(((bytes[enc->position / 8] >> shift) & 1) ? enc->config.bit1 : enc->config.bit0);
+        enc->position++;
+        encoded++;
+    }
+    enc->position = 0;
+    *state = RMT_ENCODING_COMPLETE | ((mem_free == 0) ? RMT_ENCODING_MEM_FULL : 0);
+    return encoded;
+}
+
+static size_t CopyEncode(rmt_encoder_t * encoder, rmt_channel_handle_t tx_channel, const void * data,
+                         size_t size, rmt_encode_state_t * state){
+    model_encoder_t * enc = (model_encoder_t *)encoder;
+    const rmt_symbol_word_t * symbols = data;
+    size_t encoded = 0;
+    *state = RMT_ENCODING_RESET;
+    while(enc->position < size / sizeof(rmt_symbol_word_t)){
+        if(mem_free == 0){
+            *state = RMT_ENCODING_MEM_FULL;
+            return encoded;
+        }
+        Put(symbols[enc->position++]);
+        encoded++;
+    }
+    enc->position = 0;
+    *state = RMT_ENCODING_COMPLETE | ((mem_free == 0) ? RMT_ENCODING_MEM_FULL : 0);
+    return encoded;
+}
+
+static esp_err_t EncoderReset(rmt_encoder_t * encoder){
+    ((model_encoder_t *)encoder)->position = 0;
+    return ESP_OK;
+}
+
+static esp_err_t EncoderDel(rmt_encoder_t * encoder){
+    ((model_encoder_t *)encoder)->used = false;
+    return ESP_OK;
+}
+
+static model_encoder_t * NewEncoder(void){
+    for(uint8_t i = 0; i < MAX_ENCODERS; i++){
+        if(!encoders[i].used){
+            memset(&encoders[i], 0, sizeof(encoders[i]));
+            encoders[i].used = true;
+            encoders[i].base.reset = EncoderReset;
+            encoders[i].base.del = EncoderDel;
+            return &encoders[i];
+        }
+    }
+    printf("rmt model: out of encoders\n");
+    rmt_model.errors++;
+    return NULL;
+}
+
+/* The oldest frame is sent: encoded in refills of one memory block, then the done event */
+static void SendOldest(void){
+    transaction_t * t = &queue[(queue_head + RMT_MODEL_QUEUE - queue_pending) % RMT_MODEL_QUEUE];
+    rmt_tx_done_event_data_t event = {0};
+    rmt_encode_state_t state;
+    memcpy(rmt_model.last_frame, t->payload, t->size);
+    rmt_model.last_size = t->size;
+    if(!rmt_model.fast){
+        if(memcmp(t->payload, t->snapshot, t->size)){
+            printf("rmt model: frame modified while queued\n");
+            rmt_model.errors++;
+        }
+        t->encoder->reset(t->encoder);
+        do{
+            mem_free = RMT_MODEL_REFILL;
+            rmt_model.refills++;
+            t->encoder->encode(t->encoder, (rmt_channel_handle_t)&channel, t->payload, t->size, &state);
+        }while(!(state & RMT_ENCODING_COMPLETE));
+    }
+    queue_pending--;
+    rmt_model.frames++;
+    if(done_func){
+        done_func((rmt_channel_handle_t)&channel, &event, done_ctx);
+    }
+}
+/*==================[external functions definition]==========================*/
+void RmtModelReset(void){
+    rmt_model.n_symbols = 0;
+    rmt_model.frames = 0;
+    rmt_model.refills = 0;
+}
+
+void RmtModelFinish(void){
+    while(queue_pending){
+        SendOldest();
+    }
+}
+
+uint8_t RmtModelPending(void){
+    return queue_pending;
+}
+
+/* driver/rmt_tx.h */
+esp_err_t rmt_new_tx_channel(const rmt_tx_channel_config_t * config, rmt_channel_handle_t * ret_chan){
+    rmt_model.resolution = config->resolution_hz;
+    if(config->mem_block_symbols % RMT_MODEL_REFILL || config->trans_queue_depth > RMT_MODEL_QUEUE){
+        printf("rmt model: memory of %u symbols, queue of %u\n", (unsigned)config->mem_block_symbols,
+               (unsigned)config->trans_queue_depth);
+        rmt_model.errors++;
+    }
+    *ret_chan = (rmt_channel_handle_t)&channel;
+    return ESP_OK;
+}
+
+esp_err_t rmt_new_bytes_encoder(const rmt_bytes_encoder_config_t * config, rmt_encoder_handle_t * ret_encoder){
+    model_encoder_t * enc = NewEncoder();
+    if(enc == NULL){
+        return ESP_ERR_NO_MEM;
+    }
+    enc->config = *config;
+    enc->base.encode = BytesEncode;
+    *ret_encoder = &enc->base;
+    return ESP_OK;
+}
+
+esp_err_t rmt_new_copy_encoder(const rmt_copy_encoder_config_t * config, rmt_encoder_handle_t * ret_encoder){
+    model_encoder_t * enc = NewEncoder();
+    if(enc == NULL){
+        return ESP_ERR_NO_MEM;
+    }
+    enc->base.encode = CopyEncode;
+    *ret_encoder = &enc->base;
+    return ESP_OK;
+}
+
+esp_err_t rmt_encoder_reset(rmt_encoder_handle_t encoder){
+    return encoder->reset(encoder);
+}
+
+esp_err_t rmt_del_encoder(rmt_encoder_handle_t encoder){
+    return encoder->del(encoder);
+}
+
+esp_err_t rmt_tx_register_event_callbacks(rmt_channel_handle_t tx_channel, const rmt_tx_event_callbacks_t * cbs,
+                                          void * user_data){
+    done_func = cbs->on_trans_done;
+    done_ctx = user_data;
+    return ESP_OK;
+}
+
+esp_err_t rmt_enable(rmt_channel_handle_t channel){
+    enabled = true;
+    return ESP_OK;
+}
+
+esp_err_t rmt_disable(rmt_channel_handle_t channel){
+    if(queue_pending){
+        printf("rmt model: disabled with %d frames queued\n", queue_pending);
+        rmt_model.errors++;
+    }
+    enabled = false;
+    return ESP_OK;
+}
+
+esp_err_t rmt_del_channel(rmt_channel_handle_t channel){
+    return ESP_OK;
+}
+
+esp_err_t rmt_transmit(rmt_channel_handle_t tx_channel, rmt_encoder_handle_t encoder, const void * payload,
+                       size_t payload_bytes, const rmt_transmit_config_t * config){
+    if(!enabled || payload_bytes > RMT_MODEL_MAX_FRAME){
+        printf("rmt model: transmit of %u bytes %s\n", (unsigned)payload_bytes, enabled ? "" : "(disabled)");
+        rmt_model.errors++;
+        return ESP_ERR_INVALID_STATE;
+    }
+    if(queue_pending == RMT_MODEL_QUEUE){
+        /* The driver must wait before queueing more frames than the queue depth */
+        printf("rmt model: transmit with the queue full\n");
+        rmt_model.errors++;
+        SendOldest();
+    }
+    transaction_t * t = &queue[queue_head];
+    t->encoder = encoder;
+    t->payload = payload;
+    t->size = payload_bytes;
+    memcpy(t->snapshot, payload, payload_bytes);
+    queue_head = (queue_head + 1) % RMT_MODEL_QUEUE;
+    queue_pending++;
+    return ESP_OK;
+}
+
+/* freertos/semphr.h (binary semaphores given from the done callback, and mutexes) */
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t * buffer){
+    buffer->storage = &binary_tag;
+    return buffer;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t * buffer){
+    buffer->storage = NULL;
+    return buffer;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem){
+    StaticSemaphore_t * mutex = sem;
+    if((mutex->storage == &binary_tag) || (mutex->storage == NULL)){
+        printf("rmt model: give of a mutex not taken (or of the done semaphore)\n");
+        rmt_model.errors++;
+        return pdFALSE;
+    }
+    mutex->storage = NULL;
+    rmt_model.mutexes_held--;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t * higher_priority_task_woken){
+    semaphore = true;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks){
+    StaticSemaphore_t * mutex = sem;
+    if(mutex->storage != &binary_tag){
+        if(mutex->storage != NULL){
+            printf("rmt model: mutex taken twice (deadlock on target)\n");
+            rmt_model.errors++;
+            return pdFALSE;
+        }
+        mutex->storage = mutex;
+        rmt_model.mutexes_held++;
+        return pdTRUE;
+    }
+    if(!semaphore){
+        if(queue_pending == 0){
+            printf("rmt model: take with nothing queued\n");
+            rmt_model.errors++;
+            return pdFALSE;
+        }
+        SendOldest();
+    }
+    semaphore = false;
+    return pdTRUE;
+}
+
+/*==================[end of file]============================================*/
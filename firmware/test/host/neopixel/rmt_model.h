@@ -0,0 +1,65 @@
+/**
+ * @file rmt_model.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Software model of the ESP-IDF RMT TX driver (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Queued frames are sent when the driver blocks on its semaphore or when the test calls
+ * RmtModelFinish(). Each frame is encoded with the driver's encoder in refills of
+ * RMT_MODEL_REFILL symbols, as the RMT ISR does with the ping-pong memory, and the
+ * resulting symbols are logged.
+ */
+#ifndef RMT_MODEL_H_
+#define RMT_MODEL_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "driver/rmt_tx.h"
+#include "ws2812b.h"
+/*==================[macros]=================================================*/
+#define RMT_MODEL_REFILL        48          /*!< Symbols per refill (one memory block) */
+#define RMT_MODEL_QUEUE         4           /*!< Transactions queue depth */
+#define RMT_MODEL_MAX_SYMBOLS   200000      /*!< Symbols logged */
+#define RMT_MODEL_MAX_FRAME     (3 * WS2812B_MAX_LEDS)  /*!< Max. bytes of a frame */
+/*==================[typedef]================================================*/
+/**
+ * @brief RMT model state
+ */
+typedef struct {
+    rmt_symbol_word_t symbols[RMT_MODEL_MAX_SYMBOLS];   /*!< Symbols sent */
+    uint32_t n_symbols;                                 /*!< Symbols logged */
+    uint32_t resolution;                                /*!< Channel resolution (Hz) */
+    uint32_t frames;                                    /*!< Frames sent */
+    uint32_t refills;                                   /*!< Calls to the encoder */
+    uint32_t errors;                                    /*!< Misuses detected */
+    uint8_t last_frame[RMT_MODEL_MAX_FRAME];            /*!< Payload of the last frame sent */
+    uint16_t last_size;                                 /*!< Bytes of the last frame sent */
+    bool fast;                                          /*!< Frames end without being encoded (benchmarks) */
+    uint8_t mutexes_held;                               /*!< Mutexes taken and not given yet */
+} rmt_model_t;
+/*==================[external data declaration]==============================*/
+extern rmt_model_t rmt_model;
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Clear the symbols logged and the counters (errors are kept)
+ */
+void RmtModelReset(void);
+
+/**
+ * @brief Send all the frames queued
+ */
+void RmtModelFinish(void);
+
+/**
+ * @brief Frames queued and not sent yet
+ *
+ * @return uint8_t      Frames pending
+ */
+uint8_t RmtModelPending(void);
+
+#endif /* RMT_MODEL_H_ */
+/*==================[end of file]============================================*/
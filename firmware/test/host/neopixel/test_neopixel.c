@@ -0,0 +1,167 @@
+/**
+ * @file test_neopixel.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of the NeoPixel gamma and brightness table and delta updates
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The same sequence of updates is run with the previous stripe (neopixel_stripe_prev.c and
+ * ws2812b_prev.c) and with the stripe: frames sent must be identical, and updates that
+ * change nothing must not send a frame. A shorter stripe initialized after a shift must
+ * send its colors in order and stay within its array. The benchmark measures the CPU cost
+ * of the updates of a 300 leds stripe (frames end without being encoded: symbols are
+ * generated by the RMT ISR on target). Usage: test_neopixel [updates]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "rmt_model.h"
+#include "neopixel_stripe.h"
+#include "neopixel_prev.h"
+/*==================[macros and definitions]=================================*/
+#define LEDS            300     /* Leds of the stripe */
+#define BENCH_UPDATES   2000    /* Default updates per benchmark case */
+#define STEPS           14      /* Steps of the update sequence */
+#define SHORT           20      /* Leds of the stripe initialized again */
+#define RED             0xFF0000
+#define GREEN           0x00FF00
+#define BLUE            0x0000FF
+
+/* Update sequence, run with any of the stripes (P: function prefix, s: its color array).
+ * Colors are always set through the stripe's own array: with other arrays, SetPixel() after
+ * SetArray() and SetArray() after Shift() changed meaning (see neopixel_stripe.h) */
+#define STEP(P, s, n)   do{ \
+                            switch(n){ \
+                            case 0: memcpy(s, pattern_a, sizeof(s)); P##NeoPixelSetArray(s); break; \
+                            case 1: P##NeoPixelSetPixel(5, RED); break; \
+                            case 2: P##NeoPixelSetPixel(5, RED); break; \
+                            case 3: P##NeoPixelBrightness(60); break; \
+                            case 4: P##NeoPixelBrightness(60); break; \
+                            case 5: P##NeoPixelSetPixel(LEDS - 1, BLUE); break; \
+                            case 6: memcpy(s, pattern_b, sizeof(s)); P##NeoPixelSetArray(s); break; \
+                            case 7: P##NeoPixelSetArray(s); break; \
+                            case 8: P##NeoPixelRainbow(1000, 255, 200, 2); break; \
+                            case 9: P##NeoPixelShift(true); break; \
+                            case 10: P##NeoPixelShift(false); break; \
+                            case 11: P##NeoPixelAllColor(GREEN); break; \
+                            case 12: P##NeoPixelBrightness(255); break; \
+                            case 13: P##NeoPixelAllOff(); break; \
+                            } \
+                        }while(0)
+/*==================[internal data declaration]==============================*/
+static neopixel_color_t stripe[LEDS], prev_stripe[LEDS], pattern_a[LEDS], pattern_b[LEDS];
+static uint8_t expected[STEPS][3 * LEDS];
+static const bool unchanged[STEPS] = {[2] = true, [4] = true, [7] = true};
+static struct {
+    neopixel_color_t colors[SHORT];
+    neopixel_color_t guard[LEDS];   /* Catches writes past the shorter array */
+} short_stripe;
+static neopixel_color_t prev_short[SHORT];
+/*==================[internal functions definition]==========================*/
+static void TestSameFrames(void){
+    PrevNeoPixelInit(GPIO_8, LEDS, prev_stripe);
+    for(uint8_t n = 0; n < STEPS; n++){
+        STEP(Prev, prev_stripe, n);
+        RmtModelFinish();
+        memcpy(expected[n], rmt_model.last_frame, sizeof(expected[n]));
+    }
+    NeoPixelInit(GPIO_8, LEDS, stripe);
+    for(uint8_t n = 0; n < STEPS; n++){
+        uint32_t frames = rmt_model.frames;
+        STEP(, stripe, n);
+        RmtModelFinish();
+        CHECK(memcmp(expected[n], rmt_model.last_frame, sizeof(expected[n])) == 0);
+        CHECK((rmt_model.frames == frames) == unchanged[n]);
+    }
+}
+
+/**
+ * @brief A shorter stripe initialized after a shift starts from its first color
+ */
+static void TestReinit(void){
+    uint8_t frame[3 * SHORT];
+    uint32_t guard_changes = 0;
+    NeoPixelInit(GPIO_8, LEDS, stripe);
+    NeoPixelShift(true);
+    RmtModelFinish();
+    for(uint16_t i = 0; i < SHORT; i++){
+        short_stripe.colors[i] = prev_short[i] = pattern_a[i * 7];
+    }
+    PrevNeoPixelInit(GPIO_8, SHORT, prev_short);
+    PrevNeoPixelSetArray(prev_short);
+    PrevNeoPixelSetPixel(SHORT - 1, RED);
+    RmtModelFinish();
+    memcpy(frame, rmt_model.last_frame, sizeof(frame));
+    NeoPixelInit(GPIO_8, SHORT, short_stripe.colors);
+    NeoPixelSetArray(short_stripe.colors);
+    NeoPixelSetPixel(SHORT - 1, RED);
+    RmtModelFinish();
+    for(uint16_t i = 0; i < LEDS; i++){
+        guard_changes += (short_stripe.guard[i] != 0);
+    }
+    CHECK(rmt_model.last_size == sizeof(frame));
+    CHECK(memcmp(frame, rmt_model.last_frame, sizeof(frame)) == 0);
+    CHECK(short_stripe.colors[SHORT - 1] == RED);
+    CHECK(guard_changes == 0);
+}
+
+static void Bench(uint32_t updates){
+    static const char * names[] = {"full update (Rainbow)", "full update (SetArray)", "one led (SetPixel)",
+                                   "unchanged (SetArray)", "brightness change"};
+    double time[2][5];
+    rmt_model.fast = true;
+    for(uint8_t prev = 0; prev < 2; prev++){
+        prev ? PrevNeoPixelInit(GPIO_8, LEDS, prev_stripe) : NeoPixelInit(GPIO_8, LEDS, stripe);
+        prev ? PrevNeoPixelBrightness(100) : NeoPixelBrightness(100);
+        for(uint8_t c = 0; c < 5; c++){
+            double t0 = HostTimeUs();
+            for(uint32_t k = 0; k < updates; k++){
+                switch(c){
+                case 0:
+                    prev ? PrevNeoPixelRainbow(k * 97, 255, 255, 1) : NeoPixelRainbow(k * 97, 255, 255, 1);
+                    break;
+                case 1:
+                    prev ? PrevNeoPixelSetArray((k & 1) ? pattern_b : pattern_a) :
+                           NeoPixelSetArray((k & 1) ? pattern_b : pattern_a);
+                    break;
+                case 2:
+                    prev ? PrevNeoPixelSetPixel(k % LEDS, NeoPixelHSV2Color(k * 31, 255, 255)) :
+                           NeoPixelSetPixel(k % LEDS, NeoPixelHSV2Color(k * 31, 255, 255));
+                    break;
+                case 3:
+                    prev ? PrevNeoPixelSetArray(prev_stripe) : NeoPixelSetArray(stripe);
+                    break;
+                case 4:
+                    prev ? PrevNeoPixelBrightness((k & 1) ? 60 : 200) : NeoPixelBrightness((k & 1) ? 60 : 200);
+                    break;
+                }
+            }
+            RmtModelFinish();
+            time[prev][c] = (HostTimeUs() - t0) / updates;
+        }
+    }
+    rmt_model.fast = false;
+    printf("%d leds, us per update (host CPU), previous -> table and delta updates:\n", LEDS);
+    for(uint8_t c = 0; c < 5; c++){
+        printf("  %-24s %8.2f -> %8.2f\n", names[c], time[1][c], time[0][c]);
+    }
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char * argv[]){
+    uint32_t updates = (argc > 1) ? atoi(argv[1]) : BENCH_UPDATES;
+    for(uint16_t i = 0; i < LEDS; i++){
+        pattern_a[i] = NeoPixelHSV2Color(i * 218, 255, 255);
+        pattern_b[i] = NeoPixelHSV2Color(i * 218 + 9000, 200, 255);
+    }
+    TestSameFrames();
+    TestReinit();
+    Bench(updates);
+    CHECK(rmt_model.errors == 0);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,259 @@
+/**
+ * @file test_neopixel_anim.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of the NeoPixel animation engine
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Four effects (rainbow, fade, chase and breathe) run on a 300 leds stripe, forward and in
+ * reverse, with some late ticks, and every frame is compared with an independent per-pixel
+ * model that uses the scalar NeoPixelHSV2Color(). Frame ticks and the animation task run on
+ * the simulated frame timer (frame_model.c). The benchmark measures the CPU cost of a frame
+ * (render and update of the stripe, frames end without being encoded) and of
+ * NeoPixelRainbow() against the previous stripe. Usage: test_neopixel_anim [frames]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "rmt_model.h"
+#include "frame_model.h"
+#include "neopixel_anim.h"
+#include "neopixel_prev.h"
+/*==================[macros and definitions]=================================*/
+#define LEDS            300     /* Leds of the stripe */
+#define FPS             50      /* Frames per second */
+#define FRAMES          400     /* Frames of the animation test */
+#define LATE_EVERY      97      /* A late task every LATE_EVERY frames... */
+#define LATE_TICKS      3       /* ...wakes up after LATE_TICKS ticks */
+#define BENCH_FRAMES    20000   /* Default frames per benchmark case */
+/*==================[internal data declaration]==============================*/
+static neopixel_color_t stripe[LEDS], expected[LEDS], prev_stripe[LEDS];
+static neopixel_effect_t effects[4] = {
+    {.type = NEOPIXEL_EFFECT_RAINBOW, .first = 0, .length = 0, .period = 2000, .size = 2, .sat = 255, .val = 200},
+    {.type = NEOPIXEL_EFFECT_FADE, .first = 250, .length = 50, .period = 500, .color = 0xFF0000, .color2 = 0x0000FF},
+    {.type = NEOPIXEL_EFFECT_CHASE, .first = 10, .length = 200, .period = 1000, .size = 5, .color = 0xFFFFFF},
+    {.type = NEOPIXEL_EFFECT_BREATHE, .first = 0, .length = 150, .period = 3000, .val = 40},
+};
+static uint32_t callbacks;
+/*==================[internal functions definition]==========================*/
+static void FrameDone(void * param){
+    (*(uint32_t *)param)++;
+}
+
+static uint32_t Triangle(uint32_t phase){
+    uint32_t half = phase >> 23;
+    return (half < 256) ? half : 512 - half;
+}
+
+static uint32_t Level(neopixel_color_t color, uint8_t shift){
+    return (color >> shift) & 0xFF;
+}
+
+/**
+ * @brief Per-pixel model of a frame
+ *
+ * @param frame     Ticks since the animations started
+ */
+static void Model(uint32_t frame){
+    memset(expected, 0, sizeof(expected));
+    for(uint8_t e = 0; e < 4; e++){
+        neopixel_effect_t * f = &effects[e];
+        uint16_t length = f->length ? f->length : LEDS - f->first;
+        uint32_t step = (((uint64_t)1 << 32) * 1000) / ((uint32_t)f->period * FPS);
+        uint32_t phase = step * frame;
+        neopixel_color_t color = 0;
+        uint32_t level;
+        int32_t pos;
+        switch(f->type){
+        case NEOPIXEL_EFFECT_RAINBOW:{
+            uint32_t hue_step = ((((uint64_t)f->size) << 32) + length / 2) / length;
+            uint16_t first = f->reverse ? (phase >> 16) : (uint16_t)-(phase >> 16);
+            for(uint16_t i = 0; i < length; i++){
+                expected[f->first + i] = NeoPixelHSV2Color((((uint32_t)first << 16) + i * hue_step) >> 16,
+                                                           f->sat, f->val);
+            }
+            break;
+        }
+        case NEOPIXEL_EFFECT_FADE:
+            for(uint8_t s = 0; s < 24; s += 8){
+                color |= ((Level(f->color, s) * (256 - Triangle(phase)) + Level(f->color2, s) * Triangle(phase)) >> 8) << s;
+            }
+            for(uint16_t i = 0; i < length; i++){
+                expected[f->first + i] = color;
+            }
+            break;
+        case NEOPIXEL_EFFECT_CHASE:
+            pos = ((uint64_t)phase * length) >> 32;
+            pos = f->reverse ? length - 1 - pos : pos;
+            for(uint8_t j = 0; j < f->size; j++){
+                int32_t p = f->reverse ? (pos + j) % length : ((pos - j) % length + length) % length;
+                expected[f->first + p] = f->color;
+            }
+            break;
+        case NEOPIXEL_EFFECT_BREATHE:
+            level = Triangle(phase);
+            level = (level * level) >> 8;
+            level = f->val + (((256 - f->val) * level) >> 8);
+            for(uint16_t i = 0; i < length; i++){
+                neopixel_color_t c = expected[f->first + i];
+                expected[f->first + i] = 0;
+                for(uint8_t s = 0; s < 24; s += 8){
+                    expected[f->first + i] |= ((Level(c, s) * level) >> 8) << s;
+                }
+            }
+            break;
+        }
+    }
+}
+
+static void TestSlots(void){
+    neopixel_anim_config_t config = {.pin = GPIO_8, .len = LEDS, .color_array = stripe, .timer = TIMER_B,
+                                     .fps = FPS, .priority = 5, .func_p = FrameDone, .param_p = &callbacks};
+    neopixel_effect_t extra = effects[0];
+    CHECK(NeoPixelAnimInit(&config));
+    CHECK(!NeoPixelAnimInit(&config));
+    CHECK(frame_model.inits == 1);
+    CHECK(frame_model.period == 1000000 / FPS);
+    for(int8_t e = 0; e < 4; e++){
+        CHECK(NeoPixelAnimAdd(&effects[e]) == e);
+    }
+    CHECK(NeoPixelAnimAdd(&extra) == -1);
+    NeoPixelAnimRemove(3);
+    extra.first = LEDS;
+    CHECK(NeoPixelAnimAdd(&extra) == -1);
+    CHECK(NeoPixelAnimAdd(&effects[3]) == 3);
+    /* Stopped: ticks don't reach the task */
+    FrameModelTick();
+    FrameModelRunTask();
+    CHECK(callbacks == 0);
+}
+
+/**
+ * @brief Frames match the model, late ticks are skipped frames
+ *
+ * @param reverse   Direction of the rainbow and the chase
+ */
+static void TestFrames(bool reverse){
+    neopixel_anim_stats_t stats;
+    uint32_t mismatches = 0, frame = 0, late = 0, frames_before, missed_before;
+    NeoPixelAnimGetStats(&stats, true);
+    frames_before = stats.frames;
+    missed_before = stats.missed;
+    effects[0].reverse = reverse;
+    effects[2].reverse = reverse;
+    NeoPixelAnimClear();
+    for(int8_t e = 0; e < 4; e++){
+        CHECK(NeoPixelAnimAdd(&effects[e]) == e);
+    }
+    callbacks = 0;
+    frame_model.latency_us = 30;
+    frame_model.read_step_us = 250;
+    NeoPixelAnimStart();
+    for(uint32_t k = 0; k < FRAMES; k++){
+        uint8_t ticks = (k % LATE_EVERY == LATE_EVERY / 2) ? LATE_TICKS : 1;
+        for(uint8_t t = 0; t < ticks; t++){
+            FrameModelTick();
+        }
+        late += ticks - 1;
+        frame += ticks;
+        FrameModelRunTask();
+        Model(frame);
+        for(uint16_t i = 0; i < LEDS; i++){
+            if(stripe[i] != expected[i]){
+                if(mismatches < 5){
+                    printf("frame %u led %u: %06x, model %06x\n", (unsigned)frame, i, (unsigned)stripe[i],
+                           (unsigned)expected[i]);
+                }
+                mismatches++;
+            }
+        }
+    }
+    RmtModelFinish();
+    NeoPixelAnimGetStats(&stats, true);
+    CHECK(mismatches == 0);
+    CHECK(callbacks == FRAMES);
+    CHECK(stats.frames - frames_before == FRAMES);
+    CHECK(stats.missed - missed_before == late);
+    CHECK(stats.budget == 1000000 / FPS);
+    CHECK((stats.last == 250) && (stats.max == 250) && (stats.average == 250));
+    CHECK(stats.latency == 30);
+    CHECK(stats.load == 250 * 100 / stats.budget);
+    printf("%s: %u frames, %u mismatches with the model, %u/%u late ticks counted as missed\n",
+           reverse ? "reverse" : "forward", FRAMES, (unsigned)mismatches, (unsigned)(stats.missed - missed_before),
+           (unsigned)late);
+    NeoPixelAnimGetStats(&stats, false);
+    CHECK((stats.max == 0) && (stats.latency == 0));
+    NeoPixelAnimStop();
+    FrameModelTick();
+    FrameModelRunTask();
+    CHECK(callbacks == FRAMES);
+}
+
+/**
+ * @brief The batched gradient matches the scalar conversion
+ */
+static void TestGradient(void){
+    static neopixel_color_t gradient[LEDS];
+    uint32_t mismatches = 0;
+    srand(7);
+    for(uint16_t n = 0; n < 200; n++){
+        uint16_t first = rand();
+        uint32_t step = ((uint32_t)rand() << 8) ^ rand();
+        uint8_t sat = rand(), val = rand();
+        NeoPixelHSVGradient(gradient, LEDS, first, step, sat, val);
+        for(uint16_t i = 0; i < LEDS; i++){
+            mismatches += gradient[i] != NeoPixelHSV2Color((((uint32_t)first << 16) + i * step) >> 16, sat, val);
+        }
+    }
+    CHECK(mismatches == 0);
+    printf("gradient: %u mismatches in 200 random gradients\n", (unsigned)mismatches);
+}
+
+static void Benchmark(uint32_t frames){
+    double t_anim, t_rainbow_only, t_rainbow, t_prev_rainbow;
+    uint16_t hue = 0;
+    rmt_model.fast = true;
+    NeoPixelAnimStart();
+    frame_model.read_step_us = 0;
+    HOST_BENCH(t_anim, 5, frames, {
+        FrameModelTick();
+        FrameModelRunTask();
+    });
+    NeoPixelAnimClear();
+    NeoPixelAnimAdd(&effects[0]);
+    HOST_BENCH(t_rainbow_only, 5, frames, {
+        FrameModelTick();
+        FrameModelRunTask();
+    });
+    NeoPixelAnimStop();
+    RmtModelFinish();
+    HOST_BENCH(t_rainbow, 5, frames, NeoPixelRainbow(hue += 300, 255, 200, 2));
+    RmtModelFinish();
+    PrevNeoPixelInit(GPIO_8, LEDS, prev_stripe);
+    HOST_BENCH(t_prev_rainbow, 5, frames, PrevNeoPixelRainbow(hue += 300, 255, 200, 2));
+    RmtModelFinish();
+    rmt_model.fast = false;
+    printf("%d leds, us per frame (best of 5 runs):\n", LEDS);
+    printf("  engine, 4 effects:        %6.2f\n", t_anim);
+    printf("  engine, rainbow only:     %6.2f\n", t_rainbow_only);
+    printf("  NeoPixelRainbow():        %6.2f\n", t_rainbow);
+    printf("  previous Rainbow():       %6.2f\n", t_prev_rainbow);
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char *argv[]){
+    uint32_t frames = (argc > 1) ? strtoul(argv[1], NULL, 0) : BENCH_FRAMES;
+    TestSlots();
+    TestFrames(false);
+    TestFrames(true);
+    TestGradient();
+    Benchmark(frames);
+    CHECK(rmt_model.errors == 0);
+    CHECK(frame_model.errors == 0);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,127 @@
+/**
+ * @file test_ws2812b.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of the WS2812B RMT symbol stream
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Frames are sent through the RMT model (rmt_model.c), which logs every symbol produced by
+ * the driver's encoder. The stream is checked against the WS2812B datasheet and decoded
+ * back to the colors sent.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include "host_test.h"
+#include "rmt_model.h"
+#include "ws2812b.h"
+#include "neopixel_stripe.h"
+/*==================[macros and definitions]=================================*/
+#define LEDS            60      /* Leds of the stripe */
+#define FRAMES          3       /* Frames sent by the test */
+/* WS2812B datasheet (ns): T0H 400, T1H 800, T0L 850, T1L 450 (+-150 each), reset > 50 us
+ * (280 us on newer revisions) */
+#define T0H_NS          400
+#define T1H_NS          800
+#define T0L_NS          850
+#define T1L_NS          450
+#define TOLERANCE_NS    150
+#define RESET_MIN_NS    280000
+/*==================[internal data declaration]==============================*/
+static neopixel_color_t colors[LEDS];
+static uint8_t decoded[FRAMES][3 * LEDS];
+static uint16_t callbacks;
+/*==================[internal functions definition]==========================*/
+static void FrameDone(void * param){
+    callbacks++;
+}
+
+static bool InSpec(double time, double nominal){
+    return (time >= nominal - TOLERANCE_NS) && (time <= nominal + TOLERANCE_NS);
+}
+
+static neopixel_color_t TestColor(uint16_t i){
+    return NeoPixelRgb2Color(i * 4, 255 - i * 4, (i * 37) & 0xFF);
+}
+
+static void TestAsync(void){
+    NeoPixelInit(GPIO_8, LEDS, colors);
+    NeoPixelSetCallback(FrameDone, NULL);
+    RmtModelReset();
+    for(uint16_t i = 0; i < LEDS; i++){
+        colors[i] = TestColor(i);
+    }
+    /* Returns with the frame queued, the next ones only wait for a free frame buffer */
+    NeoPixelSetArray(colors);
+    CHECK(RmtModelPending() == 1);
+    CHECK(rmt_model.frames == 0);
+    NeoPixelBrightness(128);
+    NeoPixelRainbow(0, 255, 200, 1);
+    CHECK(rmt_model.frames < FRAMES);
+    NeoPixelWait();
+    CHECK(RmtModelPending() == 0);
+    CHECK(rmt_model.frames == FRAMES);
+    CHECK(callbacks == FRAMES);
+    /* Frames are encoded from the ISR in refills of one memory block */
+    CHECK(rmt_model.refills >= FRAMES * (24 * LEDS + 1) / RMT_MODEL_REFILL);
+}
+
+static void TestTiming(void){
+    double tick = 1e9 / rmt_model.resolution;
+    double min_reset = 1e12;
+    uint32_t frames = 0, bits = 0, out_of_spec = 0;
+    for(uint32_t i = 0; i < rmt_model.n_symbols; i++){
+        rmt_symbol_word_t s = rmt_model.symbols[i];
+        double high = s.duration0 * tick, low = s.duration1 * tick;
+        if(s.level0 == 0 && s.level1 == 0){
+            /* Reset: end of frame */
+            min_reset = (high + low < min_reset) ? high + low : min_reset;
+            CHECK(bits == 24 * LEDS);
+            frames++;
+            bits = 0;
+            continue;
+        }
+        bool one = (high > (T0H_NS + T1H_NS) / 2);
+        if(s.level0 != 1 || s.level1 != 0){
+            out_of_spec++;
+        }else if(one ? !(InSpec(high, T1H_NS) && InSpec(low, T1L_NS)) : !(InSpec(high, T0H_NS) && InSpec(low, T0L_NS))){
+            out_of_spec++;
+        }
+        if(frames < FRAMES){
+            decoded[frames][bits / 8] = (decoded[frames][bits / 8] << 1) | one;
+        }
+        bits++;
+    }
+    CHECK(frames == FRAMES);
+    CHECK(out_of_spec == 0);
+    CHECK(min_reset >= RESET_MIN_NS);
+    printf("%u frames of %d leds: %u symbols, %u out of spec, reset %.1f us\n", (unsigned)frames, LEDS,
+           (unsigned)rmt_model.n_symbols, (unsigned)out_of_spec, min_reset / 1000);
+}
+
+static void TestContent(void){
+    /* First frame: GRB order, gamma corrected, full brightness */
+    uint16_t mismatches = 0;
+    for(uint16_t i = 0; i < LEDS; i++){
+        neopixel_color_t c = TestColor(i);
+        uint8_t r = ws2812bGammaCorrection((((c >> 16) & 0xFF) * 255) >> 8);
+        uint8_t g = ws2812bGammaCorrection((((c >> 8) & 0xFF) * 255) >> 8);
+        uint8_t b = ws2812bGammaCorrection(((c & 0xFF) * 255) >> 8);
+        mismatches += (decoded[0][3 * i] != g) || (decoded[0][3 * i + 1] != r) || (decoded[0][3 * i + 2] != b);
+    }
+    CHECK(mismatches == 0);
+    /* Last frame as logged by the model */
+    CHECK(memcmp(decoded[FRAMES - 1], rmt_model.last_frame, 3 * LEDS) == 0);
+}
+/*==================[external functions definition]==========================*/
+int main(void){
+    TestAsync();
+    TestTiming();
+    TestContent();
+    CHECK(rmt_model.errors == 0);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
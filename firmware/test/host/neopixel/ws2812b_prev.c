@@ -0,0 +1,122 @@
+/**
+ * @file ws2812b_prev.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief WS2812B driver before the gamma and brightness table (reference for the host benchmark)
+ * @version 0.1
+ * @date 2023-10-25
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * Copy of ws2812b.c as it was before the gamma and brightness table, renamed with the Prev
+ * prefix (reference for the host benchmark): gamma correction of every
+ * color component while the frame is built.
+ */
+
+/*==================[inclusions]=============================================*/
+#include "ws2812b.h"
+#include "neopixel_prev.h"
+#include "gpio_mcu.h"
+#include "rmt_mcu.h"
+#include "esp_attr.h"
+/*==================[macros and definitions]=================================*/
+#define RMT_RESOLUTION	20000000	// 20 MHz: 50 ns ticks
+#define T0H				8			// 0 bit high time: 0.40 us
+#define T0L				17			// 0 bit low time: 0.85 us
+#define T1H				16			// 1 bit high time: 0.80 us
+#define T1L				9			// 1 bit low time: 0.45 us
+#define RET_CMD			5600		// ret command 280 us low (50 us on datasheet, newer revisions need 280 us)
+#define LED_BYTES		3			// bytes per led (GRB)
+/*==================[internal data declaration]==============================*/
+static uint8_t frames[2][LED_BYTES * WS2812B_MAX_LEDS];	/*!< Frame being built and frame being sent */
+static uint8_t frame;				/*!< Frame being built */
+static uint16_t frame_bytes;		/*!< Bytes of frame being built */
+static void (*frame_done)(void*) = NULL;	/*!< Called at the end of each frame */
+static void *frame_done_param;		/*!< Parameter of frame_done */
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static const uint8_t gamma_table[256] = {
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,
+    1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,   2,   3,
+    3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   5,   6,
+    6,   6,   6,   7,   7,   7,   8,   8,   8,   9,   9,   9,   10,  10,  10,
+    11,  11,  11,  12,  12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,
+    17,  18,  18,  19,  19,  20,  20,  21,  21,  22,  22,  23,  24,  24,  25,
+    25,  26,  27,  27,  28,  29,  29,  30,  31,  31,  32,  33,  34,  34,  35,
+    36,  37,  38,  38,  39,  40,  41,  42,  42,  43,  44,  45,  46,  47,  48,
+    49,  50,  51,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,
+    64,  65,  66,  68,  69,  70,  71,  72,  73,  75,  76,  77,  78,  80,  81,
+    82,  84,  85,  86,  88,  89,  90,  92,  93,  94,  96,  97,  99,  100, 102,
+    103, 105, 106, 108, 109, 111, 112, 114, 115, 117, 119, 120, 122, 124, 125,
+    127, 129, 130, 132, 134, 136, 137, 139, 141, 143, 145, 146, 148, 150, 152,
+    154, 156, 158, 160, 162, 164, 166, 168, 170, 172, 174, 176, 178, 180, 182,
+    184, 186, 188, 191, 193, 195, 197, 199, 202, 204, 206, 209, 211, 213, 215,
+    218, 220, 223, 225, 227, 230, 232, 235, 237, 240, 242, 245, 247, 250, 252,
+    255};
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+uint8_t PrevWs2812bGammaCorrection(uint8_t component){
+    return gamma_table[component];
+}
+
+static void IRAM_ATTR ws2812bFrameDone(void *param){
+    if(frame_done != NULL){
+        frame_done(frame_done_param);
+    }
+}
+
+/*==================[external functions definition]==========================*/
+
+void PrevWs2812bInit(gpio_t pin){
+    rmt_mcu_config_t rmt_config = {
+        .pin = pin,
+        .resolution = RMT_RESOLUTION,
+        .bit0_high = T0H,
+        .bit0_low = T0L,
+        .bit1_high = T1H,
+        .bit1_low = T1L,
+        .reset = RET_CMD,
+        .func_p = ws2812bFrameDone,
+        .param_p = NULL
+    };
+    frame = 0;
+    frame_bytes = 0;
+    RmtInit(&rmt_config);
+}
+
+void PrevWs2812bSetCallback(void *func_p, void *param_p){
+    frame_done_param = param_p;
+    frame_done = func_p;
+}
+
+void PrevWs2812bSend(rgb_led_t led_color){
+    uint8_t *data = frames[frame];
+    if(frame_bytes == 0){
+        // Buffer was sent two frames ago: wait until it's done
+        RmtWait(1);
+    }
+    if(frame_bytes >= sizeof(frames[0])){
+        return;
+    }
+    data[frame_bytes++] = PrevWs2812bGammaCorrection(led_color.green);
+    data[frame_bytes++] = PrevWs2812bGammaCorrection(led_color.red);
+    data[frame_bytes++] = PrevWs2812bGammaCorrection(led_color.blue);
+}
+
+void PrevWs2812bSendRet(void){
+    // Reset time is sent at the end of each frame
+    if(frame_bytes == 0){
+        return;
+    }
+    RmtWrite(frames[frame], frame_bytes);
+    frame ^= 1;
+    frame_bytes = 0;
+}
+
+void PrevWs2812bWait(void){
+    RmtWait(0);
+}
+
+/*==================[end of file]============================================*/
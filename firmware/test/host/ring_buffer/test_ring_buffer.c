@@ -0,0 +1,226 @@
+/**
+ * @file test_ring_buffer.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test, stress test and benchmark of the SPSC ring buffer
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The stress test runs producer and consumer in two threads, mixing batch copies with
+ * reserve/commit and span/release access. Usage: test_ring_buffer [elements]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "ring_buffer_mcu.h"
+#include "freertos/task.h"
+/*==================[macros and definitions]=================================*/
+#define STRESS_ELEMENTS     2000000     /* Default elements moved by the stress test */
+#define STRESS_SIZE         1024        /* Ring size of the stress test */
+#define BENCH_ELEMENTS      (1 << 24)   /* Elements moved by the single thread benchmark */
+#define BENCH_BATCH         64          /* Elements per call in the benchmark */
+/*==================[internal data declaration]==============================*/
+static uint32_t notifications;
+static ring_buffer_t stress_rb;
+static uint32_t stress_storage[STRESS_SIZE];
+static uint32_t stress_elements;
+/*==================[internal functions definition]==========================*/
+/* freertos/task.h */
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_task_woken){
+    notifications++;
+    *higher_priority_task_woken = pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks){
+    return 0;
+}
+
+static void TestBasic(void){
+    ring_buffer_t rb;
+    uint16_t storage[8], data[16], out[16];
+    bool woken = false;
+    uint32_t n;
+    int dummy_task;
+    CHECK(!RingBufferInit(&rb, storage, 6, sizeof(uint16_t)));
+    CHECK(!RingBufferInit(&rb, storage, 0, sizeof(uint16_t)));
+    CHECK(RingBufferInit(&rb, storage, 8, sizeof(uint16_t)));
+    for(uint16_t i = 0; i < 16; i++){
+        data[i] = 100 + i;
+    }
+    CHECK(RingBufferCount(&rb) == 0);
+    CHECK(RingBufferSpace(&rb) == 8);
+    CHECK(RingBufferPop(&rb, out, 4) == 0);
+
+    /* wrap around */
+    CHECK(RingBufferPush(&rb, data, 5) == 5);
+    CHECK(RingBufferPop(&rb, out, 5) == 5);
+    CHECK(RingBufferPush(&rb, data, 6) == 6);
+    CHECK(RingBufferCount(&rb) == 6);
+    CHECK(RingBufferPop(&rb, out, 16) == 6);
+    for(uint16_t i = 0; i < 6; i++){
+        CHECK(out[i] == data[i]);
+    }
+
+    /* overflow: the excess is dropped and counted */
+    CHECK(RingBufferPush(&rb, data, 10) == 8);
+    CHECK(rb.dropped == 2);
+    CHECK(RingBufferSpace(&rb) == 0);
+    CHECK(RingBufferPop(&rb, out, 8) == 8);
+    CHECK((out[0] == 100) && (out[7] == 107));
+
+    /* spans stop at the end of the storage array */
+    RingBufferReset(&rb);
+    CHECK(rb.dropped == 0);
+    RingBufferPush(&rb, data, 6);
+    RingBufferPop(&rb, out, 6);
+    uint16_t *w = RingBufferWriteReserve(&rb, &n);
+    CHECK((w == &storage[6]) && (n == 2));
+    w[0] = 1;
+    w[1] = 2;
+    RingBufferWriteCommit(&rb, 2);
+    w = RingBufferWriteReserve(&rb, &n);
+    CHECK((w == &storage[0]) && (n == 6));
+    w[0] = 3;
+    RingBufferWriteCommit(&rb, 1);
+    const uint16_t *r = RingBufferReadSpan(&rb, &n);
+    CHECK((r == &storage[6]) && (n == 2) && (r[0] == 1) && (r[1] == 2));
+    RingBufferReadRelease(&rb, 2);
+    r = RingBufferReadSpan(&rb, &n);
+    CHECK((n == 1) && (r[0] == 3));
+    RingBufferReadRelease(&rb, 1);
+    CHECK(RingBufferCount(&rb) == 0);
+
+    /* FromISR variants notify the consumer, if any */
+    notifications = 0;
+    RingBufferPushFromISR(&rb, data, 1, &woken);
+    CHECK((notifications == 0) && !woken);
+    RingBufferSetConsumer(&rb, &dummy_task);
+    RingBufferPushFromISR(&rb, data, 1, &woken);
+    CHECK((notifications == 1) && woken);
+    RingBufferWriteReserve(&rb, &n);
+    RingBufferWriteCommitFromISR(&rb, 1, NULL);
+    CHECK(notifications == 2);
+    CHECK(RingBufferWait(&rb, 0));
+}
+
+static void *StressProducer(void *param){
+    uint32_t value = 0;
+    uint32_t batch[37];
+    while(value < stress_elements){
+        uint32_t n = (value % 37) + 1;
+        if(n > stress_elements - value){
+            n = stress_elements - value;
+        }
+        if(value & 1){
+            uint32_t span;
+            uint32_t *dst = RingBufferWriteReserve(&stress_rb, &span);
+            if(span > n){
+                span = n;
+            }
+            for(uint32_t i = 0; i < span; i++){
+                dst[i] = value + i;
+            }
+            RingBufferWriteCommit(&stress_rb, span);
+            value += span;
+        }else{
+            uint32_t space = RingBufferSpace(&stress_rb);
+            if(n > space){
+                n = space;
+            }
+            for(uint32_t i = 0; i < n; i++){
+                batch[i] = value + i;
+            }
+            value += RingBufferPush(&stress_rb, batch, n);
+        }
+        if(RingBufferSpace(&stress_rb) == 0){
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void TestStress(void){
+    pthread_t producer;
+    uint32_t expected = 0, errors = 0;
+    uint32_t batch[64];
+    double t0 = HostTimeUs(), t;
+    RingBufferInit(&stress_rb, stress_storage, STRESS_SIZE, sizeof(uint32_t));
+    pthread_create(&producer, NULL, StressProducer, NULL);
+    while(expected < stress_elements){
+        uint32_t n;
+        if(expected & 2){
+            const uint32_t *src = RingBufferReadSpan(&stress_rb, &n);
+            for(uint32_t i = 0; i < n; i++){
+                errors += (src[i] != expected + i);
+            }
+            RingBufferReadRelease(&stress_rb, n);
+        }else{
+            n = RingBufferPop(&stress_rb, batch, 64);
+            for(uint32_t i = 0; i < n; i++){
+                errors += (batch[i] != expected + i);
+            }
+        }
+        expected += n;
+        if(n == 0){
+            sched_yield();
+        }
+    }
+    pthread_join(producer, NULL);
+    t = HostTimeUs() - t0;
+    CHECK(errors == 0);
+    CHECK(stress_rb.dropped == 0);
+    CHECK(RingBufferCount(&stress_rb) == 0);
+    printf("stress: %u elements, %u errors, %.1f Melem/s (2 threads)\n", stress_elements, errors, stress_elements / t);
+}
+
+static void Benchmark(void){
+    static uint32_t storage[1024];
+    uint32_t batch[BENCH_BATCH];
+    ring_buffer_t rb;
+    uint32_t sum = 0, n;
+    double t0, t_copy, t_span;
+    RingBufferInit(&rb, storage, 1024, sizeof(uint32_t));
+    for(uint32_t i = 0; i < BENCH_BATCH; i++){
+        batch[i] = i;
+    }
+    t0 = HostTimeUs();
+    for(uint32_t i = 0; i < BENCH_ELEMENTS; i += BENCH_BATCH){
+        RingBufferPush(&rb, batch, BENCH_BATCH);
+        RingBufferPop(&rb, batch, BENCH_BATCH);
+        sum += batch[i & (BENCH_BATCH - 1)];
+    }
+    t_copy = HostTimeUs() - t0;
+    t0 = HostTimeUs();
+    for(uint32_t i = 0; i < BENCH_ELEMENTS; i += BENCH_BATCH){
+        uint32_t *dst = RingBufferWriteReserve(&rb, &n);
+        n = (n > BENCH_BATCH) ? BENCH_BATCH : n;
+        for(uint32_t k = 0; k < n; k++){
+            dst[k] = k;
+        }
+        RingBufferWriteCommit(&rb, n);
+        const uint32_t *src = RingBufferReadSpan(&rb, &n);
+        for(uint32_t k = 0; k < n; k++){
+            sum += src[k];
+        }
+        RingBufferReadRelease(&rb, n);
+    }
+    t_span = HostTimeUs() - t0;
+    CHECK(sum != 0);
+    printf("batch push/pop (%d elements):    %.0f Melem/s\n", BENCH_BATCH, BENCH_ELEMENTS / t_copy);
+    printf("reserve/commit + span/release:   %.0f Melem/s\n", BENCH_ELEMENTS / t_span);
+}
+
+/*==================[external functions definition]==========================*/
+int main(int argc, char *argv[]){
+    stress_elements = (argc > 1) ? strtoul(argv[1], NULL, 0) : STRESS_ELEMENTS;
+    TestBasic();
+    TestStress();
+    Benchmark();
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
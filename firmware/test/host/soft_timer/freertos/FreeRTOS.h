@@ -0,0 +1,36 @@
+/* Host model of freertos/FreeRTOS.h for the software timers: critical sections count their
+ * nesting in tick_model_lock_depth (see tick_model.h) */
+#pragma once
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_attr.h"
+
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
+typedef struct {
+    void * storage;
+} StaticTask_t;
+
+#define pdFALSE                 0
+#define pdTRUE                  1
+#define pdPASS                  1
+#define pdFAIL                  0
+#define portMAX_DELAY           0xffffffffUL
+#define configTICK_RATE_HZ      1000
+#define portTICK_PERIOD_MS      (1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms) * configTICK_RATE_HZ / 1000)
+#define portYIELD_FROM_ISR(...) ((void)(0, ##__VA_ARGS__))
+
+extern int tick_model_lock_depth;
+typedef struct {
+    int owner;
+} portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED    {0}
+#define portENTER_CRITICAL(mux)         ((void)(mux), tick_model_lock_depth++)
+#define portEXIT_CRITICAL(mux)          ((void)(mux), tick_model_lock_depth--)
+#define portENTER_CRITICAL_ISR(mux)     ((void)(mux), tick_model_lock_depth++)
+#define portEXIT_CRITICAL_ISR(mux)      ((void)(mux), tick_model_lock_depth--)
+#define portENTER_CRITICAL_SAFE(mux)    ((void)(mux), tick_model_lock_depth++)
+#define portEXIT_CRITICAL_SAFE(mux)     ((void)(mux), tick_model_lock_depth--)
@@ -0,0 +1,315 @@
+/**
+ * @file test_soft_timer.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of the software timers on a simulated tick source
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Wheel: 600 one-shot and periodic timers (periods from sub-tick to beyond the wheel range
+ * with short ticks) are started, stopped and updated at random from the task side and from
+ * their ISR callbacks. Every expiration is checked against a closed-form model, callbacks must
+ * run without the wheel lock and running timers must not miss expirations.
+ * Task callbacks: drift of a period that is not a multiple of the tick, coalescing of
+ * expirations not yet served, and timers stopped while queued for the driver task (the handle
+ * is then overwritten and reused: the task must not reach the stopped node).
+ * Benchmark: stop+start and tick cost against the number of running timers.
+ * Usage: test_soft_timer [tick_us] [ticks]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "tick_model.h"
+#include "soft_timer_mcu.h"
+/*==================[macros and definitions]=================================*/
+#define TICK_US         1000        /* Default tick */
+#define TICKS           (1UL << 23) /* Default ticks of the wheel scenario */
+#define N_TIMERS        600         /* Timers of the wheel scenario */
+#define SCAN_TICKS      1024        /* Ticks between task-side operations and missed expiration scans */
+#define WIDE_TICK_US    100         /* Ticks shorter than this also get periods beyond the wheel range */
+#define DRIFT_TICKS     10000000UL  /* Ticks of the drift check */
+#define DRIFT_PERIOD    1234567     /* Period of the drift check (us) */
+#define BENCH_MAX       20000       /* Max. timers of the benchmark */
+#define BENCH_OPS       1000000     /* Stop+start calls per benchmark run */
+/*==================[internal data declaration]==============================*/
+/**
+ * @brief Timer and its expected expirations
+ */
+typedef struct {
+    soft_timer_t timer;
+    uint16_t id;
+    bool periodic;
+    bool running;
+    uint32_t period;        /* us, at least one tick */
+    uint64_t base;          /* Tick of the start */
+    uint64_t k;             /* Expirations since the start (next one) */
+    uint64_t expected;      /* Tick of the next expiration */
+} model_timer_t;
+/*==================[internal data definition]===============================*/
+static model_timer_t timers[N_TIMERS];
+static soft_timer_t bench[BENCH_MAX];
+static uint32_t tick_us;
+static uint64_t now_tick;           /* Ticks processed */
+static bool in_callback;
+static uint64_t expirations, errors;
+static uint32_t task_calls[2];
+static uint32_t seed = 1;
+/*==================[internal functions definition]==========================*/
+static uint32_t Random(void){
+    seed = seed * 1103515245u + 12345u;
+    return (seed >> 8) ^ (seed << 13);
+}
+
+/* Tick of the k-th expiration: whole ticks of k periods, rounded to the nearest */
+static uint64_t ModelNext(model_timer_t *x){
+    return x->base + (x->k * x->period + tick_us / 2) / tick_us - 1;
+}
+
+static void ModelStart(model_timer_t *x){
+    SoftTimerStart(&x->timer);
+    x->period = (x->period < tick_us) ? tick_us : x->period;
+    /* Timers started from a callback run on the tick being processed */
+    x->base = now_tick + in_callback;
+    x->k = 1;
+    x->running = true;
+    x->expected = ModelNext(x);
+}
+
+static void ModelStop(model_timer_t *x){
+    SoftTimerStop(&x->timer);
+    x->running = false;
+}
+
+static void ModelError(model_timer_t *x, const char *what){
+    if(errors < 10){
+        printf("timer %u %s: tick %llu, expected %llu, period %u us\n", x->id, what,
+               (unsigned long long)now_tick, (unsigned long long)x->expected, x->period);
+    }
+    errors++;
+}
+
+static void ModelCallback(void *param){
+    model_timer_t *x = param;
+    expirations++;
+    in_callback = true;
+    if(tick_model_lock_depth != 0){
+        ModelError(x, "called with the lock taken");
+    }
+    if(!x->running || now_tick != x->expected){
+        ModelError(x, "expired out of time");
+    }
+    if(x->periodic){
+        x->k++;
+        x->expected = ModelNext(x);
+    } else{
+        x->running = false;
+    }
+    /* Operations from the callback, on other timers or on itself */
+    uint32_t r = Random() % 100;
+    model_timer_t *other = &timers[Random() % N_TIMERS];
+    if(r < 3 && other != x){
+        ModelStop(other);
+    } else if(r < 6){
+        ModelStart(other);
+    } else if(r < 7 && x->periodic){
+        ModelStop(x);
+    }
+    in_callback = false;
+}
+
+static uint32_t RandomPeriod(bool wide){
+    uint32_t r = Random() % 100;
+    uint64_t level2 = 262144ULL * tick_us;
+    if(r < 30){
+        return (1 + Random() % 64) * tick_us;
+    }
+    if(r < 50){
+        return (1 + Random() % 4096) * tick_us + Random() % tick_us;
+    }
+    if(r < 70){
+        return Random() % ((level2 > 4000000000ULL) ? 4000000000UL : (uint32_t)level2);
+    }
+    if(r < 80 && wide){
+        return 3000000000UL + Random() % 1000000000UL;
+    }
+    return 1 + Random() % (200 * tick_us);
+}
+
+static void TestWheel(uint64_t ticks){
+    bool wide = tick_us < WIDE_TICK_US;
+    uint64_t missed = 0, overruns = 0;
+
+    for(uint16_t i = 0; i < N_TIMERS; i++){
+        soft_timer_config_t config = {
+            .period = RandomPeriod(wide),
+            .mode = (i % 3) ? SOFT_TIMER_PERIODIC : SOFT_TIMER_ONE_SHOT,
+            .context = SOFT_TIMER_ISR,
+            .func_p = ModelCallback,
+            .param_p = &timers[i],
+        };
+        timers[i] = (model_timer_t){.id = i, .periodic = (config.mode == SOFT_TIMER_PERIODIC), .period = config.period};
+        SoftTimerInit(&timers[i].timer, &config);
+        ModelStart(&timers[i]);
+    }
+    for(uint64_t t = 0; t < ticks; t++){
+        TickModelTick();
+        now_tick++;
+        if(t % SCAN_TICKS){
+            continue;
+        }
+        for(uint8_t j = 0; j < 4; j++){
+            model_timer_t *x = &timers[Random() % N_TIMERS];
+            uint32_t r = Random() % 4;
+            if(r == 0){
+                ModelStop(x);
+            } else{
+                if(r == 1){
+                    x->period = RandomPeriod(wide);
+                    SoftTimerUpdatePeriod(&x->timer, x->period);
+                }
+                ModelStart(x);
+            }
+        }
+        for(uint16_t i = 0; i < N_TIMERS; i++){
+            model_timer_t *x = &timers[i];
+            if(x->running && x->expected < now_tick){
+                ModelError(x, "missed");
+                missed++;
+                x->running = false;
+            }
+            if(x->running != SoftTimerIsRunning(&x->timer)){
+                ModelError(x, "running flag mismatch");
+                x->running = SoftTimerIsRunning(&x->timer);
+            }
+            if(!x->running && Random() % 8 == 0){
+                ModelStart(x);
+            }
+        }
+    }
+    for(uint16_t i = 0; i < N_TIMERS; i++){
+        overruns += SoftTimerGetOverruns(&timers[i].timer);
+        ModelStop(&timers[i]);
+    }
+    printf("wheel (%u us tick, %llu ticks): %llu expirations checked, %llu errors, %llu missed, %llu overruns\n",
+           tick_us, (unsigned long long)ticks, (unsigned long long)expirations, (unsigned long long)errors,
+           (unsigned long long)missed, (unsigned long long)overruns);
+    CHECK(expirations > ticks);
+    CHECK(errors == 0);
+    CHECK(tick_model_lock_depth == 0);
+}
+
+static void TaskCallback(void *param){
+    task_calls[(uintptr_t)param]++;
+}
+
+static void TestTask(void){
+    soft_timer_config_t config = {
+        .period = DRIFT_PERIOD,
+        .mode = SOFT_TIMER_PERIODIC,
+        .context = SOFT_TIMER_TASK,
+        .func_p = TaskCallback,
+        .param_p = (void *)0,
+    };
+    soft_timer_t drift, a, b;
+
+    /* Drift: the period remainder is carried, the average period is exact */
+    SoftTimerInit(&drift, &config);
+    SoftTimerStart(&drift);
+    for(uint32_t t = 0; t < DRIFT_TICKS; t++){
+        TickModelTick();
+        TickModelRunTask();
+    }
+    SoftTimerStop(&drift);
+    double ideal = (double)DRIFT_TICKS * tick_us / DRIFT_PERIOD;
+    printf("drift: %u calls of a %u us period in %lu ticks (ideal %.3f), %u overruns\n",
+           task_calls[0], DRIFT_PERIOD, DRIFT_TICKS, ideal, SoftTimerGetOverruns(&drift));
+    CHECK(task_calls[0] >= ideal - 1 && task_calls[0] <= ideal + 1);
+    CHECK(SoftTimerGetOverruns(&drift) == 0);
+
+    /* Coalescing: 5 expirations before the task runs give 1 call and 4 overruns */
+    task_calls[0] = 0;
+    config.period = tick_us;
+    SoftTimerInit(&a, &config);
+    SoftTimerStart(&a);
+    for(uint8_t i = 0; i < 5; i++){
+        TickModelTick();
+    }
+    TickModelRunTask();
+    printf("coalescing: %u call(s), %u overruns\n", task_calls[0], SoftTimerGetOverruns(&a));
+    CHECK(task_calls[0] == 1 && SoftTimerGetOverruns(&a) == 4);
+
+    /* Stopped while queued: no call, and the handle can be overwritten and reused at once */
+    config.param_p = (void *)1;
+    SoftTimerInit(&b, &config);
+    SoftTimerStart(&b);
+    TickModelTick();
+    SoftTimerStop(&a);
+    memset(&a, 0xA5, sizeof(a));
+    TickModelRunTask();
+    printf("stopped while queued: %u call(s) of the stopped timer, %u of the other one\n", task_calls[0] - 1, task_calls[1]);
+    CHECK(task_calls[0] == 1 && task_calls[1] == 1);
+    config.param_p = (void *)0;
+    SoftTimerInit(&a, &config);
+    SoftTimerStop(&b);
+    memset(&b, 0xA5, sizeof(b));
+    SoftTimerStart(&a);
+    TickModelTick();
+    TickModelRunTask();
+    CHECK(task_calls[0] == 2 && task_calls[1] == 1);
+    SoftTimerStop(&a);
+    TickModelTick();
+    TickModelRunTask();
+    CHECK(task_calls[0] == 2);
+}
+
+static void BenchStopStart(void){
+    soft_timer_config_t config = {
+        .mode = SOFT_TIMER_PERIODIC,
+        .context = SOFT_TIMER_ISR,
+        .func_p = TaskCallback,
+        .param_p = (void *)0,
+    };
+    const uint16_t n_timers[] = {10, 100, 1000, 10000, BENCH_MAX};
+    double stop_start_us, tick_cost_us;
+
+    for(uint8_t k = 0; k < sizeof(n_timers) / sizeof(n_timers[0]); k++){
+        uint16_t n = n_timers[k];
+        for(uint16_t i = 0; i < n; i++){
+            config.period = (1 + Random() % 100000) * tick_us;
+            SoftTimerInit(&bench[i], &config);
+            SoftTimerStart(&bench[i]);
+        }
+        HOST_BENCH(stop_start_us, 3, BENCH_OPS, {
+            soft_timer_t *x = &bench[Random() % n];
+            SoftTimerStop(x);
+            SoftTimerStart(x);
+        });
+        HOST_BENCH(tick_cost_us, 3, BENCH_OPS / 4, TickModelTick());
+        printf("%5u timers: stop+start %.1f ns, tick %.1f ns (periods of 1 to 100000 ticks)\n",
+               n, stop_start_us * 1000, tick_cost_us * 1000);
+        for(uint16_t i = 0; i < n; i++){
+            SoftTimerStop(&bench[i]);
+        }
+    }
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char ** argv){
+    soft_timer_service_config_t service = {
+        .timer = TIMER_A,
+        .tick = (argc > 1) ? strtoul(argv[1], NULL, 10) : TICK_US,
+        .priority = 5,
+    };
+    uint64_t ticks = (argc > 2) ? strtoull(argv[2], NULL, 10) : TICKS;
+
+    tick_us = service.tick;
+    CHECK(SoftTimerServiceInit(&service));
+    CHECK(!SoftTimerServiceInit(&service));
+    TestWheel(ticks);
+    TestTask();
+    BenchStopStart();
+    return HOST_TEST_RESULT();
+}
+/*==================[end of file]============================================*/
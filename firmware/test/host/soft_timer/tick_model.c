@@ -0,0 +1,65 @@
+/**
+ * @file tick_model.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Simulated tick source and driver task of the software timers (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The task function never returns: when it would block in ulTaskNotifyTake() the model jumps
+ * back to TickModelRunTask(), and the next run enters the task function again.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stddef.h>
+#include <setjmp.h>
+#include "tick_model.h"
+#include "timer_mcu.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+/*==================[internal data declaration]==============================*/
+static void (*tick_isr)(void *);
+static TaskFunction_t task_func;
+static uint32_t notifications;
+static jmp_buf task_wait;
+/*==================[external data definition]===============================*/
+int tick_model_lock_depth;
+/*==================[external functions definition]==========================*/
+void TickModelTick(void){
+    tick_isr(NULL);
+}
+
+void TickModelRunTask(void){
+    if(setjmp(task_wait) == 0){
+        task_func(NULL);
+    }
+}
+
+void TimerInit(timer_config_t *timer_ini){
+    tick_isr = (void (*)(void *))timer_ini->func_p;
+}
+
+void TimerStart(timer_mcu_t timer){
+}
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t task, const char *name, uint32_t stack, void *param, UBaseType_t priority,
+                               StackType_t *stack_buffer, StaticTask_t *task_buffer){
+    task_func = task;
+    return (TaskHandle_t)task_buffer;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_task_woken){
+    notifications++;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks){
+    if(notifications == 0){
+        longjmp(task_wait, 1);
+    }
+    uint32_t value = notifications;
+    notifications = clear_on_exit ? 0 : value - 1;
+    return value;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,33 @@
+/**
+ * @file tick_model.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Simulated tick source and driver task of the software timers (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * TimerInit() keeps the tick ISR of the service, that the test calls with TickModelTick().
+ * The driver task created with xTaskCreateStatic() runs with TickModelRunTask() until it
+ * waits for a notification with nothing pending.
+ */
+#ifndef TICK_MODEL_H_
+#define TICK_MODEL_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+/*==================[external data declaration]==============================*/
+extern int tick_model_lock_depth;       /*!< Critical sections taken */
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Run the tick ISR once
+ */
+void TickModelTick(void);
+
+/**
+ * @brief Run the driver task until it waits with no notifications pending
+ */
+void TickModelRunTask(void);
+
+#endif /* TICK_MODEL_H_ */
+/*==================[end of file]============================================*/
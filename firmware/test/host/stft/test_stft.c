@@ -0,0 +1,225 @@
+/**
+ * @file test_stft.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of the streaming STFT
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Frames are compared with FFTReal() over the same samples, pushed in chunks that do not
+ * match the hop. The benchmark compares StftPush() with what applications did before: copy
+ * the last N samples to an array on every hop and call FFTReal(). Usage: test_stft [hops]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "stft.h"
+/*==================[macros and definitions]=================================*/
+#define FS              256.0f      /* Sample frequency (Hz) */
+#define N               256         /* Frame lenght */
+#define HOP             64          /* Samples between frames */
+#define FRAMES          4           /* Capacity of the output ring */
+#define SIGNAL          4096        /* Test signal lenght */
+#define CHUNK           37          /* Samples per push (not a divisor of HOP) */
+#define BENCH_HOPS      2000        /* Default hops per run in the benchmark */
+/*==================[internal data declaration]==============================*/
+static float input[STFT_INPUT_SIZE(N)];
+static float spectra[STFT_SPECTRA_SIZE(N, FRAMES)];
+static float band_power[STFT_BANDS_SIZE(2, FRAMES)];
+static float signal[SIGNAL];
+static float reference[N / 2];
+static const stft_band_t bands[2] = {{8, 13}, {13, 30}};   /* alpha and beta */
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief 2.0 amplitude alpha tone, 0.5 amplitude beta tone and DC offset
+ */
+static void Signal(void){
+    for(uint16_t i = 0; i < SIGNAL; i++){
+        signal[i] = 2.0f * sinf(2 * M_PI * 10.3f * i / FS) + 0.5f * sinf(2 * M_PI * 20.0f * i / FS) + 0.1f;
+    }
+}
+
+static stft_config_t Config(stft_window_t window, fft_output_t output){
+    stft_config_t config = {.sample_frec = FS, .fft_lenght = N, .hop = HOP, .window = window, .output = output,
+                            .bands = bands, .n_bands = 2, .n_frames = FRAMES};
+    return config;
+}
+
+static void TestConfig(void){
+    stft_t stft;
+    stft_config_t config = Config(STFT_WINDOW_HANN, FFT_MAGNITUDE);
+    config.fft_lenght = 200;
+    CHECK(!StftInit(&stft, &config, input, spectra, band_power));
+    config.fft_lenght = 2 * MAX_SIGNAL_LENGHT;
+    CHECK(!StftInit(&stft, &config, input, spectra, band_power));
+    config.fft_lenght = N;
+    config.hop = 0;
+    CHECK(!StftInit(&stft, &config, input, spectra, band_power));
+    config.hop = HOP;
+    config.n_frames = 0;
+    CHECK(!StftInit(&stft, &config, input, spectra, band_power));
+    config.n_frames = FRAMES;
+    config.n_bands = STFT_MAX_BANDS + 1;
+    CHECK(!StftInit(&stft, &config, input, spectra, band_power));
+    config.n_bands = 2;
+    CHECK(!StftInit(&stft, &config, input, spectra, NULL));
+    CHECK(StftInit(&stft, &config, input, spectra, band_power));
+}
+
+/**
+ * @brief Every frame is FFTReal() over the last N samples, both use a Hann window
+ *
+ * FFTReal() scales by 4 / N, the STFT by 2 / sum of the window (4 / (N - 1) for Hann).
+ */
+static void TestFrames(void){
+    stft_t stft;
+    stft_config_t config = Config(STFT_WINDOW_HANN, FFT_MAGNITUDE);
+    const float *spectrum, *power;
+    uint32_t frames = 0, pushed = 0;
+    float error = 0, peak = 0, alpha = 0, beta = 0, ratio;
+    CHECK(StftInit(&stft, &config, input, spectra, band_power));
+    ratio = stft.scale * N / 4;
+    CHECK(fabsf(ratio - (float)N / (N - 1)) < 1e-4f);
+    for(uint16_t pos = 0; pos < SIGNAL; pos += CHUNK){
+        uint16_t n = (pos + CHUNK > SIGNAL) ? SIGNAL - pos : CHUNK;
+        pushed += StftPush(&stft, &signal[pos], n);
+        while(StftReadFrame(&stft, &spectrum, &power)){
+            /* frame covers [end - N, end) */
+            uint32_t end = N + frames * HOP;
+            CHECK(end <= pos + n);
+            FFTReal(&signal[end - N], reference, N, FFT_MAGNITUDE);
+            for(uint16_t k = 0; k < N / 2; k++){
+                error = fmaxf(error, fabsf(spectrum[k] - reference[k] * ratio));
+                peak = fmaxf(peak, reference[k]);
+            }
+            alpha = power[0];
+            beta = power[1];
+            frames++;
+            StftReleaseFrame(&stft);
+        }
+    }
+    CHECK(frames == (SIGNAL - N) / HOP + 1);
+    CHECK(pushed == frames);
+    CHECK(stft.dropped == 0);
+    CHECK(error < 1e-4f * peak);
+    /* band power is the mean square of each tone: 2^2 / 2 and 0.5^2 / 2 */
+    CHECK(fabsf(alpha - 2.0f) < 0.01f);
+    CHECK(fabsf(beta - 0.125f) < 0.005f);
+    printf("frames: %u, max. difference with scaled FFTReal() %.2e (peak %.3f), alpha %.4f, beta %.4f\n",
+           frames, error, peak, alpha, beta);
+}
+
+/**
+ * @brief Band power does not depend on the window, spectra are stored in each format
+ */
+static void TestWindows(void){
+    static const char *names[] = {"Hann", "Blackman", "Blackman-Harris", "flat top", "rect"};
+    stft_t stft, stft_db;
+    static float input_db[STFT_INPUT_SIZE(N)], spectra_db[STFT_SPECTRA_SIZE(N, FRAMES)];
+    static float band_power_db[STFT_BANDS_SIZE(2, FRAMES)];
+    const float *spectrum, *spectrum_db, *power;
+    for(stft_window_t w = STFT_WINDOW_HANN; w <= STFT_WINDOW_RECT; w++){
+        stft_config_t config = Config(w, FFT_POWER);
+        stft_config_t config_db = Config(w, FFT_DB);
+        float db = 0;
+        CHECK(StftInit(&stft, &config, input, spectra, band_power));
+        CHECK(StftInit(&stft_db, &config_db, input_db, spectra_db, band_power_db));
+        CHECK(StftPush(&stft, signal, N) == 1);
+        CHECK(StftPush(&stft_db, signal, N) == 1);
+        CHECK(StftReadFrame(&stft, &spectrum, &power));
+        CHECK(StftReadFrame(&stft_db, &spectrum_db, NULL));
+        for(uint16_t k = 1; k < N / 2; k++){
+            if(spectrum[k] > 1e-6f){
+                db = fmaxf(db, fabsf(spectrum_db[k] - 10 * log10f(spectrum[k])));
+            }
+        }
+        CHECK(db < 1e-3f);
+        /* the rectangular window leaks the alpha tone (between bins) into the beta band,
+           the main lobe of the flat top window is wider than the alpha band */
+        if(w < STFT_WINDOW_FLAT_TOP){
+            CHECK(fabsf(power[0] - 2.0f) < 0.01f);
+            CHECK(fabsf(power[1] - 0.125f) < 0.005f);
+        }
+        else{
+            CHECK(fabsf(power[0] + power[1] - 2.125f) < 0.1f);
+        }
+        printf("%-16s alpha %.4f, beta %.4f\n", names[w], power[0], power[1]);
+    }
+}
+
+/**
+ * @brief A full ring drops frames until the consumer releases one, band-only instances
+ */
+static void TestRing(void){
+    stft_t stft;
+    stft_config_t config = Config(STFT_WINDOW_HANN, FFT_MAGNITUDE);
+    const float *spectrum, *power;
+    CHECK(StftInit(&stft, &config, input, spectra, band_power));
+    CHECK(StftPush(&stft, signal, N - 1) == 0);
+    CHECK(StftFramesAvailable(&stft) == 0);
+    CHECK(StftPush(&stft, &signal[N - 1], 1 + (FRAMES + 1) * HOP) == FRAMES);
+    CHECK(StftFramesAvailable(&stft) == FRAMES);
+    CHECK(stft.dropped == 2);
+    StftReleaseFrame(&stft);
+    CHECK(StftPush(&stft, &signal[N + (FRAMES + 1) * HOP], HOP) == 1);
+    CHECK(stft.dropped == 2);
+    for(uint8_t i = 0; i < FRAMES; i++){
+        CHECK(StftReadFrame(&stft, &spectrum, &power));
+        StftReleaseFrame(&stft);
+    }
+    CHECK(!StftReadFrame(&stft, &spectrum, &power));
+    StftReleaseFrame(&stft);
+    CHECK(StftFramesAvailable(&stft) == 0);
+    StftReset(&stft);
+    CHECK((stft.dropped == 0) && (stft.filled == 0));
+    /* without spectra ring */
+    CHECK(StftInit(&stft, &config, input, NULL, band_power));
+    CHECK(StftPush(&stft, signal, N) == 1);
+    CHECK(StftReadFrame(&stft, &spectrum, &power));
+    CHECK(spectrum == NULL);
+    CHECK(fabsf(power[0] - 2.0f) < 0.02f);
+}
+
+static void Benchmark(uint32_t hops){
+    stft_t stft;
+    stft_config_t config = Config(STFT_WINDOW_HANN, FFT_MAGNITUDE);
+    static float frame[N], spectrum[N / 2];
+    double t_app, t_stft;
+    uint32_t pos = 0;
+    CHECK(StftInit(&stft, &config, input, spectra, band_power));
+    StftPush(&stft, signal, N);
+    HOST_BENCH(t_app, 5, hops, {
+        pos = (pos + HOP) % (SIGNAL - N);
+        memcpy(frame, &signal[pos], sizeof(frame));
+        FFTReal(frame, spectrum, N, FFT_MAGNITUDE);
+    });
+    HOST_BENCH(t_stft, 5, hops, {
+        pos = (pos + HOP) % (SIGNAL - N);
+        StftPush(&stft, &signal[pos], HOP);
+        StftReleaseFrame(&stft);
+    });
+    CHECK(spectrum[10] > 0);
+    CHECK(stft.dropped == 0);
+    printf("N = %d, hop %d, us per frame (best of 5 runs):\n", N, HOP);
+    printf("  copy + FFTReal():         %6.2f\n", t_app);
+    printf("  StftPush() + 2 bands:     %6.2f\n", t_stft);
+}
+
+/*==================[external functions definition]==========================*/
+int main(int argc, char *argv[]){
+    uint32_t hops = (argc > 1) ? strtoul(argv[1], NULL, 0) : BENCH_HOPS;
+    CHECK(FFTInit());
+    Signal();
+    TestConfig();
+    TestFrames();
+    TestWindows();
+    TestRing();
+    Benchmark(hops);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/
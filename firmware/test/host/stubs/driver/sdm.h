@@ -0,0 +1,17 @@
+/* Host stub of driver/sdm.h (declarations only) */
+#pragma once
+#include "esp_err.h"
+
+typedef struct sdm_channel_t *sdm_channel_handle_t;
+
+#define SDM_CLK_SRC_DEFAULT     0
+
+typedef struct {
+    int gpio_num;
+    int clk_src;
+    uint32_t sample_rate_hz;
+} sdm_config_t;
+
+esp_err_t sdm_new_channel(const sdm_config_t *config, sdm_channel_handle_t *ret_chan);
+esp_err_t sdm_channel_enable(sdm_channel_handle_t chan);
+esp_err_t sdm_channel_set_pulse_density(sdm_channel_handle_t chan, int8_t density);
@@ -0,0 +1,15 @@
+/* Host stub of esp_adc/adc_cali_scheme.h (declarations only) */
+#pragma once
+#include "esp_adc/adc_oneshot.h"
+
+typedef struct adc_cali_scheme_t *adc_cali_handle_t;
+
+typedef struct {
+    adc_unit_t unit_id;
+    adc_channel_t chan;
+    adc_atten_t atten;
+    adc_bitwidth_t bitwidth;
+} adc_cali_curve_fitting_config_t;
+
+esp_err_t adc_cali_create_scheme_curve_fitting(const adc_cali_curve_fitting_config_t *config, adc_cali_handle_t *ret_handle);
+esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t handle, int raw, int *voltage);
@@ -0,0 +1,5 @@
+/* Host stub of esp_attr.h */
+#pragma once
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define WORD_ALIGNED_ATTR       __attribute__((aligned(4)))
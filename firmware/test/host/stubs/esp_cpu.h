@@ -0,0 +1,10 @@
+/* Host stub of esp_cpu.h: the cycle counter runs at 1 GHz of host time */
+#pragma once
+#include <stdint.h>
+#include <time.h>
+
+static inline uint32_t esp_cpu_get_cycle_count(void){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint32_t)(t.tv_sec * 1000000000ULL + t.tv_nsec);
+}
@@ -0,0 +1,8 @@
+/* Host stub of esp_intr_alloc.h (declarations only) */
+#pragma once
+#include "esp_err.h"
+
+typedef struct intr_handle_data_t *intr_handle_t;
+typedef void (*intr_handler_t)(void *arg);
+
+esp_err_t esp_intr_alloc(int source, int flags, intr_handler_t handler, void *arg, intr_handle_t *ret_handle);
@@ -0,0 +1,5 @@
+/* Host stub of esp_rom_sys.h (declarations only) */
+#pragma once
+#include <stdint.h>
+
+void esp_rom_delay_us(uint32_t us);
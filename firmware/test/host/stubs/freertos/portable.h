@@ -0,0 +1,3 @@
+/* Host stub of freertos/portable.h */
+#pragma once
+#include "freertos/FreeRTOS.h"
@@ -0,0 +1,11 @@
+/* Host stub of freertos/queue.h (declarations only) */
+#pragma once
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+typedef void * QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks);
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void *item, BaseType_t *higher_priority_task_woken);
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks);
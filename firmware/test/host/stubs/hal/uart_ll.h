@@ -0,0 +1,28 @@
+/* Host stub of hal/uart_ll.h (declarations only: the inline functions of IDF are model functions) */
+#pragma once
+#include <stdint.h>
+#include "driver/uart.h"
+
+typedef struct uart_dev_s uart_dev_t;
+extern uart_dev_t UART0;
+extern uart_dev_t UART1;
+
+#define UART_LL_GET_HW(num)     (((num) == UART_NUM_0) ? (&UART0) : (&UART1))
+#define UART_LL_INTR_MASK       (0x7ffff)
+
+typedef enum {
+    UART_INTR_RXFIFO_FULL   = (0x1 << 0),
+    UART_INTR_TXFIFO_EMPTY  = (0x1 << 1),
+    UART_INTR_RXFIFO_OVF    = (0x1 << 4),
+    UART_INTR_RXFIFO_TOUT   = (0x1 << 8),
+} uart_intr_t;
+
+uint32_t uart_ll_get_rxfifo_len(uart_dev_t *hw);
+void uart_ll_read_rxfifo(uart_dev_t *hw, uint8_t *buf, uint32_t rd_len);
+uint32_t uart_ll_get_txfifo_len(uart_dev_t *hw);
+void uart_ll_write_txfifo(uart_dev_t *hw, const uint8_t *buf, uint32_t wr_len);
+void uart_ll_ena_intr_mask(uart_dev_t *hw, uint32_t mask);
+void uart_ll_disable_intr_mask(uart_dev_t *hw, uint32_t mask);
+uint32_t uart_ll_get_intsts_mask(uart_dev_t *hw);
+void uart_ll_clr_intsts_mask(uart_dev_t *hw, uint32_t mask);
+void uart_ll_rxfifo_rst(uart_dev_t *hw);
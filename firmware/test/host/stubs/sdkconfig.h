@@ -0,0 +1,6 @@
+/* Host stub of sdkconfig.h: esp-dsp built with its ANSI C kernels */
+#pragma once
+#define CONFIG_IDF_TARGET_ESP32C6   1
+#define CONFIG_DSP_ANSI             1
+#define CONFIG_DSP_OPTIMIZED        0
+#define CONFIG_DSP_MAX_FFT_SIZE     4096
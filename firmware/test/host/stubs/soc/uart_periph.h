@@ -0,0 +1,9 @@
+/* Host stub of soc/uart_periph.h (declarations only) */
+#pragma once
+#include <stdint.h>
+
+typedef struct {
+    uint8_t irq;
+} uart_signal_conn_t;
+
+extern const uart_signal_conn_t uart_periph_signal[];
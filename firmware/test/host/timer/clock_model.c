@@ -0,0 +1,106 @@
+/**
+ * @file clock_model.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Simulated clock of the hardware timers and serial port capture (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Timers are created in order (TIMER_A, TIMER_B, TIMER_C) by the first TimerInit() of each.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <string.h>
+#include "clock_model.h"
+#include "driver/gptimer.h"
+#include "esp_timer.h"
+#include "uart_mcu.h"
+/*==================[internal data declaration]==============================*/
+struct gptimer_t {
+    int64_t last_alarm;                     /* Time of the last alarm (count restarts) */
+    uint64_t period;                        /* Alarm count */
+    gptimer_event_callbacks_t cbs;
+    void *user_data;
+};
+/*==================[internal data definition]===============================*/
+static struct gptimer_t gptimers[CLOCK_MODEL_TIMERS];
+static uint8_t n_gptimers;
+/*==================[external data declaration]==============================*/
+extern gptimer_handle_t timer_a, timer_b, timer_c;
+/*==================[external data definition]===============================*/
+clock_model_t clock_model;
+/*==================[external functions definition]==========================*/
+void ClockModelAlarm(timer_mcu_t timer, int64_t alarm_us, int64_t entry_us){
+    gptimer_handle_t handle = (timer == TIMER_A) ? timer_a : (timer == TIMER_B) ? timer_b : timer_c;
+    gptimer_alarm_event_data_t edata = {
+        .count_value = entry_us - alarm_us,
+        .alarm_value = handle->period,
+    };
+    handle->last_alarm = alarm_us;
+    handle->cbs.on_alarm(handle, &edata, handle->user_data);
+}
+
+esp_err_t gptimer_new_timer(const gptimer_config_t *config, gptimer_handle_t *ret_timer){
+    *ret_timer = &gptimers[n_gptimers++];
+    return ESP_OK;
+}
+
+esp_err_t gptimer_set_alarm_action(gptimer_handle_t timer, const gptimer_alarm_config_t *config){
+    timer->period = config->alarm_count;
+    return ESP_OK;
+}
+
+esp_err_t gptimer_register_event_callbacks(gptimer_handle_t timer, const gptimer_event_callbacks_t *cbs, void *user_data){
+    timer->cbs = *cbs;
+    timer->user_data = user_data;
+    return ESP_OK;
+}
+
+esp_err_t gptimer_enable(gptimer_handle_t timer){
+    return ESP_OK;
+}
+
+esp_err_t gptimer_disable(gptimer_handle_t timer){
+    return ESP_OK;
+}
+
+esp_err_t gptimer_start(gptimer_handle_t timer){
+    timer->last_alarm = clock_model.now_us;
+    return ESP_OK;
+}
+
+esp_err_t gptimer_stop(gptimer_handle_t timer){
+    return ESP_OK;
+}
+
+esp_err_t gptimer_get_raw_count(gptimer_handle_t timer, uint64_t *value){
+    *value = (clock_model.now_us - timer->last_alarm) % timer->period;
+    return ESP_OK;
+}
+
+esp_err_t gptimer_set_raw_count(gptimer_handle_t timer, uint64_t value){
+    timer->last_alarm = clock_model.now_us - value;
+    return ESP_OK;
+}
+
+int64_t esp_timer_get_time(void){
+    return clock_model.now_us;
+}
+
+void UartSendString(uart_mcu_port_t port, const char *msg){
+    strncat(clock_model.out, msg, sizeof(clock_model.out) - strlen(clock_model.out) - 1);
+}
+
+void UartSendByte(uart_mcu_port_t port, const char *data){
+    strncat(clock_model.out, data, (strlen(clock_model.out) < sizeof(clock_model.out) - 1) ? 1 : 0);
+}
+
+uint8_t* UartItoa(uint32_t val, uint8_t base){
+    static char text[12];
+    snprintf(text, sizeof(text), "%u", val);
+    return (uint8_t *)text;
+}
+
+/*==================[end of file]============================================*/
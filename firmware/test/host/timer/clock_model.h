@@ -0,0 +1,44 @@
+/**
+ * @file clock_model.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Simulated clock of the hardware timers and serial port capture (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Time only advances when the test (or a callback) changes clock_model.now_us. The gptimer
+ * count restarts on each alarm (auto-reload), so its value is the time since the last alarm.
+ * ClockModelAlarm() runs the ISR of a timer as the gptimer driver does.
+ */
+#ifndef CLOCK_MODEL_H_
+#define CLOCK_MODEL_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include "timer_mcu.h"
+/*==================[macros and definitions]=================================*/
+#define CLOCK_MODEL_TIMERS      3       /* TIMER_A, TIMER_B and TIMER_C */
+#define CLOCK_MODEL_OUT_SIZE    4096    /* Serial port capture */
+/*==================[typedef]================================================*/
+/**
+ * @brief Simulated clock state
+ */
+typedef struct {
+    int64_t now_us;                         /* System time (esp_timer and gptimer time base) */
+    char out[CLOCK_MODEL_OUT_SIZE];         /* Text sent to the serial ports */
+} clock_model_t;
+/*==================[external data declaration]==============================*/
+extern clock_model_t clock_model;
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Alarm of a timer: runs its ISR (the callback starts at clock_model.now_us)
+ *
+ * @param timer         Timer
+ * @param alarm_us      Time of the alarm
+ * @param entry_us      Time of the ISR entry (count captured by the gptimer driver)
+ */
+void ClockModelAlarm(timer_mcu_t timer, int64_t alarm_us, int64_t entry_us);
+
+#endif /* CLOCK_MODEL_H_ */
+/*==================[end of file]============================================*/
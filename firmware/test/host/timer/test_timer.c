@@ -0,0 +1,148 @@
+/**
+ * @file test_timer.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of the alarm timing statistics of the timer driver (simulated clock)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * TIMER_B runs ALARMS alarms of 1 ms with random ISR latency (2% masked up to 500 us),
+ * 1 to 3 us dispatch and 0.1% callbacks longer than the period (the next ISR waits for them).
+ * Every count, min/max/mean, histogram bin and the last expected/actual times must match an
+ * independent reference. TIMER_A alarms in between must not be recorded on TIMER_B. Reset
+ * and the serial port dump are checked too.
+ * Built with TIMER_MCU_STATS as 0 only the callbacks are checked (the statistics API does
+ * not exist).
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "clock_model.h"
+#include "timer_mcu.h"
+/*==================[macros and definitions]=================================*/
+#define ALARMS          100000      /* Alarms of TIMER_B */
+#define PERIOD_US       1000        /* Period of TIMER_B */
+#define OTHER_EVERY     100         /* TIMER_A alarms every this TIMER_B alarms */
+/*==================[internal data declaration]==============================*/
+#if TIMER_MCU_STATS
+/**
+ * @brief Reference accumulator
+ */
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t hist[TIMER_STATS_BINS];
+} reference_t;
+#endif
+/*==================[internal data definition]===============================*/
+static uint32_t callback_us;        /* Duration of the next callback */
+static uint32_t calls[2];
+/*==================[internal functions definition]==========================*/
+static void Callback(void *param){
+    calls[(uintptr_t)param]++;
+    clock_model.now_us += callback_us;
+}
+
+#if TIMER_MCU_STATS
+static void ReferenceAdd(reference_t *ref, uint32_t value){
+    uint8_t bin = 0;
+    while(bin < TIMER_STATS_BINS - 1 && value >= (1u << bin)){
+        bin++;
+    }
+    ref->min = (value < ref->min) ? value : ref->min;
+    ref->max = (value > ref->max) ? value : ref->max;
+    ref->sum += value;
+    ref->hist[bin]++;
+}
+
+static void ReferenceCheck(const char *name, const reference_t *ref, const timer_stat_t *stat, uint32_t alarms){
+    bool match = ref->min == stat->min && ref->max == stat->max && ref->sum / alarms == stat->mean &&
+                 memcmp(ref->hist, stat->hist, sizeof(ref->hist)) == 0;
+    printf("%-12s min %4u mean %4u max %4u | hist", name, stat->min, stat->mean, stat->max);
+    for(uint8_t i = 0; i < TIMER_STATS_BINS; i++){
+        printf(" %u", stat->hist[i]);
+    }
+    printf("%s\n", match ? "" : "  MISMATCH");
+    CHECK(match);
+}
+#endif
+/*==================[external functions definition]==========================*/
+int main(void){
+    timer_config_t config_b = {.timer = TIMER_B, .period = PERIOD_US, .func_p = Callback, .param_p = (void *)0};
+    timer_config_t config_a = {.timer = TIMER_A, .period = 10 * PERIOD_US, .func_p = Callback, .param_p = (void *)1};
+    int64_t free_at = 0;
+#if TIMER_MCU_STATS
+    int64_t expected = 0, actual = 0;
+    uint32_t overruns = 0;
+    reference_t lateness = {.min = UINT32_MAX}, isr_latency = {.min = UINT32_MAX};
+    reference_t dispatch = {.min = UINT32_MAX}, duration = {.min = UINT32_MAX};
+    timer_stats_t stats;
+#endif
+
+    TimerInit(&config_b);
+    TimerInit(&config_a);
+    TimerStart(TIMER_B);
+    TimerStart(TIMER_A);
+    srand(3);
+    for(uint32_t k = 1; k <= ALARMS; k++){
+        int64_t alarm = (int64_t)k * PERIOD_US;
+        /* Alarm to ISR entry (masked interrupts now and then), the ISR waits for the previous callback */
+        uint32_t latency = (rand() % 100 < 2) ? 100 + rand() % 400 : 2 + rand() % 8;
+        uint32_t dispatch_us = 1 + rand() % 3;
+        int64_t entry = (alarm + latency > free_at) ? alarm + latency : free_at;
+        callback_us = (rand() % 1000 == 0) ? 1200 + rand() % 200 : 20 + rand() % 100;
+        clock_model.now_us = entry + dispatch_us;
+#if TIMER_MCU_STATS
+        overruns += (callback_us >= PERIOD_US);
+        expected = alarm;
+        actual = clock_model.now_us;
+        ReferenceAdd(&lateness, clock_model.now_us - alarm);
+        ReferenceAdd(&isr_latency, entry - alarm);
+        ReferenceAdd(&dispatch, clock_model.now_us - entry);
+        ReferenceAdd(&duration, callback_us);
+#endif
+        ClockModelAlarm(TIMER_B, alarm, entry);
+        free_at = clock_model.now_us;
+        if(k % OTHER_EVERY == 0){
+            callback_us = 5;
+            clock_model.now_us = free_at;
+            ClockModelAlarm(TIMER_A, free_at, free_at);
+            free_at = clock_model.now_us;
+        }
+    }
+    printf("%u alarms of TIMER_B, %u of TIMER_A\n", calls[0], calls[1]);
+    CHECK(calls[0] == ALARMS);
+    CHECK(calls[1] == ALARMS / OTHER_EVERY);
+#if TIMER_MCU_STATS
+    TimerGetStats(TIMER_B, &stats, false);
+    printf("alarms %u, overruns %u (reference %u), last expected %lld (reference %lld), actual %lld (reference %lld)\n",
+           stats.alarms, stats.overruns, overruns, (long long)stats.expected, (long long)expected,
+           (long long)stats.actual, (long long)actual);
+    CHECK(stats.alarms == ALARMS);
+    CHECK(stats.overruns == overruns);
+    CHECK(stats.expected == expected && stats.actual == actual);
+    ReferenceCheck("lateness", &lateness, &stats.lateness, ALARMS);
+    ReferenceCheck("isr latency", &isr_latency, &stats.isr_latency, ALARMS);
+    ReferenceCheck("dispatch", &dispatch, &stats.dispatch, ALARMS);
+    ReferenceCheck("duration", &duration, &stats.duration, ALARMS);
+
+    TimerStatsDump(TIMER_B, UART_PC);
+    printf("--- serial port ---\n%s-------------------\n", clock_model.out);
+    CHECK(strncmp(clock_model.out, "Timer B: alarms 100000, overruns ", 33) == 0);
+    CHECK(strstr(clock_model.out, "\r\nduration: min ") != NULL);
+
+    TimerGetStats(TIMER_A, &stats, false);
+    CHECK(stats.alarms == ALARMS / OTHER_EVERY && stats.isr_latency.max == 0);
+    TimerGetStats(TIMER_B, &stats, true);
+    TimerGetStats(TIMER_B, &stats, false);
+    CHECK(stats.alarms == 0 && stats.lateness.min == 0 && stats.lateness.max == 0 && stats.lateness.hist[0] == 0);
+    TimerGetStats(TIMER_C, &stats, false);
+    CHECK(stats.alarms == 0);
+#endif
+    return HOST_TEST_RESULT();
+}
+/*==================[end of file]============================================*/
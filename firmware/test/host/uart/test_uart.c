@@ -0,0 +1,313 @@
+/**
+ * @file test_uart.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host loopback simulation of the UART stream mode (throughput, drops and wake-ups)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Frames (8-byte header, payload and 2-byte CRC, from a pool of 4 application buffers) are
+ * sent on UART_PC at 921600 baud with its TX wired to its RX (see uart_model.h):
+ * - previous driver (uart_mcu_prev.c) and send functions of the driver: every byte offered
+ *   must reach the line (the previous driver is expected to drop bytes).
+ * - stream mode: frames are queued as 3 segments, a consumer reads the ring buffer in place
+ *   when woken and checks every byte against what was queued. Blocking UartSendString()
+ *   lines are interleaved in some cases. With the line overloaded whole frames are rejected;
+ *   with a slow consumer the ring buffer overflows, but no byte is lost without being counted.
+ *   A consumer that replies on the port takes TX completions while the producer waits for
+ *   each frame: UartStreamWaitTx() must still return once the queue is empty.
+ * Each case runs in a child process (stream mode is initialized once per port).
+ * Usage: test_uart [seconds]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "host_test.h"
+#include "uart_model.h"
+#include "uart_mcu.h"
+#include "uart_mcu_prev.h"
+/*==================[macros and definitions]=================================*/
+#define SECONDS         10          /* Default simulated time of each case */
+#define POOL            4           /* Frame buffers of the application */
+#define HEADER          8
+#define CRC             2
+#define MAX_PAYLOAD     512
+#define LOG_SIZE        (1 << 24)   /* Bytes queued, in line order (power of 2) */
+#define TEXT_MS         100         /* Period of the status lines */
+#define DRAIN_STEPS     2000        /* Characters waited at the end of a case */
+#define REPLY_BYTES     256         /* Bytes received between replies */
+/*==================[internal data declaration]==============================*/
+typedef enum {
+    SEND_PREV,                      /* Previous driver, UartSendBuffer() */
+    SEND_BLOCKING,                  /* UartSendBuffer() */
+    SEND_STREAM                     /* UartStreamSendSegments() */
+} send_mode_t;
+
+/**
+ * @brief Simulated case
+ */
+typedef struct {
+    const char *name;
+    send_mode_t mode;
+    uint16_t payload;               /* Payload bytes of each frame */
+    float rate_hz;                  /* Frames per second offered */
+    uint32_t ring;                  /* RX ring buffer size */
+    uint32_t notify;                /* rx_notify */
+    uint32_t latency_us;            /* From the notification to the consumer run */
+    uint32_t budget;                /* Bytes read per consumer run (0: all) */
+    bool text;                      /* Interleave UartSendString() status lines */
+    bool reply;                     /* The consumer replies with UartSendString() every REPLY_BYTES */
+} uart_case_t;
+
+/**
+ * @brief Frame buffer of the application
+ */
+typedef struct {
+    uint8_t header[HEADER];
+    uint8_t payload[MAX_PAYLOAD];
+    uint8_t crc[CRC];
+    bool busy;                      /* Queued, waiting for the completion callback */
+} frame_t;
+/*==================[internal data definition]===============================*/
+static const uart_case_t cases[] = {
+    {"previous driver, 512 B at 166 Hz", SEND_PREV, 512, 166},
+    {"send functions, 512 B at 166 Hz", SEND_BLOCKING, 512, 166},
+    {"stream, 512 B at 166 Hz + text", SEND_STREAM, 512, 166, 4096, 512, 1000, 0, true},
+    {"stream, 64 B at 1 kHz", SEND_STREAM, 64, 1000, 4096, 512, 1000, 0, false},
+    {"stream, notify each transfer", SEND_STREAM, 512, 166, 4096, 0, 1000, 0, false},
+    {"stream, 512 B at 200 Hz (overload)", SEND_STREAM, 512, 200, 4096, 512, 1000, 0, true},
+    {"stream, slow consumer", SEND_STREAM, 512, 166, 1024, 512, 30000, 512, false},
+    {"stream, consumer replies", SEND_STREAM, 512, 100, 4096, 128, 100, 0, false, true},
+};
+static const uart_case_t *test;
+static frame_t pool[POOL];
+static uint8_t rx_buffer[1 << 16];
+static uint8_t *sent_log;
+static uint64_t log_w, log_r, mismatches, offered, frames, skipped, wakeups;
+static uint32_t consumer;           /* Notification counter of the consumer task */
+static uint64_t consumer_run_at;
+static uint64_t replies, reply_bytes;
+static bool consumer_running;
+/*==================[internal functions definition]==========================*/
+static void Log(const uint8_t *data, uint32_t n){
+    for(uint32_t i = 0; i < n; i++){
+        sent_log[log_w++ & (LOG_SIZE - 1)] = data[i];
+    }
+}
+
+/* Consumer task: runs latency_us after a notification, reads spans in place */
+static void Consumer(void){
+    uint32_t budget = test->budget ? test->budget : UINT32_MAX;
+    const uint8_t *span;
+    uint32_t n;
+
+    if(consumer == 0 || consumer_running){
+        return;
+    }
+    if(consumer_run_at == 0){
+        consumer_run_at = uart_model.now + test->latency_us / UART_MODEL_CHAR_US;
+    }
+    if(uart_model.now < consumer_run_at){
+        return;
+    }
+    consumer = 0;
+    consumer_run_at = 0;
+    wakeups++;
+    while(budget > 0 && (span = UartStreamRxSpan(UART_PC, &n)) != NULL && n > 0){
+        n = (n < budget) ? n : budget;
+        for(uint32_t i = 0; i < n; i++){
+            mismatches += (span[i] != sent_log[log_r++ & (LOG_SIZE - 1)]);
+        }
+        UartStreamRxRelease(UART_PC, n);
+        budget -= n;
+        reply_bytes += n;
+    }
+    /* A second task sending on the port: it takes TX completions the main task may wait for */
+    if(test->reply && reply_bytes >= REPLY_BYTES){
+        static const char ack[] = "ack\r\n";
+        reply_bytes = 0;
+        replies++;
+        consumer_running = true;
+        Log((const uint8_t *)ack, sizeof(ack) - 1);
+        UartSendString(UART_PC, ack);
+        consumer_running = false;
+    }
+}
+
+static void FrameDone(void *param){
+    ((frame_t *)param)->busy = false;
+}
+
+static void Produce(uint32_t seq){
+    frame_t *frame = NULL;
+    uint16_t crc = 0;
+
+    offered += HEADER + test->payload + CRC;
+    for(uint8_t i = 0; i < POOL && frame == NULL; i++){
+        frame = pool[i].busy ? NULL : &pool[i];
+    }
+    if(frame == NULL){
+        skipped++;
+        return;
+    }
+    frame->header[0] = 0xA5;
+    frame->header[1] = 0x5A;
+    memcpy(&frame->header[2], &seq, 4);
+    memcpy(&frame->header[6], &test->payload, 2);
+    for(uint16_t i = 0; i < test->payload; i++){
+        frame->payload[i] = rand();
+        crc += frame->payload[i];
+    }
+    memcpy(frame->crc, &crc, CRC);
+    if(test->mode == SEND_STREAM){
+        uart_segment_t segments[3] = {{frame->header, HEADER}, {frame->payload, test->payload}, {frame->crc, CRC}};
+        frame->busy = true;
+        if(!UartStreamSendSegments(UART_PC, segments, 3, FrameDone, frame)){
+            frame->busy = false;
+            skipped++;
+            return;
+        }
+    }
+    Log(frame->header, HEADER);
+    Log(frame->payload, test->payload);
+    Log(frame->crc, CRC);
+    if(test->mode != SEND_STREAM){
+        /* Contiguous frame, sent in pieces of up to 255 bytes */
+        static uint8_t buffer[HEADER + MAX_PAYLOAD + CRC];
+        uint32_t length = HEADER + test->payload + CRC;
+        memcpy(buffer, frame->header, HEADER);
+        memcpy(buffer + HEADER, frame->payload, test->payload);
+        memcpy(buffer + HEADER + test->payload, frame->crc, CRC);
+        for(uint32_t offset = 0; offset < length; offset += 255){
+            uint8_t n = (length - offset > 255) ? 255 : length - offset;
+            if(test->mode == SEND_PREV){
+                PrevUartSendBuffer(UART_PC, (const char *)buffer + offset, n);
+            } else{
+                UartSendBuffer(UART_PC, (const char *)buffer + offset, n);
+            }
+        }
+    }
+    frames++;
+}
+
+static int RunCase(double seconds){
+    static const char status[] = "status: ok\r\n";
+    uint64_t steps = seconds * 1e6 / UART_MODEL_CHAR_US, next = 0, text_next = 0;
+    double period = 1e6 / test->rate_hz / UART_MODEL_CHAR_US;
+    uint32_t seq = 0;
+    uart_stream_stats_t stats;
+
+    UartModelReset();
+    sent_log = malloc(LOG_SIZE);
+    if(test->mode == SEND_STREAM){
+        uart_stream_config_t config = {
+            .port = UART_PC,
+            .baud_rate = UART_MODEL_BAUD,
+            .rx_buffer = rx_buffer,
+            .rx_size = test->ring,
+            .rx_notify = test->notify,
+            .rx_idle = 4,
+            .consumer = &consumer,
+        };
+        CHECK(UartStreamInit(&config));
+        CHECK(!UartStreamInit(&config));
+        uart_model.step_hook = Consumer;
+    } else{
+        serial_config_t config = {.port = UART_PC, .baud_rate = UART_MODEL_BAUD, .func_p = UART_NO_INT};
+        if(test->mode == SEND_PREV){
+            PrevUartInit(&config);
+        } else{
+            UartInit(&config);
+        }
+    }
+    while(uart_model.now < steps){
+        if(uart_model.now >= next){
+            Produce(seq++);
+            next = seq * period;
+            if(test->reply){
+                /* Wait for the frame while the consumer replies on the same port */
+                UartStreamWaitTx(UART_PC, 0);
+            }
+        }
+        if(test->text && uart_model.now >= text_next){
+            text_next = uart_model.now + TEXT_MS * 1000 / UART_MODEL_CHAR_US;
+            Log((const uint8_t *)status, sizeof(status) - 1);
+            UartSendString(UART_PC, status);
+        }
+        UartModelStep();
+    }
+    if(test->mode == SEND_STREAM){
+        UartStreamWaitTx(UART_PC, 0);
+        CHECK(UartStreamTxPending(UART_PC) == 0);
+    }
+    for(uint32_t i = 0; i < DRAIN_STEPS; i++){
+        UartModelStep();
+    }
+
+    double elapsed = uart_model.now * UART_MODEL_CHAR_US / 1e6;
+    double line = uart_model.line_bytes / elapsed;
+    double kb = uart_model.line_bytes / 1024.0;
+    uint64_t drops = log_w - uart_model.line_bytes;
+    printf("%-36s offered %6.0f B/s, line %6.0f B/s (%5.1f%%), frames %llu, rejected %llu, tx drops %llu (%.1f%%)\n",
+           test->name, offered / elapsed, line, 100.0 * line / (UART_MODEL_BAUD / 10),
+           (unsigned long long)frames, (unsigned long long)skipped, (unsigned long long)drops, 100.0 * drops / log_w);
+    if(test->mode != SEND_STREAM){
+        printf("%-36s driver calls/KB %.1f\n", "", uart_model.tx_calls / kb);
+        if(test->mode == SEND_PREV){
+            CHECK(drops > 0);
+        } else{
+            CHECK(drops == 0);
+        }
+        return host_test_failures;
+    }
+    UartStreamGetStats(UART_PC, &stats, false);
+    printf("%-36s interrupts/KB %.1f, wake-ups/KB %.2f, rx %u, rx dropped %u, FIFO overflows %u, mismatches %llu\n",
+           "", uart_model.interrupts / kb, wakeups / kb, stats.rx_bytes, stats.rx_dropped, stats.rx_overflows,
+           (unsigned long long)mismatches);
+    if(test->reply){
+        printf("%-36s %llu replies\n", "", (unsigned long long)replies);
+        CHECK(replies >= frames);
+    }
+    CHECK(drops == 0);
+    CHECK(stats.rx_overflows == 0);
+    CHECK(stats.tx_bytes == uart_model.line_bytes);
+    CHECK(stats.rx_bytes + stats.rx_dropped == uart_model.line_bytes);
+    if(test->budget == 0){
+        CHECK(stats.rx_dropped == 0);
+        CHECK(mismatches == 0);
+        CHECK(log_r == log_w);
+    } else{
+        CHECK(stats.rx_dropped > 0);
+    }
+    if(test->rate_hz * (HEADER + test->payload + CRC) > UART_MODEL_BAUD / 10){
+        CHECK(line > 0.99 * UART_MODEL_BAUD / 10);
+        CHECK(skipped > 0);
+    } else{
+        CHECK(skipped == 0);
+    }
+    return host_test_failures;
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char ** argv){
+    double seconds = (argc > 1) ? atof(argv[1]) : SECONDS;
+
+    for(uint8_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++){
+        int status;
+        fflush(stdout);
+        if(fork() == 0){
+            test = &cases[i];
+            exit(RunCase(seconds) ? 1 : 0);
+        }
+        wait(&status);
+        if(!WIFEXITED(status) || WEXITSTATUS(status) != 0){
+            printf("%s: failed\n", cases[i].name);
+            host_test_failures++;
+        }
+    }
+    return HOST_TEST_RESULT();
+}
+/*==================[end of file]============================================*/
@@ -0,0 +1,318 @@
+/**
+ * @file uart_mcu_prev.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief UART driver before the stream mode (reference for the host test)
+ * @version 0.1
+ * @date 2024-02-07
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Copy of uart_mcu.c as it was before the stream mode, renamed with the Prev prefix
+ * (reference for the host test): send functions write with uart_tx_chars(), that only takes
+ * what fits in the TX FIFO.
+ */
+
+/*==================[inclusions]=============================================*/
+#include "uart_mcu.h"
+#include "uart_mcu_prev.h"
+#include "gpio_mcu.h"
+#include "ring_buffer_mcu.h"
+#include "driver/uart.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "esp_log.h"
+/*==================[macros and definitions]=================================*/
+#define UART_CONN_TX        GPIO_18         /*!<  */
+#define UART_CONN_RX        GPIO_19         /*!<  */
+#define TX_BUFFER_SIZE      256             /*!<  */
+#define RX_BUFFER_SIZE      256             /*!<  */
+#define EVENT_QUEUE_SIZE    16              /*!<  */
+#define READ_TIMEOUT        100             /*!<  */
+/*==================[internal data declaration]==============================*/
+void (*prev_uart_pc_isr_p)(void*);	            /*!<  */
+void (*prev_uart_conn_isr_p)(void*);	            /*!<  */
+void *prev_uart_pc_user_data;	                /*!<  */
+void *prev_uart_conn_user_data;	                /*!<  */
+static QueueHandle_t uart_pc_queue;         /*!<  */
+static QueueHandle_t uart_conn_queue;       /*!<  */
+static uint8_t uart_pc_rx_data[RX_BUFFER_SIZE];     /*!< RX ring buffer storage for UART_PC */
+static uint8_t uart_conn_rx_data[RX_BUFFER_SIZE];   /*!< RX ring buffer storage for UART_CONNECTOR */
+static ring_buffer_t uart_pc_rx_ring;       /*!< Received bytes moved from event task to reader (UART_PC) */
+static ring_buffer_t uart_conn_rx_ring;     /*!< Received bytes moved from event task to reader (UART_CONNECTOR) */
+static bool uart_pc_rx_ring_used = false;   /*!< UART_PC received data is stored in ring buffer */
+static bool uart_conn_rx_ring_used = false; /*!< UART_CONNECTOR received data is stored in ring buffer */
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Move bytes buffered by the UART driver directly into the ring buffer free spans
+ * 
+ * @param uart_num UART port
+ * @param rb Ring buffer
+ * @return uint32_t Number of bytes moved
+ */
+static uint32_t uart_rx_to_ring(uart_port_t uart_num, ring_buffer_t *rb){
+    size_t pending = 0;
+    uint32_t span, moved = 0;
+    int length;
+    uart_get_buffered_data_len(uart_num, &pending);
+    while(pending > 0){
+        uint8_t *dst = RingBufferWriteReserve(rb, &span);
+        if(span == 0){
+            // ring full: bytes remain in driver buffer until the reader frees space
+            break;
+        }
+        if(span > pending){
+            span = pending;
+        }
+        length = uart_read_bytes(uart_num, dst, span, 0);
+        if(length <= 0){
+            break;
+        }
+        RingBufferWriteCommit(rb, length);
+        pending -= length;
+        moved += length;
+    }
+    return moved;
+}
+
+/**
+ * @brief Indicates if received data of a port is moved to its ring buffer (reception callback used)
+ * 
+ * @param port Port to read from
+ * @return true Data must be read from ring buffer
+ * @return false Data must be read from UART driver
+ */
+static bool uart_ring_used(uart_mcu_port_t port){
+    return (port == UART_PC) ? uart_pc_rx_ring_used : uart_conn_rx_ring_used;
+}
+
+/**
+ * @brief Read bytes already moved to the port ring buffer (non blocking)
+ * 
+ * @param port Port to read from
+ * @param data Pointer to array where data will be stored
+ * @param nbytes Max. number of bytes to read
+ * @return uint16_t Number of bytes read
+ */
+static uint16_t uart_read_ring(uart_mcu_port_t port, uint8_t *data, uint16_t nbytes){
+    ring_buffer_t *rb = (port == UART_PC) ? &uart_pc_rx_ring : &uart_conn_rx_ring;
+    return RingBufferPop(rb, data, nbytes);
+}
+
+static void uart_pc_event_task(void *pvParameters){
+    uart_event_t event;
+    uart_driver_install(UART_NUM_0, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 16, &uart_pc_queue, 0);
+    while(1){
+        //Waiting for UART event.
+        if (xQueueReceive(uart_pc_queue, (void *)&event, (TickType_t)portMAX_DELAY)){
+            switch(event.type) {
+                case UART_DATA:
+                    while(uart_rx_to_ring(UART_NUM_0, &uart_pc_rx_ring) > 0){
+                        prev_uart_pc_isr_p(prev_uart_pc_user_data);
+                    }
+                    break;
+                case UART_BREAK:
+                    break;
+                case UART_BUFFER_FULL:
+                    break;
+                case UART_FIFO_OVF:
+                    break;
+                case UART_FRAME_ERR:
+                    break;
+                case UART_PARITY_ERR:
+                    break;
+                case UART_DATA_BREAK:
+                    break;
+                case UART_PATTERN_DET:
+                    break;
+                case UART_WAKEUP:
+                    break;
+                case UART_EVENT_MAX:
+                    break;
+            }
+        }
+    }
+}
+
+static void uart_conn_event_task(void *pvParameters){
+    uart_event_t event;
+    uart_driver_install(UART_NUM_1, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 16, &uart_conn_queue, 0);
+    while(1){
+        //Waiting for UART event.
+        if(xQueueReceive(uart_conn_queue, (void *)&event, (TickType_t)portMAX_DELAY)){
+            switch(event.type) {
+                case UART_DATA:
+                    while(uart_rx_to_ring(UART_NUM_1, &uart_conn_rx_ring) > 0){
+                        prev_uart_conn_isr_p(prev_uart_conn_user_data);
+                    }
+                    break;
+                case UART_BREAK:
+                    break;
+                case UART_BUFFER_FULL:
+                    break;
+                case UART_FIFO_OVF:
+                    break;
+                case UART_FRAME_ERR:
+                    break;
+                case UART_PARITY_ERR:
+                    break;
+                case UART_DATA_BREAK:
+                    break;
+                case UART_PATTERN_DET:
+                    break;
+                case UART_WAKEUP:
+                    break;
+                case UART_EVENT_MAX:
+                    break;
+            }
+        }
+    }
+}
+/*==================[external functions definition]==========================*/
+
+void PrevUartInit(serial_config_t *port_config){
+    uart_config_t uart_config = {
+        .baud_rate = port_config->baud_rate,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_DEFAULT,
+    };
+    switch(port_config->port){
+        case UART_PC:
+            uart_param_config(UART_NUM_0, &uart_config);
+            uart_set_pin(UART_NUM_0, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+            if(port_config->func_p != UART_NO_INT){
+                prev_uart_pc_isr_p = port_config->func_p;
+                uart_pc_queue = port_config->param_p;
+                RingBufferInit(&uart_pc_rx_ring, uart_pc_rx_data, RX_BUFFER_SIZE, sizeof(uint8_t));
+                uart_pc_rx_ring_used = true;
+                xTaskCreate(uart_pc_event_task, "uart_pc_event_task", 2048, NULL, 12, 0);
+            }else{
+                uart_driver_install(UART_NUM_0, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 0, NULL, 0);
+            }
+            break;
+        case UART_CONNECTOR:
+            uart_param_config(UART_NUM_1, &uart_config);
+            uart_set_pin(UART_NUM_1, UART_CONN_TX, UART_CONN_RX, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+            if(port_config->func_p != UART_NO_INT){
+                prev_uart_conn_isr_p = port_config->func_p;
+                uart_conn_queue = port_config->param_p;
+                RingBufferInit(&uart_conn_rx_ring, uart_conn_rx_data, RX_BUFFER_SIZE, sizeof(uint8_t));
+                uart_conn_rx_ring_used = true;
+                xTaskCreate(uart_conn_event_task, "uart_conn_event_task", 2048, NULL, 12, NULL);
+            }else{
+                uart_driver_install(UART_NUM_1, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 0, NULL, 0);
+            }
+            break;
+    }
+}
+
+uint8_t PrevUartReadByte(uart_mcu_port_t port, uint8_t* data){
+    uart_port_t uart_num = UART_NUM_0;
+    uint16_t length = 0;
+    switch(port){
+        case UART_PC:
+                uart_num = UART_NUM_0;
+            break;
+        case UART_CONNECTOR:
+                uart_num = UART_NUM_1;
+            break;
+    }
+    if(uart_ring_used(port)){
+        length = uart_read_ring(port, data, 1);
+    }else{
+        length = uart_read_bytes(uart_num, data, 1, READ_TIMEOUT);
+    }
+    if(length > 0){
+        return true;
+    } else{
+        return false;
+    }
+}
+
+uint8_t PrevUartReadBuffer(uart_mcu_port_t port, uint8_t* data, uint16_t nbytes){
+    uart_port_t uart_num = UART_NUM_0;
+    uint16_t length = 0;
+    switch(port){
+        case UART_PC:
+                uart_num = UART_NUM_0;
+            break;
+        case UART_CONNECTOR:
+                uart_num = UART_NUM_1;
+            break;
+    }
+    if(uart_ring_used(port)){
+        length = uart_read_ring(port, data, nbytes);
+    }else{
+        length = uart_read_bytes(uart_num, data, nbytes, READ_TIMEOUT);
+    }
+    if(length > 0){
+        return true;
+    } else{
+        return false;
+    }
+}
+
+void PrevUartSendByte(uart_mcu_port_t port, const char *data){
+    uart_port_t uart_num = UART_NUM_0;
+    switch(port){
+        case UART_PC:
+                uart_num = UART_NUM_0;
+            break;
+        case UART_CONNECTOR:
+                uart_num = UART_NUM_1;
+            break;
+    }
+    uart_tx_chars(uart_num, data, 1);
+}
+
+void PrevUartSendString(uart_mcu_port_t port, const char *msg){
+    uart_port_t uart_num = UART_NUM_0;
+    switch(port){
+        case UART_PC:
+                uart_num = UART_NUM_0;
+            break;
+        case UART_CONNECTOR:
+                uart_num = UART_NUM_1;
+            break;
+    }
+	while(*msg != 0){
+        uart_tx_chars(uart_num, msg, 1);
+		msg++;
+	}
+}
+
+void PrevUartSendBuffer(uart_mcu_port_t port, const char *data, uint8_t nbytes){
+    uart_port_t uart_num = UART_NUM_0;
+    switch(port){
+        case UART_PC:
+                uart_num = UART_NUM_0;
+            break;
+        case UART_CONNECTOR:
+                uart_num = UART_NUM_1;
+            break;
+    }
+    uart_tx_chars(uart_num, data, nbytes);
+}
+
+uint8_t* PrevUartItoa(uint32_t val, uint8_t base){
+	static uint8_t buf[32] = {0};
+	uint32_t i = 30;
+    if(val == 0){
+        return (uint8_t*)"0";
+    }else{
+        for(; val && i ; --i, val /= base){
+            buf[i] = "0123456789abcdef"[val % base];
+        }
+        return &buf[i+1];
+    }
+}
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,33 @@
+/**
+ * @file uart_mcu_prev.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief UART driver before the stream mode (reference for the host test)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef UART_MCU_PREV_H_
+#define UART_MCU_PREV_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include "uart_mcu.h"
+/*==================[external functions declaration]=========================*/
+void PrevUartInit(serial_config_t *port_config);
+
+uint8_t PrevUartReadByte(uart_mcu_port_t port, uint8_t* data);
+
+uint8_t PrevUartReadBuffer(uart_mcu_port_t port, uint8_t* data, uint16_t nbytes);
+
+void PrevUartSendByte(uart_mcu_port_t port, const char *data);
+
+void PrevUartSendString(uart_mcu_port_t port, const char *msg);
+
+void PrevUartSendBuffer(uart_mcu_port_t port, const char *data, uint8_t nbytes);
+
+uint8_t* PrevUartItoa(uint32_t val, uint8_t base);
+
+#endif /* UART_MCU_PREV_H_ */
+/*==================[end of file]============================================*/
@@ -0,0 +1,250 @@
+/**
+ * @file uart_model.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Loopback model of the UART and of the FreeRTOS calls of the UART driver (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The TX ring buffer of the IDF driver is not modelled: uart_write_bytes() waits for room in
+ * the FIFO, uart_tx_chars() writes what fits. UART1 keeps its registers but is not stepped.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <string.h>
+#include "uart_model.h"
+#include "driver/uart.h"
+#include "hal/uart_ll.h"
+#include "soc/uart_periph.h"
+#include "esp_intr_alloc.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+/*==================[macros and definitions]=================================*/
+#define DEADLOCK_STEPS  ((uint64_t)UART_MODEL_DEADLOCK_S * UART_MODEL_TICK_STEPS * configTICK_RATE_HZ)
+/*==================[internal data declaration]==============================*/
+struct uart_dev_s {
+    uint8_t rx[UART_MODEL_FIFO_LEN];
+    uint8_t tx[UART_MODEL_FIFO_LEN];
+    uint32_t rx_r, rx_w, tx_r, tx_w;    /* FIFO positions (free running) */
+    uint32_t ena, raw;                  /* Interrupt enable and raw status */
+    uint32_t rx_thr, tx_thr, tout;      /* RXFIFO_FULL, TXFIFO_EMPTY and RX timeout thresholds */
+    uint32_t idle;                      /* Idle characters since the last received byte */
+    bool tout_done;                     /* RX timeout already raised for this idle period */
+    bool installed;                     /* IDF driver installed */
+    intr_handler_t isr;
+    void *isr_arg;
+};
+/*==================[external data definition]===============================*/
+uart_model_t uart_model;
+uart_dev_t UART0, UART1;
+const uart_signal_conn_t uart_periph_signal[] = {{.irq = UART_NUM_0}, {.irq = UART_NUM_1}};
+/*==================[external functions definition]==========================*/
+void UartModelReset(void){
+    memset(&UART0, 0, sizeof(UART0));
+    memset(&UART1, 0, sizeof(UART1));
+    memset(&uart_model, 0, sizeof(uart_model));
+}
+
+void UartModelStep(void){
+    uart_dev_t *hw = &UART0;
+
+    uart_model.now++;
+    if(hw->tx_w != hw->tx_r){
+        uint8_t byte = hw->tx[hw->tx_r++ % UART_MODEL_FIFO_LEN];
+        uart_model.line_bytes++;
+        if(hw->rx_w - hw->rx_r == UART_MODEL_FIFO_LEN){
+            hw->raw |= UART_INTR_RXFIFO_OVF;
+        } else{
+            hw->rx[hw->rx_w++ % UART_MODEL_FIFO_LEN] = byte;
+        }
+        hw->idle = 0;
+        hw->tout_done = false;
+    } else{
+        hw->idle++;
+    }
+    if((hw->rx_w != hw->rx_r) && (hw->idle >= hw->tout) && !hw->tout_done){
+        hw->raw |= UART_INTR_RXFIFO_TOUT;
+        hw->tout_done = true;
+    }
+    if(hw->rx_w - hw->rx_r >= hw->rx_thr){
+        hw->raw |= UART_INTR_RXFIFO_FULL;
+    }
+    if(hw->tx_w - hw->tx_r < hw->tx_thr){
+        hw->raw |= UART_INTR_TXFIFO_EMPTY;
+    }
+    if((hw->raw & hw->ena) && (hw->isr != NULL)){
+        uart_model.interrupts++;
+        hw->isr(hw->isr_arg);
+    }
+    if(uart_model.step_hook != NULL){
+        uart_model.step_hook();
+    }
+}
+
+uint32_t uart_ll_get_rxfifo_len(uart_dev_t *hw){
+    return hw->rx_w - hw->rx_r;
+}
+
+void uart_ll_read_rxfifo(uart_dev_t *hw, uint8_t *buf, uint32_t rd_len){
+    while(rd_len--){
+        *buf++ = hw->rx[hw->rx_r++ % UART_MODEL_FIFO_LEN];
+    }
+}
+
+uint32_t uart_ll_get_txfifo_len(uart_dev_t *hw){
+    return UART_MODEL_FIFO_LEN - (hw->tx_w - hw->tx_r);
+}
+
+void uart_ll_write_txfifo(uart_dev_t *hw, const uint8_t *buf, uint32_t wr_len){
+    while(wr_len--){
+        hw->tx[hw->tx_w++ % UART_MODEL_FIFO_LEN] = *buf++;
+    }
+}
+
+void uart_ll_ena_intr_mask(uart_dev_t *hw, uint32_t mask){
+    hw->ena |= mask;
+}
+
+void uart_ll_disable_intr_mask(uart_dev_t *hw, uint32_t mask){
+    hw->ena &= ~mask;
+}
+
+uint32_t uart_ll_get_intsts_mask(uart_dev_t *hw){
+    return hw->raw & hw->ena;
+}
+
+void uart_ll_clr_intsts_mask(uart_dev_t *hw, uint32_t mask){
+    hw->raw &= ~mask;
+}
+
+void uart_ll_rxfifo_rst(uart_dev_t *hw){
+    hw->rx_r = hw->rx_w;
+}
+
+esp_err_t esp_intr_alloc(int source, int flags, intr_handler_t handler, void *arg, intr_handle_t *ret_handle){
+    uart_dev_t *hw = UART_LL_GET_HW(source);
+    hw->isr = handler;
+    hw->isr_arg = arg;
+    return ESP_OK;
+}
+
+esp_err_t uart_driver_install(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size, int queue_size,
+                              QueueHandle_t *uart_queue, int intr_alloc_flags){
+    UART_LL_GET_HW(uart_num)->installed = true;
+    return ESP_OK;
+}
+
+bool uart_is_driver_installed(uart_port_t uart_num){
+    return UART_LL_GET_HW(uart_num)->installed;
+}
+
+esp_err_t uart_param_config(uart_port_t uart_num, const uart_config_t *uart_config){
+    return ESP_OK;
+}
+
+esp_err_t uart_set_pin(uart_port_t uart_num, int tx_io_num, int rx_io_num, int rts_io_num, int cts_io_num){
+    return ESP_OK;
+}
+
+esp_err_t uart_intr_config(uart_port_t uart_num, const uart_intr_config_t *intr_conf){
+    uart_dev_t *hw = UART_LL_GET_HW(uart_num);
+    hw->rx_thr = intr_conf->rxfifo_full_thresh;
+    hw->tx_thr = intr_conf->txfifo_empty_intr_thresh;
+    hw->tout = intr_conf->rx_timeout_thresh;
+    hw->ena |= intr_conf->intr_enable_mask;
+    return ESP_OK;
+}
+
+esp_err_t uart_get_buffered_data_len(uart_port_t uart_num, size_t *size){
+    *size = 0;
+    return ESP_OK;
+}
+
+int uart_read_bytes(uart_port_t uart_num, void *buf, uint32_t length, TickType_t ticks_to_wait){
+    return 0;
+}
+
+int uart_write_bytes(uart_port_t uart_num, const void *src, size_t size){
+    uart_dev_t *hw = UART_LL_GET_HW(uart_num);
+    const uint8_t *data = src;
+    size_t left = size;
+
+    uart_model.tx_calls++;
+    while(left > 0){
+        uint32_t n = uart_ll_get_txfifo_len(hw);
+        n = (n < left) ? n : left;
+        uart_ll_write_txfifo(hw, data, n);
+        data += n;
+        left -= n;
+        if(left > 0){
+            UartModelStep();
+        }
+    }
+    return size;
+}
+
+int uart_tx_chars(uart_port_t uart_num, const char *buffer, uint32_t len){
+    uart_dev_t *hw = UART_LL_GET_HW(uart_num);
+    uint32_t room = uart_ll_get_txfifo_len(hw);
+
+    uart_model.tx_calls++;
+    len = (len < room) ? len : room;
+    uart_ll_write_txfifo(hw, (const uint8_t *)buffer, len);
+    return len;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *buffer){
+    buffer->storage = NULL;
+    return buffer;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *higher_priority_task_woken){
+    ((StaticSemaphore_t *)sem)->storage = sem;
+    if(higher_priority_task_woken != NULL){
+        *higher_priority_task_woken = pdTRUE;
+    }
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks){
+    StaticSemaphore_t *buffer = sem;
+    uint64_t steps = (ticks == portMAX_DELAY) ? DEADLOCK_STEPS : (uint64_t)ticks * UART_MODEL_TICK_STEPS;
+
+    for(uint64_t i = 0; buffer->storage == NULL; i++){
+        if(i == steps){
+            if(ticks == portMAX_DELAY){
+                printf("xSemaphoreTake(portMAX_DELAY) blocked for %u s\n", UART_MODEL_DEADLOCK_S);
+                exit(1);
+            }
+            return pdFALSE;
+        }
+        UartModelStep();
+    }
+    buffer->storage = NULL;
+    return pdTRUE;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_task_woken){
+    (*(uint32_t *)task)++;
+    if(higher_priority_task_woken != NULL){
+        *higher_priority_task_woken = pdTRUE;
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks){
+    /* Consumers of the test poll their notification counter from the step hook */
+    return 0;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char *name, uint32_t stack, void *param, UBaseType_t priority, TaskHandle_t *handle){
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks){
+    return pdFALSE;
+}
+
+/*==================[end of file]============================================*/
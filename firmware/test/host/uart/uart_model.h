@@ -0,0 +1,52 @@
+/**
+ * @file uart_model.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Loopback model of the UART and of the FreeRTOS calls of the UART driver (host tests)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * UART0 has 128-byte FIFOs and its TX line wired to its RX at UART_MODEL_BAUD (8N1). Time
+ * advances one character per UartModelStep(): a byte leaves the TX FIFO, arrives at the RX
+ * FIFO and the enabled interrupts are served at once (interrupt latency is not modelled).
+ * Blocking calls of the driver (semaphores, uart_write_bytes()) step the model while they
+ * wait. Tasks are notification counters: a TaskHandle_t points to a uint32_t.
+ */
+#ifndef UART_MODEL_H_
+#define UART_MODEL_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+/*==================[macros and definitions]=================================*/
+#define UART_MODEL_BAUD         921600
+#define UART_MODEL_FIFO_LEN     128
+#define UART_MODEL_CHAR_US      (10.0e6 / UART_MODEL_BAUD)  /* One character (8N1) */
+#define UART_MODEL_TICK_STEPS   92          /* Characters per FreeRTOS tick (1 ms) */
+#define UART_MODEL_DEADLOCK_S   10          /* portMAX_DELAY waits longer than this abort the test */
+/*==================[typedef]================================================*/
+/**
+ * @brief Model state (counters are cleared by UartModelReset())
+ */
+typedef struct {
+    uint64_t now;               /* Characters times since reset */
+    uint64_t line_bytes;        /* Bytes sent on the line */
+    uint64_t interrupts;        /* Calls to the UART ISR */
+    uint64_t tx_calls;          /* Calls to uart_tx_chars() and uart_write_bytes() */
+    void (*step_hook)(void);    /* Called after each character time (i.e. a consumer task) */
+} uart_model_t;
+/*==================[external data declaration]==============================*/
+extern uart_model_t uart_model;
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Empty the FIFOs and clear the counters
+ */
+void UartModelReset(void);
+
+/**
+ * @brief Advance one character time
+ */
+void UartModelStep(void);
+
+#endif /* UART_MODEL_H_ */
+/*==================[end of file]============================================*/
@@ -0,0 +1,151 @@
+/**
+ * @file test_welch.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test and benchmark of the Welch PSD estimator
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The benchmark compares both variants with what applications did before: one
+ * FFTMagnitude() call per segment, squared and averaged by hand. Usage: test_welch [blocks]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <math.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "welch.h"
+/*==================[macros and definitions]=================================*/
+#define FS              1000.0f     /* Sample frequency (Hz) */
+#define N               256         /* Segment lenght */
+#define OVERLAP         128         /* Segment overlap */
+#define BLOCK           1280        /* Samples per block: 9 segments */
+#define Q15_SCALE       16000.0f    /* Scale of the int16_t signal */
+#define BENCH_BLOCKS    50          /* Default blocks per run in the benchmark */
+/*==================[internal data declaration]==============================*/
+static float signal[BLOCK];
+static int16_t signal_q15[BLOCK];
+static float window[N], psd[WELCH_PSD_SIZE(N)];
+static int16_t window_q15[N];
+static float psd_q15[WELCH_PSD_SIZE(N)];
+static float mean_square;
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Noise plus a 100 Hz tone and DC offset (mean square is accumulated)
+ */
+static void Block(uint32_t number){
+    for(uint16_t i = 0; i < BLOCK; i++){
+        float x = 0.5f * sinf(2 * M_PI * 100.0f * (number * BLOCK + i) / FS) + 
+                  1.02f * ((rand() / (float)RAND_MAX) - 0.5f) + 0.2f;
+        signal[i] = x;
+        signal_q15[i] = (int16_t)lroundf(x * Q15_SCALE);
+        mean_square += x * x;
+    }
+}
+
+static float Power(const float *spectrum, float scale){
+    float sum = 0;
+    for(uint16_t k = 0; k < WELCH_PSD_SIZE(N); k++){
+        sum += spectrum[k];
+    }
+    return sum * FS / N / scale;
+}
+
+static void TestConfig(void){
+    welch_t welch;
+    welch_config_t config = {.sample_frec = FS, .fft_lenght = 200, .overlap = 0, .average = WELCH_AVERAGE_BLOCK};
+    CHECK(!WelchInit(&welch, &config, window, psd));
+    config.fft_lenght = N;
+    config.overlap = N;
+    CHECK(!WelchInit(&welch, &config, window, psd));
+    CHECK(!WelchInitSc16(&welch, &config, window_q15, psd_q15));
+    config.overlap = OVERLAP;
+    CHECK(WelchInit(&welch, &config, window, psd));
+}
+
+static void TestPower(void){
+    welch_t welch, welch_q15;
+    welch_config_t config = {.sample_frec = FS, .fft_lenght = N, .overlap = OVERLAP, .average = WELCH_AVERAGE_BLOCK};
+    uint16_t peak = 0;
+    CHECK(WelchInit(&welch, &config, window, psd));
+    CHECK(WelchInitSc16(&welch_q15, &config, window_q15, psd_q15));
+    srand(1);
+    mean_square = 0;
+    for(uint32_t b = 0; b < 4; b++){
+        Block(b);
+        CHECK(WelchUpdate(&welch, signal, BLOCK) == 9);
+        CHECK(WelchUpdateSc16(&welch_q15, signal_q15, BLOCK) == 9);
+    }
+    CHECK(welch.segments == 36);
+    mean_square /= 4 * BLOCK;
+    /* the PSD integrates to the signal power */
+    CHECK(fabsf(Power(psd, 1) / mean_square - 1) < 0.03f);
+    CHECK(fabsf(Power(psd_q15, Q15_SCALE * Q15_SCALE) / mean_square - 1) < 0.03f);
+    printf("power: mean square %.4f, float PSD %.4f, sc16 PSD %.4f\n", mean_square,
+           Power(psd, 1), Power(psd_q15, Q15_SCALE * Q15_SCALE));
+    /* the tone is at 100 Hz: between bins 25 and 26 */
+    for(uint16_t k = 1; k < WELCH_PSD_SIZE(N); k++){
+        peak = (psd[k] > psd[peak]) ? k : peak;
+    }
+    CHECK((peak == 25) || (peak == 26));
+    WelchReset(&welch);
+    CHECK(welch.segments == 0);
+}
+
+static void TestExponential(void){
+    welch_t welch, welch_exp;
+    welch_config_t config = {.sample_frec = FS, .fft_lenght = N, .overlap = OVERLAP, .average = WELCH_AVERAGE_BLOCK};
+    static float psd_exp[WELCH_PSD_SIZE(N)], window_exp[N];
+    WelchInit(&welch, &config, window, psd);
+    config.average = WELCH_AVERAGE_EXP;
+    config.alpha = 0.02f;
+    WelchInit(&welch_exp, &config, window_exp, psd_exp);
+    srand(2);
+    mean_square = 0;
+    for(uint32_t b = 0; b < 40; b++){
+        Block(b);
+        WelchUpdate(&welch, signal, BLOCK);
+        WelchUpdate(&welch_exp, signal, BLOCK);
+    }
+    /* a stationary signal: both averages give the same power */
+    CHECK(fabsf(Power(psd_exp, 1) / Power(psd, 1) - 1) < 0.05f);
+}
+
+static void Benchmark(uint32_t blocks){
+    welch_t welch, welch_q15;
+    welch_config_t config = {.sample_frec = FS, .fft_lenght = N, .overlap = OVERLAP, .average = WELCH_AVERAGE_BLOCK};
+    static float spectrum[N / 2], average[N / 2];
+    double t_app, t_float, t_q15;
+    WelchInit(&welch, &config, window, psd);
+    WelchInitSc16(&welch_q15, &config, window_q15, psd_q15);
+    Block(0);
+    HOST_BENCH(t_app, 5, blocks, {
+        for(uint16_t start = 0; start + N <= BLOCK; start += N - OVERLAP){
+            FFTMagnitude(&signal[start], spectrum, N);
+            for(uint16_t k = 0; k < N / 2; k++){
+                average[k] += spectrum[k] * spectrum[k];
+            }
+        }
+    });
+    HOST_BENCH(t_float, 5, blocks, WelchUpdate(&welch, signal, BLOCK));
+    HOST_BENCH(t_q15, 5, blocks, WelchUpdateSc16(&welch_q15, signal_q15, BLOCK));
+    CHECK(average[1] > 0);
+    printf("N = %d, %d%% overlap, us per segment (best of 5 runs):\n", N, 100 * OVERLAP / N);
+    printf("  FFTMagnitude() + average: %6.2f\n", t_app / 9);
+    printf("  WelchUpdate():            %6.2f\n", t_float / 9);
+    printf("  WelchUpdateSc16():        %6.2f\n", t_q15 / 9);
+}
+
+/*==================[external functions definition]==========================*/
+int main(int argc, char *argv[]){
+    uint32_t blocks = (argc > 1) ? strtoul(argv[1], NULL, 0) : BENCH_BLOCKS;
+    CHECK(FFTInit());
+    TestConfig();
+    TestPower();
+    TestExponential();
+    Benchmark(blocks);
+    return HOST_TEST_RESULT();
+}
+
+/*==================[end of file]============================================*/